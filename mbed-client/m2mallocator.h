@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_ALLOCATOR_H
+#define M2M_ALLOCATOR_H
+
+#include <stdint.h>
+
+/**
+ * \brief M2MAllocator
+ * An interface for the memory allocator used by mbed Client and by the
+ * mbed-client-c library underneath it for CoAP messages and NSDL resources.
+ * By default all memory comes from malloc() and free(). An application can
+ * install its own allocator, or one of the built-in ones, with set_allocator().
+ */
+class M2MAllocator {
+
+public:
+
+    /**
+     * \brief Allocation counters of memory_alloc() and memory_free().
+     * Bytes in use are only tracked when the allocator reports the size of
+     * its blocks through allocated_size(), as M2MPoolAllocator does.
+     */
+    typedef struct {
+        uint32_t    allocations;
+        uint32_t    deallocations;
+        uint32_t    failures;
+        uint32_t    bytes_requested;
+        uint32_t    bytes_in_use;
+        uint32_t    peak_bytes_in_use;
+    } Accounting;
+
+    virtual ~M2MAllocator() {}
+
+    /**
+     * \brief Allocates memory.
+     * \param size The size of memory to be reserved.
+     * \return A pointer to the memory, NULL if it could not be allocated.
+     */
+    virtual void* allocate(uint16_t size) = 0;
+
+    /**
+     * \brief Frees memory. The client may also pass memory here that it
+     * has allocated with malloc(), such memory must be released with free().
+     * \param ptr The memory to be freed.
+     */
+    virtual void deallocate(void *ptr) = 0;
+
+    /**
+     * \brief Returns the size of a block returned by allocate().
+     * \param ptr The memory.
+     * \return The size of the block, 0 if it is not known.
+     */
+    virtual uint32_t allocated_size(const void * /*ptr*/) const { return 0; }
+
+    /**
+     * \brief Sets the allocator used for the client memory. It must be set
+     * before the interface is created and stay valid as long as the client
+     * is in use.
+     * \param allocator The allocator, NULL restores malloc() and free().
+     */
+    static void set_allocator(M2MAllocator *allocator);
+
+    /**
+     * \brief Returns the allocator used for the client memory.
+     * \return The allocator, NULL if malloc() and free() are used.
+     */
+    static M2MAllocator* allocator();
+
+    /**
+     * \brief Allocates memory from the current allocator.
+     * \param size The size of memory to be reserved.
+     * \return A pointer to the memory, NULL if size is 0 or on failure.
+     */
+    static void* memory_alloc(uint16_t size);
+
+    /**
+     * \brief Frees memory to the current allocator.
+     * \param ptr The memory to be freed, may be NULL.
+     */
+    static void memory_free(void *ptr);
+
+    /**
+     * \brief Returns the allocation counters since the start or the last
+     * reset_accounting().
+     */
+    static const M2MAllocator::Accounting& accounting();
+
+    /**
+     * \brief Sets the allocation counters to zero. Bytes in use are kept.
+     */
+    static void reset_accounting();
+};
+
+#endif // M2M_ALLOCATOR_H
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_ARENA_ALLOCATOR_H
+#define M2M_ARENA_ALLOCATOR_H
+
+#include "mbed-client/m2mallocator.h"
+
+/**
+ * \brief M2MArenaAllocator
+ * A bump allocator for memory that is released all at once. Allocation
+ * takes the next free bytes of a fixed region and deallocate() does nothing
+ * for memory from the region, it is reused after reset(). When the region is
+ * full, allocation falls back to malloc(). The client uses an arena for
+ * memory that lives only for the handling of one CoAP request.
+ */
+class M2MArenaAllocator : public M2MAllocator {
+
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MArenaAllocator& operator=( const M2MArenaAllocator& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MArenaAllocator( const M2MArenaAllocator& /*other*/ );
+
+public:
+
+    /**
+     * \brief Constructor.
+     * \param size The size of the region in bytes.
+     */
+    M2MArenaAllocator(uint16_t size);
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~M2MArenaAllocator();
+
+    /**
+     * \brief Allocates memory from the region.
+     * \param size The size of memory to be reserved.
+     * \return A pointer to the memory, NULL if it could not be allocated.
+     */
+    virtual void* allocate(uint16_t size);
+
+    /**
+     * \brief Frees memory that did not fit in the region, memory
+     * from the region is released with reset().
+     * \param ptr The memory to be freed.
+     */
+    virtual void deallocate(void *ptr);
+
+    /**
+     * \brief Releases all memory allocated from the region.
+     */
+    void reset();
+
+    /**
+     * \brief Returns the number of bytes used from the region.
+     * \return The number of bytes used.
+     */
+    uint16_t used() const;
+
+    /**
+     * \brief Returns whether the memory is from the region.
+     * \param ptr The memory to check.
+     * \return True if ptr points into the region, else false.
+     */
+    bool contains(const void *ptr) const;
+
+private:
+
+    uint8_t             *_region;
+    uint16_t            _size;
+    uint16_t            _used;
+
+    friend class Test_M2MArenaAllocator;
+};
+
+#endif // M2M_ARENA_ALLOCATOR_H
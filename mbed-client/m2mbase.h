@@ -62,7 +62,8 @@ public:
         O_Attribute          = 0x04,
         OR_Attribute         = 0x05,
         OOI_Attribute        = 0x06,
-        OOIR_Attribute       = 0x07
+        OOIR_Attribute       = 0x07,
+        C_Attribute          = 0x08  // Part of a composite observation
     } Observation;
 
 
@@ -178,6 +179,16 @@ public:
     virtual void set_under_observation(bool observed,
                                        M2MObservationHandler *handler);
 
+    /**
+     * \brief Sets whether the value changes of the resource are reported
+     * to a composite observation, which covers several resources with one
+     * token (LWM2M 1.1 Composite-Observe).
+     * \param observed True to report the changes, false to stop.
+     * \param handler Handler object the changes are reported to.
+     */
+    void set_composite_observation(bool observed,
+                                   M2MObservationHandler *handler);
+
     /**
      * \brief Sets the observation token value.
      * \param token Pointer to the token of the resource.
@@ -351,6 +362,21 @@ public:
      */
     virtual bool register_uri();
 
+    /**
+     * \brief Sets whether notifications of this object or object instance
+     * carry only the resources changed since the previous notification.
+     * Notifications sent because of pmax, and changes which can't be
+     * tied to a resource, still carry all resources.
+     * \param delta True to send only the changed resources, default false.
+     */
+    void set_delta_notification(bool delta);
+
+    /**
+     * \brief Returns whether notifications carry only the changed resources.
+     * \return True if only the changed resources are sent, else false.
+     */
+    bool delta_notification() const;
+
     /**
      * \brief Sets object URI path.
      * \param path Object path
@@ -363,10 +389,21 @@ public:
      */
     virtual const String &uri_path() const;
 
+    /**
+     * \brief Returns the heap memory used by this node and everything it
+     * owns: names, values, child lists and children, the report handler and
+     * the observation token.
+     * \return The memory used in bytes.
+     */
+    virtual uint32_t memory_footprint() const;
+
 protected : // from M2MReportObserver
 
-    virtual void observation_to_be_sent(m2m::Vector<uint16_t> changed_instance_ids,
-                                        bool send_object = false);
+    virtual void observation_to_be_sent(const m2m::IdSet &changed_instance_ids,
+                                        bool send_object = false,
+                                        const m2m::IdSet *changed_resource_ids = NULL);
+
+    virtual bool samples_to_be_sent(M2MSampleBuffer &samples);
 
 protected:
 
@@ -387,6 +424,13 @@ protected:
      */
     virtual void remove_object_from_coap();
 
+    /**
+     * \brief Returns whether the node sends samples with the Send operation.
+     * Such a node keeps its observation handler and report handler when
+     * the observation is cancelled, the samples don't need an observer.
+     */
+    virtual bool sends_samples() const;
+
     /**
      * \brief Memory allocation required for libCoap.
      * \param size The size of memory to be reserved.
@@ -399,6 +443,45 @@ protected:
     */
     virtual void memory_free(void *ptr);
 
+    /**
+     * \brief Allocates memory for building a CoAP response. The memory
+     * comes from the request allocator of the handler, or from the heap
+     * if there is no handler or it has no request allocator.
+     * \param handler The handler of the current request, can be NULL.
+     * \param size The size of memory to be reserved.
+     * \return A pointer to the memory, NULL on failure.
+    */
+    static void* response_alloc(M2MObservationHandler *handler, uint16_t size);
+
+    /**
+     * \brief Frees memory allocated with response_alloc().
+     * \param handler The handler of the current request, can be NULL.
+     * \param ptr The memory to be freed.
+    */
+    static void response_free(M2MObservationHandler *handler, void *ptr);
+
+    /**
+     * \brief Encodes an integer option value into response memory,
+     * in the format of String::convert_integer_to_array().
+     * \param handler The handler of the current request, can be NULL.
+     * \param value The value to be encoded.
+     * \param size[OUT] The length of the encoded value.
+     * \return The encoded value, NULL on failure.
+    */
+    static uint8_t* response_integer(M2MObservationHandler *handler,
+                                     int64_t value,
+                                     uint8_t &size);
+
+    /**
+     * \brief Returns the content format the server asked a response in.
+     * The Accept option takes precedence over the Content-Format option.
+     * \param coap_header The received CoAP message.
+     * \param content_type[OUT] The requested content format.
+     * \return True if either option is present, else false.
+    */
+    static bool requested_content_type(const sn_coap_hdr_s *coap_header,
+                                       uint16_t &content_type);
+
     /**
      * \brief Returns the Report Handler object.
      * \return M2MReportHandler object.
@@ -411,9 +494,12 @@ protected:
     */
     M2MObservationHandler* observation_handler();
 
-private:
-
-    bool is_integer(const String &value);
+    /**
+     * \brief Returns the heap memory owned by the M2MBase part of the
+     * node, not including the node itself.
+     * \return The memory used in bytes.
+    */
+    uint32_t base_memory_footprint() const;
 
 private:
 
@@ -435,6 +521,7 @@ private:
     uint8_t                     *_token;
     uint8_t                     _token_length;
     bool                        _register_uri;
+    bool                        _delta_notification;
     String                      _uri_path;
     uint32_t                    _max_age;
 
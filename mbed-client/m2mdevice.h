@@ -230,10 +230,6 @@ private:
     M2MResourceInstance* get_resource_instance(DeviceResource dev_res,
                                                uint16_t instance_id) const;
 
-    String resource_name(DeviceResource resource) const;
-
-    bool check_value_range(DeviceResource resource, const int64_t value) const;
-
 private :
 
     M2MObjectInstance*    _device_instance;     //Not owned
@@ -17,10 +17,12 @@
 #define M2MFIRMWARE_H
 
 #include "mbed-client/m2mobject.h"
+#include "mbed-client/m2mfirmwaresink.h"
 
 // FORWARD DECLARATION
 class M2MResource;
 class M2MResourceInstance;
+class M2MFirmwarePackageWriter;
 
 /**
  *  \brief M2MFirmware.
@@ -207,28 +209,45 @@ public:
      */
     uint16_t per_resource_count(FirmwareResource resource) const;
 
+    /**
+     * \brief Sets the sink that receives a firmware package written to the
+     * 'Package' resource with CoAP Block1 transfer. Each block is passed to
+     * the sink as it arrives instead of buffering the whole image in the
+     * resource value. An ongoing transfer is aborted.
+     * \param sink The sink for the package, NULL to buffer the package
+     * in the resource value. The ownership is not passed.
+     */
+    void set_package_sink(M2MFirmwareSink *sink);
+
+    /**
+     * \brief Returns the number of bytes of the package written to the sink
+     * so far. The server can resume an interrupted transfer from this offset.
+     * \return The offset of the next expected byte of the package.
+     */
+    uint32_t package_offset() const;
+
 
 private:
 
     M2MResource* get_resource(FirmwareResource resource) const;
 
-    String resource_name(FirmwareResource resource) const;
+    const char* resource_name(FirmwareResource resource) const;
 
     void create_mandatory_resources();
 
     bool check_value_range(FirmwareResource resource, const int64_t value) const;
 
-    void set_zero_value(M2MResource *resource);
-
 private :
 
-    M2MObjectInstance*    _firmware_instance;     //Not owned
+    M2MObjectInstance*          _firmware_instance;     //Not owned
+    M2MFirmwarePackageWriter*   _package_writer;        //owned
 
 protected:
 
     static M2MFirmware*     _instance;
 
     friend class Test_M2MFirmware;
+    friend class Test_M2MFirmwarePackageWriter;
     friend class Test_M2MInterfaceFactory;
 };
 
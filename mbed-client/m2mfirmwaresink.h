@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_FIRMWARE_SINK_H
+#define M2M_FIRMWARE_SINK_H
+
+#include <stdint.h>
+
+/**
+ * \brief Size of the SHA-256 digest passed to M2MFirmwareSink::package_completed().
+ */
+#define M2M_FIRMWARE_DIGEST_SIZE 32
+
+/**
+ * \brief M2MFirmwareSink
+ * An interface for receiving a firmware package that the server writes
+ * into the Package resource with a CoAP Block1 transfer. Each block is handed
+ * over as soon as it arrives, so the client never holds more than one block
+ * of the image in memory. The application implements this class to store the
+ * image, for example into a file or a flash area, and registers it with
+ * M2MFirmware::set_package_sink().
+ */
+class M2MFirmwareSink {
+
+public:
+
+    /**
+     * \brief A callback indicating that the server has started a new package
+     * transfer. Any partially stored image must be discarded.
+     * \return True if the sink is ready to receive the package, else false.
+     */
+    virtual bool package_started() = 0;
+
+    /**
+     * \brief A callback carrying the next part of the package. Blocks are
+     * delivered in order and exactly once, offset is the position of the
+     * first byte of data in the image.
+     * \param offset The offset of the data in the package.
+     * \param data The data of the block, valid only during the call.
+     * \param length The length of the data.
+     * \return True if the data was stored, else false, which aborts the transfer.
+     */
+    virtual bool package_block(uint32_t offset,
+                               const uint8_t *data,
+                               uint16_t length) = 0;
+
+    /**
+     * \brief A callback indicating that the last block of the package
+     * has been received.
+     * \param size The total size of the package.
+     * \param digest The SHA-256 digest of the whole package,
+     * M2M_FIRMWARE_DIGEST_SIZE bytes long.
+     */
+    virtual void package_completed(uint32_t size, const uint8_t *digest) = 0;
+
+    /**
+     * \brief A callback indicating that the transfer was aborted
+     * and the partially stored package is not valid.
+     */
+    virtual void package_aborted() = 0;
+};
+
+#endif // M2M_FIRMWARE_SINK_H
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef M2M_ID_SET_H
+#define M2M_ID_SET_H
+
+#include <stdint.h>
+#include <string.h>
+
+namespace m2m
+{
+
+/**
+ * \brief A set of 16-bit IDs, kept as a bitmap.
+ * Inserting and looking up an ID is O(1), iterating goes in ID order and
+ * clear() keeps the memory for the next round. The bitmap grows to cover
+ * the highest ID inserted, up to 8 kB for the full ID range.
+ */
+class IdSet
+{
+  public:
+    IdSet()
+            : _words(NULL),
+              _word_count(0),
+              _count(0),
+              _low(0),
+              _high(0) {
+    }
+
+    IdSet(const IdSet & rhs)
+            : _words(NULL),
+              _word_count(0),
+              _count(0),
+              _low(0),
+              _high(0) {
+        operator=(rhs);
+    }
+
+    ~IdSet() {
+        delete [] _words;
+        _words = NULL;
+    }
+
+    const IdSet & operator=(const IdSet & rhs) {
+        if(this != &rhs) {
+            clear();
+            if(rhs._count > 0 && reserve_words(rhs._high + 1)) {
+                memcpy(_words + rhs._low, rhs._words + rhs._low,
+                       (rhs._high - rhs._low + 1) * sizeof(uint32_t));
+                _count = rhs._count;
+                _low = rhs._low;
+                _high = rhs._high;
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * \brief Adds an ID to the set.
+     * \return False if the memory for it couldn't be allocated, else true.
+     */
+    bool insert(uint16_t id) {
+        uint16_t word = id >> 5;
+        if(word >= _word_count && !reserve_words(word + 1)) {
+            return false;
+        }
+        uint32_t bit = 1UL << (id & 31);
+        if(!(_words[word] & bit)) {
+            _words[word] |= bit;
+            if(_count == 0 || word < _low) {
+                _low = word;
+            }
+            if(_count == 0 || word > _high) {
+                _high = word;
+            }
+            _count++;
+        }
+        return true;
+    }
+
+    bool contains(uint16_t id) const {
+        uint16_t word = id >> 5;
+        return word < _word_count && (_words[word] & (1UL << (id & 31))) != 0;
+    }
+
+    int size() const {
+        return _count;
+    }
+
+    bool empty() const {
+        return _count == 0;
+    }
+
+    /**
+     * \brief Removes all IDs. Only the words which were in use are
+     * cleared and the memory is kept.
+     */
+    void clear() {
+        if(_count > 0) {
+            memset(_words + _low, 0, (_high - _low + 1) * sizeof(uint32_t));
+            _count = 0;
+        }
+        _low = 0;
+        _high = 0;
+    }
+
+    /**
+     * \brief Returns the lowest ID in the set, -1 if the set is empty.
+     */
+    int32_t first() const {
+        return find_from((uint32_t)_low << 5);
+    }
+
+    /**
+     * \brief Returns the lowest ID in the set greater than the given one,
+     * -1 if there is none.
+     * A set is walked with
+     * for(int32_t id = set.first(); id != -1; id = set.next(id))
+     */
+    int32_t next(uint16_t id) const {
+        return find_from((uint32_t)id + 1);
+    }
+
+    /**
+     * \brief Returns the number of bytes allocated for the bitmap.
+     */
+    uint32_t capacity() const {
+        return _word_count * sizeof(uint32_t);
+    }
+
+  private:
+
+    bool reserve_words(uint32_t count) {
+        if(count <= _word_count) {
+            return true;
+        }
+        uint32_t new_count = 2 * _word_count;
+        if(new_count < count) {
+            new_count = count;
+        }
+        if(new_count > MAX_WORDS) {
+            new_count = MAX_WORDS;
+        }
+        uint32_t *words = new uint32_t[new_count];
+        if(!words) {
+            return false;
+        }
+        memset(words, 0, new_count * sizeof(uint32_t));
+        if(_words) {
+            memcpy(words, _words, _word_count * sizeof(uint32_t));
+            delete [] _words;
+        }
+        _words = words;
+        _word_count = new_count;
+        return true;
+    }
+
+    int32_t find_from(uint32_t id) const {
+        if(_count == 0) {
+            return -1;
+        }
+        uint32_t word = id >> 5;
+        if(word < _low) {
+            word = _low;
+            id = (uint32_t)_low << 5;
+        }
+        for(; word <= _high; word++) {
+            uint32_t bits = _words[word];
+            if(word == (id >> 5)) {
+                bits &= ~0UL << (id & 31);
+            }
+            if(bits) {
+                int32_t found = word << 5;
+                while(!(bits & 1)) {
+                    bits >>= 1;
+                    found++;
+                }
+                return found;
+            }
+        }
+        return -1;
+    }
+
+    enum {
+        MAX_WORDS = 65536 / 32
+    };
+
+  private:
+    uint32_t        *_words;
+    uint32_t        _word_count;
+    int             _count;
+    uint16_t        _low;
+    uint16_t        _high;
+};
+
+} // namespace
+
+#endif // M2M_ID_SET_H
@@ -27,6 +27,7 @@ class M2MObject;
 class M2MInterfaceObserver;
 
 typedef Vector<M2MObject *> M2MObjectList;
+typedef Vector<String> M2MPathList;
 typedef FP callback_handler;
 
 /**
@@ -143,11 +144,31 @@ public:
     /**
      * \brief Sets the function that will be called for indicating that the client
      * is going to sleep when the Binding mode is selected with Queue mode.
+     * The client sleeps once its confirmable messages have been acknowledged
+     * or have run out of retransmissions. While it sleeps, only the latest
+     * notification of each observation is kept. They are sent together after
+     * the next registration update, which wakes the client up.
      * \param callback A function pointer that will be called when the client
      * goes to sleep.
      */
     virtual void set_queue_sleep_handler(callback_handler handler) = 0;
 
+    /**
+     * \brief Sends the current values of the given objects, object instances,
+     * resources or resource instances to the LWM2M server in one message
+     * (LWM2M 1.1 Send operation). The values are encoded as SenML-CBOR
+     * and POSTed to "/dp". Errors are reported through M2MInterfaceObserver::error().
+     * \param paths The paths of the entities to send, for example "3/0/9".
+     */
+    virtual void send(const M2MPathList &paths) = 0;
+
+    /**
+     * \brief Returns the registered object with the given object ID.
+     * \param object_id The object ID, for example 3 for the Device object.
+     * \return The object, NULL if no object with the ID is registered.
+     */
+    virtual M2MObject* object(uint16_t object_id) const = 0;
+
 };
 
 #endif // M2M_INTERFACE_H
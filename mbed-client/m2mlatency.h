@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_LATENCY_H
+#define M2M_LATENCY_H
+
+#include <stdint.h>
+
+/**
+ * \brief M2MLatency
+ * Latency histograms for the CoAP request and notification paths. Values
+ * are recorded in microseconds into log-linear buckets, eight per power of
+ * two, so every recorded value is within 12.5% of its bucket bounds.
+ * Recording is a few relaxed atomic increments and the histograms can be
+ * read or exported from another thread at any time. Nothing is recorded
+ * until a clock has been set with M2MStatistics::set_clock().
+ */
+class M2MLatency {
+
+public:
+
+    typedef enum {
+        GetRequest = 0,     // Datagram received to response sent
+        PutRequest,
+        PostRequest,
+        DeleteRequest,
+        NotificationDelay,  // Value changed to notification sent
+        NotificationAck,    // Notification sent to ACK received
+        HistogramCount
+    } Histogram;
+
+    /**
+     * \brief Number of buckets in a histogram. Values of 2^27 us
+     * (about 134 s) and above are counted in the last bucket.
+     */
+    static const uint16_t BucketCount = 200;
+
+    /**
+     * \brief Records a value into a histogram.
+     * \param histogram The histogram.
+     * \param microseconds The latency.
+     */
+    static void record(M2MLatency::Histogram histogram, uint64_t microseconds);
+
+    /**
+     * \brief Returns the number of values recorded into a histogram.
+     */
+    static uint32_t count(M2MLatency::Histogram histogram);
+
+    /**
+     * \brief Returns the largest value recorded into a histogram.
+     */
+    static uint32_t max(M2MLatency::Histogram histogram);
+
+    /**
+     * \brief Returns the value at the given percentile of a histogram.
+     * \param histogram The histogram.
+     * \param percentile Percentile between 0 and 100, e.g. 99.9.
+     * \return The upper bound in microseconds of the bucket holding the
+     * percentile, 0 if the histogram is empty.
+     */
+    static uint32_t percentile(M2MLatency::Histogram histogram, float percentile);
+
+    /**
+     * \brief Returns the number of values counted in a bucket.
+     */
+    static uint32_t bucket(M2MLatency::Histogram histogram, uint16_t index);
+
+    /**
+     * \brief Returns the largest value in microseconds counted in a bucket.
+     */
+    static uint32_t bucket_upper_bound(uint16_t index);
+
+    /**
+     * \brief Writes all histograms as a JSON object into the buffer. Each
+     * histogram lists its count, max, p50, p90, p99 and p99.9 and its
+     * non-empty buckets as [upper bound, count] pairs.
+     * \param buffer The buffer to write to.
+     * \param size The size of the buffer.
+     * \return The length written without the terminating NUL, 0 if the
+     * buffer is too small.
+     */
+    static uint32_t export_json(char *buffer, uint32_t size);
+
+    /**
+     * \brief Clears all histograms.
+     */
+    static void reset();
+
+    /**
+     * \brief Marks the arrival of a datagram from the network.
+     */
+    static void request_received();
+
+    /**
+     * \brief Marks the start of handling a request received by
+     * request_received(). The first message sent before request_finished()
+     * is taken as its response.
+     * \param msg_code The CoAP method of the request.
+     */
+    static void request_started(uint8_t msg_code);
+
+    /**
+     * \brief Marks the end of handling a request.
+     */
+    static void request_finished();
+
+    /**
+     * \brief Sets the time of the value change a notification being sent
+     * reports, 0 when the notification is not caused by a change.
+     */
+    static void notification_triggered(uint64_t changed_at);
+
+    /**
+     * \brief Marks the messages sent until the next call as notifications.
+     */
+    static void notification_sending(bool sending);
+
+    /**
+     * \brief Records a CoAP message handed to the network.
+     * \param data The CoAP message.
+     * \param length The length of the message.
+     */
+    static void message_sent(const uint8_t *data, uint16_t length);
+
+    /**
+     * \brief Records an ACK received from the server. It completes the
+     * pending notification with the same message ID, if any.
+     * \param msg_id The CoAP message ID.
+     */
+    static void message_acknowledged(uint16_t msg_id);
+};
+
+#endif // M2M_LATENCY_H
@@ -83,7 +83,7 @@ public:
 
     /**
      * \brief Returns a list of object instances.
-     * \return A list of object instances.
+     * \return A list of object instances, sorted by instance ID.
      */
     virtual const M2MObjectInstanceList& instances() const;
 
@@ -151,20 +151,31 @@ public:
                                                M2MObservationHandler *observation_handler,
                                                bool &execute_value_updated);
 
+    /**
+     * \brief Returns the heap memory used by this object and everything it
+     * owns, see M2MBase::memory_footprint().
+     * \return The memory used in bytes.
+     */
+    virtual uint32_t memory_footprint() const;
+
 protected :
 
-     virtual void notification_update(uint16_t obj_instance_id);
+     virtual void notification_update(uint16_t obj_instance_id,
+                                      int32_t resource_id);
 
 private:
 
-    M2MObjectInstanceList     _instance_list; // owned    
+    M2MObjectInstanceList     _instance_list; // owned, sorted by instance ID
     uint16_t                  _max_instance_count;
 
 friend class Test_M2MObject;
 friend class Test_M2MInterfaceImpl;
 friend class Test_M2MNsdlInterface;
 friend class Test_M2MTLVSerializer;
+friend class Test_M2MSenMLCBORSerializer;
 friend class Test_M2MTLVDeserializer;
+friend class Test_M2MSenMLCBORDeserializer;
+friend class Test_M2MCompositeObservation;
 
 };
 
@@ -25,7 +25,8 @@ typedef Vector<M2MResourceInstance *> M2MResourceInstanceList;
 
 class M2MObjectCallback {
 public:
-    virtual void notification_update(uint16_t obj_instance_id) = 0;
+    virtual void notification_update(uint16_t obj_instance_id,
+                                     int32_t resource_id) = 0;
 };
 
 /**
@@ -161,9 +162,26 @@ public:
      */
     virtual M2MResource* resource(const String &name) const;
 
+    /**
+     * \brief Returns the resource with the given name, without
+     * constructing a String for the lookup.
+     * \param name The name of the requested resource.
+     * \return Resource reference if found, else NULL.
+     */
+    M2MResource* resource(const char *name) const;
+
+    /**
+     * \brief Returns the resource with the given numeric ID. It is not an
+     * overload of resource(), a literal 0 would select resource(const char*).
+     * \param resource_id The ID of the requested resource.
+     * \return Resource reference if found, else NULL.
+     */
+    M2MResource* resource_by_id(uint16_t resource_id) const;
+
     /**
      * \brief Returns a list of M2MResourceBase objects.
-     * \return A list of M2MResourceBase objects.
+     * \return A list of M2MResourceBase objects, sorted by numeric name ID.
+     * Resources with a non-numeric name come first.
      */
     virtual const M2MResourceList& resources() const;
 
@@ -237,15 +255,29 @@ public:
                                                M2MObservationHandler *observation_handler,
                                                bool &execute_value_updated);
 
+    /**
+     * \brief Returns the heap memory used by this object instance and everything it
+     * owns, see M2MBase::memory_footprint().
+     * \return The memory used in bytes.
+     */
+    virtual uint32_t memory_footprint() const;
+
 
 protected :
 
-    virtual void notification_update(M2MBase::Observation observation_level);
+    virtual void notification_update(M2MBase::Observation observation_level,
+                                     int32_t resource_id);
+
+private:
+
+    int resource_position(const char *resource_name) const;
+
+    void insert_resource(M2MResource *res);
 
 private:
 
     M2MObjectCallback   &_object_callback;
-    M2MResourceList     _resource_list; // owned
+    M2MResourceList     _resource_list; // owned, sorted by name ID
 
     friend class Test_M2MObjectInstance;
     friend class Test_M2MObject;
@@ -255,7 +287,10 @@ private:
     friend class Test_M2MNsdlInterface;
     friend class Test_M2MFirmware;
     friend class Test_M2MTLVSerializer;
+    friend class Test_M2MSenMLCBORSerializer;
     friend class Test_M2MTLVDeserializer;
+    friend class Test_M2MSenMLCBORDeserializer;
+    friend class Test_M2MStatistics;
 };
 
 #endif // M2M_OBJECT_INSTANCE_H
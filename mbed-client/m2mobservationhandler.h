@@ -16,9 +16,13 @@
 #ifndef M2M_OBSERVATION_HANDLER_H
 #define M2M_OBSERVATION_HANDLER_H
 
+#include "mbed-client/m2midset.h"
+
 //FORWARD DECLARATION
 class M2MBase;
 class M2MResourceInstance;
+class M2MAllocator;
+class M2MSampleBuffer;
 
 /**
  * \brief M2MObservationHandler
@@ -35,13 +39,16 @@ class M2MObservationHandler
      * server due to a change in a parameter under observation.
      * \param object The observed object whose information needs to be sent.
      * \param obs_number The observation number.
-     * \param changed_instance_ids A list of changed object instance IDs.
+     * \param changed_instance_ids The set of changed object instance IDs.
      * \param send_object Indicates whether the whole object will be sent or not.
+     * \param changed_resource_ids The set of changed resource IDs, NULL if
+     * all resources are to be sent.
      */
     virtual void observation_to_be_sent(M2MBase *object,
                                         uint16_t obs_number,
-                                        m2m::Vector<uint16_t> changed_instance_ids,
-                                        bool send_object = false) = 0;
+                                        const m2m::IdSet &changed_instance_ids,
+                                        bool send_object = false,
+                                        const m2m::IdSet *changed_resource_ids = NULL) = 0;
 
     /**
      * \brief A callback for deleting an NSDL resource.
@@ -70,6 +77,34 @@ class M2MObservationHandler
      */
     virtual void send_delayed_response(M2MBase *base) = 0;
 
+    /**
+     * \brief Returns the allocator for memory that is needed only while
+     * the current request is handled, such as the options and the payload
+     * of the response. The memory is released after the response is sent.
+     * \return The allocator, NULL if the memory is allocated from the heap.
+     */
+    virtual M2MAllocator* request_allocator() { return NULL; }
+
+    /**
+     * \brief A callback indicating that the value of a resource which is part
+     * of a composite observation has changed.
+     * \param base The resource or resource instance whose value changed.
+     */
+    virtual void composite_value_changed(M2MBase * /*base*/) {}
+
+    /**
+     * \brief A callback to send the samples buffered for a resource
+     * in one SenML-CBOR message, as a notification or with the Send
+     * operation.
+     * \param base The resource whose samples are sent.
+     * \param obs_number The observation number for a notification.
+     * \param samples The buffered samples.
+     * \return True if the samples were sent, else false.
+     */
+    virtual bool samples_to_be_sent(M2MBase * /*base*/,
+                                    uint16_t /*obs_number*/,
+                                    M2MSampleBuffer &/*samples*/) { return false; }
+
 };
 
 
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_POOL_ALLOCATOR_H
+#define M2M_POOL_ALLOCATOR_H
+
+#include "mbed-client/m2mallocator.h"
+
+/**
+ * \brief Number of block sizes in M2MPoolAllocator, from
+ * M2M_POOL_MIN_BLOCK_SIZE doubling up to M2M_POOL_MAX_BLOCK_SIZE.
+ */
+#define M2M_POOL_SIZE_CLASSES       5
+#define M2M_POOL_MIN_BLOCK_SIZE     16
+#define M2M_POOL_MAX_BLOCK_SIZE     256
+
+#ifdef YOTTA_CFG_MBED_CLIENT_POOL_BLOCKS
+#define M2M_POOL_BLOCKS YOTTA_CFG_MBED_CLIENT_POOL_BLOCKS
+#else
+#define M2M_POOL_BLOCKS 32
+#endif
+
+/**
+ * \brief M2MPoolAllocator
+ * An allocator that serves small requests from fixed size blocks of
+ * 16, 32, 64, 128 and 256 bytes. All blocks are reserved in one region when
+ * the allocator is created, so allocation and free are constant time and the
+ * heap does not fragment over the lifetime of the device. A request that
+ * does not fit in any free block falls back to malloc().
+ * The allocator is not thread safe, it is meant to be used from the thread
+ * that runs the client.
+ */
+class M2MPoolAllocator : public M2MAllocator {
+
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MPoolAllocator& operator=( const M2MPoolAllocator& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MPoolAllocator( const M2MPoolAllocator& /*other*/ );
+
+public:
+
+    /**
+     * \brief Constructor.
+     * \param blocks The number of blocks of each size.
+     */
+    M2MPoolAllocator(uint16_t blocks = M2M_POOL_BLOCKS);
+
+    /**
+     * \brief Destructor. All pool memory must have been freed before.
+     */
+    virtual ~M2MPoolAllocator();
+
+    /**
+     * \brief Allocates memory from the smallest free block that fits.
+     * \param size The size of memory to be reserved.
+     * \return A pointer to the memory, NULL if it could not be allocated.
+     */
+    virtual void* allocate(uint16_t size);
+
+    /**
+     * \brief Returns a block to the pool, other memory is freed with free().
+     * \param ptr The memory to be freed.
+     */
+    virtual void deallocate(void *ptr);
+
+    /**
+     * \brief Returns the size of a pool block.
+     * \param ptr The memory.
+     * \return The block size, 0 for memory that is not from the pool.
+     */
+    virtual uint32_t allocated_size(const void *ptr) const;
+
+    /**
+     * \brief Returns the number of pool blocks currently in use.
+     * \return The number of blocks in use.
+     */
+    uint32_t blocks_in_use() const;
+
+private:
+
+    int8_t size_class(const void *ptr) const;
+
+private:
+
+    struct FreeBlock {
+        FreeBlock   *next;
+    };
+
+    uint8_t             *_region;
+    uint16_t            _blocks;
+    FreeBlock           *_free_list[M2M_POOL_SIZE_CLASSES];
+    uint32_t            _blocks_in_use;
+
+    friend class Test_M2MPoolAllocator;
+};
+
+#endif // M2M_POOL_ALLOCATOR_H
@@ -18,6 +18,10 @@
 
 #include <inttypes.h>
 #include <mbed-client/m2mvector.h>
+#include <mbed-client/m2midset.h>
+
+//FORWARD DECLARATION
+class M2MSampleBuffer;
 
 /**
  * \brief M2MReportObserver
@@ -32,11 +36,22 @@ class M2MReportObserver
     /**
      * \brief An observation callback to be sent to the
      * server due to a change in the observed parameter.
-     * \param changed_instance_ids A list of changed object instance IDs.
+     * \param changed_instance_ids The set of changed object instance IDs.
      * \param send_object Indicates whether the whole object will be sent or not.
+     * \param changed_resource_ids The set of changed resource IDs, NULL if
+     * all resources are to be sent.
+     */
+    virtual void observation_to_be_sent(const m2m::IdSet &changed_instance_ids,
+                                        bool send_object = false,
+                                        const m2m::IdSet *changed_resource_ids = NULL) = 0;
+
+    /**
+     * \brief A callback to send the samples buffered for a resource to the
+     * server in one message.
+     * \param samples The buffered samples.
+     * \return True if the samples were sent, else false.
      */
-    virtual void observation_to_be_sent(m2m::Vector<uint16_t> changed_instance_ids,
-                                        bool send_object = false) = 0;
+    virtual bool samples_to_be_sent(M2MSampleBuffer &/*samples*/) { return false; }
 
 };
 
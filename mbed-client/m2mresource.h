@@ -154,7 +154,7 @@ public:
 
     /**
      * \brief Returns a list of resources.
-     * \return A list of resources.
+     * \return A list of resources, sorted by instance ID.
      */
     virtual const M2MResourceInstanceList& resource_instances() const;
 
@@ -227,12 +227,19 @@ public:
                                                M2MObservationHandler *observation_handler,
                                                bool &execute_value_updated);
 
+    /**
+     * \brief Returns the heap memory used by this resource and everything it
+     * owns, see M2MBase::memory_footprint().
+     * \return The memory used in bytes.
+     */
+    virtual uint32_t memory_footprint() const;
+
 protected:
     virtual void notification_update();
 
 private:
 
-    M2MResourceInstanceList     _resource_instance_list; // owned
+    M2MResourceInstanceList     _resource_instance_list; // owned, sorted by instance ID
     bool                        _has_multiple_instances;
     bool                        _delayed_response;
     uint8_t                     *_delayed_token;
@@ -247,7 +254,10 @@ friend class Test_M2MServer;
 friend class Test_M2MNsdlInterface;
 friend class Test_M2MFirmware;
 friend class Test_M2MTLVSerializer;
+friend class Test_M2MSenMLCBORSerializer;
 friend class Test_M2MTLVDeserializer;
+friend class Test_M2MSenMLCBORDeserializer;
+friend class Test_M2MStatistics;
 
 };
 
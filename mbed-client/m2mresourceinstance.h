@@ -21,7 +21,8 @@
 
 class M2MObjectInstanceCallback {
 public:
-    virtual void notification_update(M2MBase::Observation observation_level) = 0;
+    virtual void notification_update(M2MBase::Observation observation_level,
+                                     int32_t resource_id) = 0;
 };
 
 /**
@@ -32,12 +33,21 @@ public:
 typedef FP1<void,void*> execute_callback;
 typedef void(*execute_callback_2) (void *arguments);
 
+class M2MResourceInstance;
+typedef FP1<void,M2MResourceInstance*> value_provider_callback;
+typedef void(*value_provider_callback_2) (M2MResourceInstance *resource);
+
 class M2MResourceCallback;
+class M2MFirmwarePackageWriter;
+class M2MSampleBuffer;
 
 class M2MResourceInstance : public M2MBase {
 
 friend class M2MObjectInstance;
 friend class M2MResource;
+friend class M2MFirmware;
+friend class M2MTLVSerializer;
+friend class M2MSenMLCBORSerializer;
 
 public:
 
@@ -55,6 +65,15 @@ public:
         OBJLINK
     }ResourceType;
 
+    /**
+     * Enum defining which sample is dropped when
+     * the sample buffer is full.
+    */
+    typedef enum {
+        DropOldest,
+        DropNewest
+    }SampleOverflow;
+
 
 private: // Constructor and destructor are private
          // which means that these objects can be created or
@@ -144,13 +163,95 @@ public:
     virtual void set_execute_function(execute_callback_2 callback);
 
     /**
-     * \brief Sets the value of the given resource.
+     * \brief Sets the value of the given resource. With a sample buffer
+     * the value is also buffered, see set_sample_buffer().
      * \param value, A pointer to the value to be set on the resource.
      * \param value_length The length of the value pointer.
      * \return True if successfully set, else false.
      */
     virtual bool set_value(const uint8_t *value, const uint32_t value_length);
 
+    /**
+     * \brief Sets the value of the given resource to refer to a memory region
+     * owned by the caller, for example a file mapped into memory. The data is
+     * not copied, value() returns a pointer into the region and GET requests
+     * are served from it in Block2 slices of at most MAX_VALUE_BLOCK_SIZE bytes.
+     * The region must stay valid and unchanged until a new value is set or
+     * the resource is deleted.
+     * \param value A pointer to the memory region.
+     * \param value_length The length of the memory region.
+     * \return True if successfully set, else false.
+     */
+    bool set_value_reference(const uint8_t *value, const uint32_t value_length);
+
+    /**
+     * \brief Returns whether the value refers to a memory region owned by the caller.
+     * \return True if the value was set with set_value_reference(), else false.
+     */
+    bool is_value_reference() const;
+
+    /**
+     * \brief Sets the function that provides the value of this resource
+     * on demand. The function is called only when the value is needed, i.e.
+     * for a GET request, for TLV serialization and for observation reports,
+     * and it should update the value with set_value(). Updating the value
+     * from the provider does not trigger a notification, use mark_changed()
+     * for that.
+     * \param callback The function pointer that provides the value.
+     */
+    void set_value_provider(value_provider_callback callback);
+
+    /**
+     * \brief Sets the function that provides the value of this resource
+     * on demand, see set_value_provider(value_provider_callback).
+     * \param callback The function pointer that provides the value.
+     */
+    void set_value_provider(value_provider_callback_2 callback);
+
+    /**
+     * \brief Tells that the value of the resource has changed. If a value
+     * provider is set, it is called and the new value is reported to
+     * the observers of the resource.
+     */
+    void mark_changed();
+
+    /**
+     * \brief Buffers every value set with set_value() together with the time
+     * it was set, see M2MStatistics::set_clock(). The samples are sent to the
+     * server in one SenML-CBOR message once one of the thresholds is reached,
+     * instead of a notification per value change. Only a resource, not an
+     * instance of a resource with multiple instances, can buffer samples.
+     * \param capacity The maximum number of samples held.
+     * \param flush_count The number of samples that triggers sending, 0 for capacity.
+     * \param flush_age The age of the oldest sample in milliseconds that
+     * triggers sending, 0 for no limit.
+     * \param flush_bytes The total size of the values that triggers sending, 0 for no limit.
+     * \param overflow The sample dropped when the buffer is full, which
+     * happens when the samples cannot be sent.
+     * \param send True to send the samples with the Send operation, false to
+     * send them as a notification, which requires that the server observes
+     * the resource.
+     * \return True if the buffer was created, else false.
+     */
+    bool set_sample_buffer(uint16_t capacity,
+                           uint16_t flush_count = 0,
+                           uint32_t flush_age = 0,
+                           uint32_t flush_bytes = 0,
+                           SampleOverflow overflow = DropOldest,
+                           bool send = false);
+
+    /**
+     * \brief Deletes the sample buffer and the samples not sent yet. Value
+     * changes are notified again one by one.
+     */
+    void remove_sample_buffer();
+
+    /**
+     * \brief Returns the number of samples waiting to be sent.
+     * \return The number of samples, 0 if there is no sample buffer.
+     */
+    uint16_t sample_count() const;
+
     /**
      * \brief Clears the value of the given resource.
      */
@@ -218,6 +319,13 @@ public:
     */
     const String& object_name() const;
 
+    /**
+     * \brief Returns the heap memory used by this resource instance and everything it
+     * owns, see M2MBase::memory_footprint().
+     * \return The memory used in bytes.
+     */
+    virtual uint32_t memory_footprint() const;
+
 protected:
 
     /**
@@ -226,12 +334,32 @@ protected:
      */
     void set_resource_observer(M2MResourceCallback *resource);
 
+    virtual bool sends_samples() const;
+
 private:
 
     void report();
 
+    void report_composite();
+
+    void add_sample();
+
     bool is_value_changed(const uint8_t* value, const uint32_t value_len);
 
+    void free_value();
+
+    void update_value();
+
+    void copy_value(uint8_t *&value, uint32_t &value_length) const;
+
+    bool is_block_request(sn_coap_hdr_s *received_coap_header) const;
+
+    bool set_block_payload(sn_coap_hdr_s *received_coap_header,
+                           sn_coap_hdr_s *coap_response,
+                           M2MObservationHandler *observation_handler);
+
+    void set_package_writer(M2MFirmwarePackageWriter *writer);
+
 private:
 
     M2MObjectInstanceCallback               &_object_instance_callback;
@@ -243,6 +371,11 @@ private:
     uint16_t                                _object_instance_id;
     String                                  _object_name;
     FP1<void, void*>                        *_function_pointer;
+    M2MFirmwarePackageWriter                *_package_writer; // Not owned
+    bool                                    _value_referenced;
+    value_provider_callback                 *_value_provider;
+    bool                                    _providing_value;
+    M2MSampleBuffer                         *_sample_buffer;
 
     friend class Test_M2MResourceInstance;
     friend class Test_M2MResource;
@@ -254,7 +387,9 @@ private:
     friend class Test_M2MNsdlInterface;
     friend class Test_M2MFirmware;
     friend class Test_M2MTLVSerializer;
+    friend class Test_M2MSenMLCBORSerializer;
     friend class Test_M2MTLVDeserializer;
+    friend class Test_M2MSenMLCBORDeserializer;
 };
 
 #endif // M2M_RESOURCE_INSTANCE_H
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_STATISTICS_H
+#define M2M_STATISTICS_H
+
+#include <stdint.h>
+#include "mbed-client/m2mvector.h"
+
+class M2MObject;
+
+/**
+ * \brief M2MStatistics
+ * Runtime counters collected by the client. They are readable at any time
+ * through value() and can be published to the server as an instance of
+ * the LwM2M Connectivity Statistics object (7), see create_object().
+ */
+class M2MStatistics {
+
+public:
+
+    typedef enum {
+        MessagesSent = 0,
+        MessagesReceived,
+        Retransmissions,
+        NotificationsSent,
+        NotificationsCoalesced,
+        NotificationsDropped,
+        BytesSent,
+        BytesReceived,
+        MaxMessageSize,
+        RegistrationUpdates,
+        RegistrationUpdateLatency,
+        MaxRegistrationUpdateLatency,
+        HeapBytes,
+        SamplesDropped,
+        StatisticCount
+    } Statistic;
+
+    /**
+     * \brief Heap memory used by the objects with one object ID.
+     */
+    typedef struct {
+        int32_t     object_id;      // -1 for objects without a numeric name
+        uint16_t    objects;
+        uint16_t    instances;
+        uint32_t    bytes;
+    } ObjectMemory;
+
+    /**
+     * \brief Function returning a monotonic time in microseconds.
+     */
+    typedef uint64_t (*clock_function)();
+
+    /**
+     * \brief Returns the value of a counter. Latencies are in milliseconds
+     * and are only measured once a clock has been set with set_clock().
+     * HeapBytes is the heap used by the registered objects as returned by
+     * M2MBase::memory_footprint(), updated on every registration and
+     * registration update. SamplesDropped counts the samples lost because
+     * the sample buffer of a resource was full.
+     * \param statistic The counter to read.
+     * \return The value of the counter.
+     */
+    static uint32_t value(M2MStatistics::Statistic statistic);
+
+    /**
+     * \brief Returns the average message size in bytes over the sent and
+     * received messages.
+     */
+    static uint32_t average_message_size();
+
+    /**
+     * \brief Sets all counters back to zero.
+     */
+    static void reset();
+
+    /**
+     * \brief Sets the clock used for latency measurements.
+     * \param clock The clock, NULL disables latency measurements.
+     */
+    static void set_clock(clock_function clock);
+
+    /**
+     * \brief Returns the current time of the clock set with set_clock().
+     * \return Time in microseconds, 0 if no clock is set.
+     */
+    static uint64_t now();
+
+    /**
+     * \brief Creates an instance of the Connectivity Statistics object (7)
+     * for registering to the server. Tx Data, Rx Data, Max Message Size and
+     * Average Message Size are read from the counters whenever the server
+     * reads them and executing Start or Reset resets the counters.
+     * \return The object, owned by the caller. NULL if it could not be created.
+     */
+    static M2MObject* create_object();
+
+    /**
+     * \brief Breaks down the heap used by objects by object ID, in the
+     * order the IDs first appear in the list.
+     * \param objects The objects, for example the list being registered.
+     * \param report Array to fill, one entry per object ID.
+     * \param size Number of entries in the array.
+     * \return Number of entries filled. IDs that don't fit are not reported.
+     */
+    static uint16_t memory_report(const m2m::Vector<M2MObject*> &objects,
+                                  M2MStatistics::ObjectMemory *report,
+                                  uint16_t size);
+
+    /**
+     * \brief Adds to a counter.
+     * \param statistic The counter.
+     * \param amount The amount to add.
+     */
+    static void increment(M2MStatistics::Statistic statistic, uint32_t amount = 1);
+
+    /**
+     * \brief Sets a counter that holds a level rather than a count.
+     * \param statistic The counter.
+     * \param value The new value.
+     */
+    static void set(M2MStatistics::Statistic statistic, uint32_t value);
+
+    /**
+     * \brief Records a CoAP message handed to the network. A confirmable
+     * message sent again with a recently used message ID is counted as a
+     * retransmission.
+     * \param data The CoAP message.
+     * \param length The length of the message.
+     */
+    static void message_sent(const uint8_t *data, uint16_t length);
+
+    /**
+     * \brief Records a CoAP message received from the network.
+     * \param length The length of the message.
+     */
+    static void message_received(uint16_t length);
+
+    /**
+     * \brief Records that a registration update has been sent.
+     */
+    static void registration_update_sent();
+
+    /**
+     * \brief Records that a registration update has been acknowledged.
+     */
+    static void registration_update_completed();
+};
+
+#endif // M2M_STATISTICS_H
@@ -126,6 +126,18 @@ namespace m2m
   void reverse(char s[], uint32_t length);
 
   uint32_t itoa_c (int64_t n, char s[]);
+
+  /** Writes the shortest decimal text which reads back to the same
+      double, or to the same float if single is set, so 21.5 becomes
+      "21.5" and not "21.500000".
+      Returns the length, 0 if the value is not finite or doesn't fit.
+      */
+  uint32_t dtoa_c(double value, bool single, char s[], uint32_t size);
+
+  /** Parses a decimal LWM2M ID in the range 0..65535.
+      Returns -1 if the string is not such an ID.
+      */
+  int32_t id_from_string(const char *s);
 } // namespace
 
 
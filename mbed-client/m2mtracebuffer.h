@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_TRACE_BUFFER_H
+#define M2M_TRACE_BUFFER_H
+
+#include <stdint.h>
+#include <stdarg.h>
+
+/**
+ * \brief M2MTraceBuffer
+ * Ring buffer for the binary trace mode, enabled by building the library
+ * with YOTTA_CFG_MBED_CLIENT_BINARY_TRACE. In that mode the library traces
+ * are not formatted. Each trace stores the address of its format string as
+ * the event ID together with up to three integer arguments, and the
+ * records are decoded offline against the symbols of the firmware image.
+ * String arguments are recorded as 0 and floating point arguments are
+ * truncated to integers.
+ */
+class M2MTraceBuffer {
+
+public:
+
+    /**
+     * \brief Maximum number of integer arguments kept per record.
+     */
+    static const uint8_t MaxArguments = 3;
+
+    typedef struct {
+        uintptr_t   event;                      // Address of the format string
+        uint32_t    timestamp;                  // Low bits of M2MStatistics::now()
+        uint16_t    sequence;
+        uint8_t     level;
+        uint8_t     argument_count;
+        int32_t     arguments[MaxArguments];
+    } Record;
+
+    /**
+     * \brief Constructor.
+     * \param capacity Number of records kept, the oldest are overwritten.
+     */
+    M2MTraceBuffer(uint16_t capacity);
+
+    /**
+     * \brief Destructor.
+     */
+    ~M2MTraceBuffer();
+
+    /**
+     * \brief Records a trace.
+     * \param level Trace level.
+     * \param format printf style format string, must be a string literal.
+     * \param args Arguments of the format.
+     */
+    void record(uint8_t level, const char *format, va_list args);
+
+    /**
+     * \brief Returns the number of records held.
+     */
+    uint16_t count() const;
+
+    /**
+     * \brief Returns the number of records written, including overwritten
+     * ones.
+     */
+    uint32_t total() const;
+
+    /**
+     * \brief Reads a record.
+     * \param index Index of the record, 0 is the oldest held.
+     * \param record Record to fill.
+     * \return True if the record exists.
+     */
+    bool read(uint16_t index, M2MTraceBuffer::Record &record) const;
+
+    /**
+     * \brief Removes all records.
+     */
+    void clear();
+
+    /**
+     * \brief Sets the buffer library traces are recorded into. Each client
+     * activates its own buffer while it handles an event.
+     * \param buffer The buffer, NULL stops recording.
+     */
+    static void set_active(M2MTraceBuffer *buffer);
+
+    /**
+     * \brief Returns the buffer library traces are recorded into.
+     */
+    static M2MTraceBuffer* active();
+
+    /**
+     * \brief Records a trace into the active buffer.
+     * \param level Trace level.
+     * \param format printf style format string, must be a string literal.
+     */
+    static void trace(uint8_t level, const char *format, ...);
+
+private:
+
+    // Prevents the use of assignment operator by accident.
+    M2MTraceBuffer& operator=( const M2MTraceBuffer& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MTraceBuffer( const M2MTraceBuffer& /*other*/ );
+
+private:
+
+    Record          *_records;
+    uint16_t        _capacity;
+    uint16_t        _next;
+    uint32_t        _total;
+};
+
+#endif // M2M_TRACE_BUFFER_H
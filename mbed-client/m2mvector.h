@@ -104,9 +104,21 @@ class Vector
             reserve(2 * _capacity + 1);
         }
         _object_template[_index++] = x;
-        if(_index >=_capacity) {
-            _index--;
+        _size++;
+    }
+
+    void insert(int position, const ObjectTemplate& x) {
+        if(position < 0 || position > _size) {
+            return;
         }
+        if(_size == _capacity) {
+            reserve(2 * _capacity + 1);
+        }
+        for(int k = _index; k > position; k--) {
+            _object_template[k] = _object_template[k-1];
+        }
+        _object_template[position] = x;
+        _index++;
         _size++;
     }
 
@@ -144,14 +156,11 @@ class Vector
     }
 
     void erase(int position) {
-        if(position <= _size) {
-            _object_template[position] = 0;
-            _size--;
-            if(position < _index) {
-                for(int k = position; k < _index; k++) {
-                    _object_template[k] = _object_template[k+1];
-                }
+        if(position >= 0 && position < _size) {
+            for(int k = position; k < _index - 1; k++) {
+                _object_template[k] = _object_template[k+1];
             }
+            _size--;
             _index--;
         }
     }
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_BLOCK_OPTION_H
+#define M2M_BLOCK_OPTION_H
+
+#include <stdint.h>
+
+/**
+ * @brief M2MBlockOption
+ * Helper for encoding and decoding the value of the CoAP Block1 and Block2
+ * options, see RFC 7959 chapter 2.2. The value carries the block number,
+ * the "more" flag and the block size as a 4-bit exponent (SZX).
+ */
+class M2MBlockOption {
+
+public:
+
+    /**
+     * Decodes the block option value.
+     * @param block Option value.
+     * @param block_len Length of the option value, 1 to 3 bytes.
+     * @param number [OUT] Block number.
+     * @param more [OUT] True if more blocks follow.
+     * @param size [OUT] Block size in bytes.
+     * @return True if the option is valid, else false.
+     */
+    static bool parse(const uint8_t *block,
+                      uint16_t block_len,
+                      uint32_t &number,
+                      bool &more,
+                      uint16_t &size);
+
+    /**
+     * Encodes the block option value.
+     * @param number Block number.
+     * @param more True if more blocks follow.
+     * @param size Block size, a power of two from 16 to 1024.
+     * @param block_len [OUT] Length of the returned option value.
+     * @return Option value allocated with malloc, NULL on failure.
+     */
+    static uint8_t* build(uint32_t number,
+                          bool more,
+                          uint16_t size,
+                          uint8_t &block_len);
+};
+
+#endif // M2M_BLOCK_OPTION_H
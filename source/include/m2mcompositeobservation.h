@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_COMPOSITE_OBSERVATION_H
+#define M2M_COMPOSITE_OBSERVATION_H
+
+#include <stdint.h>
+#include "mbed-client/m2minterface.h"
+#include "mbed-client/m2mreportobserver.h"
+#include "mbed-client/m2mvector.h"
+
+//FORWARD DECLARATION
+class M2MBase;
+class M2MReportHandler;
+class M2MCompositeObservation;
+
+/**
+ * @brief M2MCompositeObserver
+ * Interface for sending the notifications of a composite observation.
+ */
+class M2MCompositeObserver
+{
+public:
+
+    /**
+     * @brief Callback to send a notification of the composite observation.
+     * @param observation The observation whose resources have changed.
+     */
+    virtual void composite_observation_to_be_sent(M2MCompositeObservation &observation) = 0;
+};
+
+/**
+ * @brief M2MCompositeObservation
+ * One LWM2M 1.1 Composite-Observe request. The server observes a list of
+ * paths with a single token and gets a single SenML-CBOR notification
+ * when any of the resources under the paths changes.
+ */
+class M2MCompositeObservation : public M2MReportObserver
+{
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MCompositeObservation& operator=( const M2MCompositeObservation& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MCompositeObservation( const M2MCompositeObservation& /*other*/ );
+
+public:
+
+    /**
+     * @brief Constructor.
+     * @param observer Observer which sends the notifications.
+     * @param token Token of the observe request, copied.
+     * @param token_length Length of the token.
+     * @param paths Observed paths, without the leading '/'.
+     */
+    M2MCompositeObservation(M2MCompositeObserver &observer,
+                            const uint8_t *token,
+                            uint8_t token_length,
+                            const M2MPathList &paths);
+
+    /**
+     * Destructor.
+     */
+    virtual ~M2MCompositeObservation();
+
+    /**
+     * @brief Parses pmin and pmax from the query of the observe request.
+     * @param query Query string, modified while parsing.
+     * @return True if the attributes are valid, else false.
+     */
+    bool set_notification_attributes(char *query);
+
+    /**
+     * @brief Starts or stops the pmin and pmax timers.
+     * @param observed True to start, false to stop.
+     */
+    void set_under_observation(bool observed);
+
+    /**
+     * @brief Checks if a resource or resource instance is reported
+     * through this observation, that is if its path is one of the
+     * observed paths or below one of them. Only paths are kept, so
+     * deleted nodes are never referred to and nodes created later
+     * under an observed path are members as well.
+     * @param path Path of the resource or resource instance.
+     * @return True if it is a member, else false.
+     */
+    bool is_member(const String &path) const;
+
+    /**
+     * @brief Triggers a notification, subject to pmin and pmax.
+     */
+    void value_changed();
+
+    /**
+     * @brief Checks if the observation was started with the given token.
+     * @param token Token to compare.
+     * @param token_length Length of the token.
+     * @return True if the tokens match, else false.
+     */
+    bool has_token(const uint8_t *token, uint8_t token_length) const;
+
+    /**
+     * @brief Returns the token of the observation.
+     */
+    const uint8_t* token() const;
+
+    /**
+     * @brief Returns the length of the token.
+     */
+    uint8_t token_length() const;
+
+    /**
+     * @brief Returns the observed paths.
+     */
+    const M2MPathList& paths() const;
+
+    /**
+     * @brief Returns the current observation number.
+     */
+    uint16_t observation_number() const;
+
+    /**
+     * @brief Increments the observation number for the next notification.
+     * @return The new observation number.
+     */
+    uint16_t next_observation_number();
+
+protected: // from M2MReportObserver
+
+    virtual void observation_to_be_sent(const m2m::IdSet &changed_instance_ids,
+                                        bool send_object = false,
+                                        const m2m::IdSet *changed_resource_ids = NULL);
+
+private:
+
+    M2MCompositeObserver        &_observer;
+    uint8_t                     *_token;
+    uint8_t                     _token_length;
+    M2MPathList                 _paths;
+    M2MReportHandler            *_report_handler;
+    uint16_t                    _observation_number;
+
+friend class Test_M2MCompositeObservation;
+};
+
+#endif // M2M_COMPOSITE_OBSERVATION_H
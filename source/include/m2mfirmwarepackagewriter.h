@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_FIRMWARE_PACKAGE_WRITER_H
+#define M2M_FIRMWARE_PACKAGE_WRITER_H
+
+#include "mbed-client/m2mfirmwaresink.h"
+#include "include/m2msha256.h"
+#include "include/nsdllinker.h"
+
+//FORWARD DECLARATION
+class M2MFirmware;
+
+/**
+ * @brief M2MFirmwarePackageWriter
+ * Handles a PUT with the Block1 option (RFC 7959) targeted to the firmware
+ * Package resource. Each block is passed to the M2MFirmwareSink as it
+ * arrives and hashed with SHA-256, so only the block currently held by the
+ * CoAP library is in memory. The next expected offset is kept across
+ * requests, which lets the server resume the transfer after a lost block:
+ * already stored blocks are acknowledged again without being rewritten and
+ * a block beyond the expected offset is rejected with 4.08 until the missing
+ * one arrives.
+ */
+class M2MFirmwarePackageWriter {
+
+public:
+
+    /**
+    * Constructor.
+    * @param firmware Firmware object whose State and Update Result are updated.
+    */
+    M2MFirmwarePackageWriter(M2MFirmware &firmware);
+
+    /**
+    * Destructor.
+    */
+    virtual ~M2MFirmwarePackageWriter();
+
+    /**
+     * Sets the sink receiving the package, an ongoing transfer is aborted.
+     * @param sink Sink for the package, NULL disables block handling.
+     */
+    void set_sink(M2MFirmwareSink *sink);
+
+    /**
+     * Returns whether the request is a Block1 write that this writer handles.
+     * @param received_coap_header Received CoAP message.
+     * @return True if the message carries the Block1 option and a sink is set.
+     */
+    bool is_block_message(const sn_coap_hdr_s *received_coap_header) const;
+
+    /**
+     * Handles one block of the package and fills the Block1 option of the response.
+     * @param received_coap_header Received CoAP message with the Block1 option.
+     * @param coap_response Response to the message, can be NULL.
+     * @return CoAP response code for the block.
+     */
+    sn_coap_msg_code_e handle_block(const sn_coap_hdr_s *received_coap_header,
+                                    sn_coap_hdr_s *coap_response);
+
+    /**
+     * Returns the number of bytes of the ongoing package stored so far.
+     * @return Offset where the transfer continues.
+     */
+    uint32_t package_offset() const;
+
+    /**
+     * Returns whether a package transfer is ongoing.
+     * @return True if a transfer has been started and not finished.
+     */
+    bool is_active() const;
+
+    /**
+     * Aborts an ongoing transfer.
+     */
+    void abort();
+
+private:
+
+    bool start();
+
+    void set_block_option(const sn_coap_hdr_s *received_coap_header,
+                          sn_coap_hdr_s *coap_response) const;
+
+private:
+
+    M2MFirmware             &_firmware;
+    M2MFirmwareSink         *_sink; // Not owned
+    M2MSha256               _sha256;
+    uint32_t                _offset;
+    uint16_t                _first_block_msg_id;
+    bool                    _active;
+
+    friend class Test_M2MFirmwarePackageWriter;
+};
+
+#endif // M2M_FIRMWARE_PACKAGE_WRITER_H
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_INDEX_H
+#define M2M_INDEX_H
+
+#include <stdint.h>
+#include "mbed-client/m2mvector.h"
+
+/**
+ *  @brief M2MIndex.
+ *  Binary search over the child lists of the resource tree. Object
+ *  instances and resource instances are kept sorted by their instance ID,
+ *  resources by their numeric name ID, so that addressing a node by its
+ *  LWM2M ID doesn't need a linear scan.
+ */
+class M2MIndex {
+
+public:
+
+    /**
+     * Enum defining the key the list is sorted by.
+     */
+    typedef enum {
+        InstanceId,
+        NameId
+    } Key;
+
+    /**
+     * @brief Finds the position of the first node whose key is not less
+     * than the given ID. This is where a node with that ID is, or where
+     * it is to be inserted.
+     * @param list List of nodes sorted by the key.
+     * @param id ID to look for.
+     * @param key Key the list is sorted by.
+     * @return Position in the list, list size if all keys are smaller.
+     */
+    template <typename T>
+    static int lower_bound(const m2m::Vector<T*> &list, int32_t id, Key key)
+    {
+        int low = 0;
+        int high = list.size();
+        while(low < high) {
+            int mid = low + (high - low) / 2;
+            int32_t mid_id = (InstanceId == key) ? (int32_t)list[mid]->instance_id() :
+                                                   list[mid]->name_id();
+            if(mid_id < id) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    /**
+     * @brief Finds the node with the given ID.
+     * @param list List of nodes sorted by the key.
+     * @param id ID to look for.
+     * @param key Key the list is sorted by.
+     * @return Position of the node, -1 if not found.
+     */
+    template <typename T>
+    static int find(const m2m::Vector<T*> &list, int32_t id, Key key)
+    {
+        int pos = lower_bound(list, id, key);
+        if(pos < list.size()) {
+            int32_t found = (InstanceId == key) ? (int32_t)list[pos]->instance_id() :
+                                                  list[pos]->name_id();
+            if(found == id) {
+                return pos;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Finds the lowest instance ID which is not in use.
+     * @param list List of nodes sorted by instance ID.
+     * @return The lowest free instance ID, list size if there are no gaps.
+     */
+    template <typename T>
+    static int32_t first_free_id(const m2m::Vector<T*> &list)
+    {
+        // IDs are unique, so the ID at position i is at least i, and equal
+        // to it up to the first gap.
+        int low = 0;
+        int high = list.size();
+        while(low < high) {
+            int mid = low + (high - low) / 2;
+            if((int32_t)list[mid]->instance_id() == mid) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+private:
+
+    // Only static members.
+    M2MIndex();
+};
+
+#endif // M2M_INDEX_H
@@ -21,6 +21,9 @@
 #include "mbed-client/m2mconnectionobserver.h"
 #include "include/m2mnsdlobserver.h"
 #include "mbed-client/m2mtimerobserver.h"
+#ifdef YOTTA_CFG_MBED_CLIENT_BINARY_TRACE
+#include "mbed-client/m2mtracebuffer.h"
+#endif
 
 //FORWARD DECLARATION
 class M2MNsdlInterface;
@@ -135,6 +138,10 @@ public:
      */
     virtual void set_queue_sleep_handler(callback_handler handler);
 
+    virtual void send(const M2MPathList &paths);
+
+    virtual M2MObject* object(uint16_t object_id) const;
+
 protected: // From M2MNsdlObserver
 
     virtual void coap_message_ready(uint8_t *data_ptr,
@@ -325,6 +332,13 @@ private: // state machine state functions
     */
     void internal_event(uint8_t, EventData* = NULL);
 
+    /**
+    * Restarts the queue mode sleep timer. The client stays awake for
+    * the retransmissions of its pending exchanges, or only for
+    * QUEUE_LISTEN_TIME once they have all completed.
+    */
+    void start_queue_sleep_timer();
+
     enum
     {
         EVENT_IGNORED = 0xFE,
@@ -354,6 +368,9 @@ private:
     bool                        _update_register_ongoing;
     M2MTimer                    *_queue_sleep_timer;
     callback_handler            _callback_handler;
+#ifdef YOTTA_CFG_MBED_CLIENT_BINARY_TRACE
+    M2MTraceBuffer              _trace_buffer;
+#endif
 
    friend class Test_M2MInterfaceImpl;
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_NOTIFICATION_STORE_H
+#define M2M_NOTIFICATION_STORE_H
+
+#include <stdint.h>
+#include "mbed-client/m2mconfig.h"
+#include "mbed-client/m2midset.h"
+#include "mbed-client/m2mvector.h"
+
+//FORWARD DECLARATION
+class M2MCompositeObservation;
+
+/**
+ * @brief M2MNotificationStore
+ * Notifications held while the client sleeps in queue mode. Only the
+ * latest notification of each observation is kept: the values are read
+ * again when the store is flushed, so a later change of an observed node
+ * replaces the pending one and its changed IDs are merged into it.
+ */
+class M2MNotificationStore {
+
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MNotificationStore& operator=( const M2MNotificationStore& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MNotificationStore( const M2MNotificationStore& /*other*/ );
+
+public:
+
+    /**
+     * @brief Pending notification of one observation.
+     */
+    class Entry {
+    public:
+        Entry();
+
+        String                      path;               // empty for a composite observation
+        M2MCompositeObservation     *composite;
+        uint16_t                    observation_number;
+        bool                        send_object;
+        bool                        delta;              // resource_ids lists the changed resources
+        m2m::IdSet                  instance_ids;
+        m2m::IdSet                  resource_ids;
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    M2MNotificationStore();
+
+    /**
+     * Destructor.
+     */
+    ~M2MNotificationStore();
+
+    /**
+     * @brief Stores a notification of an observed object, object instance
+     * or resource, merging it into the pending one of the same path.
+     * @param path URI path of the observed node.
+     * @param observation_number Observation number of the notification.
+     * @param instance_ids Changed object instances, for an object.
+     * @param send_object True if the whole object is to be sent.
+     * @param resource_ids Changed resources, NULL if all are to be sent.
+     */
+    void store(const String &path,
+               uint16_t observation_number,
+               const m2m::IdSet &instance_ids,
+               bool send_object,
+               const m2m::IdSet *resource_ids);
+
+    /**
+     * @brief Stores a notification of a composite observation.
+     * @param observation The composite observation.
+     */
+    void store(M2MCompositeObservation *observation);
+
+    /**
+     * @brief Removes the pending notification of a composite observation
+     * which is being cancelled.
+     * @param observation The composite observation.
+     */
+    void remove(M2MCompositeObservation *observation);
+
+    /**
+     * @brief Returns the number of pending notifications.
+     */
+    uint16_t count() const;
+
+    /**
+     * @brief Returns a pending notification, in the order they were stored.
+     * @param index Index of the notification, less than count().
+     */
+    const Entry& entry(uint16_t index) const;
+
+    /**
+     * @brief Removes all the pending notifications.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the heap memory used by the store.
+     */
+    uint32_t memory_footprint() const;
+
+private:
+
+    Entry* find(const String &path, const M2MCompositeObservation *observation) const;
+
+private:
+
+    typedef m2m::Vector<Entry*> EntryList;
+
+    EntryList                   _entries;
+
+friend class Test_M2MNotificationStore;
+};
+
+#endif // M2M_NOTIFICATION_STORE_H
@@ -22,7 +22,16 @@
 #include "mbed-client/m2mtimerobserver.h"
 #include "mbed-client/m2mobservationhandler.h"
 #include "mbed-client/m2mbase.h"
+#include "mbed-client/m2marenaallocator.h"
 #include "include/nsdllinker.h"
+#include "include/m2mcompositeobservation.h"
+#include "include/m2mnotificationstore.h"
+
+#ifdef YOTTA_CFG_MBED_CLIENT_REQUEST_ARENA_SIZE
+#define M2M_REQUEST_ARENA_SIZE YOTTA_CFG_MBED_CLIENT_REQUEST_ARENA_SIZE
+#else
+#define M2M_REQUEST_ARENA_SIZE 512
+#endif
 
 //FORWARD DECLARARTION
 class M2MSecurity;
@@ -33,15 +42,19 @@ class M2MResourceInstance;
 class M2MNsdlObserver;
 class M2MServer;
 class M2MTimer;
+class M2MPath;
+class M2MSenMLCBORSerializer;
 
 typedef Vector<M2MObject *> M2MObjectList;
+typedef Vector<M2MCompositeObservation *> M2MCompositeObservationList;
 
 /**
  * @brief M2MNsdlInterface
  * Class which interacts between mbed Client C++ Library and mbed-client-c library.
  */
 class M2MNsdlInterface : public M2MTimerObserver,
-                         public M2MObservationHandler
+                         public M2MObservationHandler,
+                         public M2MCompositeObserver
 {
 private:
     // Prevents the use of assignment operator by accident.
@@ -129,6 +142,15 @@ public:
     */
     bool send_unregister_message();
 
+    /**
+     * @brief Sends the current values of the given paths to the server in one
+     * SenML-CBOR payload, as a POST to "/dp" (LWM2M 1.1 Send operation).
+     * @param paths Paths of objects, object instances, resources or resource instances.
+     * @return ErrorNone if the message was sent, NotRegistered if the client is
+     * not registered, InvalidParameters if a path doesn't exist, else the error.
+    */
+    M2MInterface::Error send_data(const M2MPathList &paths);
+
     /**
      * @brief Memory Allocation required for libCoap.
      * @param size, Size of memory to be reserved.
@@ -204,6 +226,27 @@ public:
      */
     void stop_timers();
 
+    /**
+     * @brief Puts the client to sleep in queue mode. Until the next
+     * registration or registration update is acknowledged the notifications
+     * are held in the notification store, one per observation, and sent
+     * in one burst after it.
+     */
+    void queue_mode_sleep();
+
+    /**
+     * @brief Returns the number of confirmable messages sent to the
+     * server which are still waiting for their ACK.
+     */
+    uint8_t pending_exchanges() const;
+
+    /**
+     * @brief Returns the registered object with the given object ID.
+     * @param object_id ID of the object.
+     * @return The object, NULL if not registered.
+     */
+    M2MObject* object(uint16_t object_id) const;
+
 protected: // from M2MTimerObserver
 
     virtual void timer_expired(M2MTimerObserver::Type type);
@@ -212,8 +255,9 @@ protected: // from M2MObservationHandler
 
     virtual void observation_to_be_sent(M2MBase *object,
                                         uint16_t obs_number,
-                                        m2m::Vector<uint16_t> changed_instance_ids,
-                                        bool send_object = false);
+                                        const m2m::IdSet &changed_instance_ids,
+                                        bool send_object = false,
+                                        const m2m::IdSet *changed_resource_ids = NULL);
 
     virtual void resource_to_be_deleted(const String &resource_name);
 
@@ -223,6 +267,18 @@ protected: // from M2MObservationHandler
 
     virtual void send_delayed_response(M2MBase *base);
 
+    virtual M2MAllocator* request_allocator();
+
+    virtual void composite_value_changed(M2MBase *base);
+
+    virtual bool samples_to_be_sent(M2MBase *base,
+                                    uint16_t obs_number,
+                                    M2MSampleBuffer &samples);
+
+protected: // from M2MCompositeObserver
+
+    virtual void composite_observation_to_be_sent(M2MCompositeObservation &observation);
+
 private:
 
     /**
@@ -233,6 +289,8 @@ private:
 
     bool add_object_to_list(M2MObject *object);
 
+    void update_heap_statistics();
+
     bool create_nsdl_object_structure(M2MObject *object);
 
     bool create_nsdl_object_instance_structure(M2MObjectInstance *object_instance);
@@ -243,24 +301,13 @@ private:
 
     bool create_nsdl_resource(M2MBase *base, const String &name = "", bool publish_uri = true);
 
-    String coap_to_string(uint8_t *coap_data_ptr,
-                          int coap_data_ptr_length);
-
     void execute_nsdl_process_loop();
 
     uint64_t registration_time();
 
     M2MBase* find_resource(const String &object);
 
-    M2MBase* find_resource(const M2MObject *object,
-                           const String &object_instance);
-
-    M2MBase* find_resource(const M2MObjectInstance *object_instance,
-                           const String &resource_instance);
-
-    M2MBase* find_resource(const M2MResource *resource,
-                           const String &object_name,
-                           const String &resource_instance);
+    M2MBase* find_resource(const M2MPath &path, uint8_t depth);
 
     bool object_present(M2MObject * object) const;
 
@@ -270,11 +317,13 @@ private:
 
     void send_object_observation(M2MObject *object,
                                  uint16_t obs_number,
-                                 m2m::Vector<uint16_t> changed_instance_ids,
-                                 bool send_object);
+                                 const m2m::IdSet &changed_instance_ids,
+                                 bool send_object,
+                                 const m2m::IdSet *resource_ids = NULL);
 
     void send_object_instance_observation(M2MObjectInstance *object_instance,
-                                          uint16_t obs_number);
+                                          uint16_t obs_number,
+                                          const m2m::IdSet *resource_ids = NULL);
 
     void send_resource_observation(M2MResource *resource, uint16_t obs_number);
 
@@ -282,7 +331,7 @@ private:
                                   uint8_t *obs_len,
                                   uint16_t number);
 
-    void send_notification(uint8_t *token,
+    bool send_notification(uint8_t *token,
                            uint8_t  token_length,
                            uint8_t *value,
                            uint32_t value_length,
@@ -291,6 +340,45 @@ private:
                            uint8_t  coap_content_type,
                            const String  &uri_path);
 
+    M2MInterface::Error send_payload(uint8_t *payload, uint32_t length);
+
+    bool serialize_paths(const M2MPathList &paths,
+                         M2MSenMLCBORSerializer &serializer,
+                         bool skip_missing);
+
+    uint8_t handle_composite_request(sn_coap_hdr_s *coap_header,
+                                     sn_nsdl_addr_s *address);
+
+    bool start_composite_observation(sn_coap_hdr_s *coap_header,
+                                     const M2MPathList &paths);
+
+    void cancel_composite_observation(const uint8_t *token,
+                                      uint8_t token_length);
+
+    void mark_composite_members(M2MCompositeObservation *observation,
+                                bool observed);
+
+    void mark_composite_member(M2MBase *base,
+                               const String &path,
+                               bool observed);
+
+    void exchange_started(const uint8_t *data, uint16_t length);
+
+    void exchange_completed(uint16_t msg_id);
+
+    void flush_notification_store();
+
+private:
+
+    // Confirmable messages tracked at the same time, an older one
+    // is forgotten when more are sent without an ACK.
+    static const uint8_t MAX_PENDING_EXCHANGES = 8;
+
+    typedef struct {
+        uint16_t    msg_id;
+        bool        pending;
+    } PendingExchange;
+
 private:
 
     M2MNsdlObserver                   &_observer;
@@ -309,8 +397,15 @@ private:
     int32_t                            _unregister_id;
     uint16_t                           _update_id;
     uint16_t                           _bootstrap_id;
+    M2MArenaAllocator                  _request_arena;
+    M2MCompositeObservationList        _composite_observations;
+    M2MNotificationStore               _notification_store;
+    PendingExchange                    _pending_exchanges[MAX_PENDING_EXCHANGES];
+    uint8_t                            _next_exchange;
+    bool                               _queue_sleeping;
 
 friend class Test_M2MNsdlInterface;
+friend class Bench_M2MNsdlInterface;
 
 };
 
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_OBJECT_MODEL_H
+#define M2M_OBJECT_MODEL_H
+
+#include <stdint.h>
+#include <string.h>
+#include "mbed-client/m2mconstants.h"
+#include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mresource.h"
+#include "mbed-client/m2mstring.h"
+
+/**
+ *  @brief M2MObjectModel.
+ *  Static description of the standard OMA objects. Every object class keeps
+ *  a constant table of resource models in read-only memory, indexed by its
+ *  resource enum, so that resolving an enum to its ID, type, operation or
+ *  value range is a table lookup instead of a switch over String constants.
+ */
+class M2MObjectModel {
+
+public:
+
+    /**
+     * Enum defining the properties of a resource model.
+     */
+    enum {
+        Multiple    = 1,    // Multiple instance resource
+        Mandatory   = 2,    // Created with the object, can't be deleted
+        Observable  = 4,
+        Ranged      = 8     // Integer value limited to [min, max]
+    };
+
+    /**
+     * @brief Description of one resource of a standard object.
+     */
+    typedef struct {
+        const char                          *name;
+        M2MResourceInstance::ResourceType   type;
+        M2MBase::Operation                  operation;
+        uint8_t                             flags;
+        int32_t                             min;
+        int32_t                             max;
+        const char                          *default_value;
+    } Resource;
+
+    /**
+     * @brief Checks whether the value is allowed for the resource.
+     * @param model Resource model.
+     * @param value Value to check.
+     * @return True if the value is allowed, else false.
+     */
+    static bool in_range(const Resource &model, int64_t value)
+    {
+        return !(model.flags & Ranged) ||
+               (value >= model.min && value <= model.max);
+    }
+
+    /**
+     * @brief Creates the single instance resource described by the model.
+     * @param instance Object instance to create the resource in.
+     * @param model Resource model.
+     * @param register_uri Whether the resource is registered to the server.
+     * @return Created resource, NULL on failure.
+     */
+    static M2MResource* create_resource(M2MObjectInstance *instance,
+                                        const Resource &model,
+                                        bool register_uri)
+    {
+        M2MResource *res = NULL;
+        if(instance) {
+            res = instance->create_dynamic_resource(model.name,
+                                                    OMA_RESOURCE_TYPE,
+                                                    model.type,
+                                                    (model.flags & Observable) != 0);
+            if(res) {
+                res->set_operation(model.operation);
+                if(!register_uri) {
+                    res->set_register_uri(false);
+                }
+                if(model.default_value) {
+                    res->set_value((const uint8_t*)model.default_value,
+                                   (uint32_t)strlen(model.default_value));
+                }
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief Creates an instance of the multiple instance resource
+     * described by the model.
+     * @param instance Object instance to create the resource in.
+     * @param model Resource model.
+     * @param register_uri Whether the resource is registered to the server.
+     * @param instance_id ID of the resource instance.
+     * @return Created resource instance, NULL on failure.
+     */
+    static M2MResourceInstance* create_resource_instance(M2MObjectInstance *instance,
+                                                         const Resource &model,
+                                                         bool register_uri,
+                                                         uint16_t instance_id)
+    {
+        M2MResourceInstance *res = NULL;
+        if(instance) {
+            res = instance->create_dynamic_resource_instance(model.name,
+                                                             OMA_RESOURCE_TYPE,
+                                                             model.type,
+                                                             (model.flags & Observable) != 0,
+                                                             instance_id);
+            M2MResource *resource = instance->resource(model.name);
+            if(resource && !register_uri) {
+                resource->set_register_uri(false);
+            }
+            if(res) {
+                res->set_operation(model.operation);
+                if(!register_uri) {
+                    res->set_register_uri(false);
+                }
+                if(model.default_value) {
+                    res->set_value((const uint8_t*)model.default_value,
+                                   (uint32_t)strlen(model.default_value));
+                }
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief Creates the mandatory resources of a standard object.
+     * @param instance Object instance to create the resources in.
+     * @param table Resource models of the object.
+     * @param count Number of models in the table.
+     * @param register_uri Whether the resources are registered to the server.
+     */
+    static void create_mandatory_resources(M2MObjectInstance *instance,
+                                           const Resource *table,
+                                           uint8_t count,
+                                           bool register_uri)
+    {
+        for(uint8_t i = 0; i < count; i++) {
+            if(table[i].flags & Mandatory) {
+                if(table[i].flags & Multiple) {
+                    create_resource_instance(instance, table[i], register_uri, 0);
+                } else {
+                    create_resource(instance, table[i], register_uri);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Sets an integer value in the text format used by the
+     * standard objects.
+     * @param res Resource instance to set the value on.
+     * @param value Value to set.
+     * @return True if the value was set, else false.
+     */
+    static bool set_int_value(M2MResourceInstance *res, int64_t value)
+    {
+        char buffer[21];
+        uint32_t size = m2m::itoa_c(value, buffer);
+        return res->set_value((const uint8_t*)buffer, size);
+    }
+
+private:
+
+    // Only static members.
+    M2MObjectModel();
+};
+
+#endif // M2M_OBJECT_MODEL_H
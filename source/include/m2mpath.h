@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_PATH_H
+#define M2M_PATH_H
+
+#include <stdint.h>
+#include "mbed-client/m2mconfig.h"
+
+/**
+ *  @brief M2MPath.
+ *  Parsed form of a LWM2M URI path: object/instance/resource/instance.
+ *  The path is split in place, without copying or allocating. Each
+ *  segment is kept as its numeric ID and as a position in the parsed
+ *  buffer, so non-numeric object and resource names can still be
+ *  matched. The parsed buffer must outlive the M2MPath.
+ */
+class M2MPath {
+
+public:
+
+    /**
+     * Maximum number of segments in a LWM2M path.
+     */
+    static const uint8_t MAX_DEPTH = 4;
+
+    /**
+     * @brief Constructor, creates an empty path.
+     */
+    M2MPath();
+
+    /**
+     * @brief Parses the given path, for example the uri-path of a CoAP request.
+     * A path has one to four non-empty segments separated by '/'.
+     * @param path Path to parse, doesn't need to be null terminated.
+     * @param length Length of the path, the path ends at a NUL before it.
+     * @return True if the path is valid, else false.
+     */
+    bool parse(const uint8_t *path, uint16_t length);
+
+    /**
+     * @brief Parses the given path.
+     * @param path Path to parse.
+     * @return True if the path is valid, else false.
+     */
+    bool parse(const String &path);
+
+    /**
+     * @brief Returns the number of segments in the path.
+     * @return Number of segments, 0 if the path is not valid.
+     */
+    uint8_t depth() const;
+
+    /**
+     * @brief Returns the numeric ID of the given segment.
+     * @param level Segment index, 0 for the object.
+     * @return ID of the segment, -1 if the segment doesn't exist
+     * or is not a number in the range 0 - 65535.
+     */
+    int32_t id(uint8_t level) const;
+
+    /**
+     * @brief Checks whether the given segment is the given name.
+     * @param level Segment index, 0 for the object.
+     * @param name Name to compare against.
+     * @return True if the segment exists and is equal to the name, else false.
+     */
+    bool equals(uint8_t level, const String &name) const;
+
+    /**
+     * @brief Builds the path up to the given depth as a string.
+     * This allocates, so it is only meant for the paths which are
+     * stored, such as the path of an observed node.
+     * @param depth Number of segments to include.
+     * @return The path, empty if the depth is not valid.
+     */
+    String to_string(uint8_t depth) const;
+
+private:
+
+    const char      *_path;
+    uint16_t        _offset[MAX_DEPTH];
+    uint16_t        _length[MAX_DEPTH];
+    uint16_t        _id[MAX_DEPTH];
+    uint8_t         _numeric;
+    uint8_t         _depth;
+};
+
+#endif // M2M_PATH_H
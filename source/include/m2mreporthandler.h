@@ -23,11 +23,13 @@
 #include "mbed-client/m2mtimerobserver.h"
 #include "mbed-client/m2mresourceinstance.h"
 #include "mbed-client/m2mvector.h"
+#include "mbed-client/m2midset.h"
 
 //FORWARD DECLARATION
 class M2MReportObserver;
 class M2MTimer;
 class M2MResourceInstance;
+class M2MSampleBuffer;
 
 /**
  *  @brief M2MReportHandler.
@@ -79,8 +81,11 @@ public:
     /**
      * @brief Sets notification trigger.
      * @param obj_instance_id, Object instance id that has changed
+     * @param resource_id, ID of the resource that has changed,
+     * -1 if not known, in which case all resources are reported.
      */
-    void set_notification_trigger(uint16_t obj_instance_id = 0);
+    void set_notification_trigger(uint16_t obj_instance_id = 0,
+                                  int32_t resource_id = -1);
 
     /**
      * @brief Parses the received query for notification
@@ -94,6 +99,19 @@ public:
                                               M2MBase::BaseType type,
                                               M2MResourceInstance::ResourceType resource_type = M2MResourceInstance::OPAQUE);
 
+    /**
+     * @brief Flushes the sample buffer if its count or byte threshold is
+     * reached, else arms the timer for its age threshold.
+     * @param samples Sample buffer of the resource, not owned.
+     */
+    void sample_added(M2MSampleBuffer &samples);
+
+    /**
+     * @brief Stops flushing the sample buffer, before it is deleted.
+     * @param samples Sample buffer of the resource.
+     */
+    void remove_sample_buffer(M2MSampleBuffer *samples);
+
     /**
     * @brief Set back to default values.
     */
@@ -104,6 +122,11 @@ public:
      */
     uint8_t attribute_flags();
 
+    /**
+     * @brief Returns the heap memory used by the handler and its timers.
+     */
+    uint32_t memory_footprint() const;
+
 protected : // from M2MTimerObserver
 
     virtual void timer_expired(M2MTimerObserver::Type type =
@@ -156,6 +179,17 @@ private:
      */
     bool check_gt_lt_params();
 
+    /**
+    * @brief Forget the changed object instances and resources.
+    */
+    void clear_changes();
+
+    /**
+    * @brief Sends the buffered samples, on failure they are kept
+    * and retried once the age threshold passes again.
+    */
+    void flush_samples();
+
 private:
     M2MReportObserver           &_observer;
     int                         _pmax;
@@ -173,7 +207,12 @@ private:
     float                       _last_value;    
     uint8_t                     _attribute_state;
     bool                        _notify;
-    m2m::Vector<uint16_t>       _changed_instance_ids;
+    uint64_t                    _changed_at;
+    m2m::IdSet                  _changed_instance_ids;
+    m2m::IdSet                  _changed_resource_ids;
+    bool                        _all_resources_changed;
+    M2MSampleBuffer             *_sample_buffer;
+    M2MTimer                    *_sample_timer;
 
 friend class Test_M2MReportHandler;
 
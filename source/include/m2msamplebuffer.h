@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_SAMPLE_BUFFER_H
+#define M2M_SAMPLE_BUFFER_H
+
+#include <stdint.h>
+#include "mbed-client/m2mresourceinstance.h"
+
+/**
+ * @brief M2MSampleBuffer
+ * Ring buffer of timestamped values of one resource. The values are kept
+ * until M2MReportHandler flushes them to the server in one SenML batch,
+ * once the number of samples, their total size or the age of the oldest
+ * sample reaches the configured threshold.
+ */
+class M2MSampleBuffer {
+
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MSampleBuffer& operator=( const M2MSampleBuffer& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MSampleBuffer( const M2MSampleBuffer& /*other*/ );
+
+public:
+
+    /**
+     * @brief Constructor.
+     * @param capacity Maximum number of samples held.
+     * @param flush_count Number of samples that triggers a flush, 0 for capacity.
+     * @param flush_age Age of the oldest sample in milliseconds that triggers
+     * a flush, 0 for no age limit.
+     * @param flush_bytes Total size of the values that triggers a flush, 0 for no limit.
+     * @param overflow What to do with a new sample when the buffer is full.
+     * @param send True to flush with the Send operation, false to flush as
+     * a notification to the observer of the resource.
+     */
+    M2MSampleBuffer(uint16_t capacity,
+                    uint16_t flush_count,
+                    uint32_t flush_age,
+                    uint32_t flush_bytes,
+                    M2MResourceInstance::SampleOverflow overflow,
+                    bool send);
+
+    /**
+     * Destructor.
+     */
+    ~M2MSampleBuffer();
+
+    /**
+     * @brief Returns whether the memory for the samples could be allocated.
+     */
+    bool is_valid() const;
+
+    /**
+     * @brief Adds a sample. When the buffer is full either the oldest sample
+     * or the new one is dropped, according to the overflow setting.
+     * @param time Time of the sample from M2MStatistics::now(), 0 if unknown.
+     * @param value Value of the sample, copied.
+     * @param length Length of the value.
+     * @return True if the sample was stored, else false.
+     */
+    bool add(uint64_t time, const uint8_t *value, uint32_t length);
+
+    /**
+     * @brief Returns a sample, the oldest one has index 0.
+     * @param index Index of the sample.
+     * @param time[OUT] Time of the sample.
+     * @param value[OUT] Value of the sample, owned by the buffer.
+     * @param length[OUT] Length of the value.
+     * @return True if the index is valid, else false.
+     */
+    bool sample(uint16_t index, uint64_t &time,
+                const uint8_t *&value, uint32_t &length) const;
+
+    /**
+     * @brief Removes all the samples.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of samples.
+     */
+    uint16_t count() const;
+
+    /**
+     * @brief Returns the total size of the values in bytes.
+     */
+    uint32_t bytes() const;
+
+    /**
+     * @brief Returns whether the count or byte threshold is reached.
+     */
+    bool flush_due() const;
+
+    /**
+     * @brief Returns the age threshold in milliseconds, 0 if not set.
+     */
+    uint32_t flush_age() const;
+
+    /**
+     * @brief Returns whether the samples are flushed with the Send operation.
+     */
+    bool send() const;
+
+    /**
+     * @brief Returns the heap memory used by the buffer and its samples.
+     */
+    uint32_t memory_footprint() const;
+
+private:
+
+    typedef struct {
+        uint64_t    time;
+        uint8_t     *value;
+        uint32_t    length;
+    } Sample;
+
+    void drop_oldest();
+
+private:
+
+    Sample                                  *_samples;
+    uint16_t                                _capacity;
+    uint16_t                                _first;
+    uint16_t                                _count;
+    uint16_t                                _flush_count;
+    uint32_t                                _flush_age;
+    uint32_t                                _flush_bytes;
+    uint32_t                                _bytes;
+    M2MResourceInstance::SampleOverflow     _overflow;
+    bool                                    _send;
+
+friend class Test_M2MSampleBuffer;
+};
+
+#endif // M2M_SAMPLE_BUFFER_H
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_SENML_CBOR_DESERIALIZER_H
+#define M2M_SENML_CBOR_DESERIALIZER_H
+
+#include <stdint.h>
+#include "mbed-client/m2minterface.h"
+#include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mresource.h"
+#include "m2mpath.h"
+
+// Holds a numeric or boolean value converted to text, see read_value().
+#define SENML_NUMBER_BUFFER_SIZE 32
+
+/**
+ * @brief M2MSenMLCBORDeserializer
+ * Reads SenML packs (RFC 8428) encoded as CBOR, content format 112.
+ * The pack is read in place, without copying it.
+ * Values are written to the resources as text, the way they are stored,
+ * so numbers and booleans are converted and strings and bytes are copied.
+ */
+class M2MSenMLCBORDeserializer {
+
+public:
+
+    typedef enum {
+        None = 0,
+        NotFound,
+        NotAllowed,
+        NotValid
+    } Error;
+
+    typedef enum {
+        Put = 0,
+        Post
+    } Operation;
+
+    /**
+    * Constructor.
+    */
+    M2MSenMLCBORDeserializer();
+
+    /**
+    * Destructor.
+    */
+    virtual ~M2MSenMLCBORDeserializer();
+
+    /**
+     * @brief Reads the full names of the records of a pack, the base name
+     * joined with the name. This is the request payload of the LWM2M 1.1
+     * Composite-Read and Composite-Observe operations.
+     * A leading '/' is dropped, so the paths look like "3/0/9".
+     * @param data SenML-CBOR pack.
+     * @param size Size of the pack.
+     * @param paths List the paths are appended to.
+     * @return True if the pack is valid and names at least one record, else false.
+     */
+    bool deserialize_paths(const uint8_t *data, uint32_t size, M2MPathList &paths);
+
+    /**
+     * @brief Writes the values of a pack to the resources of an object instance.
+     * Every record must name a resource, or a resource instance, of this
+     * object instance. All records are checked before any value is written.
+     * @param data SenML-CBOR pack.
+     * @param size Size of the pack.
+     * @param object_instance Object instance to update.
+     * @param operation Put replaces existing values only, Post also creates
+     * the missing resources and resource instances.
+     * @return None if the values were written, else the reason they were not.
+     */
+    M2MSenMLCBORDeserializer::Error deserialize_resources(const uint8_t *data,
+                                                          uint32_t size,
+                                                          M2MObjectInstance &object_instance,
+                                                          M2MSenMLCBORDeserializer::Operation operation);
+
+    /**
+     * @brief Writes the values of a pack to the instances of a resource.
+     * Every record must name an existing instance of this resource.
+     * All records are checked before any value is written.
+     * @param data SenML-CBOR pack.
+     * @param size Size of the pack.
+     * @param resource Resource with multiple instances to update.
+     * @param operation Put or Post.
+     * @return None if the values were written, else the reason they were not.
+     */
+    M2MSenMLCBORDeserializer::Error deserialize_resource_instances(const uint8_t *data,
+                                                                   uint32_t size,
+                                                                   M2MResource &resource,
+                                                                   M2MSenMLCBORDeserializer::Operation operation);
+
+private:
+
+    M2MSenMLCBORDeserializer::Error write_resources(M2MObjectInstance &object_instance,
+                                                    M2MSenMLCBORDeserializer::Operation operation,
+                                                    bool update_value);
+
+    M2MSenMLCBORDeserializer::Error write_resource_instances(M2MResource &resource,
+                                                             M2MSenMLCBORDeserializer::Operation operation,
+                                                             bool update_value);
+
+    M2MSenMLCBORDeserializer::Error write_resource_instance(M2MResource &resource,
+                                                            M2MObjectInstance *object_instance,
+                                                            const M2MPath &path,
+                                                            M2MSenMLCBORDeserializer::Operation operation,
+                                                            bool update_value);
+
+    void write_value(M2MResourceInstance &resource_instance);
+
+    bool begin(const uint8_t *data, uint32_t size);
+
+    bool read_record(String &name, bool value_required);
+
+    bool read_value(int64_t label);
+
+    bool read_real(uint8_t info, uint64_t bits);
+
+    bool read_head(uint8_t &major_type, uint64_t &value);
+
+    bool read_label(int64_t &label);
+
+    bool read_text(const char *&text, uint32_t &length);
+
+    bool skip_item(uint8_t depth = 0);
+
+private:
+
+    const uint8_t   *_data;
+    uint32_t        _size;
+    uint32_t        _position;
+    const char      *_base_name;
+    uint32_t        _base_name_length;
+    const uint8_t   *_value;
+    uint32_t        _value_length;
+    uint64_t        _count;
+    char            _number[SENML_NUMBER_BUFFER_SIZE];
+
+    friend class Test_M2MSenMLCBORDeserializer;
+};
+
+#endif // M2M_SENML_CBOR_DESERIALIZER_H
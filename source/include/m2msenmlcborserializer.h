@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_SENML_CBOR_SERIALIZER_H
+#define M2M_SENML_CBOR_SERIALIZER_H
+
+#include <stdint.h>
+#include "mbed-client/m2mobject.h"
+#include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mresource.h"
+
+//FORWARD DECLARATION
+class M2MSampleBuffer;
+
+/**
+ * @brief M2MSenMLCBORSerializer
+ * Builds a SenML pack (RFC 8428) encoded as CBOR, content format 112, out of
+ * objects, object instances, resources and resource instances. Unlike OMA-TLV
+ * every record carries its full path, so one payload can hold values from
+ * several objects, as needed by the LWM2M 1.1 Send operation.
+ * The path of the object instance is sent as base name and each record only
+ * names the resource, "<resource>" or "<resource>/<instance>".
+ * Values are encoded as CBOR numbers, booleans, text or byte strings according
+ * to the resource type.
+ */
+class M2MSenMLCBORSerializer {
+
+public:
+
+    /**
+    * Constructor.
+    */
+    M2MSenMLCBORSerializer();
+
+    /**
+    * Destructor.
+    */
+    virtual ~M2MSenMLCBORSerializer();
+
+    /**
+     * @brief Appends records for all the resources of all instances of the object.
+     * @param object Object to append.
+     * @return True if the records were appended, else false.
+     */
+    bool append(M2MObject *object);
+
+    /**
+     * @brief Appends records for all the resources of the object instance.
+     * @param object_name Name of the object owning the instance.
+     * @param object_instance Object instance to append.
+     * @return True if the records were appended, else false.
+     */
+    bool append(const String &object_name, M2MObjectInstance *object_instance);
+
+    /**
+     * @brief Appends the record(s) of a resource, one per resource instance
+     * for a resource with multiple instances.
+     * @param object_name Name of the object owning the resource.
+     * @param object_instance_id ID of the object instance owning the resource.
+     * @param resource Resource to append.
+     * @return True if the records were appended, else false.
+     */
+    bool append(const String &object_name, uint16_t object_instance_id,
+                M2MResource *resource);
+
+    /**
+     * @brief Appends the record of a single resource instance.
+     * @param object_name Name of the object owning the resource.
+     * @param object_instance_id ID of the object instance owning the resource.
+     * @param resource_instance Resource instance to append.
+     * @return True if the record was appended, else false.
+     */
+    bool append(const String &object_name, uint16_t object_instance_id,
+                M2MResourceInstance *resource_instance);
+
+    /**
+     * @brief Appends a record per buffered sample of a resource. With a clock
+     * each record carries the time of the sample relative to now, negative
+     * seconds as defined by SenML.
+     * @param object_name Name of the object owning the resource.
+     * @param object_instance_id ID of the object instance owning the resource.
+     * @param resource Resource the samples belong to.
+     * @param samples Buffered samples, oldest first.
+     * @param now Current time from M2MStatistics::now(), 0 to leave out the times.
+     * @return True if the records were appended, else false.
+     */
+    bool append(const String &object_name, uint16_t object_instance_id,
+                M2MResourceInstance *resource, const M2MSampleBuffer &samples,
+                uint64_t now);
+
+    /**
+     * @brief Returns the number of records appended so far.
+     */
+    uint32_t record_count() const;
+
+    /**
+     * @brief Finishes the pack and hands it over to the caller, who must free() it.
+     * The serializer is empty again afterwards.
+     * @param size Set to the size of the returned payload.
+     * @return SenML-CBOR payload, NULL if nothing was appended or memory ran out.
+     */
+    uint8_t* serialize(uint32_t &size);
+
+private:
+
+    bool append_record(const String &object_name, uint16_t object_instance_id,
+                       M2MResourceInstance *resource, bool resource_instance);
+
+    void write_base_name(const String &object_name, uint16_t object_instance_id);
+
+    void write_name(M2MResourceInstance *resource, bool resource_instance);
+
+    bool write_record(const String &object_name, uint16_t object_instance_id,
+                      M2MResourceInstance *resource, bool resource_instance,
+                      const uint8_t *value, uint32_t length,
+                      bool timed, double time);
+
+    void write_value(M2MResourceInstance::ResourceType type,
+                     const char *value, uint32_t length);
+
+    void write_head(uint8_t major_type, uint64_t value);
+
+    void write_integer(int64_t value);
+
+    void write_double(double value);
+
+    void write_text(const char *text, uint32_t length);
+
+    void write_bytes(const uint8_t *data, uint32_t length);
+
+    uint8_t* reserve(uint32_t length);
+
+    void reset();
+
+private:
+
+    uint8_t     *_data;
+    uint32_t    _size;
+    uint32_t    _capacity;
+    uint32_t    _count;
+    String      _base_object;
+    int32_t     _base_instance;
+    bool        _failed;
+
+    friend class Test_M2MSenMLCBORSerializer;
+};
+
+#endif // M2M_SENML_CBOR_SERIALIZER_H
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_SHA256_H
+#define M2M_SHA256_H
+
+#include <stdint.h>
+
+/**
+ * @brief M2MSha256
+ * Incremental SHA-256 (FIPS 180-4) used for hashing data that is received
+ * in parts, such as a firmware package written with Block1 transfer.
+ */
+class M2MSha256 {
+
+public:
+
+    /**
+    * Constructor.
+    */
+    M2MSha256();
+
+    /**
+    * Destructor.
+    */
+    virtual ~M2MSha256();
+
+    /**
+     * Resets the state so that a new digest can be calculated.
+     */
+    void reset();
+
+    /**
+     * Feeds the next part of the data into the digest.
+     * @param data Data to be hashed.
+     * @param length Length of the data.
+     */
+    void update(const uint8_t *data, uint32_t length);
+
+    /**
+     * Finalizes the digest and resets the state.
+     * @param digest [OUT] Buffer of 32 bytes for the digest.
+     */
+    void finish(uint8_t *digest);
+
+private:
+
+    void process_block(const uint8_t *block);
+
+private:
+
+    uint32_t            _state[8];
+    uint64_t            _total_length;
+    uint8_t             _buffer[64];
+    uint8_t             _buffer_length;
+
+    friend class Test_M2MSha256;
+};
+
+#endif // M2M_SHA256_H
@@ -24,6 +24,8 @@
  * builds the <code>lwm2m</code> representation from it. See OMA-LWM2M 
  * specification, chapter 6.1 for the resource model and chapter 6.3.3 for
  * the OMA-TLV specification.
+ * Integer, time and float values arrive as binary numbers and are stored
+ * as text, like the values set by the application.
  */
 class M2MTLVDeserializer {
 
@@ -153,6 +155,10 @@ private:
                                                              M2MTLVDeserializer::Operation operation,
                                                              bool update_value);
 
+    bool set_value(M2MResourceInstance &resource, const uint8_t *value, uint32_t length);
+
+    bool is_valid_length(const M2MResourceInstance &resource, uint32_t length);
+
     bool is_object_instance(uint8_t *tlv, uint32_t offset);
     
     bool is_resource(uint8_t *tlv, uint32_t offset);
@@ -160,6 +166,8 @@ private:
     bool is_multiple_resource(uint8_t *tlv, uint32_t offset);
     
     bool is_resource_instance(uint8_t *tlv, uint32_t offset);
+
+    friend class Test_M2MTLVDeserializer;
 };
 
 class TypeIdLength {
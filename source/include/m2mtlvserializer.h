@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "mbed-client/m2mvector.h"
+#include "mbed-client/m2midset.h"
 #include "mbed-client/m2mobject.h"
 #include "mbed-client/m2mobjectinstance.h"
 #include "mbed-client/m2mresource.h"
@@ -23,7 +24,9 @@
  * TLV Serialiser constructs the binary representation of object instances,
  * resources and resource instances (see OMA-LWM2M specification, chapter 6.1
  * for resource model) as OMA-TLV according described in chapter 6.3.3. 
- * 
+ * Integer and time values are written as 1, 2, 4 or 8 byte big-endian
+ * integers and float values as 4 or 8 byte IEEE 754 numbers, as chapter
+ * 6.3.3.1 requires, the other types as they are stored.
  */
 class M2MTLVSerializer {
 
@@ -82,15 +85,40 @@ public:
      */
     uint8_t* serialize(M2MResourceList resource_list, uint32_t &size);
 
+    /**
+     * Serialises given object instances like serialize(M2MObjectInstanceList, uint32_t&),
+     * but with only the resources whose ID is in the given set.
+     * @param object_instance_list List of object instances.
+     * @param resource_ids IDs of the resources to include.
+     * @return Object instances encoded binary as OMA-TLV
+     */
+    uint8_t* serialize(M2MObjectInstanceList object_instance_list,
+                       const m2m::IdSet &resource_ids,
+                       uint32_t &size);
+
+    /**
+     * Serialises the resources of the given list whose ID is in the given set,
+     * like serialize(M2MResourceList, uint32_t&).
+     * @param resource_list Array of resources.
+     * @param resource_ids IDs of the resources to include.
+     * @return Resources encoded binary as OMA-TLV
+     */
+    uint8_t* serialize(M2MResourceList resource_list,
+                       const m2m::IdSet &resource_ids,
+                       uint32_t &size);
+
     uint8_t* serialize(M2MResource *resource, uint32_t &size);
 
 private :
 
-    uint8_t* serialize_object_instances(M2MObjectInstanceList object_instance_list, uint32_t &size);
+    uint8_t* serialize_object_instances(M2MObjectInstanceList object_instance_list, uint32_t &size,
+                                        const m2m::IdSet *resource_ids = NULL);
 
-    uint8_t* serialize_resources(M2MResourceList resource_list, uint32_t &size, bool &valid);
+    uint8_t* serialize_resources(M2MResourceList resource_list, uint32_t &size, bool &valid,
+                                 const m2m::IdSet *resource_ids = NULL);
 
-    void serialize(uint16_t id, M2MObjectInstance *object_instance, uint8_t *&data, uint32_t &size);
+    void serialize(uint16_t id, M2MObjectInstance *object_instance, uint8_t *&data, uint32_t &size,
+                   const m2m::IdSet *resource_ids = NULL);
     
     bool serialize (M2MResource *resource, uint8_t *&data, uint32_t &size);
 
@@ -99,6 +127,12 @@ private :
     bool serialize_multiple_resource(M2MResource *resource, uint8_t *&data, uint32_t &size);
 
     void serialize_resource_instance(uint16_t id, M2MResourceInstance *resource, uint8_t *&data, uint32_t &size);
+
+    void serialize_value(uint8_t type, uint16_t id, M2MResourceInstance *resource, uint8_t *&data, uint32_t &size);
+
+    uint32_t encode_integer(const uint8_t *value, uint32_t value_length, uint8_t *number);
+
+    uint32_t encode_float(const uint8_t *value, uint32_t value_length, uint8_t *number);
     
     void serialize_TILV (uint8_t type, uint16_t id, uint8_t *value, uint32_t value_length, uint8_t *&data, uint32_t &size);
 
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_TRACE_H
+#define M2M_TRACE_H
+
+// Library sources include this instead of mbed-trace directly, it removes
+// the traces above the configured level at compile time and redirects the
+// remaining ones to the binary trace buffer when that mode is enabled.
+#include "mbed-trace/mbed_trace.h"
+
+#define M2M_TRACE_LEVEL_NONE    0
+#define M2M_TRACE_LEVEL_ERROR   1
+#define M2M_TRACE_LEVEL_WARN    2
+#define M2M_TRACE_LEVEL_INFO    3
+#define M2M_TRACE_LEVEL_DEBUG   4
+
+// Highest level compiled in. Removed traces don't evaluate their arguments.
+#ifndef YOTTA_CFG_MBED_CLIENT_TRACE_LEVEL
+#define YOTTA_CFG_MBED_CLIENT_TRACE_LEVEL M2M_TRACE_LEVEL_DEBUG
+#endif
+
+#ifndef YOTTA_CFG_MBED_CLIENT_BINARY_TRACE_SIZE
+#define YOTTA_CFG_MBED_CLIENT_BINARY_TRACE_SIZE 64
+#endif
+
+#ifdef YOTTA_CFG_MBED_CLIENT_BINARY_TRACE
+#include "mbed-client/m2mtracebuffer.h"
+#undef tr_debug
+#undef tr_info
+#undef tr_warn
+#undef tr_error
+#define tr_debug(...) M2MTraceBuffer::trace(M2M_TRACE_LEVEL_DEBUG, __VA_ARGS__)
+#define tr_info(...) M2MTraceBuffer::trace(M2M_TRACE_LEVEL_INFO, __VA_ARGS__)
+#define tr_warn(...) M2MTraceBuffer::trace(M2M_TRACE_LEVEL_WARN, __VA_ARGS__)
+#define tr_error(...) M2MTraceBuffer::trace(M2M_TRACE_LEVEL_ERROR, __VA_ARGS__)
+#endif
+
+#if YOTTA_CFG_MBED_CLIENT_TRACE_LEVEL < M2M_TRACE_LEVEL_DEBUG
+#undef tr_debug
+#define tr_debug(...) ((void)0)
+#endif
+#if YOTTA_CFG_MBED_CLIENT_TRACE_LEVEL < M2M_TRACE_LEVEL_INFO
+#undef tr_info
+#define tr_info(...) ((void)0)
+#endif
+#if YOTTA_CFG_MBED_CLIENT_TRACE_LEVEL < M2M_TRACE_LEVEL_WARN
+#undef tr_warn
+#define tr_warn(...) ((void)0)
+#endif
+#if YOTTA_CFG_MBED_CLIENT_TRACE_LEVEL < M2M_TRACE_LEVEL_ERROR
+#undef tr_error
+#define tr_error(...) ((void)0)
+#endif
+
+#endif // M2M_TRACE_H
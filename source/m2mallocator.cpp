@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "mbed-client/m2mallocator.h"
+
+static M2MAllocator *__m2m_allocator = NULL;
+static M2MAllocator::Accounting __m2m_accounting;
+
+void M2MAllocator::set_allocator(M2MAllocator *allocator)
+{
+    __m2m_allocator = allocator;
+}
+
+M2MAllocator* M2MAllocator::allocator()
+{
+    return __m2m_allocator;
+}
+
+void* M2MAllocator::memory_alloc(uint16_t size)
+{
+    if(!size) {
+        return NULL;
+    }
+    void *ptr = NULL;
+    if(__m2m_allocator) {
+        ptr = __m2m_allocator->allocate(size);
+    } else {
+        ptr = malloc(size);
+    }
+    if(!ptr) {
+        __m2m_accounting.failures++;
+        return NULL;
+    }
+    __m2m_accounting.allocations++;
+    __m2m_accounting.bytes_requested += size;
+    if(__m2m_allocator) {
+        __m2m_accounting.bytes_in_use += __m2m_allocator->allocated_size(ptr);
+        if(__m2m_accounting.bytes_in_use > __m2m_accounting.peak_bytes_in_use) {
+            __m2m_accounting.peak_bytes_in_use = __m2m_accounting.bytes_in_use;
+        }
+    }
+    return ptr;
+}
+
+void M2MAllocator::memory_free(void *ptr)
+{
+    if(!ptr) {
+        return;
+    }
+    __m2m_accounting.deallocations++;
+    if(__m2m_allocator) {
+        uint32_t size = __m2m_allocator->allocated_size(ptr);
+        __m2m_accounting.bytes_in_use -= size < __m2m_accounting.bytes_in_use ?
+                                         size : __m2m_accounting.bytes_in_use;
+        __m2m_allocator->deallocate(ptr);
+    } else {
+        free(ptr);
+    }
+}
+
+const M2MAllocator::Accounting& M2MAllocator::accounting()
+{
+    return __m2m_accounting;
+}
+
+void M2MAllocator::reset_accounting()
+{
+    uint32_t in_use = __m2m_accounting.bytes_in_use;
+    memset(&__m2m_accounting, 0, sizeof(__m2m_accounting));
+    __m2m_accounting.bytes_in_use = in_use;
+    __m2m_accounting.peak_bytes_in_use = in_use;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include "mbed-client/m2marenaallocator.h"
+
+// Keeps every allocation aligned for any type stored in it.
+#define ARENA_ALIGNMENT     8
+
+M2MArenaAllocator::M2MArenaAllocator(uint16_t size)
+: _region(NULL),
+  _size(0),
+  _used(0)
+{
+    if(size > 0) {
+        _region = (uint8_t*)malloc(size);
+    }
+    if(_region) {
+        _size = size;
+    }
+}
+
+M2MArenaAllocator::~M2MArenaAllocator()
+{
+    free(_region);
+    _region = NULL;
+}
+
+void* M2MArenaAllocator::allocate(uint16_t size)
+{
+    if(!size) {
+        return NULL;
+    }
+    uint32_t aligned_size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+    if(_region && aligned_size <= (uint32_t)(_size - _used)) {
+        void *ptr = _region + _used;
+        _used += aligned_size;
+        return ptr;
+    }
+    return malloc(size);
+}
+
+void M2MArenaAllocator::deallocate(void *ptr)
+{
+    if(ptr && !contains(ptr)) {
+        free(ptr);
+    }
+}
+
+void M2MArenaAllocator::reset()
+{
+    _used = 0;
+}
+
+uint16_t M2MArenaAllocator::used() const
+{
+    return _used;
+}
+
+bool M2MArenaAllocator::contains(const void *ptr) const
+{
+    const uint8_t *address = (const uint8_t*)ptr;
+    return _region && address >= _region && address < _region + _size;
+}
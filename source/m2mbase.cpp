@@ -16,10 +16,11 @@
 #include "mbed-client/m2mbase.h"
 #include "mbed-client/m2mobservationhandler.h"
 #include "mbed-client/m2mconstants.h"
+#include "mbed-client/m2mallocator.h"
 #include "mbed-client/m2mtimer.h"
 #include "include/m2mreporthandler.h"
 #include "include/nsdllinker.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2mtrace.h"
 #include <ctype.h>
 #include <string.h>
 
@@ -40,6 +41,7 @@ M2MBase& M2MBase::operator=(const M2MBase& other)
         _observation_level = other._observation_level;
         _observation_handler = other._observation_handler;
         _register_uri = other._register_uri;
+        _delta_notification = other._delta_notification;
         _uri_path = other._uri_path;
         _max_age = other._max_age;
         if(_token) {
@@ -84,6 +86,7 @@ M2MBase::M2MBase(const M2MBase& other) :
     _observation_number = other._observation_number;
     _observation_level = other._observation_level;
     _register_uri = other._register_uri;
+    _delta_notification = other._delta_notification;
     _uri_path = other._uri_path;
     _max_age = other._max_age;
     _token_length = other._token_length;
@@ -115,17 +118,11 @@ M2MBase::M2MBase(const String & resource_name,
   _token(NULL),
   _token_length(0),
   _register_uri(true),
+  _delta_notification(false),
   _uri_path(""),
   _max_age(0)
 {
-    if(is_integer(_name) && _name.size() <= MAX_ALLOWED_STRING_LENGTH) {
-        _name_id = strtoul(_name.c_str(), NULL, 10);
-        if(_name_id > 65535){
-            _name_id = -1;
-        }
-    } else {
-        _name_id = -1;
-    }
+    _name_id = m2m::id_from_string(_name.c_str());
 }
 
 M2MBase::~M2MBase()
@@ -188,7 +185,10 @@ void M2MBase::set_under_observation(bool observed,
 
     tr_debug("M2MBase::set_under_observation - observed: %d", observed);
     tr_debug("M2MBase::set_under_observation - base_type: %d", _base_type);
-    _observation_handler = handler;
+    // A composite observation or a Send sample buffer still needs the handler.
+    if(handler || !((_observation_level & M2MBase::C_Attribute) || sends_samples())) {
+        _observation_handler = handler;
+    }
     if(handler) {
         if (_base_type != M2MBase::ResourceInstance) {
             if(!_report_handler){
@@ -196,6 +196,10 @@ void M2MBase::set_under_observation(bool observed,
             }
             _report_handler->set_under_observation(observed);
         }
+    } else if(sends_samples()) {
+        if(_report_handler) {
+            _report_handler->set_under_observation(false);
+        }
     } else {
         if(_report_handler) {
             delete _report_handler;
@@ -204,6 +208,18 @@ void M2MBase::set_under_observation(bool observed,
     }
 }
 
+void M2MBase::set_composite_observation(bool observed,
+                                        M2MObservationHandler *handler)
+{
+    tr_debug("M2MBase::set_composite_observation - observed: %d", observed);
+    if(observed) {
+        _observation_handler = handler;
+        _observation_level = (M2MBase::Observation)(_observation_level | M2MBase::C_Attribute);
+    } else {
+        _observation_level = (M2MBase::Observation)(_observation_level & ~M2MBase::C_Attribute);
+    }
+}
+
 void M2MBase::set_observation_token(const uint8_t *token, const uint8_t length)
 {
     if(_token) {
@@ -334,7 +350,9 @@ bool M2MBase::handle_observation_attribute(char *&query)
     return success;
 }
 
-void M2MBase::observation_to_be_sent(m2m::Vector<uint16_t> changed_instance_ids, bool send_object)
+void M2MBase::observation_to_be_sent(const m2m::IdSet &changed_instance_ids,
+                                     bool send_object,
+                                     const m2m::IdSet *changed_resource_ids)
 {
     //TODO: Move this to M2MResourceInstance
     if(_observation_handler) {        
@@ -342,8 +360,21 @@ void M2MBase::observation_to_be_sent(m2m::Vector<uint16_t> changed_instance_ids,
        _observation_handler->observation_to_be_sent(this,
                                                     _observation_number,
                                                     changed_instance_ids,
-                                                    send_object);
+                                                    send_object,
+                                                    changed_resource_ids);
+    }
+}
+
+bool M2MBase::samples_to_be_sent(M2MSampleBuffer &samples)
+{
+    bool sent = false;
+    if(_observation_handler) {
+       _observation_number++;
+       sent = _observation_handler->samples_to_be_sent(this,
+                                                       _observation_number,
+                                                       samples);
     }
+    return sent;
 }
 
 void M2MBase::set_base_type(M2MBase::BaseType type)
@@ -365,6 +396,11 @@ void M2MBase::remove_object_from_coap()
     }
 }
 
+bool M2MBase::sends_samples() const
+{
+    return false;
+}
+
 sn_coap_hdr_s* M2MBase::handle_get_request(nsdl_s */*nsdl*/,
                                            sn_coap_hdr_s */*received_coap_header*/,
                                            M2MObservationHandler */*observation_handler*/)
@@ -393,16 +429,66 @@ sn_coap_hdr_s* M2MBase::handle_post_request(nsdl_s */*nsdl*/,
 
 void *M2MBase::memory_alloc(uint16_t size)
 {
-    if(size)
-        return malloc(size);
-    else
-        return 0;
+    return M2MAllocator::memory_alloc(size);
 }
 
 void M2MBase::memory_free(void *ptr)
 {
-    if(ptr)
+    M2MAllocator::memory_free(ptr);
+}
+
+void* M2MBase::response_alloc(M2MObservationHandler *handler, uint16_t size)
+{
+    M2MAllocator *allocator = handler ? handler->request_allocator() : NULL;
+    if(allocator) {
+        return size ? allocator->allocate(size) : NULL;
+    }
+    return size ? malloc(size) : NULL;
+}
+
+void M2MBase::response_free(M2MObservationHandler *handler, void *ptr)
+{
+    M2MAllocator *allocator = handler ? handler->request_allocator() : NULL;
+    if(allocator) {
+        allocator->deallocate(ptr);
+    } else {
         free(ptr);
+    }
+}
+
+uint8_t* M2MBase::response_integer(M2MObservationHandler *handler,
+                                   int64_t value,
+                                   uint8_t &size)
+{
+    // Same length rules as String::convert_integer_to_array()
+    size = 1;
+    while(size < 8 && value >= (int64_t)((1ULL << (8 * size)) - 1)) {
+        size++;
+    }
+    uint8_t *buffer = (uint8_t*)response_alloc(handler, size);
+    if(buffer) {
+        for(uint8_t i = 0; i < size; i++) {
+            buffer[i] = (value >> ((size - i - 1) * 8));
+        }
+    } else {
+        size = 0;
+    }
+    return buffer;
+}
+
+bool M2MBase::requested_content_type(const sn_coap_hdr_s *coap_header,
+                                     uint16_t &content_type)
+{
+    if(coap_header->options_list_ptr && coap_header->options_list_ptr->accept_ptr) {
+        content_type = m2m::String::convert_array_to_integer(coap_header->options_list_ptr->accept_ptr,
+                                                             coap_header->options_list_ptr->accept_len);
+    } else if(coap_header->content_type_ptr) {
+        content_type = m2m::String::convert_array_to_integer(coap_header->content_type_ptr,
+                                                             coap_header->content_type_len);
+    } else {
+        return false;
+    }
+    return true;
 }
 
 M2MReportHandler* M2MBase::report_handler()
@@ -425,15 +511,14 @@ bool M2MBase::register_uri()
     return _register_uri;
 }
 
-bool M2MBase::is_integer(const String &value)
+void M2MBase::set_delta_notification(bool delta)
 {
-    const char *s = value.c_str();
-    if(value.empty() || ((!isdigit(s[0])) && (s[0] != '-') && (s[0] != '+'))) {
-        return false;
-    }
-    char * p ;
-    strtol(value.c_str(), &p, 10);
-    return (*p == 0);
+    _delta_notification = delta;
+}
+
+bool M2MBase::delta_notification() const
+{
+    return _delta_notification;
 }
 
 void M2MBase::set_uri_path(const String &path)
@@ -446,3 +531,22 @@ const String& M2MBase::uri_path() const
 {
     return _uri_path;
 }
+
+uint32_t M2MBase::memory_footprint() const
+{
+    return sizeof(M2MBase) + base_memory_footprint();
+}
+
+uint32_t M2MBase::base_memory_footprint() const
+{
+    // A String owns its capacity plus the terminating NUL.
+    uint32_t bytes = _name.capacity() + 1 +
+                     _resource_type.capacity() + 1 +
+                     _interface_description.capacity() + 1 +
+                     _uri_path.capacity() + 1 +
+                     _token_length;
+    if(_report_handler) {
+        bytes += _report_handler->memory_footprint();
+    }
+    return bytes;
+}
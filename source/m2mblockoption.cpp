@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include "include/m2mblockoption.h"
+
+#define BLOCK_OPTION_MAX_LEN    3
+#define BLOCK_MORE_BIT          0x08
+#define BLOCK_SZX_MASK          0x07
+#define BLOCK_SZX_RESERVED      7
+#define BLOCK_SIZE_MIN          16
+
+bool M2MBlockOption::parse(const uint8_t *block,
+                           uint16_t block_len,
+                           uint32_t &number,
+                           bool &more,
+                           uint16_t &size)
+{
+    if(!block || block_len == 0 || block_len > BLOCK_OPTION_MAX_LEN) {
+        return false;
+    }
+    uint32_t value = 0;
+    for(uint16_t i = 0; i < block_len; i++) {
+        value = (value << 8) + block[i];
+    }
+    uint8_t szx = value & BLOCK_SZX_MASK;
+    if(szx == BLOCK_SZX_RESERVED) {
+        return false;
+    }
+    number = value >> 4;
+    more = (value & BLOCK_MORE_BIT) != 0;
+    size = BLOCK_SIZE_MIN << szx;
+    return true;
+}
+
+uint8_t* M2MBlockOption::build(uint32_t number,
+                               bool more,
+                               uint16_t size,
+                               uint8_t &block_len)
+{
+    uint8_t szx = 0;
+    while(szx < BLOCK_SZX_RESERVED - 1 && (BLOCK_SIZE_MIN << szx) < size) {
+        szx++;
+    }
+    uint32_t value = (number << 4) | (more ? BLOCK_MORE_BIT : 0) | szx;
+    block_len = value > 0xFFFF ? 3 : value > 0xFF ? 2 : 1;
+    uint8_t *block = (uint8_t*)malloc(block_len);
+    if(block) {
+        for(uint8_t i = 0; i < block_len; i++) {
+            block[i] = (value >> (8 * (block_len - 1 - i))) & 0xFF;
+        }
+    }
+    return block;
+}
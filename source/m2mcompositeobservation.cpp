@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "include/m2mcompositeobservation.h"
+#include "include/m2mreporthandler.h"
+#include "include/m2mtrace.h"
+#include "mbed-client/m2mbase.h"
+
+#define TRACE_GROUP "mClt"
+
+M2MCompositeObservation::M2MCompositeObservation(M2MCompositeObserver &observer,
+                                                 const uint8_t *token,
+                                                 uint8_t token_length,
+                                                 const M2MPathList &paths)
+: _observer(observer),
+  _token(NULL),
+  _token_length(0),
+  _paths(paths),
+  _report_handler(new M2MReportHandler(*this)),
+  _observation_number(0)
+{
+    tr_debug("M2MCompositeObservation::M2MCompositeObservation()");
+    if(token && token_length > 0) {
+        _token = (uint8_t*)malloc(token_length);
+        if(_token) {
+            memcpy(_token, token, token_length);
+            _token_length = token_length;
+        }
+    }
+}
+
+M2MCompositeObservation::~M2MCompositeObservation()
+{
+    tr_debug("M2MCompositeObservation::~M2MCompositeObservation()");
+    delete _report_handler;
+    free(_token);
+}
+
+bool M2MCompositeObservation::set_notification_attributes(char *query)
+{
+    // Only the timing attributes apply, as to an object.
+    return _report_handler->parse_notification_attribute(query, M2MBase::Object);
+}
+
+void M2MCompositeObservation::set_under_observation(bool observed)
+{
+    _report_handler->set_under_observation(observed);
+}
+
+bool M2MCompositeObservation::is_member(const String &path) const
+{
+    // Both "3/0/9" and "/3/0/9" are accepted.
+    const char *member = path.c_str();
+    if(*member == '/') {
+        member++;
+    }
+    if(*member == '\0') {
+        return false;
+    }
+    M2MPathList::const_iterator it = _paths.begin();
+    for(; it != _paths.end(); it++) {
+        const char *observed = it->c_str();
+        if(*observed == '/') {
+            observed++;
+        }
+        size_t length = strlen(observed);
+        if(strncmp(member, observed, length) == 0 &&
+           (length == 0 || member[length] == '\0' || member[length] == '/')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void M2MCompositeObservation::value_changed()
+{
+    tr_debug("M2MCompositeObservation::value_changed()");
+    _report_handler->set_notification_trigger();
+}
+
+bool M2MCompositeObservation::has_token(const uint8_t *token, uint8_t token_length) const
+{
+    return token_length == _token_length &&
+           (token_length == 0 || memcmp(token, _token, token_length) == 0);
+}
+
+const uint8_t* M2MCompositeObservation::token() const
+{
+    return _token;
+}
+
+uint8_t M2MCompositeObservation::token_length() const
+{
+    return _token_length;
+}
+
+const M2MPathList& M2MCompositeObservation::paths() const
+{
+    return _paths;
+}
+
+uint16_t M2MCompositeObservation::observation_number() const
+{
+    return _observation_number;
+}
+
+uint16_t M2MCompositeObservation::next_observation_number()
+{
+    return ++_observation_number;
+}
+
+void M2MCompositeObservation::observation_to_be_sent(const m2m::IdSet &/*changed_instance_ids*/,
+                                                     bool /*send_object*/,
+                                                     const m2m::IdSet */*changed_resource_ids*/)
+{
+    tr_debug("M2MCompositeObservation::observation_to_be_sent()");
+    _observer.composite_observation_to_be_sent(*this);
+}
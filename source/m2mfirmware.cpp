@@ -19,10 +19,56 @@
 #include "mbed-client/m2mobject.h"
 #include "mbed-client/m2mobjectinstance.h"
 #include "mbed-client/m2mresource.h"
+#include "include/m2mfirmwarepackagewriter.h"
+#include "include/m2mobjectmodel.h"
 
-#define BUFFER_SIZE 21
 #define TRACE_GROUP "mClt"
 
+#define M2M_FIRMWARE_RESOURCE_COUNT (M2MFirmware::PackageVersion + 1)
+
+// Resource models of the Firmware object, indexed by M2MFirmware::FirmwareResource.
+static const M2MObjectModel::Resource __m2m_firmware_resources[] = {
+    // Package
+    { "0", M2MResourceInstance::OPAQUE,  M2MBase::PUT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // PackageUri
+    { "1", M2MResourceInstance::STRING,  M2MBase::PUT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // Update, executable only in the Downloaded state
+    { "2", M2MResourceInstance::OPAQUE,  M2MBase::NOT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // State
+    { "3", M2MResourceInstance::INTEGER, M2MBase::GET_ALLOWED,
+      M2MObjectModel::Mandatory | M2MObjectModel::Observable | M2MObjectModel::Ranged,
+      M2MFirmware::Idle, M2MFirmware::Updating, "0" },
+    // UpdateSupportedObjects
+    { "4", M2MResourceInstance::INTEGER, M2MBase::GET_PUT_ALLOWED,
+      M2MObjectModel::Ranged, 0, 1, NULL },
+    // UpdateResult
+    { "5", M2MResourceInstance::INTEGER, M2MBase::GET_ALLOWED,
+      M2MObjectModel::Mandatory | M2MObjectModel::Observable | M2MObjectModel::Ranged,
+      M2MFirmware::Default, M2MFirmware::InvalidURI, "0" },
+    // PackageName
+    { "6", M2MResourceInstance::STRING,  M2MBase::GET_ALLOWED,
+      0, 0, 0, NULL },
+    // PackageVersion
+    { "7", M2MResourceInstance::STRING,  M2MBase::GET_ALLOWED,
+      0, 0, 0, NULL }
+};
+
+// Fails to compile if the table and the enum go out of sync.
+typedef char __m2m_firmware_resources_check[
+    (sizeof(__m2m_firmware_resources) / sizeof(__m2m_firmware_resources[0]) ==
+     M2M_FIRMWARE_RESOURCE_COUNT) ? 1 : -1];
+
+static const M2MObjectModel::Resource* firmware_model(M2MFirmware::FirmwareResource resource)
+{
+    if((unsigned)resource < M2M_FIRMWARE_RESOURCE_COUNT) {
+        return &__m2m_firmware_resources[resource];
+    }
+    return NULL;
+}
+
 M2MFirmware* M2MFirmware::_instance = NULL;
 
 M2MFirmware* M2MFirmware::get_instance()
@@ -42,8 +88,11 @@ void M2MFirmware::delete_instance()
 }
 
 M2MFirmware::M2MFirmware()
-: M2MObject(M2M_FIRMWARE_ID)
+: M2MObject(M2M_FIRMWARE_ID),
+  _firmware_instance(NULL),
+  _package_writer(NULL)
 {
+    _package_writer = new M2MFirmwarePackageWriter(*this);
     M2MBase::set_register_uri(false);
     M2MBase::set_operation(M2MBase::GET_PUT_ALLOWED);
     _firmware_instance = M2MObject::create_object_instance();
@@ -55,91 +104,37 @@ M2MFirmware::M2MFirmware()
 
 M2MFirmware::~M2MFirmware()
 {
+    delete _package_writer;
+    _package_writer = NULL;
 }
 
 void M2MFirmware::create_mandatory_resources()
 {
     _firmware_instance->set_coap_content_type(COAP_CONTENT_OMA_TLV_TYPE);
-    M2MResource* res = _firmware_instance->create_dynamic_resource(FIRMWARE_PACKAGE,
-                                                                 OMA_RESOURCE_TYPE,
-                                                                 M2MResourceInstance::OPAQUE,
-                                                                 false);
-    if(res) {
-        res->set_operation(M2MBase::PUT_ALLOWED);
-        res->set_register_uri(false);
-    }
-
-    res = _firmware_instance->create_dynamic_resource(FIRMWARE_PACKAGE_URI,
-                                                    OMA_RESOURCE_TYPE,
-                                                    M2MResourceInstance::STRING,
-                                                    false);
-    if(res) {
-        res->set_operation(M2MBase::PUT_ALLOWED);
-        res->set_register_uri(false);
-    }
-
-    res = _firmware_instance->create_dynamic_resource(FIRMWARE_UPDATE,
-                                                    OMA_RESOURCE_TYPE,
-                                                    M2MResourceInstance::OPAQUE,
-                                                    false);
+    M2MObjectModel::create_mandatory_resources(_firmware_instance,
+                                               __m2m_firmware_resources,
+                                               M2M_FIRMWARE_RESOURCE_COUNT,
+                                               false);
+    M2MResource* res = get_resource(M2MFirmware::Package);
     if(res) {
-        res->set_operation(M2MBase::NOT_ALLOWED);
-        res->set_register_uri(false);
-    }
-
-    res = _firmware_instance->create_dynamic_resource(FIRMWARE_STATE,
-                                                    OMA_RESOURCE_TYPE,
-                                                    M2MResourceInstance::INTEGER,
-                                                    true);
-    set_zero_value(res);
-    if(res) {        
-        res->set_operation(M2MBase::GET_ALLOWED);
-        res->set_register_uri(false);
-    }
-    res = _firmware_instance->create_dynamic_resource(FIRMWARE_UPDATE_RESULT,
-                                                    OMA_RESOURCE_TYPE,
-                                                    M2MResourceInstance::INTEGER,
-                                                    true);
-    set_zero_value(res);
-    if(res) {
-        res->set_operation(M2MBase::GET_ALLOWED);
-        res->set_register_uri(false);
+        res->set_package_writer(_package_writer);
     }
 }
 
 M2MResource* M2MFirmware::create_resource(FirmwareResource resource, const String &value)
 {
     M2MResource* res = NULL;
-    String firmware_id = "";
-    M2MBase::Operation operation = M2MBase::GET_ALLOWED;
-    if(!is_resource_present(resource)) {
-        switch(resource) {
-            case PackageName:
-                firmware_id = FIRMWARE_PACKAGE_NAME;
-                break;
-            case PackageVersion:
-                firmware_id = FIRMWARE_PACKAGE_VERSION;
-                break;
-            default:
-                break;
-        }
-    }
-    if(!firmware_id.empty() && value.size() < 256) {
-        if(_firmware_instance) {
-            res = _firmware_instance->create_dynamic_resource(firmware_id,
-                                                            OMA_RESOURCE_TYPE,
-                                                            M2MResourceInstance::STRING,
-                                                            false);
-
-            if(res) {
-                res->set_register_uri(false);
-                res->set_operation(operation);
-                if(value.empty()) {
-                    res->clear_value();
-                } else {
-                    res->set_value((const uint8_t*)value.c_str(),
-                                   (uint32_t)value.length());
-                }
+    const M2MObjectModel::Resource *model = firmware_model(resource);
+    if(model && !is_resource_present(resource) && value.size() < 256 &&
+       M2MResourceInstance::STRING == model->type &&
+       !(model->flags & M2MObjectModel::Mandatory)) {
+        res = M2MObjectModel::create_resource(_firmware_instance, *model, false);
+        if(res) {
+            if(value.empty()) {
+                res->clear_value();
+            } else {
+                res->set_value((const uint8_t*)value.c_str(),
+                               (uint32_t)value.length());
             }
         }
     }
@@ -149,39 +144,13 @@ M2MResource* M2MFirmware::create_resource(FirmwareResource resource, const Strin
 M2MResource* M2MFirmware::create_resource(FirmwareResource resource, int64_t value)
 {
     M2MResource* res = NULL;
-    String firmware_id = "";
-    M2MBase::Operation operation = M2MBase::GET_ALLOWED;
-    if(!is_resource_present(resource)) {
-        switch(resource) {
-        case UpdateSupportedObjects:
-            if(check_value_range(resource, value)) {
-                firmware_id = FIRMWARE_UPDATE_SUPPORTED_OBJECTS;
-                operation = M2MBase::GET_PUT_ALLOWED;
-            }
-            break;
-        default:
-            break;
-        }
-    }
-    if(!firmware_id.empty()) {
-        if(_firmware_instance) {
-            res = _firmware_instance->create_dynamic_resource(firmware_id,
-                                                            OMA_RESOURCE_TYPE,
-                                                            M2MResourceInstance::INTEGER,
-                                                            false);
-
-            if(res) {
-                res->set_register_uri(false);
-                char *buffer = (char*)malloc(BUFFER_SIZE);
-                if(buffer) {
-                    uint32_t size = m2m::itoa_c(value, buffer);
-                    if (size <= BUFFER_SIZE) {
-                        res->set_operation(operation);
-                        res->set_value((const uint8_t*)buffer, size);
-                    }
-                    free(buffer);
-                }
-            }
+    const M2MObjectModel::Resource *model = firmware_model(resource);
+    if(model && !is_resource_present(resource) &&
+       !(model->flags & M2MObjectModel::Mandatory) &&
+       check_value_range(resource, value)) {
+        res = M2MObjectModel::create_resource(_firmware_instance, *model, false);
+        if(res) {
+            M2MObjectModel::set_int_value(res, value);
         }
     }
     return res;
@@ -192,17 +161,13 @@ bool M2MFirmware::set_resource_value(FirmwareResource resource,
 {
     bool success = false;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MFirmware::PackageUri == resource  ||
-           M2MFirmware::PackageName == resource ||
-           M2MFirmware::PackageVersion == resource) {
-            if (value.size() < 256) {
-                if(value.empty()) {
-                    res->clear_value();
-                    success = true;
-                } else {
-                    success = res->set_value((const uint8_t*)value.c_str(),(uint32_t)value.length());
-                }
+    if(res && M2MResourceInstance::STRING == firmware_model(resource)->type) {
+        if (value.size() < 256) {
+            if(value.empty()) {
+                res->clear_value();
+                success = true;
+            } else {
+                success = res->set_value((const uint8_t*)value.c_str(),(uint32_t)value.length());
             }
         }
     }
@@ -214,23 +179,8 @@ bool M2MFirmware::set_resource_value(FirmwareResource resource,
 {
     bool success = false;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MFirmware::State == resource          ||
-           M2MFirmware::UpdateSupportedObjects == resource ||
-           M2MFirmware::UpdateResult == resource) {
-            // If it is any of the above resource
-            // set the value of the resource.
-            if (check_value_range(resource, value)) {
-                char *buffer = (char*)malloc(BUFFER_SIZE);
-                if(buffer) {
-                    uint32_t size = m2m::itoa_c(value, buffer);
-                    if (size <= BUFFER_SIZE) {
-                        success = res->set_value((const uint8_t*)buffer, size);
-                    }
-                    free(buffer);
-                }
-            }
-        }
+    if(res && check_value_range(resource, value)) {
+        success = M2MObjectModel::set_int_value(res, value);
     }
     return success;
 }
@@ -259,36 +209,10 @@ bool M2MFirmware::is_resource_present(FirmwareResource resource) const
     return success;
 }
 
-String M2MFirmware::resource_name(FirmwareResource resource) const
+const char* M2MFirmware::resource_name(FirmwareResource resource) const
 {
-    String res_name = "";
-    switch(resource) {
-        case Package:
-            res_name = FIRMWARE_PACKAGE;
-            break;
-        case PackageUri:
-            res_name = FIRMWARE_PACKAGE_URI;
-            break;
-        case Update:
-            res_name = FIRMWARE_UPDATE;
-            break;
-        case State:
-            res_name = FIRMWARE_STATE;
-            break;
-        case UpdateSupportedObjects:
-            res_name = FIRMWARE_UPDATE_SUPPORTED_OBJECTS;
-            break;
-        case UpdateResult:
-            res_name = FIRMWARE_UPDATE_RESULT;
-            break;
-        case PackageName:
-            res_name = FIRMWARE_PACKAGE_NAME;
-            break;
-        case PackageVersion:
-            res_name = FIRMWARE_PACKAGE_VERSION;
-            break;
-    }
-    return res_name;
+    const M2MObjectModel::Resource *model = firmware_model(resource);
+    return model ? model->name : "";
 }
 
 uint16_t M2MFirmware::per_resource_count(FirmwareResource res) const
@@ -325,35 +249,9 @@ uint32_t M2MFirmware::resource_value_buffer(FirmwareResource resource,
 M2MResource* M2MFirmware::get_resource(FirmwareResource res) const
 {
     M2MResource* res_object = NULL;
-    if(_firmware_instance) {
-        String res_name = "";
-        switch(res) {
-            case Package:
-                res_name = FIRMWARE_PACKAGE;
-                break;
-            case PackageUri:
-                res_name = FIRMWARE_PACKAGE_URI;
-                break;
-            case Update:
-                res_name = FIRMWARE_UPDATE;
-                break;
-            case State:
-                res_name = FIRMWARE_STATE;
-                break;
-            case UpdateSupportedObjects:
-                res_name = FIRMWARE_UPDATE_SUPPORTED_OBJECTS;
-                break;
-            case UpdateResult:
-                res_name = FIRMWARE_UPDATE_RESULT;
-                break;
-            case PackageName:
-                res_name = FIRMWARE_PACKAGE_NAME;
-                break;
-            case PackageVersion:
-                res_name = FIRMWARE_PACKAGE_VERSION;
-                break;
-        }
-        res_object = _firmware_instance->resource(res_name);
+    const M2MObjectModel::Resource *model = firmware_model(res);
+    if(_firmware_instance && model) {
+        res_object = _firmware_instance->resource(model->name);
     }
     return res_object;
 }
@@ -361,11 +259,10 @@ M2MResource* M2MFirmware::get_resource(FirmwareResource res) const
 bool M2MFirmware::delete_resource(FirmwareResource resource)
 {
     bool success = false;
-    if(M2MFirmware::UpdateSupportedObjects == resource ||
-       M2MFirmware::PackageName == resource            ||
-       M2MFirmware::PackageVersion == resource) {
+    const M2MObjectModel::Resource *model = firmware_model(resource);
+    if(model && !(model->flags & M2MObjectModel::Mandatory)) {
         if(_firmware_instance) {
-            success = _firmware_instance->remove_resource(resource_name(resource));
+            success = _firmware_instance->remove_resource(model->name);
         }
     }
     return success;
@@ -375,18 +272,14 @@ int64_t M2MFirmware::resource_value_int(FirmwareResource resource) const
 {
     int64_t value = -1;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MFirmware::State == resource          ||
-           M2MFirmware::UpdateSupportedObjects == resource         ||
-           M2MFirmware::UpdateResult == resource) {
-            // Get the value and convert it into integer
-            uint8_t* buffer = NULL;
-            uint32_t length = 0;
-            res->get_value(buffer,length);
-            if(buffer) {
-                value = atoi((const char*)buffer);
-                free(buffer);
-            }
+    if(res && M2MResourceInstance::INTEGER == firmware_model(resource)->type) {
+        // Get the value and convert it into integer
+        uint8_t* buffer = NULL;
+        uint32_t length = 0;
+        res->get_value(buffer,length);
+        if(buffer) {
+            value = atoi((const char*)buffer);
+            free(buffer);
         }
     }
     return value;
@@ -396,28 +289,22 @@ String M2MFirmware::resource_value_string(FirmwareResource resource) const
 {
     String value = "";
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MFirmware::PackageUri == resource          ||
-           M2MFirmware::PackageName == resource           ||
-           M2MFirmware::PackageVersion == resource) {
-            uint8_t* buffer = NULL;
-            uint32_t length = 0;
-            res->get_value(buffer,length);
+    if(res && M2MResourceInstance::STRING == firmware_model(resource)->type) {
+        uint8_t* buffer = NULL;
+        uint32_t length = 0;
+        res->get_value(buffer,length);
 
-            char *char_buffer = (char*)malloc(length+1);
-            if(char_buffer) {
-                memset(char_buffer,0,length+1);
-                memcpy(char_buffer,(char*)buffer,length);
+        char *char_buffer = (char*)malloc(length+1);
+        if(char_buffer) {
+            memset(char_buffer,0,length+1);
+            memcpy(char_buffer,(char*)buffer,length);
 
-                String s_name(char_buffer);
-                value = s_name;
-                if(char_buffer) {
-                    free(char_buffer);
-                }
-            }
-            if(buffer) {
-                free(buffer);
-            }
+            String s_name(char_buffer);
+            value = s_name;
+            free(char_buffer);
+        }
+        if(buffer) {
+            free(buffer);
         }
     }
     return value;
@@ -426,46 +313,32 @@ String M2MFirmware::resource_value_string(FirmwareResource resource) const
 bool M2MFirmware::check_value_range(FirmwareResource resource, int64_t value) const
 {
     bool success = false;
-    switch (resource) {
-        case UpdateSupportedObjects:
-            if(value == 0 || value == 1) {
-                success = true;
-            }
-            break;
-        case State:
-            if (value >= 0 && value <= 3) {
-                success = true;
-                M2MResource* updateRes = get_resource(M2MFirmware::Update);
-                if (updateRes){
-                    if (value == M2MFirmware::Downloaded) {
-                        updateRes->set_operation(M2MBase::POST_ALLOWED);
-                    }
-                    else {
-                        updateRes->set_operation(M2MBase::NOT_ALLOWED);
-                    }
-                }
+    const M2MObjectModel::Resource *model = firmware_model(resource);
+    if(model && (model->flags & M2MObjectModel::Ranged)) {
+        success = M2MObjectModel::in_range(*model, value);
+    }
+    if(success && M2MFirmware::State == resource) {
+        M2MResource* updateRes = get_resource(M2MFirmware::Update);
+        if (updateRes){
+            if (value == M2MFirmware::Downloaded) {
+                updateRes->set_operation(M2MBase::POST_ALLOWED);
             }
-            break;
-        case UpdateResult:
-            if (value >= 0 && value <= 7) {
-                success = true;
+            else {
+                updateRes->set_operation(M2MBase::NOT_ALLOWED);
             }
-            break;
-    default:
-        break;
+        }
     }
     return success;
 }
 
-void M2MFirmware::set_zero_value(M2MResource *resource)
+void M2MFirmware::set_package_sink(M2MFirmwareSink *sink)
 {
-    char *buffer = (char*)malloc(BUFFER_SIZE);
-    int64_t value = 0;
-    if(buffer) {
-        uint32_t size = m2m::itoa_c(value, buffer);
-        if (size <= BUFFER_SIZE) {
-            resource->set_value((const uint8_t*)buffer, size);
-        }
-        free(buffer);
+    if(_package_writer) {
+        _package_writer->set_sink(sink);
     }
 }
+
+uint32_t M2MFirmware::package_offset() const
+{
+    return _package_writer ? _package_writer->package_offset() : 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include "include/m2mfirmwarepackagewriter.h"
+#include "include/m2mblockoption.h"
+#include "mbed-client/m2mfirmware.h"
+#include "include/m2mtrace.h"
+
+#define TRACE_GROUP "mClt"
+
+M2MFirmwarePackageWriter::M2MFirmwarePackageWriter(M2MFirmware &firmware)
+: _firmware(firmware),
+  _sink(NULL),
+  _offset(0),
+  _first_block_msg_id(0),
+  _active(false)
+{
+}
+
+M2MFirmwarePackageWriter::~M2MFirmwarePackageWriter()
+{
+    abort();
+}
+
+void M2MFirmwarePackageWriter::set_sink(M2MFirmwareSink *sink)
+{
+    abort();
+    _sink = sink;
+}
+
+bool M2MFirmwarePackageWriter::is_block_message(const sn_coap_hdr_s *received_coap_header) const
+{
+    return (_sink &&
+            received_coap_header &&
+            received_coap_header->options_list_ptr &&
+            received_coap_header->options_list_ptr->block1_ptr &&
+            received_coap_header->options_list_ptr->block1_len > 0);
+}
+
+sn_coap_msg_code_e M2MFirmwarePackageWriter::handle_block(const sn_coap_hdr_s *received_coap_header,
+                                                          sn_coap_hdr_s *coap_response)
+{
+    if(!is_block_message(received_coap_header)) {
+        return COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+    }
+
+    uint32_t number = 0;
+    bool more = false;
+    uint16_t size = 0;
+    if(!M2MBlockOption::parse(received_coap_header->options_list_ptr->block1_ptr,
+                              received_coap_header->options_list_ptr->block1_len,
+                              number, more, size)) {
+        tr_error("M2MFirmwarePackageWriter::handle_block() - Invalid Block1 option");
+        return COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+    }
+
+    uint16_t payload_len = received_coap_header->payload_ptr ? received_coap_header->payload_len : 0;
+    if(more && payload_len != size) {
+        tr_error("M2MFirmwarePackageWriter::handle_block() - Block size mismatch");
+        return COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+    }
+
+    uint32_t block_offset = number * size;
+    tr_debug("M2MFirmwarePackageWriter::handle_block() - block %lu, offset %lu, more %d",
+             (unsigned long)number, (unsigned long)block_offset, more);
+
+    if(block_offset == 0) {
+        // Retransmission of the first block, whose response was lost, of
+        // an ongoing transfer or of an already completed one block package.
+        // It carries the message ID of the stored block, any other block 0
+        // restarts the transfer.
+        bool duplicate = _offset > 0 &&
+                         received_coap_header->msg_id == _first_block_msg_id &&
+                         (_active ? more : (!more && payload_len == _offset));
+        if(duplicate) {
+            set_block_option(received_coap_header, coap_response);
+            return more ? COAP_MSG_CODE_RESPONSE_CONTINUE : COAP_MSG_CODE_RESPONSE_CHANGED;
+        }
+        if(!start()) {
+            return COAP_MSG_CODE_RESPONSE_INTERNAL_SERVER_ERROR;
+        }
+        _first_block_msg_id = received_coap_header->msg_id;
+    } else if(!_active) {
+        // Retransmission of the last block of an already completed package.
+        if(!more && _offset > 0 && block_offset + payload_len == _offset) {
+            set_block_option(received_coap_header, coap_response);
+            return COAP_MSG_CODE_RESPONSE_CHANGED;
+        }
+        return COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE;
+    }
+
+    if(block_offset > _offset) {
+        // A block has been lost, keep the state so that the server
+        // can resume from the expected offset.
+        tr_error("M2MFirmwarePackageWriter::handle_block() - Expected offset %lu",
+                 (unsigned long)_offset);
+        return COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE;
+    }
+
+    // Skip the part that has already been stored, e.g. when the server
+    // retransmits a block whose response was lost.
+    uint32_t skip = _offset - block_offset;
+    if(payload_len > skip) {
+        const uint8_t *data = received_coap_header->payload_ptr + skip;
+        uint16_t length = payload_len - skip;
+        if(!_sink->package_block(_offset, data, length)) {
+            tr_error("M2MFirmwarePackageWriter::handle_block() - Sink failed to store block");
+            abort();
+            _firmware.set_resource_value(M2MFirmware::UpdateResult, M2MFirmware::NotEnoughSpace);
+            return COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
+        }
+        _sha256.update(data, length);
+        _offset += length;
+    }
+
+    set_block_option(received_coap_header, coap_response);
+    if(more) {
+        return COAP_MSG_CODE_RESPONSE_CONTINUE;
+    }
+
+    uint8_t digest[M2M_FIRMWARE_DIGEST_SIZE];
+    _sha256.finish(digest);
+    _active = false;
+    _firmware.set_resource_value(M2MFirmware::State, M2MFirmware::Downloaded);
+    _sink->package_completed(_offset, digest);
+    return COAP_MSG_CODE_RESPONSE_CHANGED;
+}
+
+uint32_t M2MFirmwarePackageWriter::package_offset() const
+{
+    return _offset;
+}
+
+bool M2MFirmwarePackageWriter::is_active() const
+{
+    return _active;
+}
+
+void M2MFirmwarePackageWriter::abort()
+{
+    if(_active) {
+        tr_debug("M2MFirmwarePackageWriter::abort()");
+        _active = false;
+        if(_sink) {
+            _sink->package_aborted();
+        }
+        _firmware.set_resource_value(M2MFirmware::State, M2MFirmware::Idle);
+    }
+    _offset = 0;
+    _sha256.reset();
+}
+
+bool M2MFirmwarePackageWriter::start()
+{
+    abort();
+    if(!_sink->package_started()) {
+        tr_error("M2MFirmwarePackageWriter::start() - Sink not ready");
+        _firmware.set_resource_value(M2MFirmware::UpdateResult, M2MFirmware::OutOfMemory);
+        return false;
+    }
+    _active = true;
+    _firmware.set_resource_value(M2MFirmware::UpdateResult, M2MFirmware::Default);
+    _firmware.set_resource_value(M2MFirmware::State, M2MFirmware::Downloading);
+    return true;
+}
+
+void M2MFirmwarePackageWriter::set_block_option(const sn_coap_hdr_s *received_coap_header,
+                                                sn_coap_hdr_s *coap_response) const
+{
+    if(!coap_response) {
+        return;
+    }
+    if(!coap_response->options_list_ptr) {
+        coap_response->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+        if(!coap_response->options_list_ptr) {
+            return;
+        }
+        memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+    }
+    uint16_t block_len = received_coap_header->options_list_ptr->block1_len;
+    coap_response->options_list_ptr->block1_ptr = (uint8_t*)malloc(block_len);
+    if(coap_response->options_list_ptr->block1_ptr) {
+        memcpy(coap_response->options_list_ptr->block1_ptr,
+               received_coap_header->options_list_ptr->block1_ptr,
+               block_len);
+        coap_response->options_list_ptr->block1_len = block_len;
+    }
+}
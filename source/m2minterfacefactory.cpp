@@ -21,7 +21,7 @@
 #include "mbed-client/m2mconstants.h"
 #include "mbed-client/m2mconfig.h"
 #include "include/m2minterfaceimpl.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2mtrace.h"
 
 #define TRACE_GROUP "mClt"
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <assert.h>
+#include <string.h>
 #include "include/m2minterfaceimpl.h"
 #include "include/eventdata.h"
 #include "mbed-client/m2minterfaceobserver.h"
@@ -23,7 +24,8 @@
 #include "mbed-client/m2msecurity.h"
 #include "mbed-client/m2mconstants.h"
 #include "mbed-client/m2mtimer.h"
-#include "mbed-trace/mbed_trace.h"
+#include "mbed-client/m2mlatency.h"
+#include "include/m2mtrace.h"
 
 #define TRACE_GROUP "mClt"
 
@@ -55,7 +57,13 @@ M2MInterfaceImpl::M2MInterfaceImpl(M2MInterfaceObserver& observer,
   _update_register_ongoing(false),
   _queue_sleep_timer(new M2MTimer(*this)),
   _callback_handler(NULL)
+#ifdef YOTTA_CFG_MBED_CLIENT_BINARY_TRACE
+  ,_trace_buffer(YOTTA_CFG_MBED_CLIENT_BINARY_TRACE_SIZE)
+#endif
 {
+#ifdef YOTTA_CFG_MBED_CLIENT_BINARY_TRACE
+    M2MTraceBuffer::set_active(&_trace_buffer);
+#endif
     M2MConnectionSecurity::SecurityMode sec_mode = M2MConnectionSecurity::DTLS;
     //Hack for now
     if( _binding_mode == M2MInterface::TCP ){
@@ -259,6 +267,20 @@ void M2MInterfaceImpl::set_queue_sleep_handler(callback_handler handler)
     _callback_handler = handler;
 }
 
+void M2MInterfaceImpl::send(const M2MPathList &paths)
+{
+    tr_debug("M2MInterfaceImpl::send()");
+    M2MInterface::Error error = _nsdl_interface->send_data(paths);
+    if(error != M2MInterface::ErrorNone) {
+        _observer.error(error);
+    }
+}
+
+M2MObject* M2MInterfaceImpl::object(uint16_t object_id) const
+{
+    return _nsdl_interface->object(object_id);
+}
+
 void M2MInterfaceImpl::coap_message_ready(uint8_t *data_ptr,
                                           uint16_t data_len,
                                           sn_nsdl_addr_s *address_ptr)
@@ -343,6 +365,7 @@ void M2MInterfaceImpl::data_available(uint8_t* data,
                                       const M2MConnectionObserver::SocketAddress &address)
 {
     tr_debug("M2MInterfaceImpl::data_available(uint8_t* data,uint16_t data_size,const M2MConnectionObserver::SocketAddress &address)");
+    M2MLatency::request_received();
     ReceivedData *event = new ReceivedData();
     event->_data = data;
     event->_size = data_size;
@@ -378,15 +401,7 @@ void M2MInterfaceImpl::address_ready(const M2MConnectionObserver::SocketAddress
 void M2MInterfaceImpl::data_sent()
 {
     tr_debug("M2MInterfaceImpl::data_sent()");
-    if(_binding_mode == M2MInterface::UDP_QUEUE ||
-       _binding_mode == M2MInterface::TCP_QUEUE  ||
-       _binding_mode == M2MInterface::SMS_QUEUE  ||
-       _binding_mode == M2MInterface::UDP_SMS_QUEUE) {
-        if(_callback_handler) {
-            _queue_sleep_timer->stop_timer();
-            _queue_sleep_timer->start_timer(RETRY_COUNT*RETRY_INTERVAL*1000, M2MTimerObserver::QueueSleep);
-        }
-    }
+    start_queue_sleep_timer();
     internal_event(STATE_COAP_DATA_SENT);
 }
 
@@ -395,12 +410,29 @@ void M2MInterfaceImpl::timer_expired(M2MTimerObserver::Type type)
     tr_debug("M2MInterfaceImpl::timer_expired()");
     if(M2MTimerObserver::QueueSleep == type) {        
         if(_callback_handler) {
+            _nsdl_interface->queue_mode_sleep();
             _callback_handler();
         }
     _queue_sleep_timer->stop_timer();
     }
 }
 
+void M2MInterfaceImpl::start_queue_sleep_timer()
+{
+    if(_callback_handler &&
+       (_binding_mode == M2MInterface::UDP_QUEUE ||
+        _binding_mode == M2MInterface::TCP_QUEUE  ||
+        _binding_mode == M2MInterface::SMS_QUEUE  ||
+        _binding_mode == M2MInterface::UDP_SMS_QUEUE)) {
+        uint32_t timeout = QUEUE_LISTEN_TIME*1000;
+        if(_nsdl_interface->pending_exchanges() > 0) {
+            timeout = RETRY_COUNT*RETRY_INTERVAL*1000;
+        }
+        _queue_sleep_timer->stop_timer();
+        _queue_sleep_timer->start_timer(timeout, M2MTimerObserver::QueueSleep);
+    }
+}
+
 // state machine sits here.
 void M2MInterfaceImpl::state_idle(EventData* /*data*/)
 {
@@ -431,10 +463,10 @@ void M2MInterfaceImpl::state_bootstrap( EventData *data)
                 String ip_address;
                 uint16_t port = 0;
                 String  coap;
-                if(server_address.compare(0,COAP.size(),COAP) == 0) {
+                if(server_address.compare(0,strlen(COAP),COAP) == 0) {
                      coap = COAP;
                 }
-                else if(server_address.compare(0,COAPS.size(),COAPS) == 0) {
+                else if(server_address.compare(0,strlen(COAPS),COAPS) == 0) {
                     security->resource_value_int(M2MSecurity::SecurityMode) != M2MSecurity::NoSecurity ? coap = COAPS: coap = "";
                 }
                 if(!coap.empty()) {
@@ -549,10 +581,10 @@ void M2MInterfaceImpl::state_register( EventData *data)
                     String ip_address;
                     uint16_t port = 0;
                     String  coap;
-                    if(server_address.compare(0,COAP.size(),COAP) == 0) {
+                    if(server_address.compare(0,strlen(COAP),COAP) == 0) {
                          coap = COAP;
                     }
-                    else if(server_address.compare(0,COAPS.size(),COAPS) == 0) {
+                    else if(server_address.compare(0,strlen(COAPS),COAPS) == 0) {
                         security->resource_value_int(M2MSecurity::SecurityMode) != M2MSecurity::NoSecurity ? coap = COAPS: coap = "";
                     }
                     if(!coap.empty()) {
@@ -720,6 +752,8 @@ void M2MInterfaceImpl::state_coap_data_received( EventData *data)
            tr_error("M2MInterfaceImpl::state_coap_data_received : M2MInterface::ResponseParseFailed");
             _observer.error(M2MInterface::ResponseParseFailed);
         }
+        // An ACK may have completed the last pending exchange.
+        start_queue_sleep_timer();
     }
 }
 
@@ -768,6 +802,9 @@ void M2MInterfaceImpl::external_event(uint8_t new_state,
 void M2MInterfaceImpl::internal_event(uint8_t new_state,
                                       EventData* p_data)
 {
+#ifdef YOTTA_CFG_MBED_CLIENT_BINARY_TRACE
+    M2MTraceBuffer::set_active(&_trace_buffer);
+#endif
     tr_debug("M2MInterfaceImpl::internal_event : new state %d", new_state);
     _event_data = p_data;
     _event_generated = true;
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "mbed-client/m2mlatency.h"
+#include "mbed-client/m2mstatistics.h"
+#include "include/m2mtrace.h"
+
+#define TRACE_GROUP "mClt"
+
+// Sub-buckets per power of two, as a number of bits.
+#define SUB_BUCKET_BITS 3
+#define SUB_BUCKETS (1 << SUB_BUCKET_BITS)
+
+// Notifications waiting for their ACK.
+#define PENDING_ACKS 8
+
+#if defined(__GNUC__)
+#define M2M_ATOMIC_ADD(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_RELAXED)
+#define M2M_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define M2M_ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELAXED)
+#define M2M_ATOMIC_CAS(ptr, expected, value) \
+    __atomic_compare_exchange_n((ptr), (expected), (value), true, \
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+#define M2M_ATOMIC_ADD(ptr, value) (*(ptr) += (value))
+#define M2M_ATOMIC_LOAD(ptr) (*(ptr))
+#define M2M_ATOMIC_STORE(ptr, value) (*(ptr) = (value))
+#define M2M_ATOMIC_CAS(ptr, expected, value) ((*(ptr) = (value)), true)
+#endif
+
+typedef struct {
+    uint32_t    buckets[M2MLatency::BucketCount];
+    uint32_t    count;
+    uint32_t    max;
+} latency_histogram_s;
+
+typedef struct {
+    uint64_t    sent_at;
+    uint16_t    msg_id;
+    bool        pending;
+} pending_ack_s;
+
+static latency_histogram_s __m2m_histograms[M2MLatency::HistogramCount];
+static uint64_t __m2m_request_arrival = 0;
+static int8_t __m2m_request_histogram = -1;
+static uint64_t __m2m_notification_changed = 0;
+static bool __m2m_notification_sending = false;
+static pending_ack_s __m2m_pending_acks[PENDING_ACKS];
+static uint8_t __m2m_pending_next = 0;
+
+static uint16_t bucket_index(uint32_t value)
+{
+    if(value < SUB_BUCKETS) {
+        return value;
+    }
+    uint8_t msb = 31;
+    while(!(value & (1UL << msb))) {
+        msb--;
+    }
+    uint16_t index = (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS +
+                     ((value >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    return index < M2MLatency::BucketCount ? index : M2MLatency::BucketCount - 1;
+}
+
+void M2MLatency::record(M2MLatency::Histogram histogram, uint64_t microseconds)
+{
+    if(histogram >= HistogramCount) {
+        return;
+    }
+    uint32_t value = microseconds > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)microseconds;
+    latency_histogram_s &h = __m2m_histograms[histogram];
+    M2M_ATOMIC_ADD(&h.buckets[bucket_index(value)], 1);
+    M2M_ATOMIC_ADD(&h.count, 1);
+    uint32_t max = M2M_ATOMIC_LOAD(&h.max);
+    while(value > max && !M2M_ATOMIC_CAS(&h.max, &max, value)) {
+    }
+}
+
+uint32_t M2MLatency::count(M2MLatency::Histogram histogram)
+{
+    if(histogram >= HistogramCount) {
+        return 0;
+    }
+    return M2M_ATOMIC_LOAD(&__m2m_histograms[histogram].count);
+}
+
+uint32_t M2MLatency::max(M2MLatency::Histogram histogram)
+{
+    if(histogram >= HistogramCount) {
+        return 0;
+    }
+    return M2M_ATOMIC_LOAD(&__m2m_histograms[histogram].max);
+}
+
+uint32_t M2MLatency::percentile(M2MLatency::Histogram histogram, float percentile)
+{
+    if(histogram >= HistogramCount) {
+        return 0;
+    }
+    // Sum the buckets rather than use the count, which may run ahead of
+    // them while a value is being recorded.
+    const latency_histogram_s &h = __m2m_histograms[histogram];
+    uint32_t buckets[BucketCount];
+    uint32_t total = 0;
+    for(uint16_t i = 0; i < BucketCount; i++) {
+        buckets[i] = M2M_ATOMIC_LOAD(&h.buckets[i]);
+        total += buckets[i];
+    }
+    if(!total) {
+        return 0;
+    }
+    uint32_t rank = (uint32_t)((percentile / 100.0f) * total + 0.5f);
+    if(rank < 1) {
+        rank = 1;
+    } else if(rank > total) {
+        rank = total;
+    }
+    uint32_t seen = 0;
+    uint16_t index = 0;
+    for(; index < BucketCount - 1; index++) {
+        seen += buckets[index];
+        if(seen >= rank) {
+            break;
+        }
+    }
+    uint32_t bound = bucket_upper_bound(index);
+    uint32_t max = M2M_ATOMIC_LOAD(&h.max);
+    return bound < max ? bound : max;
+}
+
+uint32_t M2MLatency::bucket(M2MLatency::Histogram histogram, uint16_t index)
+{
+    if(histogram >= HistogramCount || index >= BucketCount) {
+        return 0;
+    }
+    return M2M_ATOMIC_LOAD(&__m2m_histograms[histogram].buckets[index]);
+}
+
+uint32_t M2MLatency::bucket_upper_bound(uint16_t index)
+{
+    if(index < SUB_BUCKETS) {
+        return index;
+    }
+    if(index >= BucketCount - 1) {
+        return 0xFFFFFFFFUL;
+    }
+    uint8_t shift = index / SUB_BUCKETS - 1;
+    uint32_t lower = (uint32_t)(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + (1UL << shift) - 1;
+}
+
+static bool append(char *buffer, uint32_t size, uint32_t &length, const char *format,
+                   const char *text, unsigned long first = 0, unsigned long second = 0)
+{
+    int written = snprintf(buffer + length, size - length, format, text, first, second);
+    if(written < 0 || (uint32_t)written >= size - length) {
+        return false;
+    }
+    length += written;
+    return true;
+}
+
+uint32_t M2MLatency::export_json(char *buffer, uint32_t size)
+{
+    static const char *names[HistogramCount] = {
+        "get", "put", "post", "delete", "notification_delay", "notification_ack"
+    };
+    if(!buffer || !size) {
+        return 0;
+    }
+    uint32_t length = 0;
+    bool ok = true;
+    for(uint8_t h = 0; ok && h < HistogramCount; h++) {
+        Histogram histogram = (Histogram)h;
+        ok = append(buffer, size, length, h ? ",\"%s\":{" : "{\"%s\":{", names[h]) &&
+             append(buffer, size, length, "%s\"count\":%lu,\"max\":%lu,", "",
+                    count(histogram), max(histogram)) &&
+             append(buffer, size, length, "%s\"p50\":%lu,\"p90\":%lu,", "",
+                    percentile(histogram, 50.0f), percentile(histogram, 90.0f)) &&
+             append(buffer, size, length, "%s\"p99\":%lu,\"p999\":%lu,\"buckets\":[", "",
+                    percentile(histogram, 99.0f), percentile(histogram, 99.9f));
+        bool first = true;
+        for(uint16_t i = 0; ok && i < BucketCount; i++) {
+            uint32_t value = bucket(histogram, i);
+            if(value) {
+                ok = append(buffer, size, length, "%s[%lu,%lu]", first ? "" : ",",
+                            bucket_upper_bound(i), value);
+                first = false;
+            }
+        }
+        ok = ok && append(buffer, size, length, "%s]}", "");
+    }
+    ok = ok && append(buffer, size, length, "%s}", "");
+    if(!ok) {
+        tr_debug("M2MLatency::export_json() - buffer too small");
+        buffer[0] = '\0';
+        return 0;
+    }
+    return length;
+}
+
+void M2MLatency::reset()
+{
+    tr_debug("M2MLatency::reset()");
+    for(uint8_t h = 0; h < HistogramCount; h++) {
+        for(uint16_t i = 0; i < BucketCount; i++) {
+            M2M_ATOMIC_STORE(&__m2m_histograms[h].buckets[i], 0);
+        }
+        M2M_ATOMIC_STORE(&__m2m_histograms[h].count, 0);
+        M2M_ATOMIC_STORE(&__m2m_histograms[h].max, 0);
+    }
+    memset(__m2m_pending_acks, 0, sizeof(__m2m_pending_acks));
+    __m2m_pending_next = 0;
+}
+
+void M2MLatency::request_received()
+{
+    __m2m_request_arrival = M2MStatistics::now();
+}
+
+void M2MLatency::request_started(uint8_t msg_code)
+{
+    // CoAP method codes 0.01 to 0.04 are GET, POST, PUT and DELETE.
+    switch(msg_code) {
+        case 1:
+            __m2m_request_histogram = GetRequest;
+            break;
+        case 2:
+            __m2m_request_histogram = PostRequest;
+            break;
+        case 3:
+            __m2m_request_histogram = PutRequest;
+            break;
+        case 4:
+            __m2m_request_histogram = DeleteRequest;
+            break;
+        default:
+            __m2m_request_histogram = -1;
+            break;
+    }
+}
+
+void M2MLatency::request_finished()
+{
+    __m2m_request_histogram = -1;
+    __m2m_request_arrival = 0;
+}
+
+void M2MLatency::notification_triggered(uint64_t changed_at)
+{
+    __m2m_notification_changed = changed_at;
+}
+
+void M2MLatency::notification_sending(bool sending)
+{
+    __m2m_notification_sending = sending;
+}
+
+void M2MLatency::message_sent(const uint8_t *data, uint16_t length)
+{
+    uint64_t now = M2MStatistics::now();
+    if(!now) {
+        return;
+    }
+    // A request may change an observed value and so send a notification
+    // before its own response.
+    if(!__m2m_notification_sending) {
+        if(__m2m_request_histogram >= 0 && __m2m_request_arrival) {
+            record((Histogram)__m2m_request_histogram, now - __m2m_request_arrival);
+            request_finished();
+        }
+        return;
+    }
+    if(__m2m_notification_changed) {
+        record(NotificationDelay, now - __m2m_notification_changed);
+        __m2m_notification_changed = 0;
+    }
+    // Confirmable notifications wait for their ACK, see
+    // M2MStatistics::message_sent() for the header layout.
+    if(data && length >= 4 && ((data[0] >> 4) & 0x03) == 0) {
+        uint16_t msg_id = (data[2] << 8) | data[3];
+        for(uint8_t i = 0; i < PENDING_ACKS; i++) {
+            // A retransmission keeps the time of the first send.
+            if(__m2m_pending_acks[i].pending && __m2m_pending_acks[i].msg_id == msg_id) {
+                return;
+            }
+        }
+        pending_ack_s &ack = __m2m_pending_acks[__m2m_pending_next];
+        ack.sent_at = now;
+        ack.msg_id = msg_id;
+        ack.pending = true;
+        __m2m_pending_next = (__m2m_pending_next + 1) % PENDING_ACKS;
+    }
+}
+
+void M2MLatency::message_acknowledged(uint16_t msg_id)
+{
+    for(uint8_t i = 0; i < PENDING_ACKS; i++) {
+        pending_ack_s &ack = __m2m_pending_acks[i];
+        if(ack.pending && ack.msg_id == msg_id) {
+            ack.pending = false;
+            uint64_t now = M2MStatistics::now();
+            if(now) {
+                record(NotificationAck, now - ack.sent_at);
+            }
+            return;
+        }
+    }
+}
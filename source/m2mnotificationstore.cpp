@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed-client/m2mstatistics.h"
+#include "include/m2mnotificationstore.h"
+#include "include/m2mtrace.h"
+
+#define TRACE_GROUP "mClt"
+
+M2MNotificationStore::Entry::Entry()
+: composite(NULL),
+  observation_number(0),
+  send_object(false),
+  delta(false)
+{
+}
+
+M2MNotificationStore::M2MNotificationStore()
+{
+}
+
+M2MNotificationStore::~M2MNotificationStore()
+{
+    clear();
+}
+
+void M2MNotificationStore::store(const String &path,
+                                 uint16_t observation_number,
+                                 const m2m::IdSet &instance_ids,
+                                 bool send_object,
+                                 const m2m::IdSet *resource_ids)
+{
+    Entry *entry = find(path, NULL);
+    if(entry) {
+        M2MStatistics::increment(M2MStatistics::NotificationsCoalesced);
+    } else {
+        tr_debug("M2MNotificationStore::store() - %s", path.c_str());
+        entry = new Entry();
+        entry->path = path;
+        entry->delta = resource_ids != NULL;
+        _entries.push_back(entry);
+    }
+    entry->observation_number = observation_number;
+    entry->send_object = entry->send_object || send_object;
+    for(int32_t id = instance_ids.first(); id != -1; id = instance_ids.next(id)) {
+        entry->instance_ids.insert(id);
+    }
+    // One notification without the changed resources sends them all.
+    if(resource_ids && entry->delta) {
+        for(int32_t id = resource_ids->first(); id != -1; id = resource_ids->next(id)) {
+            entry->resource_ids.insert(id);
+        }
+    } else {
+        entry->delta = false;
+        entry->resource_ids.clear();
+    }
+}
+
+void M2MNotificationStore::store(M2MCompositeObservation *observation)
+{
+    if(!observation) {
+        return;
+    }
+    if(find(String(), observation)) {
+        M2MStatistics::increment(M2MStatistics::NotificationsCoalesced);
+    } else {
+        tr_debug("M2MNotificationStore::store() - composite");
+        Entry *entry = new Entry();
+        entry->composite = observation;
+        _entries.push_back(entry);
+    }
+}
+
+void M2MNotificationStore::remove(M2MCompositeObservation *observation)
+{
+    for(int index = 0; index < _entries.size(); index++) {
+        if(_entries[index]->composite == observation) {
+            delete _entries[index];
+            _entries.erase(index);
+            break;
+        }
+    }
+}
+
+uint16_t M2MNotificationStore::count() const
+{
+    return _entries.size();
+}
+
+const M2MNotificationStore::Entry& M2MNotificationStore::entry(uint16_t index) const
+{
+    return *_entries[index];
+}
+
+void M2MNotificationStore::clear()
+{
+    EntryList::const_iterator it = _entries.begin();
+    for(; it != _entries.end(); it++) {
+        delete *it;
+    }
+    _entries.clear();
+}
+
+uint32_t M2MNotificationStore::memory_footprint() const
+{
+    uint32_t bytes = _entries.capacity() * sizeof(Entry*);
+    EntryList::const_iterator it = _entries.begin();
+    for(; it != _entries.end(); it++) {
+        bytes += sizeof(Entry) +
+                 (*it)->path.capacity() + 1 +
+                 (*it)->instance_ids.capacity() +
+                 (*it)->resource_ids.capacity();
+    }
+    return bytes;
+}
+
+M2MNotificationStore::Entry* M2MNotificationStore::find(const String &path,
+                                                        const M2MCompositeObservation *observation) const
+{
+    EntryList::const_iterator it = _entries.begin();
+    for(; it != _entries.end(); it++) {
+        if((*it)->composite == observation && (*it)->path == path) {
+            return *it;
+        }
+    }
+    return NULL;
+}
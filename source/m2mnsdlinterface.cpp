@@ -21,9 +21,16 @@
 #include "mbed-client/m2mobjectinstance.h"
 #include "mbed-client/m2mresource.h"
 #include "mbed-client/m2mconstants.h"
+#include "mbed-client/m2mallocator.h"
+#include "mbed-client/m2mstatistics.h"
+#include "mbed-client/m2mlatency.h"
 #include "include/m2mtlvserializer.h"
+#include "include/m2msenmlcbordeserializer.h"
+#include "include/m2msenmlcborserializer.h"
+#include "include/m2msamplebuffer.h"
+#include "include/m2mpath.h"
 #include "ip6string.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2mtrace.h"
 #include "source/libNsdl/src/include/sn_grs.h"
 #include "mbed-client/m2mtimer.h"
 
@@ -40,9 +47,13 @@ M2MNsdlInterface::M2MNsdlInterface(M2MNsdlObserver &observer)
   _register_id(0),
   _unregister_id(0),
   _update_id(0),
-  _bootstrap_id(0)
+  _bootstrap_id(0),
+  _request_arena(M2M_REQUEST_ARENA_SIZE),
+  _next_exchange(0),
+  _queue_sleeping(false)
 {
     tr_debug("M2MNsdlInterface::M2MNsdlInterface()");
+    memset(_pending_exchanges, 0, sizeof(_pending_exchanges));
     _endpoint = NULL;
     _resource = NULL;
     __nsdl_interface = this;
@@ -95,6 +106,12 @@ M2MNsdlInterface::~M2MNsdlInterface()
     delete _registration_timer;
     _object_list.clear();
 
+    M2MCompositeObservationList::const_iterator it = _composite_observations.begin();
+    for(; it != _composite_observations.end(); it++) {
+        delete *it;
+    }
+    _composite_observations.clear();
+
     if(_server){
         delete _server;
         _server = NULL;
@@ -187,7 +204,7 @@ void M2MNsdlInterface::delete_endpoint()
     tr_debug("M2MNsdlInterface::delete_endpoint()");
     if(_endpoint) {
         if(_endpoint->lifetime_ptr) {
-            free(_endpoint->lifetime_ptr);
+            memory_free(_endpoint->lifetime_ptr);
             _endpoint->lifetime_ptr = NULL;
         }
         memory_free(_endpoint);
@@ -209,6 +226,7 @@ bool M2MNsdlInterface::create_nsdl_list_structure(const M2MObjectList &object_li
             add_object_to_list(*it);
         }
     }
+    update_heap_statistics();
     return success;
 }
 
@@ -313,6 +331,9 @@ bool M2MNsdlInterface::send_update_registration(const uint32_t lifetime)
             success = _update_id != 0;
         }
     }
+    if(success) {
+        M2MStatistics::registration_update_sent();
+    }
     return success;
 }
 
@@ -330,18 +351,77 @@ bool M2MNsdlInterface::send_unregister_message()
     return success;
 }
 
+M2MInterface::Error M2MNsdlInterface::send_data(const M2MPathList &paths)
+{
+    tr_debug("M2MNsdlInterface::send_data()");
+    if(!_server || !_nsdl_handle) {
+        return M2MInterface::NotRegistered;
+    }
+    if(paths.empty()) {
+        return M2MInterface::InvalidParameters;
+    }
+
+    M2MSenMLCBORSerializer serializer;
+    if(!serialize_paths(paths, serializer, false)) {
+        return M2MInterface::InvalidParameters;
+    }
+
+    uint32_t length = 0;
+    uint8_t *payload = serializer.serialize(length);
+    if(!payload) {
+        return M2MInterface::MemoryFail;
+    }
+    M2MInterface::Error error = send_payload(payload, length);
+    free(payload);
+    return error;
+}
+
+M2MInterface::Error M2MNsdlInterface::send_payload(uint8_t *payload, uint32_t length)
+{
+    M2MInterface::Error error = M2MInterface::MemoryFail;
+    sn_coap_hdr_s *send_message_ptr = (sn_coap_hdr_s *)memory_alloc(sizeof(sn_coap_hdr_s));
+    if(send_message_ptr) {
+        memset(send_message_ptr, 0, sizeof(sn_coap_hdr_s));
+        send_message_ptr->msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+        send_message_ptr->msg_code = COAP_MSG_CODE_REQUEST_POST;
+
+        send_message_ptr->uri_path_len = strlen(SEND_PATH);
+        send_message_ptr->uri_path_ptr = (uint8_t *)SEND_PATH;
+
+        send_message_ptr->payload_len = length;
+        send_message_ptr->payload_ptr = payload;
+
+        send_message_ptr->content_type_ptr =
+                m2m::String::convert_integer_to_array(COAP_CONTENT_OMA_SENML_CBOR_TYPE,
+                                                      send_message_ptr->content_type_len);
+
+        error = (sn_nsdl_send_coap_message(_nsdl_handle,
+                                           _nsdl_handle->nsp_address_ptr->omalw_address_ptr,
+                                           send_message_ptr) == 0) ?
+                M2MInterface::ErrorNone : M2MInterface::NetworkError;
+
+        send_message_ptr->uri_path_ptr = NULL;
+        send_message_ptr->payload_ptr = NULL;
+        if(send_message_ptr->content_type_ptr) {
+            free(send_message_ptr->content_type_ptr);
+        }
+        send_message_ptr->content_type_ptr = NULL;
+        sn_nsdl_release_allocated_coap_msg_mem(_nsdl_handle, send_message_ptr);
+    }
+    return error;
+}
+
 void *M2MNsdlInterface::memory_alloc(uint16_t size)
 {
-    if(size)
-        return malloc(size);
-    else
-        return 0;
+    return M2MAllocator::memory_alloc(size);
 }
 
 void M2MNsdlInterface::memory_free(void *ptr)
 {
-    if(ptr)
-        free(ptr);
+    // Response memory from the request arena is released with reset()
+    if(!_request_arena.contains(ptr)) {
+        M2MAllocator::memory_free(ptr);
+    }
 }
 
 uint8_t M2MNsdlInterface::send_to_server_callback(struct nsdl_s * /*nsdl_handle*/,
@@ -351,6 +431,9 @@ uint8_t M2MNsdlInterface::send_to_server_callback(struct nsdl_s * /*nsdl_handle*
                                                   sn_nsdl_addr_s *address)
 {
     tr_debug("M2MNsdlInterface::send_to_server_callback()");
+    M2MStatistics::message_sent(data_ptr, data_len);
+    M2MLatency::message_sent(data_ptr, data_len);
+    exchange_started(data_ptr, data_len);
     _observer.coap_message_ready(data_ptr,data_len,address);
     return 1;
 }
@@ -363,6 +446,16 @@ uint8_t M2MNsdlInterface::received_from_server_callback(struct nsdl_s * /*nsdl_h
     _observer.coap_data_processed();
     uint8_t value = 0;
     if(coap_header) {
+        if(COAP_MSG_TYPE_ACKNOWLEDGEMENT == coap_header->msg_type) {
+            M2MLatency::message_acknowledged(coap_header->msg_id);
+        }
+        // An exchange ends with its ACK or RST, or when its
+        // retransmissions have run out.
+        if(COAP_MSG_TYPE_ACKNOWLEDGEMENT == coap_header->msg_type ||
+           COAP_MSG_TYPE_RESET == coap_header->msg_type ||
+           COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED == coap_header->coap_status) {
+            exchange_completed(coap_header->msg_id);
+        }
         if(coap_header->msg_id == _register_id || _register_id == -1) {
             _register_id = 0;
             if(coap_header->msg_code == COAP_MSG_CODE_RESPONSE_CREATED) {
@@ -375,6 +468,10 @@ uint8_t M2MNsdlInterface::received_from_server_callback(struct nsdl_s * /*nsdl_h
                 _server->set_resource_value(M2MServer::ShortServerID,1);
 
                 _observer.client_registered(_server);
+                // The held notifications belong to the observations of the
+                // previous registration, their tokens are no longer valid.
+                _queue_sleeping = false;
+                _notification_store.clear();
                 // If lifetime is less than zero then leave the field empty
                 if(coap_header->options_list_ptr) {
                     if(coap_header->options_list_ptr->max_age_ptr) {
@@ -450,7 +547,9 @@ uint8_t M2MNsdlInterface::received_from_server_callback(struct nsdl_s * /*nsdl_h
 
             if(coap_header->msg_code == COAP_MSG_CODE_RESPONSE_CHANGED) {
                 tr_debug("M2MNsdlInterface::received_from_server_callback - registration_updated successfully");
+                M2MStatistics::registration_update_completed();
                 _observer.registration_updated(*_server);
+                flush_notification_store();
             } else {
                 tr_error("M2MNsdlInterface::received_from_server_callback - registration_updated failed %d", coap_header->msg_code);                
                 _register_id = -1;
@@ -466,61 +565,58 @@ uint8_t M2MNsdlInterface::received_from_server_callback(struct nsdl_s * /*nsdl_h
             }
         }
 #endif //YOTTA_CFG_DISABLE_BOOTSTRAP_FEATURE
+        else if(COAP_REQUEST_FETCH == coap_header->msg_code) {
+            // Composite operations address the root, which has no resource.
+            M2MLatency::request_started(coap_header->msg_code);
+            value = handle_composite_request(coap_header, address);
+            M2MLatency::request_finished();
+        }
         else {
             if(COAP_MSG_CODE_REQUEST_POST == coap_header->msg_code) {
+                M2MLatency::request_started(coap_header->msg_code);
                 if(coap_header->uri_path_ptr) {
                     bool execute_value_updated = false;
                     M2MObjectInstance *obj_instance = NULL;
-                    String resource_name = coap_to_string(coap_header->uri_path_ptr,
-                                                          coap_header->uri_path_len);
+                    M2MPath path;
 
                     sn_coap_hdr_s *coap_response = NULL;
-                    String object_name;
-                    int slash_found = resource_name.find_last_of('/');
                     //The POST operation here is only allowed for non-existing object instances
-                    if(slash_found != -1) {
-                        object_name = resource_name.substr(0,slash_found);
-                        if( object_name.find_last_of('/') != -1){
-                            coap_response = sn_nsdl_build_response(_nsdl_handle,
-                                                                   coap_header,
-                                                                   COAP_MSG_CODE_RESPONSE_NOT_FOUND);
-                        } else {
-                            int32_t instance_id = atoi(resource_name.substr(slash_found+1,
-                                                     resource_name.size()-object_name.size()).c_str());
-                            M2MBase* base = find_resource(object_name);
-                            if(base && (instance_id >= 0) && (instance_id < 65535)) {
-                                if(coap_header->payload_ptr) {
-                                    M2MObject* object = (M2MObject*)base;
-                                    obj_instance = object->create_object_instance(instance_id);
-                                    if(obj_instance) {
-                                        obj_instance->set_operation(M2MBase::GET_PUT_POST_ALLOWED);                                        
-                                        coap_response = obj_instance->handle_post_request(_nsdl_handle,
-                                                                                          coap_header,
-                                                                                          this,
-                                                                                          execute_value_updated);
-                                    }
-                                    if(coap_response && coap_response->msg_code != COAP_MSG_CODE_RESPONSE_CREATED) {
-                                        //Invalid request so remove created ObjectInstance
-                                        object->remove_object_instance(instance_id);
-                                    } else  {
-                                        tr_debug("M2MNsdlInterface::received_from_server_callback - Send Update registration for Create");
-                                        send_update_registration();
-                                    }
-                                } else {
-                                    tr_debug("M2MNsdlInterface::received_from_server_callback - Missing Payload - Cannot create");
-                                    coap_response = sn_nsdl_build_response(_nsdl_handle,
-                                                                           coap_header,
-                                                                           COAP_MSG_CODE_RESPONSE_BAD_REQUEST);
+                    if(path.parse(coap_header->uri_path_ptr, coap_header->uri_path_len) &&
+                       path.depth() == 2) {
+                        int32_t instance_id = path.id(1);
+                        M2MBase* base = find_resource(path, 1);
+                        if(base && (instance_id >= 0) && (instance_id < 65535)) {
+                            if(coap_header->payload_ptr) {
+                                M2MObject* object = (M2MObject*)base;
+                                obj_instance = object->create_object_instance(instance_id);
+                                if(obj_instance) {
+                                    obj_instance->set_operation(M2MBase::GET_PUT_POST_ALLOWED);                                        
+                                    coap_response = obj_instance->handle_post_request(_nsdl_handle,
+                                                                                      coap_header,
+                                                                                      this,
+                                                                                      execute_value_updated);
                                 }
-                            } else { //if(base)
-                                tr_debug("M2MNsdlInterface::received_from_server_callback - Missing BASE - Cannot create");
+                                if(coap_response && coap_response->msg_code != COAP_MSG_CODE_RESPONSE_CREATED) {
+                                    //Invalid request so remove created ObjectInstance
+                                    object->remove_object_instance(instance_id);
+                                } else  {
+                                    tr_debug("M2MNsdlInterface::received_from_server_callback - Send Update registration for Create");
+                                    send_update_registration();
+                                }
+                            } else {
+                                tr_debug("M2MNsdlInterface::received_from_server_callback - Missing Payload - Cannot create");
                                 coap_response = sn_nsdl_build_response(_nsdl_handle,
                                                                        coap_header,
-                                                                       COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED);
+                                                                       COAP_MSG_CODE_RESPONSE_BAD_REQUEST);
                             }
+                        } else { //if(base)
+                            tr_debug("M2MNsdlInterface::received_from_server_callback - Missing BASE - Cannot create");
+                            coap_response = sn_nsdl_build_response(_nsdl_handle,
+                                                                   coap_header,
+                                                                   COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED);
                         }
-                    } else{ // if(slash_found != -1)
-                        tr_debug("M2MNsdlInterface::received_from_server_callback - slash_found - Cannot create");
+                    } else {
+                        tr_debug("M2MNsdlInterface::received_from_server_callback - Invalid path - Cannot create");
                         coap_response = sn_nsdl_build_response(_nsdl_handle,
                                                                coap_header,
                                                                COAP_MSG_CODE_RESPONSE_NOT_FOUND);
@@ -533,7 +629,9 @@ uint8_t M2MNsdlInterface::received_from_server_callback(struct nsdl_s * /*nsdl_h
                     if (execute_value_updated) {
                         value_updated(obj_instance, obj_instance->name());
                     }
+                    _request_arena.reset();
                 }
+                M2MLatency::request_finished();
             }
         }
     }
@@ -547,16 +645,19 @@ uint8_t M2MNsdlInterface::resource_callback(struct nsdl_s */*nsdl_handle*/,
 {
     tr_debug("M2MNsdlInterface::resource_callback()");
     _observer.coap_data_processed();
+    M2MLatency::request_started(received_coap_header->msg_code);
     uint8_t result = 1;
     sn_coap_hdr_s *coap_response = NULL;
     sn_coap_msg_code_e msg_code = COAP_MSG_CODE_RESPONSE_CHANGED; // 4.00
-    String resource_name = coap_to_string(received_coap_header->uri_path_ptr,
-                                          received_coap_header->uri_path_len);
-    tr_debug("M2MNsdlInterface::resource_callback() - resource_name %s", resource_name.c_str());
+    tr_debug("M2MNsdlInterface::resource_callback() - resource_name %.*s",
+             (int)received_coap_header->uri_path_len, received_coap_header->uri_path_ptr);
     bool execute_value_updated = false;
-    M2MBase* base = find_resource(resource_name);
+    M2MPath path;
+    M2MBase* base = NULL;
+    if(path.parse(received_coap_header->uri_path_ptr, received_coap_header->uri_path_len)) {
+        base = find_resource(path, path.depth());
+    }
     if(base) {
-        base->set_uri_path(resource_name);
         if(COAP_MSG_CODE_REQUEST_GET == received_coap_header->msg_code) {
             coap_response = base->handle_get_request(_nsdl_handle, received_coap_header,this);
         } else if(COAP_MSG_CODE_REQUEST_PUT == received_coap_header->msg_code) {            
@@ -572,21 +673,11 @@ uint8_t M2MNsdlInterface::resource_callback(struct nsdl_s */*nsdl_handle*/,
             tr_debug("M2MNsdlInterface::resource_callback() - DELETE the object instance");
             M2MBase::BaseType type = base->base_type();
             if(M2MBase::ObjectInstance == type) {
-                M2MBase* base_object = find_resource(base->name());
-                if(base_object) {
-                    M2MObject *object = (M2MObject*)base_object;
-                    int slash_found = resource_name.find_last_of('/');
-                    // Object instance validty checks done in upper level, no need for error handling
-                    if(slash_found != -1) {
-                        String object_name;
-                        object_name = resource_name.substr(slash_found + 1, resource_name.length());
-                        if (object->remove_object_instance(strtoul(
-                                object_name.c_str(),
-                                NULL,
-                                10))) {
-                            msg_code = COAP_MSG_CODE_RESPONSE_DELETED;
-                        }
-                    }
+                M2MObject *object = (M2MObject*)find_resource(path, 1);
+                // Object instance validty checks done in upper level, no need for error handling
+                if(object && object->remove_object_instance(path.id(1))) {
+                    msg_code = COAP_MSG_CODE_RESPONSE_DELETED;
+                    base = NULL;
                 }
             } else {
                 msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST; // 4.00
@@ -610,6 +701,12 @@ uint8_t M2MNsdlInterface::resource_callback(struct nsdl_s */*nsdl_handle*/,
             }
             base->set_under_observation(false, this);
         }
+        // The path is stored only when it is needed later: notifications
+        // of an observed node carry it and value_updated() uses it.
+        if(base && base->uri_path().empty() &&
+           (execute_value_updated || M2MBase::None != base->observation_level())) {
+            base->set_uri_path(path.to_string(path.depth()));
+        }
     } else  {
         tr_debug("M2MNsdlInterface::resource_callback() - Resource NOT FOUND");
         msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST; // 4.00
@@ -624,7 +721,7 @@ uint8_t M2MNsdlInterface::resource_callback(struct nsdl_s */*nsdl_handle*/,
         tr_debug("M2MNsdlInterface::resource_callback() - send CoAP response");
         (sn_nsdl_send_coap_message(_nsdl_handle, address, coap_response) == 0) ? result = 0 : result = 1;
         if(coap_response->payload_ptr) {
-            free(coap_response->payload_ptr);
+            memory_free(coap_response->payload_ptr);
             coap_response->payload_ptr = NULL;
         }
         sn_nsdl_release_allocated_coap_msg_mem(_nsdl_handle, coap_response);
@@ -632,6 +729,8 @@ uint8_t M2MNsdlInterface::resource_callback(struct nsdl_s */*nsdl_handle*/,
     if (execute_value_updated) {
         value_updated(base,base->uri_path());
     }
+    _request_arena.reset();
+    M2MLatency::request_finished();
     return result;
 }
 
@@ -750,6 +849,7 @@ bool M2MNsdlInterface::process_received_data(uint8_t *data,
                                              sn_nsdl_addr_s *address)
 {
     tr_debug("M2MNsdlInterface::process_received_data( data size %d)", data_size);
+    M2MStatistics::message_received(data_size);
     return (0 == sn_nsdl_process_coap(_nsdl_handle,
                                       data,
                                       data_size,
@@ -764,6 +864,25 @@ void M2MNsdlInterface::stop_timers()
     }
 }
 
+void M2MNsdlInterface::queue_mode_sleep()
+{
+    tr_debug("M2MNsdlInterface::queue_mode_sleep()");
+    _queue_sleeping = true;
+    // Nothing more is received for the exchanges left open.
+    memset(_pending_exchanges, 0, sizeof(_pending_exchanges));
+}
+
+uint8_t M2MNsdlInterface::pending_exchanges() const
+{
+    uint8_t count = 0;
+    for(uint8_t i = 0; i < MAX_PENDING_EXCHANGES; i++) {
+        if(_pending_exchanges[i].pending) {
+            count++;
+        }
+    }
+    return count;
+}
+
 void M2MNsdlInterface::timer_expired(M2MTimerObserver::Type type)
 {
     if(M2MTimerObserver::NsdlExecution == type) {
@@ -777,19 +896,34 @@ void M2MNsdlInterface::timer_expired(M2MTimerObserver::Type type)
 
 void M2MNsdlInterface::observation_to_be_sent(M2MBase *object,
                                               uint16_t obs_number,
-                                              m2m::Vector<uint16_t> changed_instance_ids,
-                                              bool send_object)
+                                              const m2m::IdSet &changed_instance_ids,
+                                              bool send_object,
+                                              const m2m::IdSet *changed_resource_ids)
 {
     tr_debug("M2MNsdlInterface::observation_to_be_sent(), %s", object->uri_path().c_str());
-    if(object) {
+    if(object && _queue_sleeping) {
+        _notification_store.store(object->uri_path(),
+                                  obs_number,
+                                  changed_instance_ids,
+                                  send_object,
+                                  changed_resource_ids);
+    } else if(object) {
+        // Only the changed resources are sent if the application enabled
+        // delta notifications on the node and the changes are known.
+        const m2m::IdSet *resource_ids = NULL;
+        if(object->delta_notification() && !send_object) {
+            resource_ids = changed_resource_ids;
+        }
         M2MBase::BaseType type = object->base_type();
         if(type == M2MBase::Object) {
             send_object_observation((M2MObject*)object,
                                     obs_number,
                                     changed_instance_ids,
-                                    send_object);
+                                    send_object,
+                                    resource_ids);
         } else if(type == M2MBase::ObjectInstance) {
-            send_object_instance_observation((M2MObjectInstance*)object, obs_number);
+            send_object_instance_observation((M2MObjectInstance*)object, obs_number,
+                                             resource_ids);
         } else if(type == M2MBase::Resource) {
             send_resource_observation((M2MResource*)object, obs_number);
         }
@@ -834,6 +968,11 @@ void M2MNsdlInterface::send_delayed_response(M2MBase *base)
     }
 }
 
+M2MAllocator* M2MNsdlInterface::request_allocator()
+{
+    return &_request_arena;
+}
+
 void M2MNsdlInterface::resource_to_be_deleted(const String &resource_name)
 {
     tr_debug("M2MNsdlInterface::resource_to_be_deleted(resource_name %s)", resource_name.c_str());
@@ -1122,6 +1261,21 @@ bool M2MNsdlInterface::create_nsdl_resource(M2MBase *base, const String &name, b
                base->set_under_observation(false,this);
             }
         }
+        // A node created later under a path of a composite observation
+        // is reported through it as well.
+        if(success && (M2MBase::Resource == base->base_type() ||
+                       M2MBase::ResourceInstance == base->base_type())) {
+            M2MCompositeObservationList::const_iterator it = _composite_observations.begin();
+            for(; it != _composite_observations.end(); it++) {
+                if((*it)->is_member(name)) {
+                    if(base->uri_path().empty()) {
+                        base->set_uri_path(name);
+                    }
+                    base->set_composite_observation(true, this);
+                    break;
+                }
+            }
+        }
     }
     if(buffer) {
         free(buffer);
@@ -1129,19 +1283,6 @@ bool M2MNsdlInterface::create_nsdl_resource(M2MBase *base, const String &name, b
     return success;
 }
 
-// convenience method to get the URI from its buffer field...
-String M2MNsdlInterface::coap_to_string(uint8_t *coap_data,int coap_data_length)
-{
-    String value = "";
-    if (coap_data != NULL && coap_data_length > 0) {
-        char buf[256+1];
-        memset(buf,0,256+1);
-        memcpy(buf,(char *)coap_data,coap_data_length);
-        value = String(buf);
-    }
-    return value;
-}
-
 uint64_t M2MNsdlInterface::registration_time()
 {
     uint64_t value = 0;
@@ -1160,132 +1301,76 @@ uint64_t M2MNsdlInterface::registration_time()
 
 M2MBase* M2MNsdlInterface::find_resource(const String &object_name)
 {
-    M2MBase *object = NULL;
-    if(!_object_list.empty()) {
-        M2MObjectList::const_iterator it;
-        it = _object_list.begin();
-        for ( ; it != _object_list.end(); it++ ) {
-            if((*it)->name() == object_name) {
-                object = (*it);
-                tr_debug("M2MNsdlInterface::find_resource(%s) found", object_name.c_str());
-                break;
-            }
-            object = find_resource((*it),object_name);
-            if(object != NULL) {
-                tr_debug("M2MNsdlInterface::find_resource(%s) found", object_name.c_str());
-                break;
-            }
-        }
+    M2MPath path;
+    M2MBase *base = NULL;
+    if(path.parse(object_name)) {
+        base = find_resource(path, path.depth());
     }
-    return object;
+    return base;
 }
 
-M2MBase* M2MNsdlInterface::find_resource(const M2MObject *object,
-                                         const String &object_instance)
+M2MBase* M2MNsdlInterface::find_resource(const M2MPath &path, uint8_t depth)
 {
-    M2MBase *instance = NULL;
-    if(object) {
-        M2MObjectInstanceList list = object->instances();
-        if(!list.empty()) {
-            M2MObjectInstanceList::const_iterator it;
-            it = list.begin();
-            for ( ; it != list.end(); it++ ) {
-                char *inst_id = (char*)memory_alloc(BUFFER_SIZE);
-                snprintf(inst_id, BUFFER_SIZE,"%d",(*it)->instance_id());
-
-                // Append object instance id to the object name.
-                String name = (*it)->name();
-                name+= String("/");
-                name+= String(inst_id);
-
-                memory_free(inst_id);
-
-                if(name == object_instance){
-                    instance = (*it);
-                    break;
-                }
-                instance = find_resource((*it),object_instance);
-                if(instance != NULL){
-                    break;
-                }
-            }
-        }
+    if(depth == 0 || depth > path.depth()) {
+        return NULL;
+    }
+    int32_t instance_id = path.id(1);
+    int32_t resource_id = path.id(2);
+    int32_t resource_instance_id = path.id(3);
+    if((depth > 1 && instance_id < 0) || (depth > 3 && resource_instance_id < 0)) {
+        return NULL;
     }
-    return instance;
-}
-
-M2MBase* M2MNsdlInterface::find_resource(const M2MObjectInstance *object_instance,
-                                         const String &resource_instance)
-{
-    M2MBase *instance = NULL;
-    if(object_instance) {
-        M2MResourceList list = object_instance->resources();
-        if(!list.empty()) {
-            M2MResourceList::const_iterator it;
-            it = list.begin();
-            for ( ; it != list.end(); it++ ) {
-                String name = object_instance->name();
-                char *obj_inst_id = (char*)memory_alloc(BUFFER_SIZE);
-                snprintf(obj_inst_id, BUFFER_SIZE,"%d",object_instance->instance_id());
-
-                // Append object instance id to the object name.
-                name+= String("/");
-                name+= String(obj_inst_id);
-
-                memory_free(obj_inst_id);
-
-                name+= String("/");
-                name+= (*it)->name();
 
-                if(name == resource_instance) {
-                    instance = *it;
+    M2MObjectList::const_iterator it = _object_list.begin();
+    for ( ; it != _object_list.end(); it++ ) {
+        if(!path.equals(0, (*it)->name())) {
+            continue;
+        }
+        if(depth == 1) {
+            return *it;
+        }
+        M2MObjectInstance *instance = (*it)->object_instance(instance_id);
+        if(instance == NULL) {
+            continue;
+        }
+        if(depth == 2) {
+            return instance;
+        }
+        M2MResource *resource = NULL;
+        if(resource_id >= 0) {
+            resource = instance->resource_by_id((uint16_t)resource_id);
+        } else {
+            // Non-numeric resource names are not indexed.
+            const M2MResourceList &list = instance->resources();
+            M2MResourceList::const_iterator res = list.begin();
+            for ( ; res != list.end(); res++ ) {
+                if(path.equals(2, (*res)->name())) {
+                    resource = *res;
                     break;
-                } else if((*it)->supports_multiple_instances()) {
-                    instance = find_resource((*it),name, resource_instance);
-                    if(instance != NULL){
-                        break;
-                    }
                 }
             }
         }
+        if(resource == NULL || depth == 3) {
+            return resource;
+        }
+        if(resource->supports_multiple_instances()) {
+            return resource->resource_instance(resource_instance_id);
+        }
+        return NULL;
     }
-    return instance;
+    return NULL;
 }
 
-M2MBase* M2MNsdlInterface::find_resource(const M2MResource *resource,
-                                         const String &object_name,
-                                         const String &resource_instance)
+M2MObject* M2MNsdlInterface::object(uint16_t object_id) const
 {
-    M2MBase *res = NULL;
-    if(resource) {
-        if(resource->supports_multiple_instances()) {
-            M2MResourceInstanceList list = resource->resource_instances();
-            if(!list.empty()) {
-                M2MResourceInstanceList::const_iterator it;
-                it = list.begin();
-                for ( ; it != list.end(); it++ ) {
-                    String name = object_name;
-                    // if there are multiple instances supported
-                    // then add instance Id into creating resource path
-                    // else normal /object_id/object_instance/resource_id format.
-
-                    char *inst_id = (char*)memory_alloc(BUFFER_SIZE);
-                    snprintf(inst_id, BUFFER_SIZE,"%d",(*it)->instance_id());
-
-                    name+= String("/") ;
-                    name+= String(inst_id);
-
-                    memory_free(inst_id);
-
-                    if(name == resource_instance){
-                        res = (*it);
-                        break;
-                    }
-                }
-            }
+    // Registered objects are few, a scan of the name IDs is enough.
+    M2MObjectList::const_iterator it = _object_list.begin();
+    for ( ; it != _object_list.end(); it++ ) {
+        if((*it)->name_id() == object_id) {
+            return *it;
         }
     }
-    return res;
+    return NULL;
 }
 
 bool M2MNsdlInterface::object_present(M2MObject* object) const
@@ -1365,8 +1450,9 @@ M2MInterface::Error M2MNsdlInterface::interface_error(sn_coap_hdr_s *coap_header
 
 void M2MNsdlInterface::send_object_observation(M2MObject *object,
                                                uint16_t obs_number,
-                                               m2m::Vector<uint16_t> changed_instance_ids,
-                                               bool send_object)
+                                               const m2m::IdSet &changed_instance_ids,
+                                               bool send_object,
+                                               const m2m::IdSet *resource_ids)
 {
     tr_debug("M2MNsdlInterface::send_object_observation");
     if(object) {
@@ -1384,15 +1470,17 @@ void M2MNsdlInterface::send_object_observation(M2MObject *object,
             // Send only change object instances
             else {
                 M2MObjectInstanceList list;
-                Vector<uint16_t>::const_iterator it;
-                it = changed_instance_ids.begin();
-                for (; it != changed_instance_ids.end(); it++){
-                    M2MObjectInstance* obj_instance = object->object_instance(*it);
+                int32_t id = changed_instance_ids.first();
+                for (; id != -1; id = changed_instance_ids.next(id)){
+                    M2MObjectInstance* obj_instance = object->object_instance(id);
                     if (obj_instance){
                         list.push_back(obj_instance);
                     }
                 }
-                if (!list.empty()) {
+                if (!list.empty() && resource_ids) {
+                    value = serializer->serialize(list, *resource_ids, length);
+                    list.clear();
+                } else if (!list.empty()) {
                     value = serializer->serialize(list, length);
                     list.clear();
                 }
@@ -1417,7 +1505,8 @@ void M2MNsdlInterface::send_object_observation(M2MObject *object,
 }
 
 void M2MNsdlInterface::send_object_instance_observation(M2MObjectInstance *object_instance,
-                                                        uint16_t obs_number)
+                                                        uint16_t obs_number,
+                                                        const m2m::IdSet *resource_ids)
 {
     tr_debug("M2MNsdlInterface::send_object_instance_observation");
     if(object_instance) {
@@ -1428,7 +1517,11 @@ void M2MNsdlInterface::send_object_instance_observation(M2MObjectInstance *objec
 
         M2MTLVSerializer *serializer = new M2MTLVSerializer();
         if(serializer) {
-            value = serializer->serialize(object_instance->resources(), length);
+            if(resource_ids) {
+                value = serializer->serialize(object_instance->resources(), *resource_ids, length);
+            } else {
+                value = serializer->serialize(object_instance->resources(), length);
+            }
             delete serializer;
         }
 
@@ -1501,7 +1594,7 @@ void M2MNsdlInterface::build_observation_number(uint8_t *obs_number,
     }
 }
 
-void M2MNsdlInterface::send_notification(uint8_t *token,
+bool M2MNsdlInterface::send_notification(uint8_t *token,
                                          uint8_t  token_length,
                                          uint8_t *value,
                                          uint32_t value_length,
@@ -1513,6 +1606,7 @@ void M2MNsdlInterface::send_notification(uint8_t *token,
 {
     tr_debug("M2MNsdlInterface::send_notification");
     sn_coap_hdr_s *notification_message_ptr;
+    bool sent = false;
 
     /* Allocate and initialize memory for header struct */
     notification_message_ptr = (sn_coap_hdr_s *)memory_alloc(sizeof(sn_coap_hdr_s));
@@ -1559,9 +1653,14 @@ void M2MNsdlInterface::send_notification(uint8_t *token,
                                                           notification_message_ptr->content_type_len);
 
             /* Send message */
-            sn_nsdl_send_coap_message(_nsdl_handle,
-                                      _nsdl_handle->nsp_address_ptr->omalw_address_ptr,
-                                      notification_message_ptr);
+            M2MLatency::notification_sending(true);
+            if(sn_nsdl_send_coap_message(_nsdl_handle,
+                                         _nsdl_handle->nsp_address_ptr->omalw_address_ptr,
+                                         notification_message_ptr) == 0) {
+                M2MStatistics::increment(M2MStatistics::NotificationsSent);
+                sent = true;
+            }
+            M2MLatency::notification_sending(false);
 
             /* Free memory */
             notification_message_ptr->uri_path_ptr = NULL;
@@ -1579,4 +1678,428 @@ void M2MNsdlInterface::send_notification(uint8_t *token,
         }
         sn_nsdl_release_allocated_coap_msg_mem(_nsdl_handle, notification_message_ptr);
     }
+    if(!sent) {
+        M2MStatistics::increment(M2MStatistics::NotificationsDropped);
+    }
+    return sent;
+}
+
+bool M2MNsdlInterface::serialize_paths(const M2MPathList &paths,
+                                       M2MSenMLCBORSerializer &serializer,
+                                       bool skip_missing)
+{
+    M2MPathList::const_iterator it = paths.begin();
+    for (; it != paths.end(); it++) {
+        // Accept both "3/0/9" and "/3/0/9".
+        const char *path_ptr = it->c_str();
+        uint16_t path_len = it->size();
+        if(path_len > 0 && *path_ptr == '/') {
+            path_ptr++;
+            path_len--;
+        }
+        M2MPath path;
+        M2MObject *object = NULL;
+        M2MBase *base = NULL;
+        if(path.parse((const uint8_t*)path_ptr, path_len)) {
+            object = (M2MObject*)find_resource(path, 1);
+            base = object ? find_resource(path, path.depth()) : NULL;
+        }
+        bool appended = false;
+        if(base) {
+            // find_resource() has already checked the numeric instance IDs.
+            switch(path.depth()) {
+                case 1:
+                    appended = serializer.append(object);
+                    break;
+                case 2:
+                    appended = serializer.append(object->name(), (M2MObjectInstance*)base);
+                    break;
+                case 3:
+                    appended = serializer.append(object->name(), path.id(1), (M2MResource*)base);
+                    break;
+                default:
+                    appended = serializer.append(object->name(), path.id(1),
+                                                 (M2MResourceInstance*)base);
+                    break;
+            }
+        }
+        if(!appended && !(skip_missing && !base)) {
+            tr_error("M2MNsdlInterface::serialize_paths - invalid path %s", it->c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+uint8_t M2MNsdlInterface::handle_composite_request(sn_coap_hdr_s *coap_header,
+                                                   sn_nsdl_addr_s *address)
+{
+    tr_debug("M2MNsdlInterface::handle_composite_request()");
+    sn_coap_msg_code_e msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
+    M2MPathList paths;
+    uint8_t *payload = NULL;
+    uint32_t length = 0;
+    if(coap_header->uri_path_len > 1 ||
+       (coap_header->uri_path_len == 1 && *coap_header->uri_path_ptr != '/')) {
+        // FETCH of a single object or resource is not supported.
+        msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
+    } else if(coap_header->content_type_ptr &&
+              m2m::String::convert_array_to_integer(coap_header->content_type_ptr,
+                                                    coap_header->content_type_len) !=
+              COAP_CONTENT_OMA_SENML_CBOR_TYPE) {
+        msg_code = COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT;
+    } else {
+        M2MSenMLCBORDeserializer deserializer;
+        M2MSenMLCBORSerializer serializer;
+        if(!deserializer.deserialize_paths(coap_header->payload_ptr,
+                                           coap_header->payload_len,
+                                           paths)) {
+            msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+        } else if(!serialize_paths(paths, serializer, false)) {
+            msg_code = COAP_MSG_CODE_RESPONSE_NOT_FOUND;
+        } else {
+            payload = serializer.serialize(length);
+            if(!payload) {
+                msg_code = COAP_MSG_CODE_RESPONSE_INTERNAL_SERVER_ERROR;
+            }
+        }
+    }
+
+    bool observation_started = false;
+    if(payload && coap_header->options_list_ptr &&
+       coap_header->options_list_ptr->observe) {
+        uint32_t number = 0;
+        for(uint8_t i = 0; i < coap_header->options_list_ptr->observe_len; i++) {
+            number = (number << 8) | coap_header->options_list_ptr->observe_ptr[i];
+        }
+        if(START_OBSERVATION == number) {
+            observation_started = start_composite_observation(coap_header, paths);
+            if(!observation_started) {
+                msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+                free(payload);
+                payload = NULL;
+                length = 0;
+            }
+        } else if(STOP_OBSERVATION == number) {
+            cancel_composite_observation(coap_header->token_ptr, coap_header->token_len);
+        }
+    }
+
+    uint8_t value = 0;
+    sn_coap_hdr_s *coap_response = sn_nsdl_build_response(_nsdl_handle,
+                                                          coap_header,
+                                                          msg_code);
+    if(coap_response) {
+        if(payload) {
+            coap_response->payload_ptr = payload;
+            coap_response->payload_len = length;
+            coap_response->content_type_ptr =
+                    m2m::String::convert_integer_to_array(COAP_CONTENT_OMA_SENML_CBOR_TYPE,
+                                                          coap_response->content_type_len);
+        }
+        uint8_t observation_number[2];
+        if(observation_started && !coap_response->options_list_ptr) {
+            coap_response->options_list_ptr =
+                    (sn_coap_options_list_s*)memory_alloc(sizeof(sn_coap_options_list_s));
+            if(coap_response->options_list_ptr) {
+                memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+                build_observation_number(observation_number,
+                                         &coap_response->options_list_ptr->observe_len,
+                                         _composite_observations.back()->observation_number());
+                coap_response->options_list_ptr->observe_ptr = observation_number;
+            }
+        }
+        (sn_nsdl_send_coap_message(_nsdl_handle, address, coap_response) == 0) ? value = 0 : value = 1;
+
+        coap_response->payload_ptr = NULL;
+        if(coap_response->content_type_ptr) {
+            free(coap_response->content_type_ptr);
+            coap_response->content_type_ptr = NULL;
+        }
+        if(coap_response->options_list_ptr) {
+            coap_response->options_list_ptr->observe_ptr = NULL;
+        }
+        sn_nsdl_release_allocated_coap_msg_mem(_nsdl_handle, coap_response);
+    }
+    free(payload);
+    return value;
+}
+
+bool M2MNsdlInterface::start_composite_observation(sn_coap_hdr_s *coap_header,
+                                                   const M2MPathList &paths)
+{
+    tr_debug("M2MNsdlInterface::start_composite_observation()");
+    // Observing again with the same token replaces the observation.
+    cancel_composite_observation(coap_header->token_ptr, coap_header->token_len);
+
+    M2MCompositeObservation *observation =
+            new M2MCompositeObservation(*this,
+                                        coap_header->token_ptr,
+                                        coap_header->token_len,
+                                        paths);
+    bool success = true;
+    if(coap_header->options_list_ptr->uri_query_ptr) {
+        uint16_t query_length = coap_header->options_list_ptr->uri_query_len;
+        char *query = (char*)malloc(query_length + 1);
+        success = false;
+        if(query) {
+            memcpy(query, coap_header->options_list_ptr->uri_query_ptr, query_length);
+            query[query_length] = '\0';
+            success = observation->set_notification_attributes(query);
+            free(query);
+        }
+    }
+    if(!success) {
+        tr_error("M2MNsdlInterface::start_composite_observation - invalid attributes");
+        delete observation;
+        return false;
+    }
+    _composite_observations.push_back(observation);
+    mark_composite_members(observation, true);
+    observation->set_under_observation(true);
+    return true;
+}
+
+void M2MNsdlInterface::cancel_composite_observation(const uint8_t *token,
+                                                    uint8_t token_length)
+{
+    M2MCompositeObservationList::const_iterator it = _composite_observations.begin();
+    int index = 0;
+    for(; it != _composite_observations.end(); it++, index++) {
+        if((*it)->has_token(token, token_length)) {
+            tr_debug("M2MNsdlInterface::cancel_composite_observation()");
+            M2MCompositeObservation *observation = *it;
+            _composite_observations.erase(index);
+            mark_composite_members(observation, false);
+            _notification_store.remove(observation);
+            delete observation;
+            // Resources shared with the other observations are marked again.
+            for(it = _composite_observations.begin(); it != _composite_observations.end(); it++) {
+                mark_composite_members(*it, true);
+            }
+            break;
+        }
+    }
+}
+
+void M2MNsdlInterface::mark_composite_members(M2MCompositeObservation *observation,
+                                              bool observed)
+{
+    const M2MPathList &paths = observation->paths();
+    M2MPathList::const_iterator it = paths.begin();
+    for(; it != paths.end(); it++) {
+        M2MBase *base = find_resource(*it);
+        if(base) {
+            String path = *it;
+            if(path.size() > 0 && path[0] == '/') {
+                path = path.substr(1, path.size() - 1);
+            }
+            mark_composite_member(base, path, observed);
+        }
+    }
+}
+
+void M2MNsdlInterface::mark_composite_member(M2MBase *base,
+                                             const String &path,
+                                             bool observed)
+{
+    char id[BUFFER_SIZE];
+    switch(base->base_type()) {
+        case M2MBase::Object: {
+            const M2MObjectInstanceList &list = ((M2MObject*)base)->instances();
+            M2MObjectInstanceList::const_iterator it = list.begin();
+            for(; it != list.end(); it++) {
+                snprintf(id, BUFFER_SIZE, "/%d", (*it)->instance_id());
+                String child = path;
+                child += id;
+                mark_composite_member(*it, child, observed);
+            }
+        }
+        break;
+        case M2MBase::ObjectInstance: {
+            const M2MResourceList &list = ((M2MObjectInstance*)base)->resources();
+            M2MResourceList::const_iterator it = list.begin();
+            for(; it != list.end(); it++) {
+                String child = path;
+                child += "/";
+                child += (*it)->name();
+                mark_composite_member(*it, child, observed);
+            }
+        }
+        break;
+        case M2MBase::Resource: {
+            M2MResource *resource = (M2MResource*)base;
+            if(resource->supports_multiple_instances()) {
+                const M2MResourceInstanceList &list = resource->resource_instances();
+                M2MResourceInstanceList::const_iterator it = list.begin();
+                for(; it != list.end(); it++) {
+                    snprintf(id, BUFFER_SIZE, "/%d", (*it)->instance_id());
+                    String child = path;
+                    child += id;
+                    mark_composite_member(*it, child, observed);
+                }
+            }
+        }
+        // fall through, the resource reports its own value changes too
+        case M2MBase::ResourceInstance:
+            // Membership is decided by the path when the value changes.
+            if(observed && base->uri_path().empty()) {
+                base->set_uri_path(path);
+            }
+            base->set_composite_observation(observed, this);
+        break;
+    }
+}
+
+void M2MNsdlInterface::composite_value_changed(M2MBase *base)
+{
+    tr_debug("M2MNsdlInterface::composite_value_changed()");
+    M2MCompositeObservationList::const_iterator it = _composite_observations.begin();
+    for(; it != _composite_observations.end(); it++) {
+        if((*it)->is_member(base->uri_path())) {
+            (*it)->value_changed();
+        }
+    }
+}
+
+void M2MNsdlInterface::composite_observation_to_be_sent(M2MCompositeObservation &observation)
+{
+    tr_debug("M2MNsdlInterface::composite_observation_to_be_sent()");
+    if(_queue_sleeping) {
+        _notification_store.store(&observation);
+        return;
+    }
+    // Paths removed since the observation started are left out.
+    M2MSenMLCBORSerializer serializer;
+    serialize_paths(observation.paths(), serializer, true);
+    uint32_t length = 0;
+    uint8_t *payload = serializer.serialize(length);
+    if(payload) {
+        send_notification((uint8_t*)observation.token(),
+                          observation.token_length(),
+                          payload,
+                          length,
+                          observation.next_observation_number(),
+                          0,
+                          COAP_CONTENT_OMA_SENML_CBOR_TYPE,
+                          String());
+        free(payload);
+    } else {
+        M2MStatistics::increment(M2MStatistics::NotificationsDropped);
+    }
+}
+
+bool M2MNsdlInterface::samples_to_be_sent(M2MBase *base,
+                                          uint16_t obs_number,
+                                          M2MSampleBuffer &samples)
+{
+    tr_debug("M2MNsdlInterface::samples_to_be_sent()");
+    // The samples stay in the buffer while sleeping in queue mode.
+    if(!base || !_server || !_nsdl_handle || _queue_sleeping) {
+        return false;
+    }
+    // A notification needs an observer, Send only the registration.
+    uint8_t *token = NULL;
+    uint32_t token_length = 0;
+    if(!samples.send()) {
+        if(!(base->observation_level() & M2MBase::R_Attribute)) {
+            return false;
+        }
+        base->get_observation_token(token, token_length);
+        if(!token) {
+            return false;
+        }
+    }
+
+    M2MResourceInstance *resource = (M2MResourceInstance*)base;
+    M2MSenMLCBORSerializer serializer;
+    serializer.append(resource->object_name(), resource->object_instance_id(),
+                      resource, samples, M2MStatistics::now());
+    uint32_t length = 0;
+    uint8_t *payload = serializer.serialize(length);
+    bool sent = false;
+    if(payload) {
+        if(samples.send()) {
+            sent = send_payload(payload, length) == M2MInterface::ErrorNone;
+        } else {
+            sent = send_notification(token,
+                                     token_length,
+                                     payload,
+                                     length,
+                                     obs_number,
+                                     base->max_age(),
+                                     COAP_CONTENT_OMA_SENML_CBOR_TYPE,
+                                     base->uri_path());
+        }
+        free(payload);
+    }
+    memory_free(token);
+    return sent;
+}
+
+void M2MNsdlInterface::exchange_started(const uint8_t *data, uint16_t length)
+{
+    // Only confirmable messages wait for an answer, see
+    // M2MStatistics::message_sent() for the header layout.
+    if(!data || length < 4 || ((data[0] >> 4) & 0x03) != 0) {
+        return;
+    }
+    uint16_t msg_id = (data[2] << 8) | data[3];
+    for(uint8_t i = 0; i < MAX_PENDING_EXCHANGES; i++) {
+        // A retransmission continues the same exchange.
+        if(_pending_exchanges[i].pending && _pending_exchanges[i].msg_id == msg_id) {
+            return;
+        }
+    }
+    PendingExchange &exchange = _pending_exchanges[_next_exchange];
+    exchange.msg_id = msg_id;
+    exchange.pending = true;
+    _next_exchange = (_next_exchange + 1) % MAX_PENDING_EXCHANGES;
+}
+
+void M2MNsdlInterface::exchange_completed(uint16_t msg_id)
+{
+    for(uint8_t i = 0; i < MAX_PENDING_EXCHANGES; i++) {
+        if(_pending_exchanges[i].pending && _pending_exchanges[i].msg_id == msg_id) {
+            _pending_exchanges[i].pending = false;
+            return;
+        }
+    }
+}
+
+void M2MNsdlInterface::flush_notification_store()
+{
+    _queue_sleeping = false;
+    uint16_t count = _notification_store.count();
+    if(count == 0) {
+        return;
+    }
+    tr_debug("M2MNsdlInterface::flush_notification_store() - %d notifications", count);
+    for(uint16_t index = 0; index < count; index++) {
+        const M2MNotificationStore::Entry &entry = _notification_store.entry(index);
+        if(entry.composite) {
+            composite_observation_to_be_sent(*entry.composite);
+        } else {
+            // The values are read now, nodes deleted meanwhile are skipped.
+            M2MBase *base = find_resource(entry.path);
+            if(base) {
+                observation_to_be_sent(base,
+                                       entry.observation_number,
+                                       entry.instance_ids,
+                                       entry.send_object,
+                                       entry.delta ? &entry.resource_ids : NULL);
+            }
+        }
+    }
+    _notification_store.clear();
+}
+
+void M2MNsdlInterface::update_heap_statistics()
+{
+    uint32_t bytes = _object_list.capacity() * sizeof(M2MObject*);
+    M2MObjectList::const_iterator it = _object_list.begin();
+    for(; it != _object_list.end(); it++) {
+        bytes += (*it)->memory_footprint();
+    }
+    M2MStatistics::set(M2MStatistics::HeapBytes, bytes);
 }
@@ -18,9 +18,12 @@
 #include "mbed-client/m2mconstants.h"
 #include "include/m2mtlvserializer.h"
 #include "include/m2mtlvdeserializer.h"
+#include "include/m2msenmlcborserializer.h"
+#include "include/m2msenmlcbordeserializer.h"
 #include "include/nsdllinker.h"
 #include "include/m2mreporthandler.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2mindex.h"
+#include "include/m2mtrace.h"
 
 #define BUFFER_SIZE 10
 #define TRACE_GROUP "mClt"
@@ -41,14 +44,13 @@ M2MObject::~M2MObject()
         M2MObjectInstanceList::const_iterator it;
         it = _instance_list.begin();
         M2MObjectInstance* obj = NULL;
-        uint16_t index = 0;
-        for (; it!=_instance_list.end(); it++, index++ ) {
+        for (; it!=_instance_list.end(); it++ ) {
             //Free allocated memory for object instances.
             obj = *it;
 
             char *obj_inst_id = (char*)malloc(BUFFER_SIZE);
             if(obj_inst_id) {
-                snprintf(obj_inst_id, BUFFER_SIZE,"%d",index);
+                snprintf(obj_inst_id, BUFFER_SIZE,"%d",obj->instance_id());
 
                 String obj_name = M2MBase::name();
                 obj_name += String("/");
@@ -93,7 +95,9 @@ M2MObjectInstance* M2MObject::create_object_instance(uint16_t instance_id)
 {
     tr_debug("M2MObject::create_object_instance - id: %d", instance_id);
     M2MObjectInstance *instance = NULL;
-    if(!object_instance(instance_id)) {
+    // The instances are kept sorted by ID.
+    int pos = M2MIndex::lower_bound(_instance_list, instance_id, M2MIndex::InstanceId);
+    if(pos == _instance_list.size() || _instance_list[pos]->instance_id() != instance_id) {
         instance = new M2MObjectInstance(this->name(),*this);
         if(instance) {
             instance->add_observation_level(observation_level());
@@ -101,7 +105,7 @@ M2MObjectInstance* M2MObject::create_object_instance(uint16_t instance_id)
             if(M2MBase::name_id() != -1) {
                 instance->set_coap_content_type(COAP_CONTENT_OMA_TLV_TYPE);
             }
-            _instance_list.push_back(instance);
+            _instance_list.insert(pos, instance);
         }
     }
     return instance;
@@ -111,35 +115,27 @@ bool M2MObject::remove_object_instance(uint16_t inst_id)
 {
     tr_debug("M2MObject::remove_object_instance(inst_id %d)", inst_id);
     bool success = false;
-    if(!_instance_list.empty()) {
-        M2MObjectInstance* obj = NULL;
-        M2MObjectInstanceList::const_iterator it;
-        it = _instance_list.begin();
-        int pos = 0;
-        for ( ; it != _instance_list.end(); it++, pos++ ) {
-            if((*it)->instance_id() == inst_id) {
-                // Instance found and deleted.
-                obj = *it;
+    int pos = M2MIndex::find(_instance_list, inst_id, M2MIndex::InstanceId);
+    if(pos != -1) {
+        // Instance found and deleted.
+        M2MObjectInstance* obj = _instance_list[pos];
 
-                char *obj_inst_id = (char*)malloc(BUFFER_SIZE);
-                if(obj_inst_id) {
-                    snprintf(obj_inst_id, BUFFER_SIZE,"%d",obj->instance_id());
+        char *obj_inst_id = (char*)malloc(BUFFER_SIZE);
+        if(obj_inst_id) {
+            snprintf(obj_inst_id, BUFFER_SIZE,"%d",obj->instance_id());
 
-                    String obj_name = name();
-                    obj_name += String("/");
-                    obj_name += String(obj_inst_id);
+            String obj_name = name();
+            obj_name += String("/");
+            obj_name += String(obj_inst_id);
 
-                    free(obj_inst_id);
+            free(obj_inst_id);
 
-                    delete obj;
-                    obj = NULL;
-                    _instance_list.erase(pos);
-                    success = true;
+            delete obj;
+            obj = NULL;
+            _instance_list.erase(pos);
+            success = true;
 
-                    remove_resource_from_coap(obj_name);
-                }
-                break;
-            }
+            remove_resource_from_coap(obj_name);
         }
     }
     return success;
@@ -149,16 +145,9 @@ M2MObjectInstance* M2MObject::object_instance(uint16_t inst_id) const
 {
     tr_debug("M2MObject::object_instance(inst_id %d)", inst_id);
     M2MObjectInstance *obj = NULL;
-    if(!_instance_list.empty()) {
-        M2MObjectInstanceList::const_iterator it;
-        it = _instance_list.begin();
-        for ( ; it != _instance_list.end(); it++ ) {
-            if((*it)->instance_id() == inst_id) {
-                // Instance found.
-                obj = *it;
-                break;
-            }
-        }
+    int pos = M2MIndex::find(_instance_list, inst_id, M2MIndex::InstanceId);
+    if(pos != -1) {
+        obj = _instance_list[pos];
     }
     return obj;
 }
@@ -218,14 +207,13 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
         if ((operation() & SN_GRS_GET_ALLOWED) != 0) {
             if(coap_response) {
                 uint16_t coap_content_type = 0;
+                uint16_t requested_type = 0;
                 bool content_type_present = false;
-                if(received_coap_header->content_type_ptr) {
+                if(requested_content_type(received_coap_header, requested_type)) {
                     content_type_present = true;
                     coap_response->content_type_ptr =
-                            m2m::String::convert_integer_to_array(0,
-                                  coap_response->content_type_len,
-                                  received_coap_header->content_type_ptr,
-                                  received_coap_header->content_type_len);
+                            response_integer(observation_handler, requested_type,
+                                  coap_response->content_type_len);
 
                     if(coap_response->content_type_ptr) {
                         for(uint8_t i = 0; i < coap_response->content_type_len; i++) {
@@ -242,7 +230,7 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
                 tr_debug("M2MObject::handle_get_request() - Request Content-Type %d", coap_content_type);
                 if (!coap_response->content_type_ptr) {
                     coap_response->content_type_ptr =
-                            m2m::String::convert_integer_to_array(coap_content_type,
+                            response_integer(observation_handler, coap_content_type,
                                 coap_response->content_type_len);
                     if (coap_response->content_type_ptr) {
                         set_coap_content_type(coap_content_type);
@@ -254,18 +242,22 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
                     data = serializer->serialize(_instance_list, data_length);
                     delete serializer;
 
-                } else { // TOD0: Implement JSON Format.
+                } else if(COAP_CONTENT_OMA_SENML_CBOR_TYPE == coap_content_type) {
+                    M2MSenMLCBORSerializer serializer;
+                    serializer.append(this);
+                    data = serializer.serialize(data_length);
+                } else {
                     msg_code = COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT; // Content format not supported
                 }
 
                 coap_response->payload_len = data_length;
                 coap_response->payload_ptr = data;
 
-                coap_response->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+                coap_response->options_list_ptr = (sn_coap_options_list_s*)response_alloc(observation_handler, sizeof(sn_coap_options_list_s));
                 memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
 
                 coap_response->options_list_ptr->max_age_ptr =
-                        m2m::String::convert_integer_to_array(max_age(),
+                        response_integer(observation_handler, max_age(),
                                                               coap_response->options_list_ptr->max_age_len);
 
                 if(data){
@@ -299,7 +291,7 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
                                         add_observation_level(M2MBase::O_Attribute);
                                         tr_debug("M2MObject::handle_get_request - Observation Number %d", observation_number());
                                         coap_response->options_list_ptr->observe_ptr =
-                                                m2m::String::convert_integer_to_array(observation_number(),
+                                                response_integer(observation_handler, observation_number(),
                                                       coap_response->options_list_ptr->observe_len);
                                     }
                                 } else if (STOP_OBSERVATION == observe_option) {
@@ -335,7 +327,7 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
 
 sn_coap_hdr_s* M2MObject::handle_put_request(nsdl_s *nsdl,
                                              sn_coap_hdr_s *received_coap_header,
-                                             M2MObservationHandler */*observation_handler*/,
+                                             M2MObservationHandler *observation_handler,
                                              bool &/*execute_value_updated*/)
 {
     tr_debug("M2MObject::handle_put_request()");
@@ -346,7 +338,7 @@ sn_coap_hdr_s* M2MObject::handle_put_request(nsdl_s *nsdl,
     if(received_coap_header) {
         if(received_coap_header->options_list_ptr &&
            received_coap_header->options_list_ptr->uri_query_ptr) {
-            char *query = (char*)malloc(received_coap_header->options_list_ptr->uri_query_len+1);
+            char *query = (char*)response_alloc(observation_handler, received_coap_header->options_list_ptr->uri_query_len+1);
             if (query){
                 memset(query, 0, received_coap_header->options_list_ptr->uri_query_len+1);
                 memcpy(query,
@@ -359,7 +351,7 @@ sn_coap_hdr_s* M2MObject::handle_put_request(nsdl_s *nsdl,
                     tr_debug("M2MObject::handle_put_request() - Invalid query");
                     msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST; // 4.00
                 }
-                free(query);
+                response_free(observation_handler, query);
             }
         } else {
             tr_error("M2MObject::handle_put_request() - COAP_MSG_CODE_RESPONSE_BAD_REQUEST - Empty URI_QUERY");
@@ -397,10 +389,10 @@ sn_coap_hdr_s* M2MObject::handle_post_request(nsdl_s *nsdl,
                     content_type_present = true;
                     if(coap_response) {
                         coap_response->content_type_ptr =
-                                m2m::String::convert_integer_to_array(0,
-                                      coap_response->content_type_len,
-                                      received_coap_header->content_type_ptr,
-                                      received_coap_header->content_type_len);
+                                response_integer(observation_handler,
+                                      m2m::String::convert_array_to_integer(received_coap_header->content_type_ptr,
+                                                                            received_coap_header->content_type_len),
+                                      coap_response->content_type_len);
 
                         if(coap_response->content_type_ptr) {
                             for(uint8_t i = 0; i < coap_response->content_type_len; i++) {
@@ -418,17 +410,12 @@ sn_coap_hdr_s* M2MObject::handle_post_request(nsdl_s *nsdl,
                 tr_debug("M2MObject::handle_post_request() - Request Content-Type %d", coap_content_type);
 
                 if(COAP_CONTENT_OMA_TLV_TYPE == coap_content_type) {
-                    uint16_t instance_id = 0;
                     // Check next free instance id
-                    for(instance_id = 0; instance_id <= _max_instance_count; instance_id++) {
-                        if(NULL == object_instance(instance_id)) {
-                            break;
-                        }
-                        if(instance_id == _max_instance_count) {
-                            msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
-                            break;
-                        }
+                    int32_t free_id = M2MIndex::first_free_id(_instance_list);
+                    if(free_id > _max_instance_count) {
+                        msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
                     }
+                    uint16_t instance_id = (uint16_t)free_id;
                     if(COAP_MSG_CODE_RESPONSE_CHANGED == msg_code) {
                         M2MTLVDeserializer *deserializer = new M2MTLVDeserializer();
                         bool is_obj_instance = false;
@@ -475,27 +462,27 @@ sn_coap_hdr_s* M2MObject::handle_post_request(nsdl_s *nsdl,
                                         if(observation_handler) {
                                             execute_value_updated = true;
                                         }
-                                        coap_response->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+                                        coap_response->options_list_ptr = (sn_coap_options_list_s*)response_alloc(observation_handler, sizeof(sn_coap_options_list_s));
                                         if (coap_response->options_list_ptr) {
                                             memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
 
                                             obj_name = M2MBase::name();
                                             obj_name += String("/");
-                                            obj_inst_id = (char*)malloc(BUFFER_SIZE);
+                                            obj_inst_id = (char*)response_alloc(observation_handler, BUFFER_SIZE);
                                             snprintf(obj_inst_id, BUFFER_SIZE,"%d",instance_id);
                                             obj_name += obj_inst_id;
 
                                             coap_response->options_list_ptr->location_path_len = obj_name.length();
                                             if (coap_response->options_list_ptr->location_path_len != 0) {
                                                 coap_response->options_list_ptr->location_path_ptr =
-                                                        (uint8_t*)malloc(coap_response->options_list_ptr->location_path_len);
+                                                        (uint8_t*)response_alloc(observation_handler, coap_response->options_list_ptr->location_path_len);
                                                 if (coap_response->options_list_ptr->location_path_ptr) {
                                                     memcpy(coap_response->options_list_ptr->location_path_ptr,
                                                            obj_name.c_str(),
                                                            coap_response->options_list_ptr->location_path_len);
                                                 }
                                             }
-                                            free(obj_inst_id);
+                                            response_free(observation_handler, obj_inst_id);
                                         }
                                         msg_code = COAP_MSG_CODE_RESPONSE_CREATED;
                                         break;
@@ -538,12 +525,24 @@ sn_coap_hdr_s* M2MObject::handle_post_request(nsdl_s *nsdl,
     return coap_response;
 }
 
-void M2MObject::notification_update(uint16_t obj_instance_id)
+uint32_t M2MObject::memory_footprint() const
+{
+    uint32_t bytes = sizeof(M2MObject) + base_memory_footprint() +
+                     _instance_list.capacity() * sizeof(M2MObjectInstance*);
+    M2MObjectInstanceList::const_iterator it = _instance_list.begin();
+    for(; it != _instance_list.end(); it++) {
+        bytes += (*it)->memory_footprint();
+    }
+    return bytes;
+}
+
+void M2MObject::notification_update(uint16_t obj_instance_id,
+                                    int32_t resource_id)
 {
     tr_debug("M2MObject::notification_update - id: %d", obj_instance_id);
     M2MReportHandler *report_handler = M2MBase::report_handler();
     if(report_handler && is_observable()) {
-        report_handler->set_notification_trigger(obj_instance_id);
+        report_handler->set_notification_trigger(obj_instance_id, resource_id);
     }
 }
 
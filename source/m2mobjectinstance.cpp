@@ -22,9 +22,12 @@
 #include "mbed-client/m2mstring.h"
 #include "include/m2mtlvserializer.h"
 #include "include/m2mtlvdeserializer.h"
+#include "include/m2msenmlcborserializer.h"
+#include "include/m2msenmlcbordeserializer.h"
 #include "include/nsdllinker.h"
 #include "include/m2mreporthandler.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2mindex.h"
+#include "include/m2mtrace.h"
 
 #define BUFFER_SIZE 10
 #define TRACE_GROUP "mClt"
@@ -98,7 +101,7 @@ M2MResource* M2MObjectInstance::create_static_resource(const String &resource_na
             if (multiple_instance) {
                 res->set_coap_content_type(COAP_CONTENT_OMA_TLV_TYPE);
             }
-            _resource_list.push_back(res);
+            insert_resource(res);
         }
     }
     return res;
@@ -124,7 +127,7 @@ M2MResource* M2MObjectInstance::create_dynamic_resource(const String &resource_n
                 res->set_coap_content_type(COAP_CONTENT_OMA_TLV_TYPE);
             }
             res->add_observation_level(observation_level());
-            _resource_list.push_back(res);
+            insert_resource(res);
         }
     }
     return res;
@@ -147,7 +150,7 @@ M2MResourceInstance* M2MObjectInstance::create_static_resource_instance(const St
         res = new M2MResource(*this,resource_name, resource_type, type,
                               value, value_length, M2MBase::instance_id(),
                               M2MBase::name(), true);
-        _resource_list.push_back(res);
+        insert_resource(res);
         res->set_operation(M2MBase::GET_ALLOWED);
         res->set_observable(false);
         res->set_register_uri(false);        
@@ -180,7 +183,7 @@ M2MResourceInstance* M2MObjectInstance::create_dynamic_resource_instance(const S
     if(!res) {
         res = new M2MResource(*this,resource_name, resource_type, type,
                               false, M2MBase::instance_id(), M2MBase::name(), true);
-        _resource_list.push_back(res);
+        insert_resource(res);
         res->set_register_uri(false);
         res->set_operation(M2MBase::GET_ALLOWED);        
     }
@@ -202,37 +205,29 @@ bool M2MObjectInstance::remove_resource(const String &resource_name)
     tr_debug("M2MObjectInstance::remove_resource(resource_name %s)",
              resource_name.c_str());
     bool success = false;
-    if(!_resource_list.empty()) {
-         M2MResource* res = NULL;
-         M2MResourceList::const_iterator it;
-         it = _resource_list.begin();
-         int pos = 0;
-         for ( ; it != _resource_list.end(); it++, pos++ ) {
-             if(((*it)->name() == resource_name)) {
-                // Resource found and deleted.
-                res = *it;
-
-                char *obj_inst_id = (char*)malloc(BUFFER_SIZE);
-                if(obj_inst_id) {
-                    uint32_t size = m2m::itoa_c(instance_id(), obj_inst_id);
-                    if (size <= BUFFER_SIZE) {
-                        String obj_name = name();
-                        obj_name += String("/");
-                        obj_name += String(obj_inst_id);
-                        obj_name += String("/");
-                        obj_name += (*it)->name();
-                        remove_resource_from_coap(obj_name);
-                        delete res;
-                        res = NULL;
-                        _resource_list.erase(pos);
-                        success = true;
-                    }
-                    free(obj_inst_id);
-                }
-                 break;
-             }
-         }
-     }
+    int pos = resource_position(resource_name.c_str());
+    if(pos != -1) {
+        // Resource found and deleted.
+        M2MResource* res = _resource_list[pos];
+
+        char *obj_inst_id = (char*)malloc(BUFFER_SIZE);
+        if(obj_inst_id) {
+            uint32_t size = m2m::itoa_c(instance_id(), obj_inst_id);
+            if (size <= BUFFER_SIZE) {
+                String obj_name = name();
+                obj_name += String("/");
+                obj_name += String(obj_inst_id);
+                obj_name += String("/");
+                obj_name += res->name();
+                remove_resource_from_coap(obj_name);
+                delete res;
+                res = NULL;
+                _resource_list.erase(pos);
+                success = true;
+            }
+            free(obj_inst_id);
+        }
+    }
     return success;
 }
 
@@ -272,16 +267,11 @@ bool M2MObjectInstance::remove_resource_instance(const String &resource_name,
                         remove_resource_from_coap(obj_name);
                         success = res->remove_resource_instance(inst_id);
                         if(res->resource_instance_count() == 0) {
-                            M2MResourceList::const_iterator itr;
-                            itr = _resource_list.begin();
-                            int pos = 0;
-                            for ( ; itr != _resource_list.end(); itr++, pos++ ) {
-                                if(((*itr)->name() == resource_name)) {
-                                    delete res;
-                                    res = NULL;
-                                    _resource_list.erase(pos);
-                                    break;
-                                }
+                            int pos = resource_position(resource_name.c_str());
+                            if(pos != -1) {
+                                delete res;
+                                res = NULL;
+                                _resource_list.erase(pos);
                             }
                         }
                     }
@@ -294,19 +284,59 @@ bool M2MObjectInstance::remove_resource_instance(const String &resource_name,
 }
 
 M2MResource* M2MObjectInstance::resource(const String &resource) const
+{
+    return M2MObjectInstance::resource(resource.c_str());
+}
+
+M2MResource* M2MObjectInstance::resource(const char *resource) const
 {
     M2MResource *res = NULL;
-    if(!_resource_list.empty()) {
-        M2MResourceList::const_iterator it;
-        it = _resource_list.begin();
-        for (; it!=_resource_list.end(); it++ ) {
-            if((*it)->name() == resource) {
-                res = *it;
-                break;
+    int pos = resource ? resource_position(resource) : -1;
+    if(pos != -1) {
+        res = _resource_list[pos];
+    }
+    return res;
+}
+
+M2MResource* M2MObjectInstance::resource_by_id(uint16_t resource_id) const
+{
+    M2MResource *res = NULL;
+    int pos = M2MIndex::find(_resource_list, resource_id, M2MIndex::NameId);
+    if(pos != -1) {
+        res = _resource_list[pos];
+    }
+    return res;
+}
+
+int M2MObjectInstance::resource_position(const char *resource_name) const
+{
+    int32_t id = m2m::id_from_string(resource_name);
+    if(id != -1) {
+        // Numeric names are found through the sorted IDs. The name is still
+        // compared as differently written numbers share the same ID.
+        int pos = M2MIndex::lower_bound(_resource_list, id, M2MIndex::NameId);
+        for(; pos < _resource_list.size() && _resource_list[pos]->name_id() == id; pos++) {
+            if(_resource_list[pos]->name() == resource_name) {
+                return pos;
+            }
+        }
+    } else {
+        for(int pos = 0; pos < _resource_list.size(); pos++) {
+            if(_resource_list[pos]->name() == resource_name) {
+                return pos;
             }
         }
     }
-    return res;
+    return -1;
+}
+
+void M2MObjectInstance::insert_resource(M2MResource *res)
+{
+    // Resources are kept sorted by name ID, the ones with a non-numeric
+    // name (ID -1) first, in the order they were created.
+    _resource_list.insert(M2MIndex::lower_bound(_resource_list, res->name_id() + 1,
+                                                M2MIndex::NameId),
+                          res);
 }
 
 const M2MResourceList& M2MObjectInstance::resources() const
@@ -395,14 +425,13 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
         if ((operation() & SN_GRS_GET_ALLOWED) != 0) {
             if(coap_response) {
                 uint16_t coap_content_type = 0;
+                uint16_t requested_type = 0;
                 bool content_type_present = false;
-                if(received_coap_header->content_type_ptr) {
+                if(requested_content_type(received_coap_header, requested_type)) {
                     content_type_present = true;
                     coap_response->content_type_ptr =
-                            m2m::String::convert_integer_to_array(0,
-                                                                  coap_response->content_type_len,
-                                                                  received_coap_header->content_type_ptr,
-                                                                  received_coap_header->content_type_len);
+                            response_integer(observation_handler, requested_type,
+                                                                  coap_response->content_type_len);
                     if(coap_response->content_type_ptr) {
                         for(uint8_t i = 0; i < coap_response->content_type_len; i++) {
                             coap_content_type = (coap_content_type << 8) +
@@ -418,7 +447,7 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
                 tr_debug("M2MObjectInstance::handle_get_request() - Request Content-Type %d", coap_content_type);
                 if (!coap_response->content_type_ptr) {
                     coap_response->content_type_ptr =
-                            m2m::String::convert_integer_to_array(coap_content_type,
+                            response_integer(observation_handler, coap_content_type,
                                                                   coap_response->content_type_len);
                     if (coap_response->content_type_ptr) {
                         set_coap_content_type(coap_content_type);
@@ -431,6 +460,10 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
                         data = serializer->serialize(_resource_list, data_length);
                         delete serializer;
                     }
+                } else if(COAP_CONTENT_OMA_SENML_CBOR_TYPE == coap_content_type) {
+                    M2MSenMLCBORSerializer serializer;
+                    serializer.append(name(), this);
+                    data = serializer.serialize(data_length);
                 } else {
                     msg_code = COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT; // Content format not supported
                 }
@@ -439,11 +472,11 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
                 coap_response->payload_ptr = data;
 
                 if(data) {
-                    coap_response->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+                    coap_response->options_list_ptr = (sn_coap_options_list_s*)response_alloc(observation_handler, sizeof(sn_coap_options_list_s));
                     memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
 
                     coap_response->options_list_ptr->max_age_ptr =
-                            m2m::String::convert_integer_to_array(max_age(),
+                            response_integer(observation_handler, max_age(),
                                 coap_response->options_list_ptr->max_age_len);
 
                     if(received_coap_header->token_ptr) {
@@ -474,7 +507,7 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
                                         set_under_observation(true,observation_handler);
                                         add_observation_level(M2MBase::OI_Attribute);
                                         coap_response->options_list_ptr->observe_ptr =
-                                                m2m::String::convert_integer_to_array(observation_number(),
+                                                response_integer(observation_handler, observation_number(),
                                                       coap_response->options_list_ptr->observe_len);
                                     }
                                 } else if (STOP_OBSERVATION == observe_option) {
@@ -525,10 +558,10 @@ sn_coap_hdr_s* M2MObjectInstance::handle_put_request(nsdl_s *nsdl,
             content_type_present = true;
             if(coap_response) {
                 coap_response->content_type_ptr =
-                        m2m::String::convert_integer_to_array(0,
-                                                              coap_response->content_type_len,
-                                                              received_coap_header->content_type_ptr,
-                                                              received_coap_header->content_type_len);
+                        response_integer(observation_handler,
+                                                              m2m::String::convert_array_to_integer(received_coap_header->content_type_ptr,
+                                                                                                    received_coap_header->content_type_len),
+                                                              coap_response->content_type_len);
 
                 if(coap_response->content_type_ptr) {
                     for(uint8_t i = 0; i < coap_response->content_type_len; i++) {
@@ -540,7 +573,7 @@ sn_coap_hdr_s* M2MObjectInstance::handle_put_request(nsdl_s *nsdl,
         }
         if(received_coap_header->options_list_ptr &&
            received_coap_header->options_list_ptr->uri_query_ptr) {
-            char *query = (char*)malloc(received_coap_header->options_list_ptr->uri_query_len+1);
+            char *query = (char*)response_alloc(observation_handler, received_coap_header->options_list_ptr->uri_query_len+1);
             if (query){
                 memset(query, 0, received_coap_header->options_list_ptr->uri_query_len+1);
                 memcpy(query,
@@ -555,7 +588,7 @@ sn_coap_hdr_s* M2MObjectInstance::handle_put_request(nsdl_s *nsdl,
                 } else {
                     msg_code =COAP_MSG_CODE_RESPONSE_CHANGED;
                 }
-                free(query);
+                response_free(observation_handler, query);
             }
         } else if ((operation() & SN_GRS_PUT_ALLOWED) != 0) {
             if(!content_type_present &&
@@ -592,6 +625,28 @@ sn_coap_hdr_s* M2MObjectInstance::handle_put_request(nsdl_s *nsdl,
                     }
                 }
                 delete deserializer;
+            } else if(COAP_CONTENT_OMA_SENML_CBOR_TYPE == coap_content_type) {
+                M2MSenMLCBORDeserializer deserializer;
+                switch(deserializer.deserialize_resources(received_coap_header->payload_ptr,
+                                                          received_coap_header->payload_len,
+                                                          *this,
+                                                          M2MSenMLCBORDeserializer::Put)) {
+                    case M2MSenMLCBORDeserializer::None:
+                        if(observation_handler) {
+                            observation_handler->value_updated(this);
+                        }
+                        msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
+                        break;
+                    case M2MSenMLCBORDeserializer::NotFound:
+                        msg_code = COAP_MSG_CODE_RESPONSE_NOT_FOUND;
+                        break;
+                    case M2MSenMLCBORDeserializer::NotAllowed:
+                        msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
+                        break;
+                    case M2MSenMLCBORDeserializer::NotValid:
+                        msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+                        break;
+                }
             } else {
                 msg_code =COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT;
             } // if(COAP_CONTENT_OMA_TLV_TYPE == coap_content_type)
@@ -627,10 +682,10 @@ sn_coap_hdr_s* M2MObjectInstance::handle_post_request(nsdl_s *nsdl,
                 content_type_present = true;
                 if(coap_response) {
                     coap_response->content_type_ptr =
-                            m2m::String::convert_integer_to_array(0,
-                                                                  coap_response->content_type_len,
-                                                                  received_coap_header->content_type_ptr,
-                                                                  received_coap_header->content_type_len);
+                            response_integer(observation_handler,
+                                                                  m2m::String::convert_array_to_integer(received_coap_header->content_type_ptr,
+                                                                                                        received_coap_header->content_type_len),
+                                                                  coap_response->content_type_len);
 
                     if(coap_response->content_type_ptr) {
                         for(uint8_t i = 0; i < coap_response->content_type_len; i++) {
@@ -665,12 +720,12 @@ sn_coap_hdr_s* M2MObjectInstance::handle_post_request(nsdl_s *nsdl,
                             if(observation_handler) {
                                 execute_value_updated = true;
                             }                            
-                            coap_response->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+                            coap_response->options_list_ptr = (sn_coap_options_list_s*)response_alloc(observation_handler, sizeof(sn_coap_options_list_s));
                             if (coap_response->options_list_ptr) {
                                 memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
 
-                                resource_id = (char*)malloc(BUFFER_SIZE);
-                                obj_inst_id = (char*)malloc(BUFFER_SIZE);
+                                resource_id = (char*)response_alloc(observation_handler, BUFFER_SIZE);
+                                obj_inst_id = (char*)response_alloc(observation_handler, BUFFER_SIZE);
                                 snprintf(resource_id, BUFFER_SIZE, "%d",instance_id);
                                 snprintf(obj_inst_id, BUFFER_SIZE, "%d",M2MBase::instance_id());
 
@@ -683,7 +738,7 @@ sn_coap_hdr_s* M2MObjectInstance::handle_post_request(nsdl_s *nsdl,
                                 coap_response->options_list_ptr->location_path_len = obj_name.length();
                                 if (coap_response->options_list_ptr->location_path_len != 0) {
                                     coap_response->options_list_ptr->location_path_ptr =
-                                            (uint8_t*)malloc(coap_response->options_list_ptr->location_path_len);
+                                            (uint8_t*)response_alloc(observation_handler, coap_response->options_list_ptr->location_path_len);
                                     if (coap_response->options_list_ptr->location_path_ptr) {
                                         memcpy(coap_response->options_list_ptr->location_path_ptr,
                                                obj_name.c_str(),
@@ -691,8 +746,8 @@ sn_coap_hdr_s* M2MObjectInstance::handle_post_request(nsdl_s *nsdl,
                                     }
                                 }
 
-                                free(obj_inst_id);
-                                free(resource_id);
+                                response_free(observation_handler, obj_inst_id);
+                                response_free(observation_handler, resource_id);
                             }
                             msg_code = COAP_MSG_CODE_RESPONSE_CREATED;
                             break;
@@ -707,6 +762,30 @@ sn_coap_hdr_s* M2MObjectInstance::handle_post_request(nsdl_s *nsdl,
                     }
                     delete deserializer;
                 }
+            } else if(COAP_CONTENT_OMA_SENML_CBOR_TYPE == coap_content_type) {
+                // Every SenML record carries its own path, so this is a partial
+                // update of the instance and there is no single location to return.
+                M2MSenMLCBORDeserializer deserializer;
+                switch(deserializer.deserialize_resources(received_coap_header->payload_ptr,
+                                                          received_coap_header->payload_len,
+                                                          *this,
+                                                          M2MSenMLCBORDeserializer::Post)) {
+                    case M2MSenMLCBORDeserializer::None:
+                        if(observation_handler) {
+                            execute_value_updated = true;
+                        }
+                        msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
+                        break;
+                    case M2MSenMLCBORDeserializer::NotFound:
+                        msg_code = COAP_MSG_CODE_RESPONSE_NOT_FOUND;
+                        break;
+                    case M2MSenMLCBORDeserializer::NotAllowed:
+                        msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
+                        break;
+                    case M2MSenMLCBORDeserializer::NotValid:
+                        msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+                        break;
+                }
             } else {
                 msg_code =COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT;
             } // if(COAP_CONTENT_OMA_TLV_TYPE == coap_content_type)
@@ -724,16 +803,28 @@ sn_coap_hdr_s* M2MObjectInstance::handle_post_request(nsdl_s *nsdl,
     return coap_response;
 }
 
-void M2MObjectInstance::notification_update(M2MBase::Observation observation_level)
+uint32_t M2MObjectInstance::memory_footprint() const
+{
+    uint32_t bytes = sizeof(M2MObjectInstance) + base_memory_footprint() +
+                     _resource_list.capacity() * sizeof(M2MResource*);
+    M2MResourceList::const_iterator it = _resource_list.begin();
+    for(; it != _resource_list.end(); it++) {
+        bytes += (*it)->memory_footprint();
+    }
+    return bytes;
+}
+
+void M2MObjectInstance::notification_update(M2MBase::Observation observation_level,
+                                            int32_t resource_id)
 {
     tr_debug("M2MObjectInstance::notification_update()");
     if(M2MBase::O_Attribute == observation_level) {
          tr_debug("M2MObjectInstance::notification_update() - M2MBase::O_Attribute == observation_level");
-        _object_callback.notification_update(instance_id());
+        _object_callback.notification_update(instance_id(), resource_id);
     } else {
         M2MReportHandler *report_handler = M2MBase::report_handler();
         if(report_handler && is_observable()) {
-            report_handler->set_notification_trigger();
+            report_handler->set_notification_trigger(instance_id(), resource_id);
         }
     }
 }
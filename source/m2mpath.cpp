@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include "include/m2mpath.h"
+
+M2MPath::M2MPath()
+: _path(NULL),
+  _numeric(0),
+  _depth(0)
+{
+}
+
+bool M2MPath::parse(const uint8_t *path, uint16_t length)
+{
+    _path = (const char*)path;
+    _numeric = 0;
+    _depth = 0;
+    if(path == NULL) {
+        return false;
+    }
+    // Like a C string, the path ends at a NUL.
+    const void *end = memchr(path, 0, length);
+    if(end) {
+        length = (const uint8_t*)end - path;
+    }
+    if(length == 0) {
+        return false;
+    }
+
+    uint16_t start = 0;
+    uint32_t value = 0;
+    bool numeric = true;
+    for(uint16_t index = 0; index <= length; index++) {
+        if(index == length || _path[index] == '/') {
+            if(index == start || _depth == MAX_DEPTH) {
+                _depth = 0;
+                return false;
+            }
+            _offset[_depth] = start;
+            _length[_depth] = index - start;
+            _id[_depth] = (uint16_t)value;
+            if(numeric) {
+                _numeric |= (1 << _depth);
+            }
+            _depth++;
+            start = index + 1;
+            value = 0;
+            numeric = true;
+        } else if(numeric) {
+            char c = _path[index];
+            if(c >= '0' && c <= '9') {
+                value = value * 10 + (c - '0');
+                if(value > 0xFFFF) {
+                    numeric = false;
+                }
+            } else {
+                numeric = false;
+            }
+        }
+    }
+    return true;
+}
+
+bool M2MPath::parse(const String &path)
+{
+    return parse((const uint8_t*)path.c_str(), path.size());
+}
+
+uint8_t M2MPath::depth() const
+{
+    return _depth;
+}
+
+int32_t M2MPath::id(uint8_t level) const
+{
+    if(level < _depth && (_numeric & (1 << level))) {
+        return _id[level];
+    }
+    return -1;
+}
+
+bool M2MPath::equals(uint8_t level, const String &name) const
+{
+    return level < _depth &&
+           name.size() == _length[level] &&
+           memcmp(_path + _offset[level], name.c_str(), _length[level]) == 0;
+}
+
+String M2MPath::to_string(uint8_t depth) const
+{
+    String path;
+    if(depth > 0 && depth <= _depth) {
+        uint8_t last = depth - 1;
+        path.append(_path, _offset[last] + _length[last]);
+    }
+    return path;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include "mbed-client/m2mpoolallocator.h"
+#include "include/m2mtrace.h"
+
+#define TRACE_GROUP "mClt"
+
+// Size of all blocks of the given class, blocks of the classes
+// follow each other in the region starting from the smallest.
+#define CLASS_BLOCK_SIZE(c)     (M2M_POOL_MIN_BLOCK_SIZE << (c))
+
+M2MPoolAllocator::M2MPoolAllocator(uint16_t blocks)
+: _region(NULL),
+  _blocks(blocks),
+  _blocks_in_use(0)
+{
+    uint32_t region_size = 0;
+    for(uint8_t c = 0; c < M2M_POOL_SIZE_CLASSES; c++) {
+        _free_list[c] = NULL;
+        region_size += (uint32_t)CLASS_BLOCK_SIZE(c) * _blocks;
+    }
+    if(region_size > 0) {
+        _region = (uint8_t*)malloc(region_size);
+    }
+    if(_region) {
+        uint8_t *block = _region;
+        for(uint8_t c = 0; c < M2M_POOL_SIZE_CLASSES; c++) {
+            for(uint16_t i = 0; i < _blocks; i++) {
+                FreeBlock *free_block = (FreeBlock*)block;
+                free_block->next = _free_list[c];
+                _free_list[c] = free_block;
+                block += CLASS_BLOCK_SIZE(c);
+            }
+        }
+    } else {
+        tr_error("M2MPoolAllocator::M2MPoolAllocator() - no memory for pool");
+        _blocks = 0;
+    }
+}
+
+M2MPoolAllocator::~M2MPoolAllocator()
+{
+    free(_region);
+    _region = NULL;
+}
+
+void* M2MPoolAllocator::allocate(uint16_t size)
+{
+    if(!size) {
+        return NULL;
+    }
+    for(uint8_t c = 0; c < M2M_POOL_SIZE_CLASSES; c++) {
+        if(size <= CLASS_BLOCK_SIZE(c) && _free_list[c]) {
+            FreeBlock *block = _free_list[c];
+            _free_list[c] = block->next;
+            _blocks_in_use++;
+            return block;
+        }
+    }
+    return malloc(size);
+}
+
+void M2MPoolAllocator::deallocate(void *ptr)
+{
+    if(!ptr) {
+        return;
+    }
+    int8_t c = size_class(ptr);
+    if(c < 0) {
+        free(ptr);
+        return;
+    }
+    FreeBlock *block = (FreeBlock*)ptr;
+    block->next = _free_list[c];
+    _free_list[c] = block;
+    _blocks_in_use--;
+}
+
+uint32_t M2MPoolAllocator::allocated_size(const void *ptr) const
+{
+    // Blocks above the largest size class come from malloc().
+    int8_t c = size_class(ptr);
+    return c < 0 ? 0 : CLASS_BLOCK_SIZE(c);
+}
+
+uint32_t M2MPoolAllocator::blocks_in_use() const
+{
+    return _blocks_in_use;
+}
+
+int8_t M2MPoolAllocator::size_class(const void *ptr) const
+{
+    const uint8_t *address = (const uint8_t*)ptr;
+    if(!_region || address < _region) {
+        return -1;
+    }
+    const uint8_t *class_start = _region;
+    for(uint8_t c = 0; c < M2M_POOL_SIZE_CLASSES; c++) {
+        const uint8_t *class_end = class_start + (uint32_t)CLASS_BLOCK_SIZE(c) * _blocks;
+        if(address < class_end) {
+            return c;
+        }
+        class_start = class_end;
+    }
+    return -1;
+}
@@ -16,8 +16,11 @@
 #include "mbed-client/m2mreportobserver.h"
 #include "mbed-client/m2mconstants.h"
 #include "mbed-client/m2mtimer.h"
+#include "mbed-client/m2mstatistics.h"
+#include "mbed-client/m2mlatency.h"
 #include "include/m2mreporthandler.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2msamplebuffer.h"
+#include "include/m2mtrace.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -39,7 +42,11 @@ M2MReportHandler::M2MReportHandler(M2MReportObserver &observer)
   _current_value(0.0f),
   _last_value(0.0f),
   _attribute_state(0),
-  _notify(false)
+  _notify(false),
+  _changed_at(0),
+  _all_resources_changed(false),
+  _sample_buffer(NULL),
+  _sample_timer(NULL)
 {
     tr_debug("M2MReportHandler::M2MReportHandler()");
 }
@@ -53,6 +60,9 @@ M2MReportHandler::~M2MReportHandler()
     if(_pmin_timer) {
         delete _pmin_timer;
     }
+    if(_sample_timer) {
+        delete _sample_timer;
+    }
 }
 
 void M2MReportHandler::set_under_observation(bool observed)
@@ -95,21 +105,13 @@ void M2MReportHandler::set_value(float value)
     }
 }
 
-void M2MReportHandler::set_notification_trigger(uint16_t obj_instance_id)
+void M2MReportHandler::set_notification_trigger(uint16_t obj_instance_id,
+                                                int32_t resource_id)
 {
     tr_debug("M2MReportHandler::set_notification_trigger(): %d", obj_instance_id);
-    // Add to array if not there yet
-    m2m::Vector<uint16_t>::const_iterator it;
-    it = _changed_instance_ids.begin();
-    bool found = false;
-    for ( ; it != _changed_instance_ids.end(); it++) {
-        if ((*it) == obj_instance_id) {
-            found = true;
-            break;
-        }
-    }
-    if (!found) {
-        _changed_instance_ids.push_back(obj_instance_id);
+    _changed_instance_ids.insert(obj_instance_id);
+    if(resource_id < 0 || !_changed_resource_ids.insert((uint16_t)resource_id)) {
+        _all_resources_changed = true;
     }
 
     _current_value = 0.0f;
@@ -117,6 +119,34 @@ void M2MReportHandler::set_notification_trigger(uint16_t obj_instance_id)
     schedule_report();
 }
 
+void M2MReportHandler::sample_added(M2MSampleBuffer &samples)
+{
+    tr_debug("M2MReportHandler::sample_added(count %d)", samples.count());
+    _sample_buffer = &samples;
+    if(samples.flush_due()) {
+        flush_samples();
+    } else if(samples.flush_age() > 0 && samples.count() == 1) {
+        // The age is counted from the oldest sample.
+        if(!_sample_timer) {
+            _sample_timer = new M2MTimer(*this);
+        }
+        _sample_timer->start_timer(samples.flush_age(),
+                                   M2MTimerObserver::SampleFlush,
+                                   true);
+    }
+}
+
+void M2MReportHandler::remove_sample_buffer(M2MSampleBuffer *samples)
+{
+    if(_sample_buffer == samples) {
+        tr_debug("M2MReportHandler::remove_sample_buffer()");
+        _sample_buffer = NULL;
+        if(_sample_timer) {
+            _sample_timer->stop_timer();
+        }
+    }
+}
+
 bool M2MReportHandler::parse_notification_attribute(char *&query,
                                                     M2MBase::BaseType type,
                                                     M2MResourceInstance::ResourceType resource_type)
@@ -213,6 +243,11 @@ void M2MReportHandler::timer_expired(M2MTimerObserver::Type type)
             }
         }
         break;
+        case M2MTimerObserver::SampleFlush: {
+            tr_debug("M2MReportHandler::timer_expired - SAMPLE FLUSH");
+            flush_samples();
+        }
+        break;
         default:
             break;
     }
@@ -229,7 +264,7 @@ bool M2MReportHandler::set_notification_attribute(char* option,
     memset(&attribute, 0, 20);
     memset(&value, 0, 20);
 
-    char* pos = strstr(option, EQUAL.c_str());
+    char* pos = strstr(option, EQUAL);
     if( pos != NULL ){        
         memcpy(attribute, option, (size_t)(pos-option));
         pos++;
@@ -239,33 +274,33 @@ bool M2MReportHandler::set_notification_attribute(char* option,
     }
 
     if (strlen(value)) {
-        if (strcmp(attribute, PMIN.c_str()) == 0) {
+        if (strcmp(attribute, PMIN) == 0) {
            _pmin = atoi(value);
             success = true;
             _attribute_state |= M2MReportHandler::Pmin;
             tr_debug("M2MReportHandler::set_notification_attribute %s to %d", attribute, _pmin);
         }
-        else if(strcmp(attribute, PMAX.c_str()) == 0) {
+        else if(strcmp(attribute, PMAX) == 0) {
             _pmax = atoi(value);
             success = true;
             _attribute_state |= M2MReportHandler::Pmax;
             tr_debug("M2MReportHandler::set_notification_attribute %s to %d", attribute, _pmax);
         }
-        else if(strcmp(attribute, GT.c_str()) == 0 &&
+        else if(strcmp(attribute, GT) == 0 &&
                 (M2MBase::Resource == type)){
             _gt = atof(value);
             success = true;
             _attribute_state |= M2MReportHandler::Gt;
             tr_debug("M2MReportHandler::set_notification_attribute %s to %f", attribute, _gt);
         }
-        else if(strcmp(attribute, LT.c_str()) == 0 &&
+        else if(strcmp(attribute, LT) == 0 &&
                 (M2MBase::Resource == type)){
             _lt = atof(value);
             success = true;
             _attribute_state |= M2MReportHandler::Lt;
             tr_debug("M2MReportHandler::set_notification_attribute %s to %f", attribute, _lt);
         }
-        else if((strcmp(attribute, ST.c_str()) == 0 || (strcmp(attribute, STP.c_str()) == 0))
+        else if((strcmp(attribute, ST) == 0 || (strcmp(attribute, STP) == 0))
                 && (M2MBase::Resource == type)){
             _st = atof(value);
             success = true;
@@ -290,6 +325,12 @@ bool M2MReportHandler::set_notification_attribute(char* option,
 void M2MReportHandler::schedule_report()
 {
     tr_debug("M2MReportHandler::schedule_report()");
+    if(_notify) {
+        // A change is already waiting for pmin, this one replaces it.
+        M2MStatistics::increment(M2MStatistics::NotificationsCoalesced);
+    } else {
+        _changed_at = M2MStatistics::now();
+    }
     _notify = true;
     if ((_attribute_state & M2MReportHandler::Pmin) != M2MReportHandler::Pmin ||
          _pmin_exceeded) {
@@ -305,8 +346,12 @@ void M2MReportHandler::report()
         _pmin_exceeded = false;
         _pmax_exceeded = false;
         _notify = false;        
-        _observer.observation_to_be_sent(_changed_instance_ids);
-        _changed_instance_ids.clear();
+        M2MLatency::notification_triggered(_changed_at);
+        _observer.observation_to_be_sent(_changed_instance_ids, false,
+                                         _all_resources_changed ? NULL : &_changed_resource_ids);
+        M2MLatency::notification_triggered(0);
+        _changed_at = 0;
+        clear_changes();
         if (_pmax_timer) {
             _pmax_timer->stop_timer();
         }
@@ -315,7 +360,7 @@ void M2MReportHandler::report()
         if (_pmax_exceeded) {
             tr_debug("M2MReportHandler::report()- send with PMAX");            
             _observer.observation_to_be_sent(_changed_instance_ids, true);
-            _changed_instance_ids.clear();
+            clear_changes();
         }
         else {
             tr_debug("M2MReportHandler::report()- no need to send");
@@ -392,6 +437,23 @@ void M2MReportHandler::stop_timers()
     tr_debug("M2MReportHandler::stop_timers() - out");
 }
 
+uint32_t M2MReportHandler::memory_footprint() const
+{
+    uint32_t bytes = sizeof(M2MReportHandler) +
+                     _changed_instance_ids.capacity() +
+                     _changed_resource_ids.capacity();
+    if(_pmin_timer) {
+        bytes += sizeof(M2MTimer);
+    }
+    if(_pmax_timer) {
+        bytes += sizeof(M2MTimer);
+    }
+    if(_sample_timer) {
+        bytes += sizeof(M2MTimer);
+    }
+    return bytes;
+}
+
 void M2MReportHandler::set_default_values()
 {
     tr_debug("M2MReportHandler::set_default_values");
@@ -406,7 +468,35 @@ void M2MReportHandler::set_default_values()
     _pmax_exceeded = false;
     _last_value = 0.0f;
     _attribute_state = 0;
+    clear_changes();
+}
+
+void M2MReportHandler::clear_changes()
+{
     _changed_instance_ids.clear();
+    _changed_resource_ids.clear();
+    _all_resources_changed = false;
+}
+
+void M2MReportHandler::flush_samples()
+{
+    if(_sample_timer) {
+        _sample_timer->stop_timer();
+    }
+    if(_sample_buffer && _sample_buffer->count() > 0) {
+        tr_debug("M2MReportHandler::flush_samples(count %d)", _sample_buffer->count());
+        if(_observer.samples_to_be_sent(*_sample_buffer)) {
+            _sample_buffer->clear();
+        } else if(_sample_buffer->flush_age() > 0) {
+            tr_debug("M2MReportHandler::flush_samples - not sent, retry later");
+            if(!_sample_timer) {
+                _sample_timer = new M2MTimer(*this);
+            }
+            _sample_timer->start_timer(_sample_buffer->flush_age(),
+                                       M2MTimerObserver::SampleFlush,
+                                       true);
+        }
+    }
 }
 
 bool M2MReportHandler::check_threshold_values()
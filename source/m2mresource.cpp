@@ -17,10 +17,13 @@
 #include "mbed-client/m2mresource.h"
 #include "mbed-client/m2mobservationhandler.h"
 #include "include/m2mreporthandler.h"
+#include "include/m2mindex.h"
 #include "include/m2mtlvserializer.h"
 #include "include/m2mtlvdeserializer.h"
+#include "include/m2msenmlcborserializer.h"
+#include "include/m2msenmlcbordeserializer.h"
 #include "include/nsdllinker.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2mtrace.h"
 
 #define TRACE_GROUP "mClt"
 
@@ -148,22 +151,12 @@ bool M2MResource::remove_resource_instance(uint16_t inst_id)
 {
     tr_debug("M2MResource::remove_resource(inst_id %d)", inst_id);
     bool success = false;
-    if(!_resource_instance_list.empty()) {
-        M2MResourceInstance* res = NULL;
-        M2MResourceInstanceList::const_iterator it;
-        it = _resource_instance_list.begin();
-        int pos = 0;
-        for ( ; it != _resource_instance_list.end(); it++, pos++ ) {
-            if(((*it)->instance_id() == inst_id)) {
-                // Resource found and deleted.
-                res = *it;
-                delete res;
-                res = NULL;
-                _resource_instance_list.erase(pos);
-                success = true;
-                break;
-            }
-        }
+    int pos = M2MIndex::find(_resource_instance_list, inst_id, M2MIndex::InstanceId);
+    if(pos != -1) {
+        // Resource found and deleted.
+        delete _resource_instance_list[pos];
+        _resource_instance_list.erase(pos);
+        success = true;
     }
     return success;
 }
@@ -172,16 +165,9 @@ M2MResourceInstance* M2MResource::resource_instance(uint16_t inst_id) const
 {
     tr_debug("M2MResource::resource(resource_name inst_id %d)", inst_id);
     M2MResourceInstance *res = NULL;
-    if(!_resource_instance_list.empty()) {
-        M2MResourceInstanceList::const_iterator it;
-        it = _resource_instance_list.begin();
-        for ( ; it != _resource_instance_list.end(); it++ ) {
-            if(((*it)->instance_id() == inst_id)) {
-                // Resource found.
-                res = *it;
-                break;
-            }
-        }
+    int pos = M2MIndex::find(_resource_instance_list, inst_id, M2MIndex::InstanceId);
+    if(pos != -1) {
+        res = _resource_instance_list[pos];
     }
     return res;
 }
@@ -264,7 +250,11 @@ void M2MResource::add_resource_instance(M2MResourceInstance *res)
 {
     tr_debug("M2MResource::add_resource_instance()");
     if(res) {
-        _resource_instance_list.push_back(res);
+        // The instances are kept sorted by ID.
+        _resource_instance_list.insert(M2MIndex::lower_bound(_resource_instance_list,
+                                                             res->instance_id(),
+                                                             M2MIndex::InstanceId),
+                                       res);
     }
 }
 
@@ -284,14 +274,13 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
             if ((operation() & SN_GRS_GET_ALLOWED) != 0) {
                 if(coap_response) {
                     uint16_t coap_content_type = 0;
+                    uint16_t requested_type = 0;
                     bool content_type_present = false;
-                    if(received_coap_header->content_type_ptr){
+                    if(requested_content_type(received_coap_header, requested_type)) {
                         content_type_present = true;
                         coap_response->content_type_ptr =
-                                m2m::String::convert_integer_to_array(0,
-                                      coap_response->content_type_len,
-                                      received_coap_header->content_type_ptr,
-                                      received_coap_header->content_type_len);
+                                response_integer(observation_handler, requested_type,
+                                      coap_response->content_type_len);
                         if(coap_response->content_type_ptr) {
                             for(uint8_t i = 0; i < coap_response->content_type_len; i++) {
                                 coap_content_type = (coap_content_type << 8) +
@@ -308,7 +297,7 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
                     tr_debug("M2MResource::handle_get_request() - Request Content-Type %d", coap_content_type);
                     if (!coap_response->content_type_ptr) {
                         coap_response->content_type_ptr =
-                                m2m::String::convert_integer_to_array(coap_content_type,
+                                response_integer(observation_handler, coap_content_type,
                                     coap_response->content_type_len);
                         if (coap_response->content_type_ptr) {
                             set_coap_content_type(coap_content_type);
@@ -323,6 +312,10 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
                             data = serializer->serialize(this, data_length);
                             delete serializer;
                         }
+                    } else if(COAP_CONTENT_OMA_SENML_CBOR_TYPE == coap_content_type) {
+                        M2MSenMLCBORSerializer serializer;
+                        serializer.append(object_name(), object_instance_id(), this);
+                        data = serializer.serialize(data_length);
                     } else {
                         msg_code = COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT; // Content format not supported
                     }
@@ -330,11 +323,11 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
                     coap_response->payload_len = data_length;
                     coap_response->payload_ptr = data;
 
-                    coap_response->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+                    coap_response->options_list_ptr = (sn_coap_options_list_s*)response_alloc(observation_handler, sizeof(sn_coap_options_list_s));
                     memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
 
                     coap_response->options_list_ptr->max_age_ptr =
-                            m2m::String::convert_integer_to_array(max_age(),
+                            response_integer(observation_handler, max_age(),
                                 coap_response->options_list_ptr->max_age_len);
 
                     if(received_coap_header->token_ptr) {
@@ -373,7 +366,7 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
                                         set_under_observation(true,observation_handler);
                                         M2MBase::add_observation_level(M2MBase::R_Attribute);
                                         coap_response->options_list_ptr->observe_ptr =
-                                                m2m::String::convert_integer_to_array(observation_number(),
+                                                response_integer(observation_handler, observation_number(),
                                                       coap_response->options_list_ptr->observe_len);
                                     }
                                 } else if (STOP_OBSERVATION == observe_option) {
@@ -431,10 +424,10 @@ sn_coap_hdr_s* M2MResource::handle_put_request(nsdl_s *nsdl,
                 if(coap_response) {
                     content_type_present = true;
                     coap_response->content_type_ptr =
-                            m2m::String::convert_integer_to_array(0,
-                                coap_response->content_type_len,
-                                received_coap_header->content_type_ptr,
-                                received_coap_header->content_type_len);
+                            response_integer(observation_handler,
+                                m2m::String::convert_array_to_integer(received_coap_header->content_type_ptr,
+                                                                      received_coap_header->content_type_len),
+                                coap_response->content_type_len);
 
                     if(coap_response->content_type_ptr) {
                         for(uint8_t i = 0; i < coap_response->content_type_len; i++) {
@@ -446,7 +439,7 @@ sn_coap_hdr_s* M2MResource::handle_put_request(nsdl_s *nsdl,
             }
             if(received_coap_header->options_list_ptr &&
                received_coap_header->options_list_ptr->uri_query_ptr) {
-                char *query = (char*)malloc(received_coap_header->options_list_ptr->uri_query_len+1);
+                char *query = (char*)response_alloc(observation_handler, received_coap_header->options_list_ptr->uri_query_len+1);
                 if (query){
                     msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
                     memset(query, 0, received_coap_header->options_list_ptr->uri_query_len+1);
@@ -460,7 +453,7 @@ sn_coap_hdr_s* M2MResource::handle_put_request(nsdl_s *nsdl,
                         tr_debug("M2MResource::handle_put_request() - Invalid query");
                         msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST; // 4.00
                     }
-                    free(query);
+                    response_free(observation_handler, query);
                 }
             } else if ((operation() & SN_GRS_PUT_ALLOWED) != 0) {
                 if(!content_type_present &&
@@ -481,17 +474,6 @@ sn_coap_hdr_s* M2MResource::handle_put_request(nsdl_s *nsdl,
                         switch(error) {
                             case M2MTLVDeserializer::None:
                                 if(observation_handler) {
-                                    String value = "";
-                                    if (received_coap_header->uri_path_ptr != NULL &&
-                                        received_coap_header->uri_path_len > 0) {
-                                        char* buf = (char*)malloc(received_coap_header->uri_path_len+1);
-                                        if(buf) {
-                                            memset(buf,0,received_coap_header->uri_path_len+1);
-                                            memcpy(buf,received_coap_header->uri_path_ptr,received_coap_header->uri_path_len);
-                                            value = String(buf);
-                                            free(buf);
-                                        }
-                                    }
                                     execute_value_updated = true;
                                 }
                                 msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
@@ -508,6 +490,28 @@ sn_coap_hdr_s* M2MResource::handle_put_request(nsdl_s *nsdl,
                         }
                         delete deserializer;
                     }
+                } else if(COAP_CONTENT_OMA_SENML_CBOR_TYPE == coap_content_type) {
+                    M2MSenMLCBORDeserializer deserializer;
+                    switch(deserializer.deserialize_resource_instances(received_coap_header->payload_ptr,
+                                                                       received_coap_header->payload_len,
+                                                                       *this,
+                                                                       M2MSenMLCBORDeserializer::Put)) {
+                        case M2MSenMLCBORDeserializer::None:
+                            if(observation_handler) {
+                                execute_value_updated = true;
+                            }
+                            msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
+                            break;
+                        case M2MSenMLCBORDeserializer::NotFound:
+                            msg_code = COAP_MSG_CODE_RESPONSE_NOT_FOUND;
+                            break;
+                        case M2MSenMLCBORDeserializer::NotAllowed:
+                            msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
+                            break;
+                        case M2MSenMLCBORDeserializer::NotValid:
+                            msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+                            break;
+                    }
                 } else {
                     msg_code =COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT;
                 } // if(COAP_CONTENT_OMA_TLV_TYPE == coap_content_type)
@@ -615,6 +619,20 @@ sn_coap_hdr_s* M2MResource::handle_post_request(nsdl_s *nsdl,
     return coap_response;
 }
 
+uint32_t M2MResource::memory_footprint() const
+{
+    // The resource instance part accounts for its own size.
+    uint32_t bytes = M2MResourceInstance::memory_footprint() -
+                     sizeof(M2MResourceInstance) + sizeof(M2MResource) +
+                     _resource_instance_list.capacity() * sizeof(M2MResourceInstance*) +
+                     _delayed_token_len;
+    M2MResourceInstanceList::const_iterator it = _resource_instance_list.begin();
+    for(; it != _resource_instance_list.end(); it++) {
+        bytes += (*it)->memory_footprint();
+    }
+    return bytes;
+}
+
 void M2MResource::notification_update()
 {
     tr_debug("M2MResource::notification_update()");
@@ -18,20 +18,20 @@
 #include "mbed-client/m2mconstants.h"
 #include "mbed-client/m2mobservationhandler.h"
 #include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mstatistics.h"
 #include "include/m2mreporthandler.h"
+#include "include/m2msamplebuffer.h"
+#include "include/m2mfirmwarepackagewriter.h"
+#include "include/m2mblockoption.h"
 #include "include/nsdllinker.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2mtrace.h"
 
 #define TRACE_GROUP "mClt"
 
 M2MResourceInstance& M2MResourceInstance::operator=(const M2MResourceInstance& other)
 {
     if (this != &other) { // protect against invalid self-assignment
-        if(_value) {
-            free(_value);
-            _value = NULL;
-            _value_length = 0;
-        }
+        free_value();
         _value_length = other._value_length;
         if(other._value) {
             _value = (uint8_t *)malloc(other._value_length+1);
@@ -54,7 +54,12 @@ M2MResourceInstance::M2MResourceInstance(const M2MResourceInstance& other)
   _resource_callback(NULL),
   _object_instance_id(other._object_instance_id),
   _object_name(other._object_name),
-  _function_pointer(NULL)
+  _function_pointer(NULL),
+  _package_writer(NULL),
+  _value_referenced(false),
+  _value_provider(NULL),
+  _providing_value(false),
+  _sample_buffer(NULL)
 {
     this->operator=(other);
 }
@@ -75,7 +80,12 @@ M2MResourceInstance::M2MResourceInstance(const String &res_name,
  _resource_callback(NULL),
  _object_instance_id(object_instance_id),
  _object_name(object_name),
- _function_pointer(NULL)
+ _function_pointer(NULL),
+ _package_writer(NULL),
+ _value_referenced(false),
+ _value_provider(NULL),
+ _providing_value(false),
+ _sample_buffer(NULL)
 {
     M2MBase::set_resource_type(resource_type);
     M2MBase::set_base_type(M2MBase::ResourceInstance);
@@ -99,7 +109,12 @@ M2MResourceInstance::M2MResourceInstance(const String &res_name,
  _resource_callback(NULL),
  _object_instance_id(object_instance_id),
  _object_name(object_name),
- _function_pointer(NULL)
+ _function_pointer(NULL),
+ _package_writer(NULL),
+ _value_referenced(false),
+ _value_provider(NULL),
+ _providing_value(false),
+ _sample_buffer(NULL)
 {
     M2MBase::set_resource_type(resource_type);
     M2MBase::set_base_type(M2MBase::Resource);
@@ -115,15 +130,16 @@ M2MResourceInstance::M2MResourceInstance(const String &res_name,
 
 M2MResourceInstance::~M2MResourceInstance()
 {
-    if(_value) {
-        free(_value);
-        _value = NULL;
-        _value_length = 0;
-    }
+    free_value();
     if (_function_pointer) {
         delete _function_pointer;
         _function_pointer = NULL;
     }
+    if (_value_provider) {
+        delete _value_provider;
+        _value_provider = NULL;
+    }
+    remove_sample_buffer();
     _resource_callback = NULL;
 }
 
@@ -173,14 +189,110 @@ void M2MResourceInstance::set_execute_function(execute_callback_2 callback)
     set_execute_function(execute_callback(_function_pointer, &FP1<void, void*>::call));
 }
 
+void M2MResourceInstance::set_value_provider(value_provider_callback callback)
+{
+    if (_value_provider) {
+        delete _value_provider;
+    }
+    _value_provider = new value_provider_callback(callback);
+}
+
+void M2MResourceInstance::set_value_provider(value_provider_callback_2 callback)
+{
+    set_value_provider(value_provider_callback(callback));
+}
+
+void M2MResourceInstance::update_value()
+{
+    // The provider sets the value through set_value(), guard against
+    // recursion if it reads the value back.
+    if(_value_provider && !_providing_value) {
+        tr_debug("M2MResourceInstance::update_value()");
+        _providing_value = true;
+        _value_provider->call(this);
+        _providing_value = false;
+    }
+}
+
+void M2MResourceInstance::mark_changed()
+{
+    tr_debug("M2MResourceInstance::mark_changed()");
+    update_value();
+    if (_resource_type == M2MResourceInstance::STRING) {
+        report_composite();
+        M2MReportHandler *report_handler = M2MBase::report_handler();
+        if(report_handler && is_observable()) {
+            report_handler->set_notification_trigger();
+        }
+    }
+    else {
+        report();
+    }
+}
+
+bool M2MResourceInstance::set_sample_buffer(uint16_t capacity,
+                                            uint16_t flush_count,
+                                            uint32_t flush_age,
+                                            uint32_t flush_bytes,
+                                            SampleOverflow overflow,
+                                            bool send)
+{
+    tr_debug("M2MResourceInstance::set_sample_buffer(capacity %d)", capacity);
+    // Only resources have a report handler to flush the samples.
+    if(capacity == 0 || M2MBase::ResourceInstance == base_type()) {
+        return false;
+    }
+    remove_sample_buffer();
+    _sample_buffer = new M2MSampleBuffer(capacity, flush_count, flush_age,
+                                         flush_bytes, overflow, send);
+    if(!_sample_buffer->is_valid()) {
+        remove_sample_buffer();
+    } else if(send && observation_handler() && !report_handler()) {
+        // The Send operation needs no observer, only a report handler
+        // to flush the samples. Registration attaches both otherwise.
+        set_under_observation(false, observation_handler());
+    }
+    return _sample_buffer != NULL;
+}
+
+void M2MResourceInstance::remove_sample_buffer()
+{
+    if(_sample_buffer) {
+        tr_debug("M2MResourceInstance::remove_sample_buffer()");
+        M2MReportHandler *report_handler = M2MBase::report_handler();
+        if(report_handler) {
+            report_handler->remove_sample_buffer(_sample_buffer);
+        }
+        delete _sample_buffer;
+        _sample_buffer = NULL;
+    }
+}
+
+bool M2MResourceInstance::sends_samples() const
+{
+    return _sample_buffer && _sample_buffer->send();
+}
+
+uint16_t M2MResourceInstance::sample_count() const
+{
+    return _sample_buffer ? _sample_buffer->count() : 0;
+}
+
+void M2MResourceInstance::add_sample()
+{
+    // Unchanged values are samples too. The report handler is called even
+    // if the sample was dropped, so that a full buffer is retried.
+    _sample_buffer->add(M2MStatistics::now(), _value, _value_length);
+    M2MReportHandler *report_handler = M2MBase::report_handler();
+    if(report_handler) {
+        report_handler->sample_added(*_sample_buffer);
+    }
+}
+
 void M2MResourceInstance::clear_value()
 {
     tr_debug("M2MResourceInstance::clear_value");
-    if(_value) {
-         free(_value);
-         _value = NULL;
-         _value_length = 0;
-    }
+    free_value();
     report();
 }
 
@@ -190,23 +302,24 @@ bool M2MResourceInstance::set_value(const uint8_t *value,
     tr_debug("M2MResourceInstance::set_value()");
     bool success = false;
     bool value_changed = false;
-    if(is_value_changed(value,value_length)) {
+    if(!_providing_value && is_value_changed(value,value_length)) {
         value_changed = true;
     }
     if( value != NULL && value_length > 0 ) {
         success = true;
-        if(_value) {
-             free(_value);
-             _value = NULL;
-             _value_length = 0;
-        }
+        free_value();
         _value = (uint8_t *)malloc(value_length+1);
         if(_value) {
             memset(_value, 0, value_length+1);
             memcpy((uint8_t *)_value, (uint8_t *)value, value_length);
             _value_length = value_length;
-            if( value_changed ) { //
+            if(_sample_buffer) {
+                if(!_providing_value) {
+                    add_sample();
+                }
+            } else if( value_changed ) { //
                 if (_resource_type == M2MResourceInstance::STRING) {
+                    report_composite();
                     M2MReportHandler *report_handler = M2MBase::report_handler();
                     if(report_handler && is_observable()) {
                         report_handler->set_notification_trigger();
@@ -221,15 +334,58 @@ bool M2MResourceInstance::set_value(const uint8_t *value,
     return success;
 }
 
+bool M2MResourceInstance::set_value_reference(const uint8_t *value,
+                                              const uint32_t value_length)
+{
+    tr_debug("M2MResourceInstance::set_value_reference()");
+    bool success = false;
+    if( value != NULL && value_length > 0 ) {
+        success = true;
+        bool value_changed = !_providing_value &&
+                             (value != _value || value_length != _value_length);
+        free_value();
+        _value = (uint8_t *)value;
+        _value_length = value_length;
+        _value_referenced = true;
+        if( value_changed ) {
+            // The region is not NUL terminated, so it cannot be
+            // passed to the numeric report handler.
+            M2MReportHandler *report_handler = M2MBase::report_handler();
+            if(report_handler && is_observable()) {
+                report_handler->set_notification_trigger();
+            }
+        }
+    }
+    return success;
+}
+
+bool M2MResourceInstance::is_value_reference() const
+{
+    return _value_referenced;
+}
+
+void M2MResourceInstance::free_value()
+{
+    if(_value && !_value_referenced) {
+        free(_value);
+    }
+    _value = NULL;
+    _value_length = 0;
+    _value_referenced = false;
+}
+
 void M2MResourceInstance::report()
 {
     tr_debug("M2MResourceInstance::report()");
-    M2MBase::Observation  observation_level = M2MBase::observation_level();
+    report_composite();
+    M2MBase::Observation  observation_level =
+            (M2MBase::Observation)(M2MBase::observation_level() & ~M2MBase::C_Attribute);
     if(M2MBase::O_Attribute == observation_level ||
        M2MBase::OI_Attribute == observation_level||
        M2MBase::OOI_Attribute == observation_level) {
         tr_debug("M2MResourceInstance::report() -- object level");
-        _object_instance_callback.notification_update(observation_level);
+        _object_instance_callback.notification_update(observation_level,
+                                                      M2MBase::name_id());
     }
 
     if(M2MBase::Dynamic == mode() && M2MBase::R_Attribute == observation_level) {
@@ -237,7 +393,10 @@ void M2MResourceInstance::report()
         if(!_resource_callback && _resource_type != M2MResourceInstance::STRING) {
             M2MReportHandler *report_handler = M2MBase::report_handler();
             if (report_handler && is_observable()) {
-                if(_value) {
+                if(_value_referenced) {
+                    // Not NUL terminated, see set_value_reference().
+                    report_handler->set_notification_trigger();
+                } else if(_value) {
                     report_handler->set_value(atof((const char*)_value));
                 } else {
                     report_handler->set_value(0);
@@ -259,11 +418,22 @@ void M2MResourceInstance::report()
     }
 }
 
+void M2MResourceInstance::report_composite()
+{
+    if(M2MBase::observation_level() & M2MBase::C_Attribute) {
+        tr_debug("M2MResourceInstance::report_composite()");
+        M2MObservationHandler *observation_handler = M2MBase::observation_handler();
+        if(observation_handler) {
+            observation_handler->composite_value_changed(this);
+        }
+    }
+}
+
 bool M2MResourceInstance::is_value_changed(const uint8_t* value, const uint32_t value_len)
 {
     tr_debug("M2MResourceInstance::is_value_changed()");
     bool changed = false;
-    if(value_len != _value_length) {
+    if(value_len != _value_length || _value_referenced) {
         changed = true;
     } else if(value && !_value) {
         changed = true;
@@ -290,6 +460,12 @@ void M2MResourceInstance::execute(void *arguments)
 }
 
 void M2MResourceInstance::get_value(uint8_t *&value, uint32_t &value_length)
+{
+    update_value();
+    copy_value(value, value_length);
+}
+
+void M2MResourceInstance::copy_value(uint8_t *&value, uint32_t &value_length) const
 {
     value_length = 0;
     if(value) {
@@ -331,25 +507,40 @@ sn_coap_hdr_s* M2MResourceInstance::handle_get_request(nsdl_s *nsdl,
             if(coap_response) {
                 if(_resource_type == M2MResourceInstance::OPAQUE) {
                     coap_response->content_type_ptr =
-                            m2m::String::convert_integer_to_array(COAP_CONTENT_OMA_OPAQUE_TYPE,
+                            response_integer(observation_handler, COAP_CONTENT_OMA_OPAQUE_TYPE,
                                 coap_response->content_type_len);
                 } else {
                     coap_response->content_type_ptr =
-                            m2m::String::convert_integer_to_array(0,
+                            response_integer(observation_handler, 0,
                                 coap_response->content_type_len);
                 }
 
+                coap_response->options_list_ptr = (sn_coap_options_list_s*)response_alloc(observation_handler, sizeof(sn_coap_options_list_s));
+                memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+
                 // fill in the CoAP response payload
                 coap_response->payload_ptr = NULL;
-                uint32_t payload_len = 0;
-                get_value(coap_response->payload_ptr,payload_len);
-                coap_response->payload_len = payload_len;
-
-                coap_response->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
-                memset(coap_response->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+                update_value();
+                if(is_block_request(received_coap_header)) {
+                    if(!set_block_payload(received_coap_header, coap_response,
+                                          observation_handler)) {
+                        msg_code = COAP_MSG_CODE_RESPONSE_BAD_OPTION;
+                    }
+                } else if(_value && _value_length > 0 && _value_length <= 0xFFFF) {
+                    coap_response->payload_ptr =
+                            (uint8_t*)response_alloc(observation_handler, _value_length);
+                    if(coap_response->payload_ptr) {
+                        memcpy(coap_response->payload_ptr, _value, _value_length);
+                        coap_response->payload_len = _value_length;
+                    }
+                } else {
+                    uint32_t payload_len = 0;
+                    copy_value(coap_response->payload_ptr,payload_len);
+                    coap_response->payload_len = payload_len;
+                }
 
                 coap_response->options_list_ptr->max_age_ptr =
-                        m2m::String::convert_integer_to_array(max_age(),
+                        response_integer(observation_handler, max_age(),
                             coap_response->options_list_ptr->max_age_len);
 
                 if(received_coap_header->token_ptr) {
@@ -381,7 +572,7 @@ sn_coap_hdr_s* M2MResourceInstance::handle_get_request(nsdl_s *nsdl,
                                     set_under_observation(true,observation_handler);
                                     M2MBase::add_observation_level(M2MBase::R_Attribute);
                                     coap_response->options_list_ptr->observe_ptr =
-                                            m2m::String::convert_integer_to_array(observation_number(),
+                                            response_integer(observation_handler, observation_number(),
                                                   coap_response->options_list_ptr->observe_len);
                                 }
                             } else if (STOP_OBSERVATION == observe_option) {
@@ -409,6 +600,55 @@ sn_coap_hdr_s* M2MResourceInstance::handle_get_request(nsdl_s *nsdl,
     return coap_response;
 }
 
+bool M2MResourceInstance::is_block_request(sn_coap_hdr_s *received_coap_header) const
+{
+    bool block_requested = (received_coap_header->options_list_ptr &&
+                            received_coap_header->options_list_ptr->block2_ptr);
+    return block_requested ||
+           (_value_referenced && _value_length > MAX_VALUE_BLOCK_SIZE);
+}
+
+bool M2MResourceInstance::set_block_payload(sn_coap_hdr_s *received_coap_header,
+                                            sn_coap_hdr_s *coap_response,
+                                            M2MObservationHandler *observation_handler)
+{
+    uint32_t number = 0;
+    bool more = false;
+    uint16_t size = MAX_VALUE_BLOCK_SIZE;
+    if(received_coap_header->options_list_ptr &&
+       received_coap_header->options_list_ptr->block2_ptr) {
+        if(!M2MBlockOption::parse(received_coap_header->options_list_ptr->block2_ptr,
+                                  received_coap_header->options_list_ptr->block2_len,
+                                  number, more, size)) {
+            return false;
+        }
+    }
+    uint32_t offset = number * size;
+    if(offset > _value_length || (offset == _value_length && offset > 0)) {
+        tr_error("M2MResourceInstance::set_block_payload() - block %lu out of range",
+                 (unsigned long)number);
+        return false;
+    }
+
+    // Only the requested slice is copied, not the whole value.
+    uint32_t length = _value_length - offset;
+    if(length > size) {
+        length = size;
+    }
+    more = (offset + length) < _value_length;
+    if(length > 0) {
+        coap_response->payload_ptr = (uint8_t*)response_alloc(observation_handler, length);
+        if(coap_response->payload_ptr) {
+            memcpy(coap_response->payload_ptr, _value + offset, length);
+            coap_response->payload_len = length;
+        }
+    }
+    coap_response->options_list_ptr->block2_ptr =
+            M2MBlockOption::build(number, more, size,
+                                  coap_response->options_list_ptr->block2_len);
+    return true;
+}
+
 sn_coap_hdr_s* M2MResourceInstance::handle_put_request(nsdl_s *nsdl,
                                                sn_coap_hdr_s *received_coap_header,
                                                M2MObservationHandler *observation_handler,
@@ -425,10 +665,10 @@ sn_coap_hdr_s* M2MResourceInstance::handle_put_request(nsdl_s *nsdl,
         if(received_coap_header->content_type_ptr) {
             if(coap_response) {
                 coap_response->content_type_ptr =
-                        m2m::String::convert_integer_to_array(0,
-                            coap_response->content_type_len,
-                            received_coap_header->content_type_ptr,
-                            received_coap_header->content_type_len);
+                        response_integer(observation_handler,
+                            m2m::String::convert_array_to_integer(received_coap_header->content_type_ptr,
+                                                                  received_coap_header->content_type_len),
+                            coap_response->content_type_len);
 
                 if(coap_response->content_type_ptr) {
                     for(uint8_t i = 0; i < coap_response->content_type_len; i++) {
@@ -440,7 +680,7 @@ sn_coap_hdr_s* M2MResourceInstance::handle_put_request(nsdl_s *nsdl,
         }
         if(received_coap_header->options_list_ptr &&
            received_coap_header->options_list_ptr->uri_query_ptr) {
-            char *query = (char*)malloc(received_coap_header->options_list_ptr->uri_query_len+1);
+            char *query = (char*)response_alloc(observation_handler, received_coap_header->options_list_ptr->uri_query_len+1);
             if (query){
                 memset(query, 0, received_coap_header->options_list_ptr->uri_query_len+1);
                 memcpy(query,
@@ -454,29 +694,21 @@ sn_coap_hdr_s* M2MResourceInstance::handle_put_request(nsdl_s *nsdl,
                     tr_debug("M2MResourceInstance::handle_put_request() - Invalid query");
                     msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST; // 4.00
                 }
-                free(query);
+                response_free(observation_handler, query);
             }
         } else if ((operation() & SN_GRS_PUT_ALLOWED) != 0) {
             tr_debug("M2MResourceInstance::handle_put_request() - Request Content-Type %d", coap_content_type);
 
-            if(COAP_CONTENT_OMA_TLV_TYPE == coap_content_type) {
+            if(_package_writer && _package_writer->is_block_message(received_coap_header)) {
+                msg_code = _package_writer->handle_block(received_coap_header, coap_response);
+            } else if(COAP_CONTENT_OMA_TLV_TYPE == coap_content_type ||
+                      COAP_CONTENT_OMA_SENML_CBOR_TYPE == coap_content_type) {
                 msg_code = COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT;
             } else {
                 set_value(received_coap_header->payload_ptr, received_coap_header->payload_len);
                 if(received_coap_header->payload_ptr) {
                    tr_debug("M2MResourceInstance::handle_put_request() - Update Resource with new values");
                     if(observation_handler) {
-                        String value = "";
-                        if (received_coap_header->uri_path_ptr != NULL &&
-                            received_coap_header->uri_path_len > 0) {
-                            char* buf = (char*)malloc(received_coap_header->uri_path_len+1);
-                            if(buf) {
-                                memset(buf,0,received_coap_header->uri_path_len+1);
-                                memcpy(buf,received_coap_header->uri_path_ptr,received_coap_header->uri_path_len);
-                                value = String(buf);
-                                free(buf);
-                            }
-                        }
                         execute_value_updated = true;
                     }
                 }
@@ -500,6 +732,11 @@ void M2MResourceInstance::set_resource_observer(M2MResourceCallback *resource)
     _resource_callback = resource;
 }
 
+void M2MResourceInstance::set_package_writer(M2MFirmwarePackageWriter *writer)
+{
+    _package_writer = writer;
+}
+
 const String& M2MResourceInstance::object_name() const
 {
     return _object_name;
@@ -509,3 +746,23 @@ uint16_t M2MResourceInstance::object_instance_id() const
 {
     return _object_instance_id;
 }
+
+uint32_t M2MResourceInstance::memory_footprint() const
+{
+    uint32_t bytes = sizeof(M2MResourceInstance) + base_memory_footprint() +
+                     _object_name.capacity() + 1;
+    // Owned values are stored NUL terminated.
+    if(_value && !_value_referenced) {
+        bytes += _value_length + 1;
+    }
+    if(_function_pointer) {
+        bytes += sizeof(FP1<void, void*>);
+    }
+    if(_value_provider) {
+        bytes += sizeof(value_provider_callback);
+    }
+    if(_sample_buffer) {
+        bytes += _sample_buffer->memory_footprint();
+    }
+    return bytes;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "mbed-client/m2mstatistics.h"
+#include "include/m2msamplebuffer.h"
+#include "include/m2mtrace.h"
+
+#define TRACE_GROUP "mClt"
+
+M2MSampleBuffer::M2MSampleBuffer(uint16_t capacity,
+                                 uint16_t flush_count,
+                                 uint32_t flush_age,
+                                 uint32_t flush_bytes,
+                                 M2MResourceInstance::SampleOverflow overflow,
+                                 bool send)
+: _samples(NULL),
+  _capacity(0),
+  _first(0),
+  _count(0),
+  _flush_count(flush_count),
+  _flush_age(flush_age),
+  _flush_bytes(flush_bytes),
+  _bytes(0),
+  _overflow(overflow),
+  _send(send)
+{
+    if(_flush_count == 0 || _flush_count > capacity) {
+        _flush_count = capacity;
+    }
+    if(capacity > 0) {
+        _samples = (Sample*)malloc(capacity * sizeof(Sample));
+        if(_samples) {
+            _capacity = capacity;
+        }
+    }
+}
+
+M2MSampleBuffer::~M2MSampleBuffer()
+{
+    clear();
+    free(_samples);
+}
+
+bool M2MSampleBuffer::is_valid() const
+{
+    return _samples != NULL;
+}
+
+bool M2MSampleBuffer::add(uint64_t time, const uint8_t *value, uint32_t length)
+{
+    if(!_samples) {
+        return false;
+    }
+    if(_count == _capacity) {
+        M2MStatistics::increment(M2MStatistics::SamplesDropped);
+        if(_overflow == M2MResourceInstance::DropNewest) {
+            tr_debug("M2MSampleBuffer::add - full, sample dropped");
+            return false;
+        }
+        drop_oldest();
+    }
+    uint8_t *copy = (uint8_t*)malloc(length + 1);
+    if(!copy) {
+        M2MStatistics::increment(M2MStatistics::SamplesDropped);
+        return false;
+    }
+    if(length > 0) {
+        memcpy(copy, value, length);
+    }
+    copy[length] = '\0';
+
+    Sample &sample = _samples[(_first + _count) % _capacity];
+    sample.time = time;
+    sample.value = copy;
+    sample.length = length;
+    _count++;
+    _bytes += length;
+    return true;
+}
+
+bool M2MSampleBuffer::sample(uint16_t index, uint64_t &time,
+                             const uint8_t *&value, uint32_t &length) const
+{
+    if(index >= _count) {
+        return false;
+    }
+    const Sample &sample = _samples[(_first + index) % _capacity];
+    time = sample.time;
+    value = sample.value;
+    length = sample.length;
+    return true;
+}
+
+void M2MSampleBuffer::clear()
+{
+    while(_count > 0) {
+        drop_oldest();
+    }
+    _first = 0;
+}
+
+uint16_t M2MSampleBuffer::count() const
+{
+    return _count;
+}
+
+uint32_t M2MSampleBuffer::bytes() const
+{
+    return _bytes;
+}
+
+bool M2MSampleBuffer::flush_due() const
+{
+    return _count > 0 &&
+           (_count >= _flush_count ||
+            (_flush_bytes > 0 && _bytes >= _flush_bytes));
+}
+
+uint32_t M2MSampleBuffer::flush_age() const
+{
+    return _flush_age;
+}
+
+bool M2MSampleBuffer::send() const
+{
+    return _send;
+}
+
+uint32_t M2MSampleBuffer::memory_footprint() const
+{
+    // Values are stored NUL terminated.
+    return sizeof(M2MSampleBuffer) + _capacity * sizeof(Sample) + _bytes + _count;
+}
+
+void M2MSampleBuffer::drop_oldest()
+{
+    Sample &sample = _samples[_first];
+    free(sample.value);
+    sample.value = NULL;
+    _bytes -= sample.length;
+    _first = (_first + 1) % _capacity;
+    _count--;
+}
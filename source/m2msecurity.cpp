@@ -20,70 +20,90 @@
 #include "mbed-client/m2mobjectinstance.h"
 #include "mbed-client/m2mresource.h"
 #include "mbed-client/m2mstring.h"
+#include "include/m2mobjectmodel.h"
 
 #define TRACE_GROUP "mClt"
 
-#define BUFFER_SIZE 21
+#define M2M_SECURITY_RESOURCE_COUNT (M2MSecurity::ClientHoldOffTime + 1)
+
+// Resource models of the Security object, indexed by M2MSecurity::SecurityResource.
+// None of them is accessible to the server.
+static const M2MObjectModel::Resource __m2m_security_resources[] = {
+    // M2MServerUri
+    { "0",  M2MResourceInstance::STRING,  M2MBase::NOT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // BootstrapServer
+    { "1",  M2MResourceInstance::BOOLEAN, M2MBase::NOT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // SecurityMode
+    { "2",  M2MResourceInstance::INTEGER, M2MBase::NOT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // PublicKey
+    { "3",  M2MResourceInstance::OPAQUE,  M2MBase::NOT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // ServerPublicKey
+    { "4",  M2MResourceInstance::OPAQUE,  M2MBase::NOT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // Secretkey
+    { "5",  M2MResourceInstance::OPAQUE,  M2MBase::NOT_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL },
+    // SMSSecurityMode
+    { "6",  M2MResourceInstance::INTEGER, M2MBase::NOT_ALLOWED,
+      0, 0, 0, NULL },
+    // SMSBindingKey
+    { "7",  M2MResourceInstance::OPAQUE,  M2MBase::NOT_ALLOWED,
+      0, 0, 0, NULL },
+    // SMSBindingSecretKey
+    { "8",  M2MResourceInstance::OPAQUE,  M2MBase::NOT_ALLOWED,
+      0, 0, 0, NULL },
+    // M2MServerSMSNumber
+    { "9",  M2MResourceInstance::INTEGER, M2MBase::NOT_ALLOWED,
+      0, 0, 0, NULL },
+    // ShortServerID, mandatory for the LWM2M server only
+    { "10", M2MResourceInstance::INTEGER, M2MBase::NOT_ALLOWED,
+      0, 0, 0, NULL },
+    // ClientHoldOffTime
+    { "11", M2MResourceInstance::INTEGER, M2MBase::NOT_ALLOWED,
+      0, 0, 0, NULL }
+};
+
+// Fails to compile if the table and the enum go out of sync.
+typedef char __m2m_security_resources_check[
+    (sizeof(__m2m_security_resources) / sizeof(__m2m_security_resources[0]) ==
+     M2M_SECURITY_RESOURCE_COUNT) ? 1 : -1];
+
+static const M2MObjectModel::Resource* security_model(M2MSecurity::SecurityResource resource)
+{
+    if((unsigned)resource < M2M_SECURITY_RESOURCE_COUNT) {
+        return &__m2m_security_resources[resource];
+    }
+    return NULL;
+}
+
+// Only the key material of the (D)TLS connection is accessible as a buffer,
+// the SMS binding keys aren't supported.
+static bool is_connection_key(const M2MObjectModel::Resource *model)
+{
+    return M2MResourceInstance::OPAQUE == model->type &&
+           (model->flags & M2MObjectModel::Mandatory);
+}
 
 M2MSecurity::M2MSecurity(ServerType ser_type)
 : M2MObject(M2M_SECURITY_ID),
  _server_type(ser_type),
  _server_instance(NULL)
 {
-     _server_instance  = M2MObject::create_object_instance();
+    _server_instance  = M2MObject::create_object_instance();
 
     if(_server_instance) {
-
-        M2MResource* res = _server_instance->create_dynamic_resource(SECURITY_M2M_SERVER_URI,
-                                                                     OMA_RESOURCE_TYPE,
-                                                                     M2MResourceInstance::STRING,
-                                                                     false);
-        if(res) {
-            res->set_operation(M2MBase::NOT_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SECURITY_BOOTSTRAP_SERVER,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::BOOLEAN,
-                                                        false);
-        if(res) {
-            res->set_operation(M2MBase::NOT_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SECURITY_SECURITY_MODE,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::INTEGER,
-                                                        false);
-        if(res) {
-            res->set_operation(M2MBase::NOT_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SECURITY_PUBLIC_KEY,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::OPAQUE,
-                                                        false);
-        if(res) {
-            res->set_operation(M2MBase::NOT_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SECURITY_SERVER_PUBLIC_KEY,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::OPAQUE,
-                                                        false);
-        if(res) {
-            res->set_operation(M2MBase::NOT_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SECURITY_SECRET_KEY,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::OPAQUE,
-                                                        false);
-        if(res) {
-            res->set_operation(M2MBase::NOT_ALLOWED);
-        }
+        M2MObjectModel::create_mandatory_resources(_server_instance,
+                                                   __m2m_security_resources,
+                                                   M2M_SECURITY_RESOURCE_COUNT,
+                                                   true);
         if(M2MSecurity::M2MServer == ser_type) {
-            res = _server_instance->create_dynamic_resource(SECURITY_SHORT_SERVER_ID,
-                                                            OMA_RESOURCE_TYPE,
-                                                            M2MResourceInstance::INTEGER,
-                                                            false);
-            if(res) {
-                res->set_operation(M2MBase::NOT_ALLOWED);
-            }
+            M2MObjectModel::create_resource(_server_instance,
+                                            __m2m_security_resources[ShortServerID],
+                                            true);
         }
     }
 }
@@ -96,43 +116,13 @@ M2MSecurity::~M2MSecurity()
 M2MResource* M2MSecurity::create_resource(SecurityResource resource, uint32_t value)
 {
     M2MResource* res = NULL;
-    String security_id = "";
-    if(!is_resource_present(resource)) {
-        switch(resource) {
-            case SMSSecurityMode:
-               security_id = SECURITY_SMS_SECURITY_MODE;
-               break;
-            case M2MServerSMSNumber:
-                security_id = SECURITY_M2M_SERVER_SMS_NUMBER;
-                break;
-            case ShortServerID:
-                security_id = SECURITY_SHORT_SERVER_ID;
-                break;
-            case ClientHoldOffTime:
-                security_id = SECURITY_CLIENT_HOLD_OFF_TIME;
-                break;
-            default:
-                break;
-        }
-    }
-    if(!security_id.empty()) {
-        if(_server_instance) {
-
-            res = _server_instance->create_dynamic_resource(security_id,OMA_RESOURCE_TYPE,
-                                                            M2MResourceInstance::INTEGER,
-                                                            false);
-
-            if(res) {
-                res->set_operation(M2MBase::NOT_ALLOWED);
-                char *buffer = (char*)malloc(BUFFER_SIZE);
-                if(buffer) {
-                    uint32_t size = m2m::itoa_c(value, buffer);
-                    if (size <= BUFFER_SIZE) {
-                        res->set_value((const uint8_t*)buffer, size);
-                    }
-                    free(buffer);
-                }
-            }
+    const M2MObjectModel::Resource *model = security_model(resource);
+    if(model && !is_resource_present(resource) &&
+       M2MResourceInstance::INTEGER == model->type &&
+       !(model->flags & M2MObjectModel::Mandatory)) {
+        res = M2MObjectModel::create_resource(_server_instance, *model, true);
+        if(res) {
+            M2MObjectModel::set_int_value(res, value);
         }
     }
     return res;
@@ -141,29 +131,12 @@ M2MResource* M2MSecurity::create_resource(SecurityResource resource, uint32_t va
 bool M2MSecurity::delete_resource(SecurityResource resource)
 {
     bool success = false;
-    String security_id = "";
-    switch(resource) {
-        case SMSSecurityMode:
-           security_id = SECURITY_SMS_SECURITY_MODE;
-           break;
-        case M2MServerSMSNumber:
-            security_id = SECURITY_M2M_SERVER_SMS_NUMBER;
-            break;
-        case ShortServerID:
-            if(M2MSecurity::Bootstrap == _server_type) {
-                security_id = SECURITY_SHORT_SERVER_ID;
-            }
-            break;
-        case ClientHoldOffTime:
-            security_id = SECURITY_CLIENT_HOLD_OFF_TIME;
-            break;
-        default:
-            // Others are mandatory resources hence cannot be deleted.
-            break;
-    }
-    if(!security_id.empty()) {
+    const M2MObjectModel::Resource *model = security_model(resource);
+    // Mandatory resources cannot be deleted.
+    if(model && !(model->flags & M2MObjectModel::Mandatory) &&
+       (M2MSecurity::ShortServerID != resource || M2MSecurity::Bootstrap == _server_type)) {
         if(_server_instance) {
-            success = _server_instance->remove_resource(security_id);
+            success = _server_instance->remove_resource(model->name);
         }
     }
     return success;
@@ -173,11 +146,9 @@ bool M2MSecurity::set_resource_value(SecurityResource resource,
                                      const String &value)
 {
     bool success = false;
-    if(M2MSecurity::M2MServerUri == resource) {
-        M2MResource* res = get_resource(resource);
-        if(res) {
-            success = res->set_value((const uint8_t*)value.c_str(),(uint32_t)value.length());
-        }
+    M2MResource* res = get_resource(resource);
+    if(res && M2MResourceInstance::STRING == security_model(resource)->type) {
+        success = res->set_value((const uint8_t*)value.c_str(),(uint32_t)value.length());
     }
     return success;
 }
@@ -187,23 +158,8 @@ bool M2MSecurity::set_resource_value(SecurityResource resource,
 {
     bool success = false;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MSecurity::SecurityMode == resource        ||
-           M2MSecurity::SMSSecurityMode == resource     ||
-           M2MSecurity::M2MServerSMSNumber == resource  ||
-           M2MSecurity::ShortServerID == resource       ||
-           M2MSecurity::ClientHoldOffTime == resource) {
-            // If it is any of the above resource
-            // set the value of the resource.            
-            char *buffer = (char*)malloc(BUFFER_SIZE);
-            if(buffer) {
-                uint32_t size = m2m::itoa_c(value, buffer);
-                if (size <= BUFFER_SIZE) {
-                    success = res->set_value((const uint8_t*)buffer, size);
-                }
-                free(buffer);
-            }
-        }
+    if(res && M2MResourceInstance::INTEGER == security_model(resource)->type) {
+        success = M2MObjectModel::set_int_value(res, value);
     }
     return success;
 }
@@ -214,12 +170,8 @@ bool M2MSecurity::set_resource_value(SecurityResource resource,
 {
     bool success = false;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MSecurity::PublicKey == resource           ||
-           M2MSecurity::ServerPublicKey == resource     ||
-           M2MSecurity::Secretkey == resource) {
-            success = res->set_value(value,length);
-        }
+    if(res && is_connection_key(security_model(resource))) {
+        success = res->set_value(value,length);
     }
     return success;
 }
@@ -228,25 +180,23 @@ String M2MSecurity::resource_value_string(SecurityResource resource) const
 {
     String value = "";
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MSecurity::M2MServerUri == resource) {
-            uint8_t* buffer = NULL;
-            uint32_t length = 0;
-            res->get_value(buffer,length);
+    if(res && M2MResourceInstance::STRING == security_model(resource)->type) {
+        uint8_t* buffer = NULL;
+        uint32_t length = 0;
+        res->get_value(buffer,length);
 
-            char *char_buffer = (char*)malloc(length+1);
-            if(char_buffer) {
-                memset(char_buffer,0,length+1);
-                if(buffer) {
-                    memcpy(char_buffer,(char*)buffer,length);                    
-                }
-                String s_name(char_buffer);
-                value = s_name;
-                free(char_buffer);
-            }
+        char *char_buffer = (char*)malloc(length+1);
+        if(char_buffer) {
+            memset(char_buffer,0,length+1);
             if(buffer) {
-                free(buffer);
+                memcpy(char_buffer,(char*)buffer,length);
             }
+            String s_name(char_buffer);
+            value = s_name;
+            free(char_buffer);
+        }
+        if(buffer) {
+            free(buffer);
         }
     }
     return value;
@@ -257,12 +207,8 @@ uint32_t M2MSecurity::resource_value_buffer(SecurityResource resource,
 {
     uint32_t size = 0;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MSecurity::PublicKey == resource        ||
-           M2MSecurity::ServerPublicKey == resource  ||
-           M2MSecurity::Secretkey == resource) {
-            res->get_value(data,size);
-        }
+    if(res && is_connection_key(security_model(resource))) {
+        res->get_value(data,size);
     }
     return size;
 }
@@ -272,20 +218,14 @@ uint32_t M2MSecurity::resource_value_int(SecurityResource resource) const
 {
     uint32_t value = 0;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MSecurity::SecurityMode == resource        ||
-           M2MSecurity::SMSSecurityMode == resource     ||
-           M2MSecurity::M2MServerSMSNumber == resource  ||
-           M2MSecurity::ShortServerID == resource       ||
-           M2MSecurity::ClientHoldOffTime == resource) {
-            // Get the value and convert it into integer
-            uint8_t* buffer = NULL;
-            uint32_t length = 0;
-            res->get_value(buffer,length);
-            if(buffer) {
-                value = atoi((const char*)buffer);
-                free(buffer);
-            }
+    if(res && M2MResourceInstance::INTEGER == security_model(resource)->type) {
+        // Get the value and convert it into integer
+        uint8_t* buffer = NULL;
+        uint32_t length = 0;
+        res->get_value(buffer,length);
+        if(buffer) {
+            value = atoi((const char*)buffer);
+            free(buffer);
         }
     }
     return value;
@@ -318,47 +258,9 @@ M2MSecurity::ServerType M2MSecurity::server_type() const
 M2MResource* M2MSecurity::get_resource(SecurityResource res) const
 {
     M2MResource* res_object = NULL;
-    if(_server_instance) {
-        String res_name = "";
-        switch(res) {
-            case M2MServerUri:
-                res_name = SECURITY_M2M_SERVER_URI;
-                break;
-            case BootstrapServer:
-                res_name = SECURITY_BOOTSTRAP_SERVER;
-                break;
-            case SecurityMode:
-                res_name = SECURITY_SECURITY_MODE;
-                break;
-            case PublicKey:
-                res_name = SECURITY_PUBLIC_KEY;
-                break;
-            case ServerPublicKey:
-                res_name = SECURITY_SERVER_PUBLIC_KEY;
-                break;
-            case Secretkey:
-                res_name = SECURITY_SECRET_KEY;
-                break;
-            case SMSSecurityMode:
-                res_name = SECURITY_SMS_SECURITY_MODE;
-                break;
-            case SMSBindingKey:
-                res_name = SECURITY_SMS_BINDING_KEY;
-                break;
-            case SMSBindingSecretKey:
-                res_name = SECURITY_SMS_BINDING_SECRET_KEY;
-                break;
-            case M2MServerSMSNumber:
-                res_name = SECURITY_M2M_SERVER_SMS_NUMBER;
-                break;
-            case ShortServerID:
-                res_name = SECURITY_SHORT_SERVER_ID;
-                break;
-            case ClientHoldOffTime:
-                res_name = SECURITY_CLIENT_HOLD_OFF_TIME;
-                break;
-        }
-        res_object = _server_instance->resource(res_name);
+    const M2MObjectModel::Resource *model = security_model(res);
+    if(_server_instance && model) {
+        res_object = _server_instance->resource(model->name);
     }
     return res_object;
 }
@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include "include/m2msenmlcbordeserializer.h"
+#include "mbed-client/m2mconstants.h"
+#include "include/nsdllinker.h"
+#include "include/m2mtrace.h"
+
+#define TRACE_GROUP "mClt"
+
+// Nesting allowed in values that are skipped, keeps the recursion bounded.
+#define MAX_NESTING_DEPTH 8
+// Stands for a map label that is text, SenML only defines integer labels.
+#define UNKNOWN_LABEL 0x7FFF
+// Stands for the "vlo" text label of object link values.
+#define OBJLNK_LABEL 0x7FFE
+#define BUFFER_SIZE 10
+
+// CBOR major types, RFC 7049 chapter 2.1
+#define CBOR_UNSIGNED 0
+#define CBOR_NEGATIVE 1
+#define CBOR_BYTES 2
+#define CBOR_TEXT 3
+#define CBOR_ARRAY 4
+#define CBOR_MAP 5
+#define CBOR_TAG 6
+#define CBOR_SIMPLE 7
+
+// Additional information of the simple values and floats, RFC 7049 chapter 2.3
+#define CBOR_FALSE_INFO 20
+#define CBOR_TRUE_INFO 21
+#define CBOR_FLOAT16_INFO 25
+#define CBOR_FLOAT32_INFO 26
+#define CBOR_FLOAT64_INFO 27
+
+M2MSenMLCBORDeserializer::M2MSenMLCBORDeserializer()
+: _data(NULL),
+  _size(0),
+  _position(0),
+  _base_name(NULL),
+  _base_name_length(0),
+  _value(NULL),
+  _value_length(0),
+  _count(0)
+{
+}
+
+M2MSenMLCBORDeserializer::~M2MSenMLCBORDeserializer()
+{
+}
+
+bool M2MSenMLCBORDeserializer::deserialize_paths(const uint8_t *data, uint32_t size, M2MPathList &paths)
+{
+    if(!begin(data, size)) {
+        return false;
+    }
+    for(uint64_t i = 0; i < _count; i++) {
+        String path;
+        if(!read_record(path, false)) {
+            return false;
+        }
+        paths.push_back(path);
+    }
+    // Trailing bytes mean the pack was not what the sender meant it to be.
+    return _position == _size;
+}
+
+M2MSenMLCBORDeserializer::Error M2MSenMLCBORDeserializer::deserialize_resources(const uint8_t *data,
+                                                                                uint32_t size,
+                                                                                M2MObjectInstance &object_instance,
+                                                                                M2MSenMLCBORDeserializer::Operation operation)
+{
+    tr_debug("M2MSenMLCBORDeserializer::deserialize_resources()");
+    if(!begin(data, size)) {
+        return M2MSenMLCBORDeserializer::NotValid;
+    }
+    M2MSenMLCBORDeserializer::Error error = write_resources(object_instance, operation, false);
+    if(M2MSenMLCBORDeserializer::None == error) {
+        begin(data, size);
+        error = write_resources(object_instance, operation, true);
+    }
+    return error;
+}
+
+M2MSenMLCBORDeserializer::Error M2MSenMLCBORDeserializer::deserialize_resource_instances(const uint8_t *data,
+                                                                                         uint32_t size,
+                                                                                         M2MResource &resource,
+                                                                                         M2MSenMLCBORDeserializer::Operation operation)
+{
+    tr_debug("M2MSenMLCBORDeserializer::deserialize_resource_instances()");
+    if(!begin(data, size)) {
+        return M2MSenMLCBORDeserializer::NotValid;
+    }
+    M2MSenMLCBORDeserializer::Error error = write_resource_instances(resource, operation, false);
+    if(M2MSenMLCBORDeserializer::None == error) {
+        begin(data, size);
+        error = write_resource_instances(resource, operation, true);
+    }
+    return error;
+}
+
+M2MSenMLCBORDeserializer::Error M2MSenMLCBORDeserializer::write_resources(M2MObjectInstance &object_instance,
+                                                                          M2MSenMLCBORDeserializer::Operation operation,
+                                                                          bool update_value)
+{
+    M2MSenMLCBORDeserializer::Error error = M2MSenMLCBORDeserializer::None;
+    for(uint64_t i = 0; i < _count && M2MSenMLCBORDeserializer::None == error; i++) {
+        String name;
+        M2MPath path;
+        if(!read_record(name, true) || !path.parse(name) || path.depth() < 3 ||
+           !path.equals(0, object_instance.name()) ||
+           path.id(1) != object_instance.instance_id()) {
+            return M2MSenMLCBORDeserializer::NotValid;
+        }
+
+        M2MResource *resource = NULL;
+        int32_t resource_id = path.id(2);
+        if(resource_id >= 0) {
+            resource = object_instance.resource_by_id((uint16_t)resource_id);
+        } else {
+            const M2MResourceList &list = object_instance.resources();
+            M2MResourceList::const_iterator it = list.begin();
+            for(; it != list.end() && !resource; it++) {
+                if(path.equals(2, (*it)->name())) {
+                    resource = *it;
+                }
+            }
+        }
+
+        if(!resource) {
+            if(M2MSenMLCBORDeserializer::Post == operation &&
+               path.depth() == 3 && resource_id >= 0) {
+                // Create a new Resource
+                char buffer[BUFFER_SIZE];
+                m2m::itoa_c(resource_id, buffer);
+                resource = object_instance.create_dynamic_resource(String(buffer), "",
+                                                                   M2MResourceInstance::INTEGER,
+                                                                   true, false);
+                if(resource) {
+                    resource->set_operation(M2MBase::GET_PUT_POST_DELETE_ALLOWED);
+                    if(update_value) {
+                        write_value(*resource);
+                    }
+                    continue;
+                }
+            }
+            error = M2MSenMLCBORDeserializer::NotFound;
+        } else if(resource->supports_multiple_instances() != (path.depth() == 4)) {
+            // A resource with instances is written one instance at a time.
+            error = M2MSenMLCBORDeserializer::NotValid;
+        } else if(path.depth() == 4) {
+            error = write_resource_instance(*resource, &object_instance, path,
+                                            operation, update_value);
+        } else if(update_value) {
+            write_value(*resource);
+        } else if(0 == (resource->operation() & SN_GRS_PUT_ALLOWED)) {
+            tr_debug("M2MSenMLCBORDeserializer::write_resources() - NOT_ALLOWED");
+            error = M2MSenMLCBORDeserializer::NotAllowed;
+        }
+    }
+    if(M2MSenMLCBORDeserializer::None == error && _position != _size) {
+        error = M2MSenMLCBORDeserializer::NotValid;
+    }
+    return error;
+}
+
+M2MSenMLCBORDeserializer::Error M2MSenMLCBORDeserializer::write_resource_instances(M2MResource &resource,
+                                                                                   M2MSenMLCBORDeserializer::Operation operation,
+                                                                                   bool update_value)
+{
+    M2MSenMLCBORDeserializer::Error error = M2MSenMLCBORDeserializer::None;
+    for(uint64_t i = 0; i < _count && M2MSenMLCBORDeserializer::None == error; i++) {
+        String name;
+        M2MPath path;
+        if(!read_record(name, true) || !path.parse(name) || path.depth() != 4 ||
+           !path.equals(0, resource.object_name()) ||
+           path.id(1) != resource.object_instance_id() ||
+           !path.equals(2, resource.name())) {
+            return M2MSenMLCBORDeserializer::NotValid;
+        }
+        error = write_resource_instance(resource, NULL, path, operation, update_value);
+    }
+    if(M2MSenMLCBORDeserializer::None == error && _position != _size) {
+        error = M2MSenMLCBORDeserializer::NotValid;
+    }
+    return error;
+}
+
+M2MSenMLCBORDeserializer::Error M2MSenMLCBORDeserializer::write_resource_instance(M2MResource &resource,
+                                                                                  M2MObjectInstance *object_instance,
+                                                                                  const M2MPath &path,
+                                                                                  M2MSenMLCBORDeserializer::Operation operation,
+                                                                                  bool update_value)
+{
+    int32_t instance_id = path.id(3);
+    M2MResourceInstance *instance = NULL;
+    if(instance_id >= 0) {
+        instance = resource.resource_instance((uint16_t)instance_id);
+    }
+    if(instance) {
+        if(update_value) {
+            write_value(*instance);
+        } else if(0 == (instance->operation() & SN_GRS_PUT_ALLOWED)) {
+            return M2MSenMLCBORDeserializer::NotAllowed;
+        }
+        return M2MSenMLCBORDeserializer::None;
+    }
+    if(M2MSenMLCBORDeserializer::Post != operation || instance_id < 0) {
+        return M2MSenMLCBORDeserializer::NotFound;
+    }
+    // Only a write to the object instance creates resource instances,
+    // as with OMA-TLV.
+    if(!object_instance) {
+        return M2MSenMLCBORDeserializer::NotAllowed;
+    }
+    instance = object_instance->create_dynamic_resource_instance(resource.name(), "",
+                                                                 M2MResourceInstance::INTEGER,
+                                                                 true,
+                                                                 (uint16_t)instance_id);
+    if(!instance) {
+        return M2MSenMLCBORDeserializer::NotFound;
+    }
+    instance->set_operation(M2MBase::GET_PUT_POST_DELETE_ALLOWED);
+    if(update_value) {
+        write_value(*instance);
+    }
+    return M2MSenMLCBORDeserializer::None;
+}
+
+void M2MSenMLCBORDeserializer::write_value(M2MResourceInstance &resource_instance)
+{
+    if(_value_length > 0) {
+        resource_instance.set_value(_value, _value_length);
+    } else {
+        resource_instance.clear_value();
+    }
+}
+
+bool M2MSenMLCBORDeserializer::begin(const uint8_t *data, uint32_t size)
+{
+    _data = data;
+    _size = size;
+    _position = 0;
+    _base_name = NULL;
+    _base_name_length = 0;
+
+    uint8_t major_type;
+    return data && read_head(major_type, _count) &&
+           major_type == CBOR_ARRAY && _count > 0;
+}
+
+bool M2MSenMLCBORDeserializer::read_record(String &name, bool value_required)
+{
+    uint8_t major_type;
+    uint64_t pairs;
+    if(!read_head(major_type, pairs) || major_type != CBOR_MAP) {
+        return false;
+    }
+    // The base name stays in effect until the next record that sets one.
+    const char *record_name = NULL;
+    uint32_t name_length = 0;
+    _value = NULL;
+    _value_length = 0;
+    for(uint64_t j = 0; j < pairs; j++) {
+        int64_t label;
+        if(!read_label(label)) {
+            return false;
+        }
+        bool success;
+        if(label == SENML_BASE_NAME) {
+            success = read_text(_base_name, _base_name_length);
+        } else if(label == SENML_NAME) {
+            success = read_text(record_name, name_length);
+        } else if(label == SENML_VALUE || label == SENML_STRING_VALUE ||
+                  label == SENML_BOOLEAN_VALUE || label == SENML_DATA_VALUE ||
+                  label == OBJLNK_LABEL) {
+            success = read_value(label);
+        } else {
+            success = skip_item();
+        }
+        if(!success) {
+            return false;
+        }
+    }
+    if(_base_name_length + name_length == 0 || (value_required && !_value)) {
+        return false;
+    }
+    name.reserve(_base_name_length + name_length);
+    name.append(_base_name, _base_name_length);
+    name.append(record_name, name_length);
+    if(name[0] == '/') {
+        name.erase(0, 1);
+    }
+    return true;
+}
+
+bool M2MSenMLCBORDeserializer::read_value(int64_t label)
+{
+    uint32_t start = _position;
+    uint8_t major_type;
+    uint64_t value;
+    if(!read_head(major_type, value)) {
+        return false;
+    }
+    uint8_t info = _data[start] & 0x1F;
+    uint8_t expected_type = CBOR_TEXT;
+    if(label == SENML_VALUE) {
+        if(major_type == CBOR_SIMPLE) {
+            return read_real(info, value);
+        }
+        // The most negative integer is left out, its absolute value doesn't fit.
+        const uint64_t max = ((uint64_t)1 << 63) - 1;
+        if((major_type != CBOR_UNSIGNED && major_type != CBOR_NEGATIVE) ||
+           value > max || (major_type == CBOR_NEGATIVE && value == max)) {
+            return false;
+        }
+        int64_t integer = major_type == CBOR_UNSIGNED ? (int64_t)value : -1 - (int64_t)value;
+        _value_length = m2m::itoa_c(integer, _number);
+        _value = (const uint8_t*)_number;
+        return true;
+    } else if(label == SENML_BOOLEAN_VALUE) {
+        if(major_type != CBOR_SIMPLE ||
+           (info != CBOR_FALSE_INFO && info != CBOR_TRUE_INFO)) {
+            return false;
+        }
+        // Booleans are stored as "1" and "0", like get_value_int() expects.
+        _number[0] = info == CBOR_TRUE_INFO ? '1' : '0';
+        _number[1] = '\0';
+        _value_length = 1;
+        _value = (const uint8_t*)_number;
+        return true;
+    } else if(label == SENML_DATA_VALUE) {
+        expected_type = CBOR_BYTES;
+    }
+    if(major_type != expected_type || _size - _position < value) {
+        return false;
+    }
+    _value = _data + _position;
+    _value_length = (uint32_t)value;
+    _position += _value_length;
+    return true;
+}
+
+bool M2MSenMLCBORDeserializer::read_real(uint8_t info, uint64_t bits)
+{
+    double real;
+    bool single = true;
+    if(info == CBOR_FLOAT16_INFO) {
+        uint16_t exponent = (bits >> 10) & 0x1F;
+        uint16_t mantissa = bits & 0x3FF;
+        if(exponent == 0x1F) {
+            return false;
+        }
+        // Subnormal halves are mantissa * 2^-24, normal ones (1024 + mantissa) * 2^(exponent - 25).
+        real = exponent == 0 ? mantissa / 16777216.0 :
+                               (mantissa | 0x400) * (double)(1UL << exponent) / 33554432.0;
+        if(bits & 0x8000) {
+            real = -real;
+        }
+    } else if(info == CBOR_FLOAT32_INFO) {
+        uint32_t single_bits = (uint32_t)bits;
+        float value;
+        memcpy(&value, &single_bits, sizeof(value));
+        real = value;
+    } else if(info == CBOR_FLOAT64_INFO) {
+        memcpy(&real, &bits, sizeof(real));
+        single = false;
+    } else {
+        return false;
+    }
+    _value_length = m2m::dtoa_c(real, single, _number, SENML_NUMBER_BUFFER_SIZE);
+    if(_value_length == 0) {
+        return false;
+    }
+    _value = (const uint8_t*)_number;
+    return true;
+}
+
+bool M2MSenMLCBORDeserializer::read_head(uint8_t &major_type, uint64_t &value)
+{
+    if(_position >= _size) {
+        return false;
+    }
+    uint8_t initial = _data[_position++];
+    major_type = initial >> 5;
+    uint8_t info = initial & 0x1F;
+    if(info < 24) {
+        value = info;
+        return true;
+    }
+    if(info > 27) {
+        // Indefinite lengths are not used in SenML-CBOR.
+        return false;
+    }
+    uint8_t length = 1 << (info - 24);
+    if(_size - _position < length) {
+        return false;
+    }
+    value = 0;
+    for(uint8_t i = 0; i < length; i++) {
+        value = (value << 8) | _data[_position++];
+    }
+    return true;
+}
+
+bool M2MSenMLCBORDeserializer::read_label(int64_t &label)
+{
+    uint8_t major_type;
+    uint64_t value;
+    if(!read_head(major_type, value)) {
+        return false;
+    }
+    if(major_type == CBOR_UNSIGNED) {
+        label = (int64_t)value;
+    } else if(major_type == CBOR_NEGATIVE) {
+        label = -1 - (int64_t)value;
+    } else if(major_type == CBOR_TEXT && _size - _position >= value) {
+        const char *text = (const char*)_data + _position;
+        _position += (uint32_t)value;
+        label = (value == strlen(SENML_OBJLNK_VALUE) &&
+                 memcmp(text, SENML_OBJLNK_VALUE, value) == 0) ? OBJLNK_LABEL : UNKNOWN_LABEL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool M2MSenMLCBORDeserializer::read_text(const char *&text, uint32_t &length)
+{
+    uint8_t major_type;
+    uint64_t value;
+    if(!read_head(major_type, value) || major_type != CBOR_TEXT ||
+       _size - _position < value) {
+        return false;
+    }
+    text = (const char*)_data + _position;
+    length = (uint32_t)value;
+    _position += length;
+    return true;
+}
+
+bool M2MSenMLCBORDeserializer::skip_item(uint8_t depth)
+{
+    uint8_t major_type;
+    uint64_t value;
+    if(depth > MAX_NESTING_DEPTH || !read_head(major_type, value)) {
+        return false;
+    }
+    switch(major_type) {
+        case CBOR_BYTES:
+        case CBOR_TEXT:
+            if(_size - _position < value) {
+                return false;
+            }
+            _position += (uint32_t)value;
+            break;
+        case CBOR_MAP:
+            if(value > _size) {
+                return false;
+            }
+            value *= 2;
+            // fall through
+        case CBOR_ARRAY:
+            // Every item takes at least a byte, which bounds the loop.
+            if(value > _size - _position) {
+                return false;
+            }
+            for(uint64_t i = 0; i < value; i++) {
+                if(!skip_item(depth + 1)) {
+                    return false;
+                }
+            }
+            break;
+        case CBOR_TAG:
+            return skip_item(depth + 1);
+        default:
+            // Integers, simple values and floats are complete after the head.
+            break;
+    }
+    return true;
+}
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "include/m2msenmlcborserializer.h"
+#include "include/m2msamplebuffer.h"
+#include "mbed-client/m2mconstants.h"
+
+#define TRACE_GROUP "mClt"
+
+// Room kept in front of the records for the array header, which can only
+// be written once the number of records is known.
+#define ARRAY_HEADER_SIZE 5
+#define MINIMUM_CAPACITY 64
+#define NUMBER_BUFFER_SIZE 32
+
+// CBOR major types, RFC 7049 chapter 2.1
+#define CBOR_UNSIGNED 0
+#define CBOR_NEGATIVE 1
+#define CBOR_BYTES 2
+#define CBOR_TEXT 3
+#define CBOR_ARRAY 4
+#define CBOR_MAP 5
+#define CBOR_SIMPLE 7
+
+#define CBOR_FALSE 0xF4
+#define CBOR_TRUE 0xF5
+#define CBOR_FLOAT32 0xFA
+#define CBOR_FLOAT64 0xFB
+
+M2MSenMLCBORSerializer::M2MSenMLCBORSerializer()
+: _data(NULL),
+  _size(0),
+  _capacity(0),
+  _count(0),
+  _base_instance(-1),
+  _failed(false)
+{
+}
+
+M2MSenMLCBORSerializer::~M2MSenMLCBORSerializer()
+{
+    free(_data);
+}
+
+bool M2MSenMLCBORSerializer::append(M2MObject *object)
+{
+    bool success = false;
+    if(object) {
+        success = true;
+        const M2MObjectInstanceList &list = object->instances();
+        M2MObjectInstanceList::const_iterator it = list.begin();
+        for (; it != list.end(); it++) {
+            success = append(object->name(), *it) && success;
+        }
+    }
+    return success;
+}
+
+bool M2MSenMLCBORSerializer::append(const String &object_name, M2MObjectInstance *object_instance)
+{
+    bool success = false;
+    if(object_instance) {
+        success = true;
+        const M2MResourceList &list = object_instance->resources();
+        M2MResourceList::const_iterator it = list.begin();
+        for (; it != list.end(); it++) {
+            success = append(object_name, object_instance->instance_id(), *it) && success;
+        }
+    }
+    return success;
+}
+
+bool M2MSenMLCBORSerializer::append(const String &object_name, uint16_t object_instance_id,
+                                    M2MResource *resource)
+{
+    bool success = false;
+    if(resource) {
+        if(resource->supports_multiple_instances()) {
+            success = true;
+            const M2MResourceInstanceList &list = resource->resource_instances();
+            M2MResourceInstanceList::const_iterator it = list.begin();
+            for (; it != list.end(); it++) {
+                success = append_record(object_name, object_instance_id, *it, true) && success;
+            }
+        } else {
+            success = append_record(object_name, object_instance_id, resource, false);
+        }
+    }
+    return success;
+}
+
+bool M2MSenMLCBORSerializer::append(const String &object_name, uint16_t object_instance_id,
+                                    M2MResourceInstance *resource_instance)
+{
+    bool success = false;
+    if(resource_instance) {
+        success = append_record(object_name, object_instance_id, resource_instance, true);
+    }
+    return success;
+}
+
+bool M2MSenMLCBORSerializer::append(const String &object_name, uint16_t object_instance_id,
+                                    M2MResourceInstance *resource, const M2MSampleBuffer &samples,
+                                    uint64_t now)
+{
+    bool success = false;
+    if(resource) {
+        success = true;
+        bool resource_instance = M2MBase::ResourceInstance == resource->base_type();
+        uint64_t time = 0;
+        const uint8_t *value = NULL;
+        uint32_t length = 0;
+        for(uint16_t i = 0; samples.sample(i, time, value, length); i++) {
+            // Microseconds since the sample to seconds before now.
+            bool timed = now > 0 && time > 0 && time <= now;
+            double relative = timed ? -(double)(now - time) / 1000000.0 : 0;
+            success = write_record(object_name, object_instance_id, resource, resource_instance,
+                                   value, length, timed, relative) && success;
+        }
+    }
+    return success;
+}
+
+uint32_t M2MSenMLCBORSerializer::record_count() const
+{
+    return _count;
+}
+
+uint8_t* M2MSenMLCBORSerializer::serialize(uint32_t &size)
+{
+    uint8_t *data = NULL;
+    size = 0;
+    if(!_failed && _count > 0) {
+        uint32_t header_size = _count < 24 ? 1 :
+                               _count < 256 ? 2 :
+                               _count < 65536 ? 3 : 5;
+        // Write the header right in front of the records and move
+        // everything to the start of the buffer.
+        uint32_t records_size = _size - ARRAY_HEADER_SIZE;
+        _size = ARRAY_HEADER_SIZE - header_size;
+        write_head(CBOR_ARRAY, _count);
+        memmove(_data, _data + ARRAY_HEADER_SIZE - header_size, header_size + records_size);
+        data = _data;
+        size = header_size + records_size;
+        _data = NULL;
+    }
+    reset();
+    return data;
+}
+
+bool M2MSenMLCBORSerializer::append_record(const String &object_name, uint16_t object_instance_id,
+                                           M2MResourceInstance *resource, bool resource_instance)
+{
+    resource->update_value();
+    const uint8_t *value = resource->value();
+    uint32_t length = value ? resource->value_length() : 0;
+    return write_record(object_name, object_instance_id, resource, resource_instance,
+                        value, length, false, 0);
+}
+
+bool M2MSenMLCBORSerializer::write_record(const String &object_name, uint16_t object_instance_id,
+                                          M2MResourceInstance *resource, bool resource_instance,
+                                          const uint8_t *value, uint32_t length,
+                                          bool timed, double time)
+{
+    bool new_base = (int32_t)object_instance_id != _base_instance ||
+                    !(_base_object == object_name);
+    write_head(CBOR_MAP, (new_base ? 3 : 2) + (timed ? 1 : 0));
+    if(new_base) {
+        write_base_name(object_name, object_instance_id);
+    }
+    write_name(resource, resource_instance);
+    if(timed) {
+        write_integer(SENML_TIME);
+        write_double(time);
+    }
+    write_value(resource->resource_instance_type(), (const char*)value, length);
+    if(!_failed) {
+        _count++;
+    }
+    return !_failed;
+}
+
+void M2MSenMLCBORSerializer::write_base_name(const String &object_name, uint16_t object_instance_id)
+{
+    // "/<object>/<instance>/"
+    char id[NUMBER_BUFFER_SIZE];
+    uint32_t id_length = m2m::itoa_c(object_instance_id, id);
+    write_integer(SENML_BASE_NAME);
+    write_head(CBOR_TEXT, object_name.size() + id_length + 3);
+    uint8_t *text = reserve(object_name.size() + id_length + 3);
+    if(text) {
+        *text++ = '/';
+        memcpy(text, object_name.c_str(), object_name.size());
+        text += object_name.size();
+        *text++ = '/';
+        memcpy(text, id, id_length);
+        text += id_length;
+        *text = '/';
+    }
+    _base_object = object_name;
+    _base_instance = object_instance_id;
+}
+
+void M2MSenMLCBORSerializer::write_name(M2MResourceInstance *resource, bool resource_instance)
+{
+    // "<resource>" or "<resource>/<instance>"
+    const String &name = resource->name();
+    char id[NUMBER_BUFFER_SIZE];
+    uint32_t id_length = 0;
+    if(resource_instance) {
+        id[0] = '/';
+        id_length = m2m::itoa_c(resource->instance_id(), id + 1) + 1;
+    }
+    write_integer(SENML_NAME);
+    write_head(CBOR_TEXT, name.size() + id_length);
+    uint8_t *text = reserve(name.size() + id_length);
+    if(text) {
+        memcpy(text, name.c_str(), name.size());
+        memcpy(text + name.size(), id, id_length);
+    }
+}
+
+void M2MSenMLCBORSerializer::write_value(M2MResourceInstance::ResourceType type,
+                                         const char *value, uint32_t length)
+{
+    // Numbers are stored as text, anything that doesn't parse
+    // completely is sent as a string value instead.
+    char number[NUMBER_BUFFER_SIZE];
+    bool numeric = length > 0 && length < NUMBER_BUFFER_SIZE;
+    if(numeric) {
+        memcpy(number, value, length);
+        number[length] = '\0';
+    }
+    char *end = NULL;
+
+    switch(type) {
+        case M2MResourceInstance::INTEGER:
+        case M2MResourceInstance::TIME:
+            if(numeric) {
+                int64_t integer = strtoll(number, &end, 10);
+                if(*end == '\0') {
+                    write_integer(SENML_VALUE);
+                    write_integer(integer);
+                    return;
+                }
+            }
+            break;
+        case M2MResourceInstance::FLOAT:
+            if(numeric) {
+                double real = strtod(number, &end);
+                if(*end == '\0') {
+                    write_integer(SENML_VALUE);
+                    write_double(real);
+                    return;
+                }
+            }
+            break;
+        case M2MResourceInstance::BOOLEAN: {
+            bool flag = (length == 1 && value[0] == '1') ||
+                        (length == 4 && memcmp(value, "true", 4) == 0);
+            write_integer(SENML_BOOLEAN_VALUE);
+            write_head(CBOR_SIMPLE, flag ? CBOR_TRUE & 0x1F : CBOR_FALSE & 0x1F);
+            return;
+        }
+        case M2MResourceInstance::OPAQUE:
+            write_integer(SENML_DATA_VALUE);
+            write_bytes((const uint8_t*)value, length);
+            return;
+        case M2MResourceInstance::OBJLINK:
+            write_text(SENML_OBJLNK_VALUE, strlen(SENML_OBJLNK_VALUE));
+            write_text(value, length);
+            return;
+        default:
+            break;
+    }
+    write_integer(SENML_STRING_VALUE);
+    write_text(value, length);
+}
+
+void M2MSenMLCBORSerializer::write_head(uint8_t major_type, uint64_t value)
+{
+    uint8_t length = value < 24 ? 0 :
+                     value <= 0xFF ? 1 :
+                     value <= 0xFFFF ? 2 :
+                     value <= 0xFFFFFFFF ? 4 : 8;
+    uint8_t *head = reserve(length + 1);
+    if(head) {
+        // Additional information 24, 25, 26 and 27 mean 1, 2, 4 and 8 bytes follow.
+        uint8_t info = length == 0 ? (uint8_t)value :
+                       length == 1 ? 24 :
+                       length == 2 ? 25 :
+                       length == 4 ? 26 : 27;
+        *head++ = (major_type << 5) | info;
+        for(uint8_t i = length; i > 0; i--) {
+            *head++ = (uint8_t)(value >> ((i - 1) * 8));
+        }
+    }
+}
+
+void M2MSenMLCBORSerializer::write_integer(int64_t value)
+{
+    if(value < 0) {
+        write_head(CBOR_NEGATIVE, (uint64_t)(-(value + 1)));
+    } else {
+        write_head(CBOR_UNSIGNED, (uint64_t)value);
+    }
+}
+
+void M2MSenMLCBORSerializer::write_double(double value)
+{
+    // Use single precision whenever it holds the value exactly.
+    float single = (float)value;
+    if((double)single == value) {
+        uint32_t bits = 0;
+        memcpy(&bits, &single, sizeof(bits));
+        uint8_t *data = reserve(5);
+        if(data) {
+            *data++ = CBOR_FLOAT32;
+            for(int i = 3; i >= 0; i--) {
+                *data++ = (uint8_t)(bits >> (i * 8));
+            }
+        }
+    } else {
+        uint64_t bits = 0;
+        memcpy(&bits, &value, sizeof(bits));
+        uint8_t *data = reserve(9);
+        if(data) {
+            *data++ = CBOR_FLOAT64;
+            for(int i = 7; i >= 0; i--) {
+                *data++ = (uint8_t)(bits >> (i * 8));
+            }
+        }
+    }
+}
+
+void M2MSenMLCBORSerializer::write_text(const char *text, uint32_t length)
+{
+    write_head(CBOR_TEXT, length);
+    uint8_t *data = reserve(length);
+    if(data && length > 0) {
+        memcpy(data, text, length);
+    }
+}
+
+void M2MSenMLCBORSerializer::write_bytes(const uint8_t *bytes, uint32_t length)
+{
+    write_head(CBOR_BYTES, length);
+    uint8_t *data = reserve(length);
+    if(data && length > 0) {
+        memcpy(data, bytes, length);
+    }
+}
+
+uint8_t* M2MSenMLCBORSerializer::reserve(uint32_t length)
+{
+    if(_failed) {
+        return NULL;
+    }
+    if(_data == NULL) {
+        _size = ARRAY_HEADER_SIZE;
+    }
+    if(_size + length > _capacity) {
+        uint32_t capacity = _capacity ? _capacity * 2 : MINIMUM_CAPACITY;
+        if(capacity < _size + length) {
+            capacity = _size + length;
+        }
+        uint8_t *data = (uint8_t*)realloc(_data, capacity);
+        if(data == NULL) {
+            _failed = true;
+            return NULL;
+        }
+        _data = data;
+        _capacity = capacity;
+    }
+    uint8_t *position = _data + _size;
+    _size += length;
+    return position;
+}
+
+void M2MSenMLCBORSerializer::reset()
+{
+    free(_data);
+    _data = NULL;
+    _size = 0;
+    _capacity = 0;
+    _count = 0;
+    _base_object.clear();
+    _base_instance = -1;
+    _failed = false;
+}
@@ -20,10 +20,62 @@
 #include "mbed-client/m2mobjectinstance.h"
 #include "mbed-client/m2mresource.h"
 #include "mbed-client/m2mstring.h"
+#include "include/m2mobjectmodel.h"
 
 #define TRACE_GROUP "mClt"
 
-#define BUFFER_SIZE 21
+#define M2M_SERVER_RESOURCE_COUNT   (M2MServer::RegistrationUpdate + 1)
+
+// Resource models of the Server object, indexed by M2MServer::ServerResource.
+static const M2MObjectModel::Resource __m2m_server_resources[] = {
+    // ShortServerID
+    { "0", M2MResourceInstance::INTEGER, M2MBase::GET_PUT_ALLOWED,
+      M2MObjectModel::Mandatory | M2MObjectModel::Observable, 0, 0, NULL },
+    // Lifetime
+    { "1", M2MResourceInstance::INTEGER, M2MBase::GET_PUT_POST_ALLOWED,
+      M2MObjectModel::Mandatory | M2MObjectModel::Observable, 0, 0, NULL },
+    // DefaultMinPeriod
+    { "2", M2MResourceInstance::INTEGER, M2MBase::GET_PUT_POST_ALLOWED,
+      M2MObjectModel::Observable, 0, 0, NULL },
+    // DefaultMaxPeriod
+    { "3", M2MResourceInstance::INTEGER, M2MBase::GET_PUT_POST_ALLOWED,
+      M2MObjectModel::Observable, 0, 0, NULL },
+    // Disable
+    { "4", M2MResourceInstance::OPAQUE,  M2MBase::POST_ALLOWED,
+      0, 0, 0, NULL },
+    // DisableTimeout
+    { "5", M2MResourceInstance::INTEGER, M2MBase::GET_PUT_POST_ALLOWED,
+      M2MObjectModel::Observable, 0, 0, NULL },
+    // NotificationStorage
+    { "6", M2MResourceInstance::BOOLEAN, M2MBase::GET_PUT_POST_ALLOWED,
+      M2MObjectModel::Mandatory | M2MObjectModel::Observable, 0, 0, NULL },
+    // Binding
+    { "7", M2MResourceInstance::STRING,  M2MBase::GET_PUT_POST_ALLOWED,
+      M2MObjectModel::Mandatory | M2MObjectModel::Observable, 0, 0, NULL },
+    // RegistrationUpdate
+    { "8", M2MResourceInstance::OPAQUE,  M2MBase::POST_ALLOWED,
+      M2MObjectModel::Mandatory, 0, 0, NULL }
+};
+
+// Fails to compile if the table and the enum go out of sync.
+typedef char __m2m_server_resources_check[
+    (sizeof(__m2m_server_resources) / sizeof(__m2m_server_resources[0]) ==
+     M2M_SERVER_RESOURCE_COUNT) ? 1 : -1];
+
+static const M2MObjectModel::Resource* server_model(M2MServer::ServerResource resource)
+{
+    if((unsigned)resource < M2M_SERVER_RESOURCE_COUNT) {
+        return &__m2m_server_resources[resource];
+    }
+    return NULL;
+}
+
+// Integer accessors also cover the boolean resources.
+static bool has_integer_value(const M2MObjectModel::Resource *model)
+{
+    return M2MResourceInstance::INTEGER == model->type ||
+           M2MResourceInstance::BOOLEAN == model->type;
+}
 
 M2MServer::M2MServer()
 : M2MObject(M2M_SERVER_ID)
@@ -32,44 +84,10 @@ M2MServer::M2MServer()
 
     _server_instance = object_instance();
 
-    if(_server_instance) {
-
-        M2MResource* res = _server_instance->create_dynamic_resource(SERVER_SHORT_SERVER_ID,
-                                                                     OMA_RESOURCE_TYPE,
-                                                                     M2MResourceInstance::INTEGER,
-                                                                     true);
-        if(res) {
-            res->set_operation(M2MBase::GET_PUT_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SERVER_LIFETIME,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::INTEGER,
-                                                        true);
-        if(res) {
-            res->set_operation(M2MBase::GET_PUT_POST_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SERVER_NOTIFICATION_STORAGE,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::BOOLEAN,
-                                                        true);
-        if(res) {
-            res->set_operation(M2MBase::GET_PUT_POST_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SERVER_BINDING,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::STRING,
-                                                        true);
-        if(res) {
-            res->set_operation(M2MBase::GET_PUT_POST_ALLOWED);
-        }
-        res = _server_instance->create_dynamic_resource(SERVER_REGISTRATION_UPDATE,
-                                                        OMA_RESOURCE_TYPE,
-                                                        M2MResourceInstance::OPAQUE,
-                                                        false);
-        if(res) {
-          res->set_operation(M2MBase::POST_ALLOWED);
-        }
-    }
+    M2MObjectModel::create_mandatory_resources(_server_instance,
+                                               __m2m_server_resources,
+                                               M2M_SERVER_RESOURCE_COUNT,
+                                               true);
 }
 
 M2MServer::~M2MServer()
@@ -80,40 +98,14 @@ M2MServer::~M2MServer()
 M2MResource* M2MServer::create_resource(ServerResource resource, uint32_t value)
 {
     M2MResource* res = NULL;
-    String server_id = "";
-    if(!is_resource_present(resource)) {
-        switch(resource) {
-        case DefaultMinPeriod:
-            server_id = SERVER_DEFAULT_MIN_PERIOD;
-            break;
-        case DefaultMaxPeriod:
-            server_id = SERVER_DEFAULT_MAX_PERIOD;
-            break;
-        case DisableTimeout:
-            server_id = SERVER_DISABLE_TIMEOUT;
-            break;
-        default:
-            break;
-        }
-    }
-    if(!server_id.empty()) {
-        if(_server_instance) {
-            res = _server_instance->create_dynamic_resource(server_id,
-                                                            OMA_RESOURCE_TYPE,
-                                                            M2MResourceInstance::INTEGER,
-                                                            true);
-            if(res) {
-                res->set_operation(M2MBase::GET_PUT_POST_ALLOWED);
-                // If resource is created then set the value.                
-                char *buffer = (char*)malloc(BUFFER_SIZE);
-                if(buffer) {
-                    uint32_t size = m2m::itoa_c(value, buffer);
-                    if (size <= BUFFER_SIZE) {
-                        res->set_value((const uint8_t*)buffer, size);
-                    }
-                    free(buffer);
-                }
-            }
+    const M2MObjectModel::Resource *model = server_model(resource);
+    if(model && !is_resource_present(resource) &&
+       M2MResourceInstance::INTEGER == model->type &&
+       !(model->flags & M2MObjectModel::Mandatory)) {
+        res = M2MObjectModel::create_resource(_server_instance, *model, true);
+        if(res) {
+            // If resource is created then set the value.
+            M2MObjectModel::set_int_value(res, value);
         }
     }
     return res;
@@ -122,18 +114,11 @@ M2MResource* M2MServer::create_resource(ServerResource resource, uint32_t value)
 M2MResource* M2MServer::create_resource(ServerResource resource)
 {
     M2MResource* res = NULL;
-    if(!is_resource_present(resource)) {
-        if(M2MServer::Disable == resource) {
-                if(_server_instance) {
-                    res = _server_instance->create_dynamic_resource(SERVER_DISABLE,
-                                                                    OMA_RESOURCE_TYPE,
-                                                                    M2MResourceInstance::OPAQUE,
-                                                                    false);
-                if(res) {
-                    res->set_operation(M2MBase::POST_ALLOWED);
-                }
-            }
-        }
+    const M2MObjectModel::Resource *model = server_model(resource);
+    if(model && !is_resource_present(resource) &&
+       M2MResourceInstance::OPAQUE == model->type &&
+       !(model->flags & M2MObjectModel::Mandatory)) {
+        res = M2MObjectModel::create_resource(_server_instance, *model, true);
     }
     return res;
 }
@@ -141,26 +126,10 @@ M2MResource* M2MServer::create_resource(ServerResource resource)
 bool M2MServer::delete_resource(ServerResource resource)
 {
     bool success = false;
-    String server_id = "";
-    switch(resource) {
-        case DefaultMinPeriod:
-           server_id = SERVER_DEFAULT_MIN_PERIOD;
-           break;
-        case DefaultMaxPeriod:
-            server_id = SERVER_DEFAULT_MAX_PERIOD;
-            break;
-        case Disable:
-            server_id = SERVER_DISABLE;
-            break;
-        case DisableTimeout:
-            server_id = SERVER_DISABLE_TIMEOUT;
-            break;
-        default:
-            break;
-    }
-    if(!server_id.empty()) {
+    const M2MObjectModel::Resource *model = server_model(resource);
+    if(model && !(model->flags & M2MObjectModel::Mandatory)) {
         if(_server_instance) {
-            success = _server_instance->remove_resource(server_id);
+            success = _server_instance->remove_resource(model->name);
         }
     }
     return success;
@@ -171,7 +140,7 @@ bool M2MServer::set_resource_value(ServerResource resource,
 {
     bool success = false;
     M2MResource* res = get_resource(resource);
-    if(res && (M2MServer::Binding == resource)) {
+    if(res && M2MResourceInstance::STRING == server_model(resource)->type) {
         success = res->set_value((const uint8_t*)value.c_str(),(uint32_t)value.length());
     }
     return success;
@@ -182,24 +151,8 @@ bool M2MServer::set_resource_value(ServerResource resource,
 {
     bool success = false;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MServer::ShortServerID == resource     ||
-           M2MServer::Lifetime == resource          ||
-           M2MServer::DefaultMinPeriod == resource  ||
-           M2MServer::DefaultMaxPeriod == resource  ||
-           M2MServer::DisableTimeout == resource    ||
-           M2MServer::NotificationStorage == resource) {
-            // If it is any of the above resource
-            // set the value of the resource.
-            char *buffer = (char*)malloc(BUFFER_SIZE);
-            if(buffer) {
-                uint32_t size = m2m::itoa_c(value, buffer);
-                if (size <= BUFFER_SIZE) {
-                    success = res->set_value((const uint8_t*)buffer, size);
-                }
-                free(buffer);
-            }
-        }
+    if(res && has_integer_value(server_model(resource))) {
+        success = M2MObjectModel::set_int_value(res, value);
     }
     return success;
 }
@@ -208,7 +161,7 @@ String M2MServer::resource_value_string(ServerResource resource) const
 {
     String value = "";
     M2MResource* res = get_resource(resource);
-    if(res && (M2MServer::Binding == resource)) {
+    if(res && M2MResourceInstance::STRING == server_model(resource)->type) {
         uint8_t* buffer = NULL;
         uint32_t length = 0;
         res->get_value(buffer,length);
@@ -220,9 +173,7 @@ String M2MServer::resource_value_string(ServerResource resource) const
 
             String s_name(char_buffer);
             value = s_name;
-            if(char_buffer) {
-                free(char_buffer);
-            }
+            free(char_buffer);
         }
         if(buffer) {
             free(buffer);
@@ -236,21 +187,14 @@ uint32_t M2MServer::resource_value_int(ServerResource resource) const
 {
     uint32_t value = 0;
     M2MResource* res = get_resource(resource);
-    if(res) {
-        if(M2MServer::ShortServerID == resource     ||
-           M2MServer::Lifetime == resource          ||
-           M2MServer::DefaultMinPeriod == resource  ||
-           M2MServer::DefaultMaxPeriod == resource  ||
-           M2MServer::DisableTimeout == resource    ||
-           M2MServer::NotificationStorage == resource) {
-            // Get the value and convert it into integer
-            uint8_t* buffer = NULL;
-            uint32_t length = 0;
-            res->get_value(buffer,length);
-            if(buffer) {
-                value = atoi((const char*)buffer);
-                free(buffer);
-            }
+    if(res && has_integer_value(server_model(resource))) {
+        // Get the value and convert it into integer
+        uint8_t* buffer = NULL;
+        uint32_t length = 0;
+        res->get_value(buffer,length);
+        if(buffer) {
+            value = atoi((const char*)buffer);
+            free(buffer);
         }
     }
     return value;
@@ -278,40 +222,9 @@ uint16_t M2MServer::total_resource_count() const
 M2MResource* M2MServer::get_resource(ServerResource res) const
 {
     M2MResource* res_object = NULL;
-    String res_name = "";
-    switch(res) {
-    case ShortServerID:
-        res_name = SERVER_SHORT_SERVER_ID;
-        break;
-    case Lifetime:
-        res_name = SERVER_LIFETIME;
-        break;
-    case DefaultMinPeriod:
-        res_name = SERVER_DEFAULT_MIN_PERIOD;
-        break;
-    case DefaultMaxPeriod:
-        res_name = SERVER_DEFAULT_MAX_PERIOD;
-        break;
-    case Disable:
-        res_name = SERVER_DISABLE;
-        break;
-    case DisableTimeout:
-        res_name = SERVER_DISABLE_TIMEOUT;
-        break;
-    case NotificationStorage:
-        res_name = SERVER_NOTIFICATION_STORAGE;
-        break;
-    case Binding:
-        res_name = SERVER_BINDING;
-        break;
-    case RegistrationUpdate:
-        res_name = SERVER_REGISTRATION_UPDATE;
-        break;
-    }
-    if(!res_name.empty()) {
-        if(_server_instance) {
-        res_object = _server_instance->resource(res_name);
-        }
+    const M2MObjectModel::Resource *model = server_model(res);
+    if(_server_instance && model) {
+        res_object = _server_instance->resource(model->name);
     }
     return res_object;
 }
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include "include/m2msha256.h"
+
+#define ROTR(x,n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+M2MSha256::M2MSha256()
+{
+    reset();
+}
+
+M2MSha256::~M2MSha256()
+{
+}
+
+void M2MSha256::reset()
+{
+    _state[0] = 0x6a09e667;
+    _state[1] = 0xbb67ae85;
+    _state[2] = 0x3c6ef372;
+    _state[3] = 0xa54ff53a;
+    _state[4] = 0x510e527f;
+    _state[5] = 0x9b05688c;
+    _state[6] = 0x1f83d9ab;
+    _state[7] = 0x5be0cd19;
+    _total_length = 0;
+    _buffer_length = 0;
+    memset(_buffer, 0, sizeof(_buffer));
+}
+
+void M2MSha256::update(const uint8_t *data, uint32_t length)
+{
+    if(!data) {
+        return;
+    }
+    _total_length += length;
+    while(length > 0) {
+        if(_buffer_length == 0 && length >= sizeof(_buffer)) {
+            process_block(data);
+            data += sizeof(_buffer);
+            length -= sizeof(_buffer);
+        } else {
+            uint32_t copy = sizeof(_buffer) - _buffer_length;
+            if(copy > length) {
+                copy = length;
+            }
+            memcpy(_buffer + _buffer_length, data, copy);
+            _buffer_length += copy;
+            data += copy;
+            length -= copy;
+            if(_buffer_length == sizeof(_buffer)) {
+                process_block(_buffer);
+                _buffer_length = 0;
+            }
+        }
+    }
+}
+
+void M2MSha256::finish(uint8_t *digest)
+{
+    uint64_t bit_length = _total_length * 8;
+    _buffer[_buffer_length++] = 0x80;
+    if(_buffer_length > 56) {
+        memset(_buffer + _buffer_length, 0, sizeof(_buffer) - _buffer_length);
+        process_block(_buffer);
+        _buffer_length = 0;
+    }
+    memset(_buffer + _buffer_length, 0, 56 - _buffer_length);
+    for(int i = 0; i < 8; i++) {
+        _buffer[63 - i] = (uint8_t)(bit_length >> (8 * i));
+    }
+    process_block(_buffer);
+
+    if(digest) {
+        for(int i = 0; i < 8; i++) {
+            digest[i * 4] = (uint8_t)(_state[i] >> 24);
+            digest[i * 4 + 1] = (uint8_t)(_state[i] >> 16);
+            digest[i * 4 + 2] = (uint8_t)(_state[i] >> 8);
+            digest[i * 4 + 3] = (uint8_t)_state[i];
+        }
+    }
+    reset();
+}
+
+void M2MSha256::process_block(const uint8_t *block)
+{
+    uint32_t w[64];
+    for(int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[i * 4] << 24) |
+               ((uint32_t)block[i * 4 + 1] << 16) |
+               ((uint32_t)block[i * 4 + 2] << 8) |
+               ((uint32_t)block[i * 4 + 3]);
+    }
+    for(int i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = _state[0];
+    uint32_t b = _state[1];
+    uint32_t c = _state[2];
+    uint32_t d = _state[3];
+    uint32_t e = _state[4];
+    uint32_t f = _state[5];
+    uint32_t g = _state[6];
+    uint32_t h = _state[7];
+
+    for(int i = 0; i < 64; i++) {
+        uint32_t s1 = ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+        uint32_t s0 = ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    _state[0] += a;
+    _state[1] += b;
+    _state[2] += c;
+    _state[3] += d;
+    _state[4] += e;
+    _state[5] += f;
+    _state[6] += g;
+    _state[7] += h;
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include "mbed-client/m2mstatistics.h"
+#include "mbed-client/m2mconstants.h"
+#include "mbed-client/m2minterfacefactory.h"
+#include "mbed-client/m2mobject.h"
+#include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mresource.h"
+#include "include/m2mtrace.h"
+
+#define TRACE_GROUP "mClt"
+
+// Number of recently sent confirmable message IDs remembered for
+// detecting retransmissions.
+#define RECENT_MESSAGE_IDS 8
+
+static uint32_t __m2m_statistics[M2MStatistics::StatisticCount];
+static M2MStatistics::clock_function __m2m_clock = NULL;
+static uint16_t __m2m_recent_ids[RECENT_MESSAGE_IDS];
+static uint8_t __m2m_recent_count = 0;
+static uint8_t __m2m_recent_next = 0;
+static uint64_t __m2m_update_sent = 0;
+
+uint32_t M2MStatistics::value(M2MStatistics::Statistic statistic)
+{
+    if(statistic >= StatisticCount) {
+        return 0;
+    }
+    return __m2m_statistics[statistic];
+}
+
+uint32_t M2MStatistics::average_message_size()
+{
+    uint32_t messages = __m2m_statistics[MessagesSent] +
+                        __m2m_statistics[MessagesReceived];
+    if(!messages) {
+        return 0;
+    }
+    return (__m2m_statistics[BytesSent] + __m2m_statistics[BytesReceived]) / messages;
+}
+
+void M2MStatistics::reset()
+{
+    tr_debug("M2MStatistics::reset()");
+    // The heap usage is a level, not a count.
+    uint32_t heap = __m2m_statistics[HeapBytes];
+    memset(__m2m_statistics, 0, sizeof(__m2m_statistics));
+    __m2m_statistics[HeapBytes] = heap;
+    __m2m_recent_count = 0;
+    __m2m_recent_next = 0;
+    __m2m_update_sent = 0;
+}
+
+void M2MStatistics::set_clock(clock_function clock)
+{
+    __m2m_clock = clock;
+}
+
+uint64_t M2MStatistics::now()
+{
+    return __m2m_clock ? __m2m_clock() : 0;
+}
+
+void M2MStatistics::increment(M2MStatistics::Statistic statistic, uint32_t amount)
+{
+    if(statistic < StatisticCount) {
+        __m2m_statistics[statistic] += amount;
+    }
+}
+
+void M2MStatistics::set(M2MStatistics::Statistic statistic, uint32_t value)
+{
+    if(statistic < StatisticCount) {
+        __m2m_statistics[statistic] = value;
+    }
+}
+
+void M2MStatistics::message_sent(const uint8_t *data, uint16_t length)
+{
+    __m2m_statistics[MessagesSent]++;
+    __m2m_statistics[BytesSent] += length;
+    if(length > __m2m_statistics[MaxMessageSize]) {
+        __m2m_statistics[MaxMessageSize] = length;
+    }
+    // CoAP header: version and type in bits 7-4 of the first byte,
+    // message ID in bytes 2 and 3. Type 0 is confirmable.
+    if(!data || length < 4 || ((data[0] >> 4) & 0x03) != 0) {
+        return;
+    }
+    uint16_t msg_id = (data[2] << 8) | data[3];
+    for(uint8_t i = 0; i < __m2m_recent_count; i++) {
+        if(__m2m_recent_ids[i] == msg_id) {
+            __m2m_statistics[Retransmissions]++;
+            return;
+        }
+    }
+    __m2m_recent_ids[__m2m_recent_next] = msg_id;
+    __m2m_recent_next = (__m2m_recent_next + 1) % RECENT_MESSAGE_IDS;
+    if(__m2m_recent_count < RECENT_MESSAGE_IDS) {
+        __m2m_recent_count++;
+    }
+}
+
+void M2MStatistics::message_received(uint16_t length)
+{
+    __m2m_statistics[MessagesReceived]++;
+    __m2m_statistics[BytesReceived] += length;
+    if(length > __m2m_statistics[MaxMessageSize]) {
+        __m2m_statistics[MaxMessageSize] = length;
+    }
+}
+
+void M2MStatistics::registration_update_sent()
+{
+    __m2m_update_sent = now();
+}
+
+void M2MStatistics::registration_update_completed()
+{
+    __m2m_statistics[RegistrationUpdates]++;
+    if(__m2m_clock && __m2m_update_sent) {
+        uint32_t latency = (uint32_t)((now() - __m2m_update_sent) / 1000);
+        __m2m_statistics[RegistrationUpdateLatency] = latency;
+        if(latency > __m2m_statistics[MaxRegistrationUpdateLatency]) {
+            __m2m_statistics[MaxRegistrationUpdateLatency] = latency;
+        }
+    }
+    __m2m_update_sent = 0;
+}
+
+static void set_integer_value(M2MResourceInstance *resource, uint32_t value)
+{
+    char buffer[12];
+    uint32_t size = m2m::itoa_c(value, buffer);
+    resource->set_value((const uint8_t*)buffer, size);
+}
+
+// Tx Data and Rx Data are reported in kilobytes.
+static void provide_tx_data(M2MResourceInstance *resource)
+{
+    set_integer_value(resource, M2MStatistics::value(M2MStatistics::BytesSent) / 1024);
+}
+
+static void provide_rx_data(M2MResourceInstance *resource)
+{
+    set_integer_value(resource, M2MStatistics::value(M2MStatistics::BytesReceived) / 1024);
+}
+
+static void provide_max_message_size(M2MResourceInstance *resource)
+{
+    set_integer_value(resource, M2MStatistics::value(M2MStatistics::MaxMessageSize));
+}
+
+static void provide_average_message_size(M2MResourceInstance *resource)
+{
+    set_integer_value(resource, M2MStatistics::average_message_size());
+}
+
+static void start_or_reset(void *)
+{
+    M2MStatistics::reset();
+}
+
+static bool create_counter_resource(M2MObjectInstance *instance,
+                                    const String &name,
+                                    value_provider_callback_2 provider)
+{
+    M2MResource *res = instance->create_dynamic_resource(name,
+                                                         OMA_RESOURCE_TYPE,
+                                                         M2MResourceInstance::INTEGER,
+                                                         false);
+    if(res) {
+        res->set_operation(M2MBase::GET_ALLOWED);
+        res->set_value_provider(provider);
+    }
+    return res != NULL;
+}
+
+uint16_t M2MStatistics::memory_report(const m2m::Vector<M2MObject*> &objects,
+                                     M2MStatistics::ObjectMemory *report,
+                                     uint16_t size)
+{
+    uint16_t count = 0;
+    if(!report) {
+        return 0;
+    }
+    m2m::Vector<M2MObject*>::const_iterator it = objects.begin();
+    for(; it != objects.end(); it++) {
+        int32_t id = (*it)->name_id();
+        uint16_t i = 0;
+        while(i < count && report[i].object_id != id) {
+            i++;
+        }
+        if(i == count) {
+            if(count == size) {
+                continue;
+            }
+            report[i].object_id = id;
+            report[i].objects = 0;
+            report[i].instances = 0;
+            report[i].bytes = 0;
+            count++;
+        }
+        report[i].objects++;
+        report[i].instances += (*it)->instance_count();
+        report[i].bytes += (*it)->memory_footprint();
+    }
+    return count;
+}
+
+M2MObject* M2MStatistics::create_object()
+{
+    tr_debug("M2MStatistics::create_object()");
+    M2MObject *object = M2MInterfaceFactory::create_object(M2M_CONNECTIVITY_STATISTICS_ID);
+    if(!object) {
+        return NULL;
+    }
+    object->set_operation(M2MBase::GET_ALLOWED);
+    M2MObjectInstance *instance = object->create_object_instance();
+    bool success = false;
+    if(instance) {
+        instance->set_operation(M2MBase::GET_ALLOWED);
+        instance->set_coap_content_type(COAP_CONTENT_OMA_TLV_TYPE);
+        success = create_counter_resource(instance, CONNECTIVITY_STATISTICS_TX_DATA,
+                                          provide_tx_data) &&
+                  create_counter_resource(instance, CONNECTIVITY_STATISTICS_RX_DATA,
+                                          provide_rx_data) &&
+                  create_counter_resource(instance, CONNECTIVITY_STATISTICS_MAX_MESSAGE_SIZE,
+                                          provide_max_message_size) &&
+                  create_counter_resource(instance, CONNECTIVITY_STATISTICS_AVERAGE_MESSAGE_SIZE,
+                                          provide_average_message_size);
+        if(success) {
+            M2MResource *res = instance->create_dynamic_resource(CONNECTIVITY_STATISTICS_START_OR_RESET,
+                                                                 OMA_RESOURCE_TYPE,
+                                                                 M2MResourceInstance::OPAQUE,
+                                                                 false);
+            success = res != NULL;
+            if(res) {
+                res->set_operation(M2MBase::POST_ALLOWED);
+                res->set_execute_function(start_or_reset);
+            }
+        }
+    }
+    if(!success) {
+        delete object;
+        object = NULL;
+    }
+    return object;
+}
@@ -15,10 +15,14 @@
  */
 #include "mbed-client/m2mstring.h"
 #include <string.h> // strlen
-#include <stdlib.h> // malloc, realloc
+#include <stdlib.h> // malloc, realloc, strtod
+#include <stdio.h> // snprintf
 #include <assert.h>
 #include <algorithm> // min
 
+// Enough digits to read back any double exactly.
+#define MAX_DOUBLE_PRECISION 17
+
 namespace m2m {
 
 const String::size_type String::npos = static_cast<size_t>(-1);
@@ -224,9 +228,11 @@ String& String::erase(size_type pos, size_type len)
 
 String& String::append( const char* str, size_type n) {
     if (str && n > 0) {
-        size_t lens = strlen(str);
-        if (n > lens)
-            n = lens;
+        // Stop at a NUL within n, but don't read past n: str may be
+        // a buffer which isn't null terminated.
+        const char *end = (const char*)memchr(str, 0, n);
+        if (end)
+            n = end - str;
         size_t newlen = size_ + n;
         this->reserve( newlen );
         memmove(p+size_, str, n); // p and s.p MAY overlap
@@ -363,6 +369,42 @@ uint32_t itoa_c (int64_t n, char s[])
     return i;
 }
 
+uint32_t dtoa_c(double value, bool single, char s[], uint32_t size)
+{
+    // NaN and infinity have no text form the resources would accept.
+    if (value != value || value - value != 0)
+        return 0;
+
+    int length = 0;
+    for (int precision = 1; precision <= MAX_DOUBLE_PRECISION; precision++) {
+        length = snprintf(s, size, "%.*g", precision, value);
+        double parsed = strtod(s, NULL);
+        if (single ? (float)parsed == (float)value : parsed == value)
+            break;
+    }
+    if (length <= 0 || (uint32_t)length >= size)
+        return 0;
+    return (uint32_t)length;
+}
+
+int32_t id_from_string(const char *s)
+{
+    int32_t id = -1;
+    if(s && *s) {
+        id = 0;
+        for(; *s; s++) {
+            if(*s < '0' || *s > '9') {
+                return -1;
+            }
+            id = id * 10 + (*s - '0');
+            if(id > 65535) {
+                return -1;
+            }
+        }
+    }
+    return id;
+}
+
 uint8_t* String::convert_integer_to_array(int64_t value, uint8_t &size, uint8_t *array, uint32_t array_size)
 {
     uint8_t* buffer = NULL;
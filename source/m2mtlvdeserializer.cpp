@@ -14,13 +14,16 @@
  * limitations under the License.
  */
 #include <stdio.h>
+#include <string.h>
 #include "include/m2mtlvdeserializer.h"
 #include "mbed-client/m2mconstants.h"
 #include "include/nsdllinker.h"
-#include "mbed-trace/mbed_trace.h"
+#include "include/m2mtrace.h"
 
 #define TRACE_GROUP "mClt"
 #define BUFFER_SIZE 10
+// Holds a binary number converted to text.
+#define NUMBER_BUFFER_SIZE 32
 
 M2MTLVDeserializer::M2MTLVDeserializer()
 {
@@ -142,7 +145,7 @@ M2MTLVDeserializer::Error M2MTLVDeserializer::deserialize_object_instances(uint8
         }
         offset += til->_length;
 
-        if(offset < tlv_size) {
+        if(offset < tlv_size && M2MTLVDeserializer::NotValid != error) {
             error = deserialize_object_instances(tlv, tlv_size-offset, offset, object, operation, update_value);
         }
         delete til;
@@ -162,31 +165,27 @@ M2MTLVDeserializer::Error M2MTLVDeserializer::deserialize_resources(uint8_t *tlv
     TypeIdLength *til = TypeIdLength::createTypeIdLength(tlv, offset)->deserialize();
     offset = til->_offset;
 
-    M2MResourceList list = object_instance.resources();
-    M2MResourceList::const_iterator it;
-    it = list.begin();
-
     if (TYPE_RESOURCE == til->_type || TYPE_RESOURCE_INSTANCE == til->_type) {
-        bool found = false;
-        for (; it!=list.end(); it++) {
-            if((*it)->name_id() == til->_id){
-                tr_debug("M2MTLVDeserializer::deserialize_resources() - Resource ID %d ", til->_id);
-                found = true;
-                if(update_value) {
-                    if(til->_length > 0) {
-                        tr_debug("M2MTLVDeserializer::deserialize_resources() - Update value");
-                        (*it)->set_value(tlv+offset, til->_length);
-                    } else {
-                        tr_debug("M2MTLVDeserializer::deserialize_resources() - Clear Value");
-                        (*it)->clear_value();
+        M2MResource *resource = object_instance.resource_by_id(til->_id);
+        bool found = (resource != NULL);
+        if(found) {
+            tr_debug("M2MTLVDeserializer::deserialize_resources() - Resource ID %d ", til->_id);
+            if(update_value) {
+                if(til->_length > 0) {
+                    tr_debug("M2MTLVDeserializer::deserialize_resources() - Update value");
+                    if(!set_value(*resource, tlv+offset, til->_length)) {
+                        error = M2MTLVDeserializer::NotValid;
                     }
-                    break;
-                } else if(0 == ((*it)->operation() & SN_GRS_PUT_ALLOWED)) {
-                    tr_debug("M2MTLVDeserializer::deserialize_resources() - NOT_ALLOWED");
-                    error = M2MTLVDeserializer::NotAllowed;
-                    break;
+                } else {
+                    tr_debug("M2MTLVDeserializer::deserialize_resources() - Clear Value");
+                    resource->clear_value();
                 }
-            }            
+            } else if(!is_valid_length(*resource, til->_length)) {
+                error = M2MTLVDeserializer::NotValid;
+            } else if(0 == (resource->operation() & SN_GRS_PUT_ALLOWED)) {
+                tr_debug("M2MTLVDeserializer::deserialize_resources() - NOT_ALLOWED");
+                error = M2MTLVDeserializer::NotAllowed;
+            }
         }
         if(!found) {
             if(M2MTLVDeserializer::Post == operation) {
@@ -206,6 +205,8 @@ M2MTLVDeserializer::Error M2MTLVDeserializer::deserialize_resources(uint8_t *tlv
             }
         }
     } else if (TYPE_MULTIPLE_RESOURCE == til->_type) {
+        const M2MResourceList &list = object_instance.resources();
+        M2MResourceList::const_iterator it = list.begin();
         for (; it!=list.end(); it++) {
             if((*it)->supports_multiple_instances()) {
                 error = deserialize_resource_instances(tlv, tlv_size-offset, offset, (**it), object_instance, operation, update_value);
@@ -220,7 +221,7 @@ M2MTLVDeserializer::Error M2MTLVDeserializer::deserialize_resources(uint8_t *tlv
     offset += til->_length;
 
     delete til;
-    if(offset < tlv_size) {
+    if(offset < tlv_size && M2MTLVDeserializer::NotValid != error) {
         error = deserialize_resources(tlv, tlv_size-offset, offset, object_instance, operation, update_value);
     }
     return error;
@@ -248,11 +249,16 @@ M2MTLVDeserializer::Error M2MTLVDeserializer::deserialize_resource_instances(uin
                 found = true;
                 if(update_value) {
                     if(til->_length > 0) {
-                        (*it)->set_value(tlv+offset, til->_length);
+                        if(!set_value(**it, tlv+offset, til->_length)) {
+                            error = M2MTLVDeserializer::NotValid;
+                        }
                     } else {
                         (*it)->clear_value();
                     }
                     break;
+                } else if(!is_valid_length(**it, til->_length)) {
+                    error = M2MTLVDeserializer::NotValid;
+                    break;
                 } else if(0 == ((*it)->operation() & SN_GRS_PUT_ALLOWED)) {
                     error = M2MTLVDeserializer::NotAllowed;
                     break;
@@ -282,7 +288,7 @@ M2MTLVDeserializer::Error M2MTLVDeserializer::deserialize_resource_instances(uin
     offset += til->_length;
 
     delete til;
-    if(offset < tlv_size) {
+    if(offset < tlv_size && M2MTLVDeserializer::NotValid != error) {
         error = deserialize_resource_instances(tlv, tlv_size-offset, offset, resource, object_instance, operation, update_value);
     }
     return error;
@@ -309,11 +315,16 @@ M2MTLVDeserializer::Error M2MTLVDeserializer::deserialize_resource_instances(uin
                 found = true;
                 if(update_value) {
                     if(til->_length > 0) {
-                    (*it)->set_value(tlv+offset, til->_length);
+                        if(!set_value(**it, tlv+offset, til->_length)) {
+                            error = M2MTLVDeserializer::NotValid;
+                        }
                     } else {
                         (*it)->clear_value();
                     }
                     break;
+                } else if(!is_valid_length(**it, til->_length)) {
+                    error = M2MTLVDeserializer::NotValid;
+                    break;
                 } else if(0 == ((*it)->operation() & SN_GRS_PUT_ALLOWED)) {
                     error = M2MTLVDeserializer::NotAllowed;
                     break;
@@ -336,12 +347,79 @@ M2MTLVDeserializer::Error M2MTLVDeserializer::deserialize_resource_instances(uin
     offset += til->_length;
 
     delete til;
-    if(offset < tlv_size) {
+    if(offset < tlv_size && M2MTLVDeserializer::NotValid != error) {
         error = deserialize_resource_instances(tlv, tlv_size-offset, offset, resource, operation, update_value);
     }
     return error;
 }
 
+bool M2MTLVDeserializer::set_value(M2MResourceInstance &resource, const uint8_t *value, uint32_t length)
+{
+    // OMA-LWM2M chapter 6.3.3.1: integers are 1, 2, 4 or 8 byte big-endian
+    // and floats 4 or 8 byte IEEE 754 numbers. A value of any other length
+    // is malformed and isn't stored.
+    char number[NUMBER_BUFFER_SIZE];
+    uint32_t number_length = 0;
+    bool numeric = true;
+    switch(resource.resource_instance_type()) {
+        case M2MResourceInstance::INTEGER:
+        case M2MResourceInstance::TIME:
+            if(length == 1 || length == 2 || length == 4 || length == 8) {
+                uint64_t bits = 0;
+                for(uint32_t i = 0; i < length; i++) {
+                    bits = (bits << 8) | value[i];
+                }
+                if(length < 8 && (value[0] & 0x80)) {
+                    bits |= ~(uint64_t)0 << (length * 8);
+                }
+                number_length = m2m::itoa_c((int64_t)bits, number);
+            }
+            break;
+        case M2MResourceInstance::FLOAT:
+            if(length == 4) {
+                uint32_t bits = ((uint32_t)value[0] << 24) | ((uint32_t)value[1] << 16) |
+                                ((uint32_t)value[2] << 8) | value[3];
+                float real;
+                memcpy(&real, &bits, sizeof(real));
+                number_length = m2m::dtoa_c(real, true, number, NUMBER_BUFFER_SIZE);
+            } else if(length == 8) {
+                uint64_t bits = 0;
+                for(uint32_t i = 0; i < length; i++) {
+                    bits = (bits << 8) | value[i];
+                }
+                double real;
+                memcpy(&real, &bits, sizeof(real));
+                number_length = m2m::dtoa_c(real, false, number, NUMBER_BUFFER_SIZE);
+            }
+            break;
+        default:
+            numeric = false;
+            break;
+    }
+    if(!numeric) {
+        resource.set_value(value, length);
+    } else if(number_length > 0) {
+        resource.set_value((const uint8_t*)number, number_length);
+    } else {
+        tr_debug("M2MTLVDeserializer::set_value() - invalid length %d", length);
+        return false;
+    }
+    return true;
+}
+
+bool M2MTLVDeserializer::is_valid_length(const M2MResourceInstance &resource, uint32_t length)
+{
+    switch(resource.resource_instance_type()) {
+        case M2MResourceInstance::INTEGER:
+        case M2MResourceInstance::TIME:
+            return length == 0 || length == 1 || length == 2 || length == 4 || length == 8;
+        case M2MResourceInstance::FLOAT:
+            return length == 0 || length == 4 || length == 8;
+        default:
+            return true;
+    }
+}
+
 bool M2MTLVDeserializer::is_object_instance(uint8_t *tlv, uint32_t offset)
 {
     bool ret = false;
@@ -14,12 +14,17 @@
  * limitations under the License.
  */
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "include/m2mtlvserializer.h"
 #include "include/nsdllinker.h"
 #include "mbed-client/m2mconstants.h"
 
 #define TRACE_GROUP "mClt"
 
+// Longest number text that is converted to binary.
+#define NUMBER_BUFFER_SIZE 32
+
 M2MTLVSerializer::M2MTLVSerializer()
 {
 }
@@ -39,6 +44,21 @@ uint8_t* M2MTLVSerializer::serialize(M2MResourceList resource_list, uint32_t &si
     return serialize_resources(resource_list, size,valid);
 }
 
+uint8_t* M2MTLVSerializer::serialize(M2MObjectInstanceList object_instance_list,
+                                     const m2m::IdSet &resource_ids,
+                                     uint32_t &size)
+{
+    return serialize_object_instances(object_instance_list, size, &resource_ids);
+}
+
+uint8_t* M2MTLVSerializer::serialize(M2MResourceList resource_list,
+                                     const m2m::IdSet &resource_ids,
+                                     uint32_t &size)
+{
+    bool valid = true;
+    return serialize_resources(resource_list, size, valid, &resource_ids);
+}
+
 uint8_t* M2MTLVSerializer::serialize(M2MResource *resource, uint32_t &size)
 {
     uint8_t* data = NULL;
@@ -46,7 +66,8 @@ uint8_t* M2MTLVSerializer::serialize(M2MResource *resource, uint32_t &size)
     return data;
 }
 
-uint8_t* M2MTLVSerializer::serialize_object_instances(M2MObjectInstanceList object_instance_list, uint32_t &size)
+uint8_t* M2MTLVSerializer::serialize_object_instances(M2MObjectInstanceList object_instance_list, uint32_t &size,
+                                                      const m2m::IdSet *resource_ids)
 {
     uint8_t *data = NULL;
 
@@ -55,13 +76,14 @@ uint8_t* M2MTLVSerializer::serialize_object_instances(M2MObjectInstanceList obje
         it = object_instance_list.begin();
         for (; it!=object_instance_list.end(); it++) {
             uint16_t id = (*it)->instance_id();
-            serialize(id, *it, data, size);
+            serialize(id, *it, data, size, resource_ids);
         }
     }
     return data;
 }
 
-uint8_t* M2MTLVSerializer::serialize_resources(M2MResourceList resource_list, uint32_t &size, bool &valid)
+uint8_t* M2MTLVSerializer::serialize_resources(M2MResourceList resource_list, uint32_t &size, bool &valid,
+                                               const m2m::IdSet *resource_ids)
 {
     uint8_t *data = NULL;
 
@@ -77,20 +99,23 @@ uint8_t* M2MTLVSerializer::serialize_resources(M2MResourceList resource_list, ui
         if(valid) {
             it = resource_list.begin();
             for (; it!=resource_list.end(); it++) {
-                serialize(*it, data, size);
+                if(!resource_ids || resource_ids->contains((*it)->name_id())) {
+                    serialize(*it, data, size);
+                }
             }
         }
     }
     return data;
 }
 
-void M2MTLVSerializer::serialize(uint16_t id, M2MObjectInstance *object_instance, uint8_t *&data, uint32_t &size)
+void M2MTLVSerializer::serialize(uint16_t id, M2MObjectInstance *object_instance, uint8_t *&data, uint32_t &size,
+                                 const m2m::IdSet *resource_ids)
 {
     uint8_t *resource_data = NULL;
     uint32_t resource_size = 0;
 
     bool valid = true;
-    resource_data = serialize_resources(object_instance->resources(),resource_size,valid);
+    resource_data = serialize_resources(object_instance->resources(),resource_size,valid,resource_ids);
     if(valid) {
         serialize_TILV(TYPE_OBJECT_INSTANCE, id, resource_data, resource_size, data, size);
     }
@@ -113,7 +138,7 @@ bool M2MTLVSerializer::serialize_resource(M2MResource *resource, uint8_t *&data,
     bool success = false;
     if(resource->name_id() != -1) {
         success = true;
-        serialize_TILV(TYPE_RESOURCE, resource->name_id(), resource->value(), resource->value_length(), data, size);
+        serialize_value(TYPE_RESOURCE, resource->name_id(), resource, data, size);
     }
     return success;
 }
@@ -145,7 +170,89 @@ bool M2MTLVSerializer::serialize_multiple_resource(M2MResource *resource, uint8_
 
 void M2MTLVSerializer::serialize_resource_instance(uint16_t id, M2MResourceInstance *resource, uint8_t *&data, uint32_t &size)
 {
-    serialize_TILV(TYPE_RESOURCE_INSTANCE, id, resource->value(), resource->value_length(), data, size);
+    serialize_value(TYPE_RESOURCE_INSTANCE, id, resource, data, size);
+}
+
+void M2MTLVSerializer::serialize_value(uint8_t type, uint16_t id, M2MResourceInstance *resource, uint8_t *&data, uint32_t &size)
+{
+    resource->update_value();
+    uint8_t *value = resource->value();
+    uint32_t value_length = resource->value_length();
+
+    // Numbers are stored as text, a value which doesn't parse as a
+    // number is sent as it is.
+    uint8_t number[sizeof(uint64_t)];
+    uint32_t number_length = 0;
+    switch(resource->resource_instance_type()) {
+        case M2MResourceInstance::INTEGER:
+        case M2MResourceInstance::TIME:
+            number_length = encode_integer(value, value_length, number);
+            break;
+        case M2MResourceInstance::FLOAT:
+            number_length = encode_float(value, value_length, number);
+            break;
+        default:
+            break;
+    }
+    if(number_length > 0) {
+        value = number;
+        value_length = number_length;
+    }
+    serialize_TILV(type, id, value, value_length, data, size);
+}
+
+uint32_t M2MTLVSerializer::encode_integer(const uint8_t *value, uint32_t value_length, uint8_t *number)
+{
+    char text[NUMBER_BUFFER_SIZE];
+    if(!value || value_length == 0 || value_length >= NUMBER_BUFFER_SIZE) {
+        return 0;
+    }
+    memcpy(text, value, value_length);
+    text[value_length] = '\0';
+    char *end = NULL;
+    int64_t integer = strtoll(text, &end, 10);
+    if(*end != '\0') {
+        return 0;
+    }
+    // The shortest of 1, 2, 4 or 8 bytes which holds the signed value.
+    uint32_t length = integer == (int8_t)integer ? 1 :
+                      integer == (int16_t)integer ? 2 :
+                      integer == (int32_t)integer ? 4 : 8;
+    for(uint32_t i = 0; i < length; i++) {
+        number[i] = (uint8_t)(integer >> ((length - i - 1) * 8));
+    }
+    return length;
+}
+
+uint32_t M2MTLVSerializer::encode_float(const uint8_t *value, uint32_t value_length, uint8_t *number)
+{
+    char text[NUMBER_BUFFER_SIZE];
+    if(!value || value_length == 0 || value_length >= NUMBER_BUFFER_SIZE) {
+        return 0;
+    }
+    memcpy(text, value, value_length);
+    text[value_length] = '\0';
+    char *end = NULL;
+    double real = strtod(text, &end);
+    if(*end != '\0') {
+        return 0;
+    }
+    // Single precision whenever it holds the value exactly.
+    uint64_t bits = 0;
+    uint32_t length = 8;
+    float single = (float)real;
+    if((double)single == real) {
+        uint32_t single_bits = 0;
+        memcpy(&single_bits, &single, sizeof(single_bits));
+        bits = single_bits;
+        length = 4;
+    } else {
+        memcpy(&bits, &real, sizeof(bits));
+    }
+    for(uint32_t i = 0; i < length; i++) {
+        number[i] = (uint8_t)(bits >> ((length - i - 1) * 8));
+    }
+    return length;
 }
 
 void M2MTLVSerializer::serialize_TILV(uint8_t type, uint16_t id, uint8_t *value, uint32_t value_length, uint8_t *&data, uint32_t &size)
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "mbed-client/m2mtracebuffer.h"
+#include "mbed-client/m2mstatistics.h"
+
+static M2MTraceBuffer *__m2m_active_trace_buffer = NULL;
+
+M2MTraceBuffer::M2MTraceBuffer(uint16_t capacity)
+: _records(NULL),
+  _capacity(0),
+  _next(0),
+  _total(0)
+{
+    if(capacity) {
+        _records = (Record*)malloc(capacity * sizeof(Record));
+        if(_records) {
+            _capacity = capacity;
+        }
+    }
+}
+
+M2MTraceBuffer::~M2MTraceBuffer()
+{
+    if(__m2m_active_trace_buffer == this) {
+        __m2m_active_trace_buffer = NULL;
+    }
+    free(_records);
+}
+
+void M2MTraceBuffer::record(uint8_t level, const char *format, va_list args)
+{
+    if(!_capacity || !format) {
+        return;
+    }
+    Record &record = _records[_next];
+    record.event = (uintptr_t)format;
+    record.timestamp = (uint32_t)M2MStatistics::now();
+    record.sequence = (uint16_t)_total;
+    record.level = level;
+    record.argument_count = 0;
+
+    // Walk the conversions only to take the arguments off the list, the
+    // text itself is never formatted.
+    const char *pos = format;
+    while(record.argument_count < MaxArguments && (pos = strchr(pos, '%')) != NULL) {
+        pos++;
+        if(*pos == '%') {
+            pos++;
+            continue;
+        }
+        while(*pos && strchr("-+ #0", *pos)) {
+            pos++;
+        }
+        while((*pos >= '0' && *pos <= '9') || *pos == '.') {
+            pos++;
+        }
+        uint8_t longs = 0;
+        while(*pos && strchr("hlzjtL", *pos)) {
+            if(*pos == 'l' || *pos == 'z' || *pos == 'j' || *pos == 't') {
+                longs++;
+            }
+            pos++;
+        }
+        int32_t value = 0;
+        switch(*pos) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+                if(longs >= 2) {
+                    value = (int32_t)va_arg(args, long long);
+                } else if(longs == 1) {
+                    value = (int32_t)va_arg(args, long);
+                } else {
+                    value = va_arg(args, int);
+                }
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+                value = (int32_t)va_arg(args, double);
+                break;
+            case 'p':
+                value = (int32_t)(uintptr_t)va_arg(args, void*);
+                break;
+            case 's':
+                // The string may not outlive the call.
+                (void)va_arg(args, const char*);
+                break;
+            default:
+                // Unknown conversion, the remaining arguments can't be
+                // located.
+                pos = NULL;
+                break;
+        }
+        if(!pos) {
+            break;
+        }
+        record.arguments[record.argument_count++] = value;
+        pos++;
+    }
+    for(uint8_t i = record.argument_count; i < MaxArguments; i++) {
+        record.arguments[i] = 0;
+    }
+
+    _next = (_next + 1) % _capacity;
+    _total++;
+}
+
+uint16_t M2MTraceBuffer::count() const
+{
+    return _total < _capacity ? (uint16_t)_total : _capacity;
+}
+
+uint32_t M2MTraceBuffer::total() const
+{
+    return _total;
+}
+
+bool M2MTraceBuffer::read(uint16_t index, M2MTraceBuffer::Record &record) const
+{
+    uint16_t held = count();
+    if(index >= held) {
+        return false;
+    }
+    uint16_t oldest = (_total < _capacity) ? 0 : _next;
+    record = _records[(oldest + index) % _capacity];
+    return true;
+}
+
+void M2MTraceBuffer::clear()
+{
+    _next = 0;
+    _total = 0;
+}
+
+void M2MTraceBuffer::set_active(M2MTraceBuffer *buffer)
+{
+    __m2m_active_trace_buffer = buffer;
+}
+
+M2MTraceBuffer* M2MTraceBuffer::active()
+{
+    return __m2m_active_trace_buffer;
+}
+
+void M2MTraceBuffer::trace(uint8_t level, const char *format, ...)
+{
+    if(__m2m_active_trace_buffer) {
+        va_list args;
+        va_start(args, format);
+        __m2m_active_trace_buffer->record(level, format, args);
+        va_end(args);
+    }
+}
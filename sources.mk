@@ -1,21 +1,36 @@
 SRCS += \
+	source/m2mallocator.cpp \
+	source/m2marenaallocator.cpp \
 	source/m2mbase.cpp \
+	source/m2mblockoption.cpp \
+	source/m2mcompositeobservation.cpp \
 	source/m2mconstants.cpp \
 	source/m2mdevice.cpp \
         source/m2mfirmware.cpp \
+	source/m2mfirmwarepackagewriter.cpp \
 	source/m2minterfacefactory.cpp \
 	source/m2minterfaceimpl.cpp \
+	source/m2mlatency.cpp \
 	source/m2mnsdlinterface.cpp \
+	source/m2mnotificationstore.cpp \
         source/m2mobject.cpp \
 	source/m2mobjectinstance.cpp \
+	source/m2mpath.cpp \
+	source/m2mpoolallocator.cpp \
 	source/m2mreporthandler.cpp \
 	source/m2mresource.cpp \
 	source/m2mresourceinstance.cpp \
+	source/m2msamplebuffer.cpp \
 	source/m2msecurity.cpp \
+	source/m2msenmlcbordeserializer.cpp \
+	source/m2msenmlcborserializer.cpp \
 	source/m2mserver.cpp \
+	source/m2msha256.cpp \
+	source/m2mstatistics.cpp \
 	source/m2mstring.cpp \
 	source/m2mtlvdeserializer.cpp \
 	source/m2mtlvserializer.cpp \
+	source/m2mtracebuffer.cpp \
 	source/nsdlaccesshelper.cpp \
 	source/m2mfirmware.cpp \
 	../lwm2m-client-linux/source/m2mconnectionhandler.cpp \
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mallocator.h"
+#include "test_m2mpoolallocator.h"
+#include "test_m2marenaallocator.h"
+
+TEST_GROUP(M2MAllocator)
+{
+  Test_M2MAllocator* m2m_allocator;
+
+  void setup()
+  {
+    m2m_allocator = new Test_M2MAllocator();
+  }
+  void teardown()
+  {
+    delete m2m_allocator;
+  }
+};
+
+TEST(M2MAllocator, Create)
+{
+    CHECK(m2m_allocator != NULL);
+}
+
+TEST(M2MAllocator, default_allocator)
+{
+    m2m_allocator->test_default_allocator();
+}
+
+TEST(M2MAllocator, set_allocator)
+{
+    m2m_allocator->test_set_allocator();
+}
+
+TEST(M2MAllocator, accounting)
+{
+    m2m_allocator->test_accounting();
+}
+
+TEST_GROUP(M2MPoolAllocator)
+{
+  Test_M2MPoolAllocator* m2m_pool;
+
+  void setup()
+  {
+    m2m_pool = new Test_M2MPoolAllocator();
+  }
+  void teardown()
+  {
+    delete m2m_pool;
+  }
+};
+
+TEST(M2MPoolAllocator, Create)
+{
+    CHECK(m2m_pool != NULL);
+}
+
+TEST(M2MPoolAllocator, allocate)
+{
+    m2m_pool->test_allocate();
+}
+
+TEST(M2MPoolAllocator, allocate_exhausted)
+{
+    m2m_pool->test_allocate_exhausted();
+}
+
+TEST(M2MPoolAllocator, deallocate)
+{
+    m2m_pool->test_deallocate();
+}
+
+TEST_GROUP(M2MArenaAllocator)
+{
+  Test_M2MArenaAllocator* m2m_arena;
+
+  void setup()
+  {
+    m2m_arena = new Test_M2MArenaAllocator();
+  }
+  void teardown()
+  {
+    delete m2m_arena;
+  }
+};
+
+TEST(M2MArenaAllocator, Create)
+{
+    CHECK(m2m_arena != NULL);
+}
+
+TEST(M2MArenaAllocator, allocate)
+{
+    m2m_arena->test_allocate();
+}
+
+TEST(M2MArenaAllocator, allocate_full)
+{
+    m2m_arena->test_allocate_full();
+}
+
+TEST(M2MArenaAllocator, reset)
+{
+    m2m_arena->test_reset();
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_m2mallocator.h"
+#include <stdlib.h>
+#include "m2mpoolallocator.h"
+
+class TestAllocator : public M2MAllocator {
+public:
+    TestAllocator() : allocated(0), freed(0) {}
+    void* allocate(uint16_t size) {
+        allocated++;
+        return malloc(size);
+    }
+    void deallocate(void *ptr) {
+        freed++;
+        free(ptr);
+    }
+
+    int allocated;
+    int freed;
+};
+
+class NullAllocator : public M2MAllocator {
+public:
+    void* allocate(uint16_t) {
+        return NULL;
+    }
+    void deallocate(void *) {
+    }
+};
+
+Test_M2MAllocator::Test_M2MAllocator()
+{
+}
+
+Test_M2MAllocator::~Test_M2MAllocator()
+{
+    M2MAllocator::set_allocator(NULL);
+}
+
+void Test_M2MAllocator::test_default_allocator()
+{
+    CHECK(M2MAllocator::allocator() == NULL);
+    CHECK(M2MAllocator::memory_alloc(0) == NULL);
+
+    void *ptr = M2MAllocator::memory_alloc(10);
+    CHECK(ptr != NULL);
+    M2MAllocator::memory_free(ptr);
+    M2MAllocator::memory_free(NULL);
+}
+
+void Test_M2MAllocator::test_set_allocator()
+{
+    TestAllocator allocator;
+    M2MAllocator::set_allocator(&allocator);
+    CHECK(M2MAllocator::allocator() == &allocator);
+
+    void *ptr = M2MAllocator::memory_alloc(10);
+    CHECK(ptr != NULL);
+    CHECK(allocator.allocated == 1);
+
+    M2MAllocator::memory_free(ptr);
+    CHECK(allocator.freed == 1);
+
+    // NULL is not passed to the allocator
+    M2MAllocator::memory_free(NULL);
+    CHECK(allocator.freed == 1);
+
+    M2MAllocator::set_allocator(NULL);
+    CHECK(M2MAllocator::allocator() == NULL);
+}
+
+void Test_M2MAllocator::test_accounting()
+{
+    M2MAllocator::reset_accounting();
+    void *ptr = M2MAllocator::memory_alloc(10);
+    M2MAllocator::memory_free(ptr);
+    CHECK(M2MAllocator::accounting().allocations == 1);
+    CHECK(M2MAllocator::accounting().deallocations == 1);
+    CHECK(M2MAllocator::accounting().bytes_requested == 10);
+    // malloc() doesn't report block sizes.
+    CHECK(M2MAllocator::accounting().bytes_in_use == 0);
+
+    M2MPoolAllocator pool(1);
+    M2MAllocator::set_allocator(&pool);
+    M2MAllocator::reset_accounting();
+    void *small = M2MAllocator::memory_alloc(10);
+    void *medium = M2MAllocator::memory_alloc(100);
+    CHECK(pool.allocated_size(small) == M2M_POOL_MIN_BLOCK_SIZE);
+    CHECK(M2MAllocator::accounting().bytes_in_use ==
+          pool.allocated_size(small) + pool.allocated_size(medium));
+
+    M2MAllocator::memory_free(medium);
+    CHECK(M2MAllocator::accounting().bytes_in_use == M2M_POOL_MIN_BLOCK_SIZE);
+    CHECK(M2MAllocator::accounting().peak_bytes_in_use > M2M_POOL_MIN_BLOCK_SIZE);
+
+    M2MAllocator::reset_accounting();
+    CHECK(M2MAllocator::accounting().allocations == 0);
+    CHECK(M2MAllocator::accounting().bytes_in_use == M2M_POOL_MIN_BLOCK_SIZE);
+    M2MAllocator::memory_free(small);
+    CHECK(M2MAllocator::accounting().bytes_in_use == 0);
+
+    NullAllocator null_allocator;
+    M2MAllocator::set_allocator(&null_allocator);
+    CHECK(M2MAllocator::memory_alloc(10) == NULL);
+    CHECK(M2MAllocator::accounting().failures == 1);
+    CHECK(M2MAllocator::accounting().allocations == 0);
+    M2MAllocator::set_allocator(NULL);
+}
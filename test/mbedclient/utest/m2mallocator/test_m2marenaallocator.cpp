@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_m2marenaallocator.h"
+#include <stdlib.h>
+
+Test_M2MArenaAllocator::Test_M2MArenaAllocator()
+{
+    arena = new M2MArenaAllocator(64);
+}
+
+Test_M2MArenaAllocator::~Test_M2MArenaAllocator()
+{
+    delete arena;
+}
+
+void Test_M2MArenaAllocator::test_allocate()
+{
+    CHECK(arena->allocate(0) == NULL);
+
+    uint8_t *first = (uint8_t*)arena->allocate(3);
+    CHECK(first != NULL);
+    CHECK(arena->contains(first) == true);
+    CHECK(arena->used() == 8);
+
+    uint8_t *second = (uint8_t*)arena->allocate(8);
+    CHECK(second == first + 8);
+    CHECK(arena->used() == 16);
+
+    // Memory from the region is released only with reset
+    arena->deallocate(first);
+    CHECK(arena->used() == 16);
+}
+
+void Test_M2MArenaAllocator::test_allocate_full()
+{
+    void *region = arena->allocate(64);
+    CHECK(arena->contains(region) == true);
+
+    void *heap = arena->allocate(1);
+    CHECK(heap != NULL);
+    CHECK(arena->contains(heap) == false);
+    arena->deallocate(heap);
+
+    M2MArenaAllocator *empty = new M2MArenaAllocator(0);
+    void *ptr = empty->allocate(16);
+    CHECK(ptr != NULL);
+    CHECK(empty->contains(ptr) == false);
+    empty->deallocate(ptr);
+    delete empty;
+}
+
+void Test_M2MArenaAllocator::test_reset()
+{
+    void *first = arena->allocate(40);
+    CHECK(arena->used() == 40);
+    arena->reset();
+    CHECK(arena->used() == 0);
+
+    void *second = arena->allocate(40);
+    CHECK(first == second);
+}
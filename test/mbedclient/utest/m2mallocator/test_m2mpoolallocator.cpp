@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_m2mpoolallocator.h"
+#include <stdlib.h>
+
+Test_M2MPoolAllocator::Test_M2MPoolAllocator()
+{
+    pool = new M2MPoolAllocator(2);
+}
+
+Test_M2MPoolAllocator::~Test_M2MPoolAllocator()
+{
+    delete pool;
+}
+
+void Test_M2MPoolAllocator::test_allocate()
+{
+    CHECK(pool->allocate(0) == NULL);
+
+    void *small = pool->allocate(10);
+    CHECK(small != NULL);
+    CHECK(pool->size_class(small) == 0);
+
+    void *medium = pool->allocate(100);
+    CHECK(medium != NULL);
+    CHECK(pool->size_class(medium) == 3);
+
+    void *largest = pool->allocate(M2M_POOL_MAX_BLOCK_SIZE);
+    CHECK(largest != NULL);
+    CHECK(pool->size_class(largest) == M2M_POOL_SIZE_CLASSES - 1);
+    CHECK(pool->blocks_in_use() == 3);
+
+    // Too large for the pool, comes from the heap
+    void *large = pool->allocate(M2M_POOL_MAX_BLOCK_SIZE + 1);
+    CHECK(large != NULL);
+    CHECK(pool->size_class(large) == -1);
+    CHECK(pool->blocks_in_use() == 3);
+
+    pool->deallocate(small);
+    pool->deallocate(medium);
+    pool->deallocate(largest);
+    pool->deallocate(large);
+    CHECK(pool->blocks_in_use() == 0);
+}
+
+void Test_M2MPoolAllocator::test_allocate_exhausted()
+{
+    void *first = pool->allocate(16);
+    void *second = pool->allocate(16);
+    CHECK(pool->size_class(first) == 0);
+    CHECK(pool->size_class(second) == 0);
+
+    // Falls back to the next larger block
+    void *third = pool->allocate(16);
+    CHECK(pool->size_class(third) == 1);
+
+    pool->deallocate(first);
+    pool->deallocate(second);
+    pool->deallocate(third);
+    CHECK(pool->blocks_in_use() == 0);
+
+    M2MPoolAllocator *empty = new M2MPoolAllocator(0);
+    void *ptr = empty->allocate(16);
+    CHECK(ptr != NULL);
+    CHECK(empty->blocks_in_use() == 0);
+    empty->deallocate(ptr);
+    delete empty;
+}
+
+void Test_M2MPoolAllocator::test_deallocate()
+{
+    void *first = pool->allocate(32);
+    pool->deallocate(first);
+    CHECK(pool->blocks_in_use() == 0);
+
+    // Freed blocks are reused
+    void *second = pool->allocate(32);
+    CHECK(first == second);
+    pool->deallocate(second);
+
+    // Memory from malloc is released with free
+    void *heap = malloc(8);
+    pool->deallocate(heap);
+    CHECK(pool->blocks_in_use() == 0);
+
+    pool->deallocate(NULL);
+}
@@ -122,6 +122,16 @@ TEST(M2MBase, set_under_observation)
     m2m_base->test_set_under_observation();
 }
 
+TEST(M2MBase, set_composite_observation)
+{
+    m2m_base->test_set_composite_observation();
+}
+
+TEST(M2MBase, sends_samples)
+{
+    m2m_base->test_sends_samples();
+}
+
 TEST(M2MBase, set_observable)
 {
     m2m_base->test_set_observable();
@@ -222,6 +232,21 @@ TEST(M2MBase, test_memory_free)
     m2m_base->test_memory_free();
 }
 
+TEST(M2MBase, test_response_alloc)
+{
+    m2m_base->test_response_alloc();
+}
+
+TEST(M2MBase, test_response_integer)
+{
+    m2m_base->test_response_integer();
+}
+
+TEST(M2MBase, test_requested_content_type)
+{
+    m2m_base->test_requested_content_type();
+}
+
 TEST(M2MBase, test_report_handler)
 {
     m2m_base->test_report_handler();
@@ -260,3 +285,8 @@ TEST(M2MBase, test_max_age)
 {
     m2m_base->test_max_age();
 }
+
+TEST(M2MBase, test_memory_footprint)
+{
+    m2m_base->test_memory_footprint();
+}
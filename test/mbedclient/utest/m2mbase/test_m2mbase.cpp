@@ -19,6 +19,9 @@
 #include "m2mreportobserver.h"
 #include "m2mreporthandler.h"
 #include "m2mreporthandler_stub.h"
+#include "m2mallocator.h"
+#include "nsdllinker.h"
+#include "m2msamplebuffer.h"
 
 
 class Handler : public M2MObservationHandler {
@@ -27,28 +30,56 @@ public:
 
     Handler() : visited(false) {}
     ~Handler(){}
-    void observation_to_be_sent(M2MBase *, uint16_t, m2m::Vector<uint16_t>, bool){
+    void observation_to_be_sent(M2MBase *, uint16_t, const m2m::IdSet &, bool, const m2m::IdSet *){
         visited = true;
     }
     void send_delayed_response(M2MBase *){}
     void resource_to_be_deleted(const String &){visited=true;}
     void remove_object(M2MBase *){visited = true;}
     void value_updated(M2MBase *,const String&){visited = true;}
+    bool samples_to_be_sent(M2MBase *, uint16_t, M2MSampleBuffer &){
+        visited = true;
+        return true;
+    }
 
     void clear() {visited = false;}
     bool visited;
 };
 
+class TestAllocator : public M2MAllocator {
+public:
+    TestAllocator() : allocated(0), freed(0) {}
+    void* allocate(uint16_t size) {
+        allocated++;
+        return malloc(size);
+    }
+    void deallocate(void *ptr) {
+        freed++;
+        free(ptr);
+    }
+
+    int allocated;
+    int freed;
+};
+
+class ArenaHandler : public Handler {
+public:
+    M2MAllocator* request_allocator() { return &allocator; }
+
+    TestAllocator allocator;
+};
+
 class Observer : public M2MReportObserver {
 public:
     Observer(){}
     ~Observer(){}
 
-    void observation_to_be_sent(m2m::Vector<uint16_t>,bool){}
+    void observation_to_be_sent(const m2m::IdSet &, bool, const m2m::IdSet *){}
 };
 
 Test_M2MBase::Test_M2MBase()
-    :M2MBase("name",M2MBase::Static)
+    :M2MBase("name",M2MBase::Static),
+     _sends_samples(false)
 {
 
 }
@@ -245,6 +276,59 @@ void Test_M2MBase::test_set_under_observation()
     set_under_observation(test,&handler);
 }
 
+void Test_M2MBase::test_set_composite_observation()
+{
+    Handler handler;
+
+    this->_base_type = M2MBase::Resource;
+    this->_observation_level = M2MBase::R_Attribute;
+
+    set_composite_observation(true, &handler);
+    CHECK(&handler == this->_observation_handler);
+    CHECK((M2MBase::R_Attribute | M2MBase::C_Attribute) == this->_observation_level);
+
+    // Cancelling the plain observation keeps the handler for the composite one
+    set_under_observation(false, NULL);
+    CHECK(&handler == this->_observation_handler);
+
+    set_composite_observation(false, NULL);
+    CHECK(M2MBase::R_Attribute == this->_observation_level);
+
+    set_under_observation(false, NULL);
+    CHECK(NULL == this->_observation_handler);
+}
+
+bool Test_M2MBase::sends_samples() const
+{
+    return _sends_samples;
+}
+
+void Test_M2MBase::test_sends_samples()
+{
+    Handler handler;
+    M2MSampleBuffer samples(4, 0, 0, 0, M2MResourceInstance::DropOldest, true);
+    this->_base_type = M2MBase::Resource;
+
+    // Registration attaches the handler without an observation
+    _sends_samples = true;
+    set_under_observation(false, &handler);
+    CHECK(this->_report_handler != NULL);
+
+    // Cancelling an observation keeps what the Send operation needs
+    set_under_observation(true, &handler);
+    set_under_observation(false, NULL);
+    CHECK(&handler == this->_observation_handler);
+    CHECK(this->_report_handler != NULL);
+    CHECK(samples_to_be_sent(samples) == true);
+    CHECK(handler.visited == true);
+
+    _sends_samples = false;
+    set_under_observation(false, NULL);
+    CHECK(NULL == this->_observation_handler);
+    CHECK(NULL == this->_report_handler);
+    CHECK(samples_to_be_sent(samples) == false);
+}
+
 void Test_M2MBase::test_set_observation_token()
 {
     this->_token_length = 4;
@@ -423,7 +507,7 @@ void Test_M2MBase::test_handle_observation_attribute()
 void Test_M2MBase::test_observation_to_be_sent()
 {
     Handler handler;
-    Vector<uint16_t> list;
+    m2m::IdSet list;
     observation_to_be_sent(list);
     CHECK(handler.visited == false);
 
@@ -503,6 +587,85 @@ void Test_M2MBase::test_memory_free()
     //memory leak test will fail, if there is a leak, so no need for CHECK
 }
 
+void Test_M2MBase::test_response_alloc()
+{
+    CHECK(response_alloc(NULL, 0) == NULL);
+    void *ptr = response_alloc(NULL, 10);
+    CHECK(ptr != NULL);
+    response_free(NULL, ptr);
+
+    // Handler without request allocator uses the heap
+    Handler handler;
+    ptr = response_alloc(&handler, 10);
+    CHECK(ptr != NULL);
+    response_free(&handler, ptr);
+
+    ArenaHandler arena_handler;
+    ptr = response_alloc(&arena_handler, 10);
+    CHECK(ptr != NULL);
+    CHECK(arena_handler.allocator.allocated == 1);
+    response_free(&arena_handler, ptr);
+    CHECK(arena_handler.allocator.freed == 1);
+}
+
+void Test_M2MBase::test_response_integer()
+{
+    uint8_t size = 0;
+    uint8_t *value = response_integer(NULL, 0, size);
+    CHECK(size == 1);
+    CHECK(value[0] == 0);
+    free(value);
+
+    value = response_integer(NULL, 0x2A, size);
+    CHECK(size == 1);
+    CHECK(value[0] == 0x2A);
+    free(value);
+
+    value = response_integer(NULL, 11542, size);
+    CHECK(size == 2);
+    CHECK(value[0] == 0x2D);
+    CHECK(value[1] == 0x16);
+    free(value);
+
+    // Same lengths as String::convert_integer_to_array()
+    value = response_integer(NULL, 0xFF, size);
+    CHECK(size == 2);
+    free(value);
+
+    ArenaHandler arena_handler;
+    value = response_integer(&arena_handler, 3600, size);
+    CHECK(size == 2);
+    CHECK(arena_handler.allocator.allocated == 1);
+    response_free(&arena_handler, value);
+}
+
+void Test_M2MBase::test_requested_content_type()
+{
+    sn_coap_hdr_s header;
+    memset(&header, 0, sizeof(header));
+    uint16_t content_type = 0;
+    CHECK(!requested_content_type(&header, content_type));
+
+    uint8_t format[] = {0x2D, 0x16};
+    header.content_type_ptr = format;
+    header.content_type_len = sizeof(format);
+    CHECK(requested_content_type(&header, content_type));
+    CHECK(content_type == 11542);
+
+    // Accept takes precedence over Content-Format
+    sn_coap_options_list_s options;
+    memset(&options, 0, sizeof(options));
+    header.options_list_ptr = &options;
+    CHECK(requested_content_type(&header, content_type));
+    CHECK(content_type == 11542);
+
+    uint8_t accept = 112;
+    options.accept_ptr = &accept;
+    options.accept_len = 1;
+    CHECK(requested_content_type(&header, content_type));
+    CHECK(content_type == 112);
+}
+
 void Test_M2MBase::test_report_handler()
 {
     CHECK(report_handler() == NULL);
@@ -552,3 +715,22 @@ void Test_M2MBase::test_max_age()
     this->_max_age = 10000;
     CHECK(this->max_age() == 10000);
 }
+
+void Test_M2MBase::test_memory_footprint()
+{
+    uint32_t bytes = memory_footprint();
+    // The node and the name "name" with its NUL.
+    CHECK(bytes >= sizeof(M2MBase) + 5);
+
+    uint8_t token[] = {1, 2, 3};
+    set_observation_token(token, 3);
+    CHECK(memory_footprint() == bytes + 3);
+
+    Handler handler;
+    m2mreporthandler_stub::int_value = 50;
+    set_observable(true);
+    set_under_observation(true, &handler);
+    CHECK(memory_footprint() == bytes + 3 + 50);
+    set_under_observation(false, &handler);
+    m2mreporthandler_stub::clear();
+}
@@ -53,6 +53,10 @@ public:
 
     void test_set_under_observation();
 
+    void test_set_composite_observation();
+
+    void test_sends_samples();
+
     void test_set_observation_token();
 
     void test_is_observable();
@@ -99,6 +103,12 @@ public:
 
     void test_memory_free();
 
+    void test_response_alloc();
+
+    void test_response_integer();
+
+    void test_requested_content_type();
+
     void test_report_handler();
 
     void test_observation_handler();
@@ -114,6 +124,14 @@ public:
     void test_set_max_age();
 
     void test_max_age();
+
+    void test_memory_footprint();
+
+protected:
+
+    virtual bool sends_samples() const;
+
+    bool _sends_samples;
 };
 
 
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mcompositeobservation.h"
+
+
+TEST_GROUP(M2MCompositeObservation)
+{
+  Test_M2MCompositeObservation* m2m_observation;
+
+  void setup()
+  {
+    m2m_observation = new Test_M2MCompositeObservation();
+  }
+  void teardown()
+  {
+    delete m2m_observation;
+  }
+};
+
+TEST(M2MCompositeObservation, Create)
+{
+    CHECK(m2m_observation != NULL);
+}
+
+TEST(M2MCompositeObservation, test_token)
+{
+    m2m_observation->test_token();
+}
+
+TEST(M2MCompositeObservation, test_paths)
+{
+    m2m_observation->test_paths();
+}
+
+TEST(M2MCompositeObservation, test_members)
+{
+    m2m_observation->test_members();
+}
+
+TEST(M2MCompositeObservation, test_set_notification_attributes)
+{
+    m2m_observation->test_set_notification_attributes();
+}
+
+TEST(M2MCompositeObservation, test_observation_number)
+{
+    m2m_observation->test_observation_number();
+}
+
+TEST(M2MCompositeObservation, test_observation_to_be_sent)
+{
+    m2m_observation->test_observation_to_be_sent();
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mcompositeobservation.h"
+#include "m2mreporthandler_stub.h"
+
+class Observer : public M2MCompositeObserver {
+public:
+    Observer() : observation(NULL), count(0) {}
+    virtual ~Observer() {}
+
+    void composite_observation_to_be_sent(M2MCompositeObservation &obs) {
+        observation = &obs;
+        count++;
+    }
+
+    M2MCompositeObservation *observation;
+    int count;
+};
+
+Test_M2MCompositeObservation::Test_M2MCompositeObservation()
+{
+    observer = new Observer();
+    uint8_t token[] = {0x01, 0x02, 0x03};
+    M2MPathList paths;
+    paths.push_back("3/0/9");
+    paths.push_back("1/0");
+    observation = new M2MCompositeObservation(*observer, token, sizeof(token), paths);
+}
+
+Test_M2MCompositeObservation::~Test_M2MCompositeObservation()
+{
+    delete observation;
+    delete observer;
+    m2mreporthandler_stub::clear();
+}
+
+void Test_M2MCompositeObservation::test_token()
+{
+    uint8_t token[] = {0x01, 0x02, 0x03};
+    uint8_t other[] = {0x01, 0x02, 0x04};
+    CHECK(observation->token_length() == 3);
+    CHECK(memcmp(observation->token(), token, sizeof(token)) == 0);
+    CHECK(observation->has_token(token, sizeof(token)));
+    CHECK(!observation->has_token(other, sizeof(other)));
+    CHECK(!observation->has_token(token, 2));
+
+    M2MPathList paths;
+    M2MCompositeObservation *empty = new M2MCompositeObservation(*observer, NULL, 0, paths);
+    CHECK(empty->token() == NULL);
+    CHECK(empty->token_length() == 0);
+    CHECK(empty->has_token(NULL, 0));
+    CHECK(!empty->has_token(token, sizeof(token)));
+    delete empty;
+}
+
+void Test_M2MCompositeObservation::test_paths()
+{
+    CHECK(observation->paths().size() == 2);
+    CHECK(observation->paths()[0] == "3/0/9");
+    CHECK(observation->paths()[1] == "1/0");
+}
+
+void Test_M2MCompositeObservation::test_members()
+{
+    // The observed paths and the nodes below them
+    CHECK(observation->is_member("3/0/9"));
+    CHECK(observation->is_member("/3/0/9"));
+    CHECK(observation->is_member("3/0/9/1"));
+    CHECK(observation->is_member("1/0/1"));
+    CHECK(observation->is_member("1/0/7/0"));
+
+    CHECK(!observation->is_member("3/0/90"));
+    CHECK(!observation->is_member("3/0/1"));
+    CHECK(!observation->is_member("1/1/1"));
+    CHECK(!observation->is_member("1/01"));
+    CHECK(!observation->is_member("1"));
+    CHECK(!observation->is_member(""));
+
+    // The root path covers every node
+    M2MPathList paths;
+    paths.push_back("/");
+    M2MCompositeObservation *root = new M2MCompositeObservation(*observer, NULL, 0, paths);
+    CHECK(root->is_member("5/0/1"));
+    CHECK(!root->is_member(""));
+    delete root;
+}
+
+void Test_M2MCompositeObservation::test_set_notification_attributes()
+{
+    char query[] = "pmin=10&pmax=60";
+    m2mreporthandler_stub::bool_return = true;
+    CHECK(observation->set_notification_attributes(query));
+
+    m2mreporthandler_stub::bool_return = false;
+    CHECK(!observation->set_notification_attributes(query));
+
+    observation->set_under_observation(true);
+    observation->value_changed();
+    observation->set_under_observation(false);
+}
+
+void Test_M2MCompositeObservation::test_observation_number()
+{
+    CHECK(observation->observation_number() == 0);
+    CHECK(observation->next_observation_number() == 1);
+    CHECK(observation->next_observation_number() == 2);
+    CHECK(observation->observation_number() == 2);
+}
+
+void Test_M2MCompositeObservation::test_observation_to_be_sent()
+{
+    m2m::IdSet ids;
+    observation->observation_to_be_sent(ids, false, NULL);
+    CHECK(observer->count == 1);
+    CHECK(observer->observation == observation);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_M2M_COMPOSITE_OBSERVATION_H
+#define TEST_M2M_COMPOSITE_OBSERVATION_H
+
+#include "m2mcompositeobservation.h"
+
+class Observer;
+
+class Test_M2MCompositeObservation
+{
+public:
+    Test_M2MCompositeObservation();
+
+    virtual ~Test_M2MCompositeObservation();
+
+    void test_token();
+
+    void test_paths();
+
+    void test_members();
+
+    void test_set_notification_attributes();
+
+    void test_observation_number();
+
+    void test_observation_to_be_sent();
+
+    M2MCompositeObservation *observation;
+    Observer *observer;
+};
+
+#endif // TEST_M2M_COMPOSITE_OBSERVATION_H
@@ -27,7 +27,7 @@ public:
 
     Callback(){}
     ~Callback(){}
-    void notification_update(uint16_t obj_instance_id) {
+    void notification_update(uint16_t, int32_t) {
         visited = true;
     }
 
@@ -413,12 +413,12 @@ void Test_M2MFirmware::test_set_resource_value_buffer()
 
 void Test_M2MFirmware::test_resource_name()
 {
-    CHECK(firmware->resource_name(M2MFirmware::Package) == "0");
-    CHECK(firmware->resource_name(M2MFirmware::PackageUri) == "1");
-    CHECK(firmware->resource_name(M2MFirmware::Update) == "2");
-    CHECK(firmware->resource_name(M2MFirmware::State) == "3");
-    CHECK(firmware->resource_name(M2MFirmware::UpdateSupportedObjects) == "4");
-    CHECK(firmware->resource_name(M2MFirmware::UpdateResult) == "5");
-    CHECK(firmware->resource_name(M2MFirmware::PackageName) == "6");
-    CHECK(firmware->resource_name(M2MFirmware::PackageVersion) == "7");
+    STRCMP_EQUAL("0", firmware->resource_name(M2MFirmware::Package));
+    STRCMP_EQUAL("1", firmware->resource_name(M2MFirmware::PackageUri));
+    STRCMP_EQUAL("2", firmware->resource_name(M2MFirmware::Update));
+    STRCMP_EQUAL("3", firmware->resource_name(M2MFirmware::State));
+    STRCMP_EQUAL("4", firmware->resource_name(M2MFirmware::UpdateSupportedObjects));
+    STRCMP_EQUAL("5", firmware->resource_name(M2MFirmware::UpdateResult));
+    STRCMP_EQUAL("6", firmware->resource_name(M2MFirmware::PackageName));
+    STRCMP_EQUAL("7", firmware->resource_name(M2MFirmware::PackageVersion));
 }
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mfirmwarepackagewriter.h"
+
+TEST_GROUP(M2MFirmwarePackageWriter)
+{
+  Test_M2MFirmwarePackageWriter* m2m_writer;
+
+  void setup()
+  {
+    m2m_writer = new Test_M2MFirmwarePackageWriter();
+  }
+  void teardown()
+  {
+    delete m2m_writer;
+  }
+};
+
+TEST(M2MFirmwarePackageWriter, Create)
+{
+    CHECK(m2m_writer != NULL);
+}
+
+TEST(M2MFirmwarePackageWriter, is_block_message)
+{
+    m2m_writer->test_is_block_message();
+}
+
+TEST(M2MFirmwarePackageWriter, parse_block_option)
+{
+    m2m_writer->test_parse_block_option();
+}
+
+TEST(M2MFirmwarePackageWriter, handle_block_in_order)
+{
+    m2m_writer->test_handle_block_in_order();
+}
+
+TEST(M2MFirmwarePackageWriter, handle_block_retransmission)
+{
+    m2m_writer->test_handle_block_retransmission();
+}
+
+TEST(M2MFirmwarePackageWriter, handle_block_first_block_retransmission)
+{
+    m2m_writer->test_handle_block_first_block_retransmission();
+}
+
+TEST(M2MFirmwarePackageWriter, handle_block_restarted_transfer)
+{
+    m2m_writer->test_handle_block_restarted_transfer();
+}
+
+TEST(M2MFirmwarePackageWriter, handle_block_lost_block)
+{
+    m2m_writer->test_handle_block_lost_block();
+}
+
+TEST(M2MFirmwarePackageWriter, handle_block_sink_failure)
+{
+    m2m_writer->test_handle_block_sink_failure();
+}
+
+TEST(M2MFirmwarePackageWriter, set_sink_aborts_transfer)
+{
+    m2m_writer->test_set_sink_aborts_transfer();
+}
+
+TEST(M2MFirmwarePackageWriter, sha256)
+{
+    m2m_writer->test_sha256();
+}
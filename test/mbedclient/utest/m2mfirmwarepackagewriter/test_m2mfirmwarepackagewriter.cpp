@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_m2mfirmwarepackagewriter.h"
+#include "m2mfirmware_stub.h"
+#include "include/m2mblockoption.h"
+
+#define BLOCK_SIZE 16
+
+class TestSink : public M2MFirmwareSink {
+
+public:
+
+    TestSink(){ clear(); }
+    ~TestSink(){}
+
+    bool package_started() {
+        started++;
+        length = 0;
+        return start_result;
+    }
+
+    bool package_block(uint32_t offset, const uint8_t *block, uint16_t block_length) {
+        if(!block_result || offset != length || offset + block_length > sizeof(data)) {
+            return false;
+        }
+        memcpy(data + offset, block, block_length);
+        length += block_length;
+        return true;
+    }
+
+    void package_completed(uint32_t size, const uint8_t *hash) {
+        completed = true;
+        completed_size = size;
+        memcpy(digest, hash, M2M_FIRMWARE_DIGEST_SIZE);
+    }
+
+    void package_aborted() {
+        aborted = true;
+    }
+
+    void clear() {
+        started = 0;
+        length = 0;
+        completed_size = 0;
+        completed = false;
+        aborted = false;
+        start_result = true;
+        block_result = true;
+        memset(data, 0, sizeof(data));
+        memset(digest, 0, sizeof(digest));
+    }
+
+    int         started;
+    uint8_t     data[128];
+    uint32_t    length;
+    uint32_t    completed_size;
+    uint8_t     digest[M2M_FIRMWARE_DIGEST_SIZE];
+    bool        completed;
+    bool        aborted;
+    bool        start_result;
+    bool        block_result;
+};
+
+static uint8_t package[40];
+
+static sn_coap_msg_code_e send_block(M2MFirmwarePackageWriter *writer,
+                                     uint32_t number, bool more,
+                                     uint16_t length,
+                                     uint16_t msg_id = 0)
+{
+    sn_coap_hdr_s request;
+    memset(&request, 0, sizeof(sn_coap_hdr_s));
+    request.msg_id = msg_id;
+    sn_coap_options_list_s options;
+    memset(&options, 0, sizeof(sn_coap_options_list_s));
+    uint8_t block = (number << 4) | (more ? 0x08 : 0x00);
+    options.block1_ptr = &block;
+    options.block1_len = 1;
+    request.options_list_ptr = &options;
+    request.payload_ptr = package + number * BLOCK_SIZE;
+    request.payload_len = length;
+
+    sn_coap_hdr_s response;
+    memset(&response, 0, sizeof(sn_coap_hdr_s));
+    sn_coap_msg_code_e code = writer->handle_block(&request, &response);
+    if(response.options_list_ptr) {
+        free(response.options_list_ptr->block1_ptr);
+        free(response.options_list_ptr);
+    }
+    return code;
+}
+
+Test_M2MFirmwarePackageWriter::Test_M2MFirmwarePackageWriter()
+{
+    for(uint8_t i = 0; i < sizeof(package); i++) {
+        package[i] = i;
+    }
+    m2mfirmware_stub::clear();
+    firmware = M2MFirmware::get_instance();
+    writer = new M2MFirmwarePackageWriter(*firmware);
+    sink = new TestSink();
+    writer->set_sink(sink);
+}
+
+Test_M2MFirmwarePackageWriter::~Test_M2MFirmwarePackageWriter()
+{
+    delete writer;
+    delete sink;
+    delete firmware;
+}
+
+void Test_M2MFirmwarePackageWriter::test_is_block_message()
+{
+    sn_coap_hdr_s request;
+    memset(&request, 0, sizeof(sn_coap_hdr_s));
+    CHECK(false == writer->is_block_message(&request));
+    CHECK(false == writer->is_block_message(NULL));
+
+    sn_coap_options_list_s options;
+    memset(&options, 0, sizeof(sn_coap_options_list_s));
+    request.options_list_ptr = &options;
+    CHECK(false == writer->is_block_message(&request));
+
+    uint8_t block = 0x08;
+    options.block1_ptr = &block;
+    options.block1_len = 1;
+    CHECK(true == writer->is_block_message(&request));
+
+    writer->set_sink(NULL);
+    CHECK(false == writer->is_block_message(&request));
+}
+
+void Test_M2MFirmwarePackageWriter::test_parse_block_option()
+{
+    uint32_t number = 0;
+    bool more = false;
+    uint16_t size = 0;
+
+    uint8_t block[3] = {0x0A, 0xBC, 0xDC};
+    CHECK(true == M2MBlockOption::parse(block, 3, number, more, size));
+    CHECK(0xABCD == number);
+    CHECK(true == more);
+    CHECK(256 == size);
+
+    block[0] = 0x1F;
+    CHECK(false == M2MBlockOption::parse(block, 1, number, more, size));
+    CHECK(false == M2MBlockOption::parse(block, 4, number, more, size));
+    CHECK(false == M2MBlockOption::parse(NULL, 1, number, more, size));
+
+    block[0] = 0x26;
+    CHECK(true == M2MBlockOption::parse(block, 1, number, more, size));
+    CHECK(2 == number);
+    CHECK(false == more);
+    CHECK(1024 == size);
+
+    uint8_t block_len = 0;
+    uint8_t *built = M2MBlockOption::build(0xABCD, true, 256, block_len);
+    CHECK(3 == block_len);
+    CHECK(0 == memcmp(built, "\x0A\xBC\xDC", 3));
+    free(built);
+
+    built = M2MBlockOption::build(1, false, 1024, block_len);
+    CHECK(1 == block_len);
+    CHECK(0x16 == built[0]);
+    free(built);
+}
+
+void Test_M2MFirmwarePackageWriter::test_handle_block_in_order()
+{
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE));
+    CHECK(true == writer->is_active());
+    CHECK(BLOCK_SIZE == writer->package_offset());
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 1, true, BLOCK_SIZE));
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 2, false, 8));
+
+    CHECK(false == writer->is_active());
+    CHECK(1 == sink->started);
+    CHECK(true == sink->completed);
+    CHECK(40 == sink->completed_size);
+    CHECK(0 == memcmp(sink->data, package, sizeof(package)));
+
+    uint8_t digest[M2M_FIRMWARE_DIGEST_SIZE];
+    M2MSha256 sha;
+    sha.update(package, sizeof(package));
+    sha.finish(digest);
+    CHECK(0 == memcmp(sink->digest, digest, M2M_FIRMWARE_DIGEST_SIZE));
+
+    // Retransmitted last block is acknowledged again.
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 2, false, 8));
+    CHECK(40 == sink->length);
+
+    // A block without transfer in progress.
+    CHECK(COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE == send_block(writer, 1, true, BLOCK_SIZE));
+
+    // Non-last block with wrong size.
+    CHECK(COAP_MSG_CODE_RESPONSE_BAD_REQUEST == send_block(writer, 0, true, 8));
+}
+
+void Test_M2MFirmwarePackageWriter::test_handle_block_retransmission()
+{
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE));
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 1, true, BLOCK_SIZE));
+    // Response to block 1 was lost, server sends it again.
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 1, true, BLOCK_SIZE));
+    CHECK(32 == sink->length);
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 2, false, 8));
+    CHECK(0 == memcmp(sink->data, package, sizeof(package)));
+}
+
+void Test_M2MFirmwarePackageWriter::test_handle_block_first_block_retransmission()
+{
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE, 1));
+    // Response to block 0 was lost, the transfer goes on.
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE, 1));
+    CHECK(true == writer->is_active());
+    CHECK(false == sink->aborted);
+    CHECK(1 == sink->started);
+    CHECK(BLOCK_SIZE == sink->length);
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 1, true, BLOCK_SIZE, 2));
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 2, false, 8, 3));
+    CHECK(true == sink->completed);
+    CHECK(0 == memcmp(sink->data, package, sizeof(package)));
+
+    // A new package starts a new transfer.
+    sink->completed = false;
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 0, false, 8, 4));
+    CHECK(2 == sink->started);
+    CHECK(true == sink->completed);
+
+    // Response to the only block of that package was lost.
+    sink->completed = false;
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 0, false, 8, 4));
+    CHECK(2 == sink->started);
+    CHECK(false == sink->completed);
+    CHECK(8 == writer->package_offset());
+
+    // Another package of the same length is stored.
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 0, false, 8, 5));
+    CHECK(3 == sink->started);
+    CHECK(true == sink->completed);
+    CHECK(8 == writer->package_offset());
+}
+
+void Test_M2MFirmwarePackageWriter::test_handle_block_restarted_transfer()
+{
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE, 1));
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 1, true, BLOCK_SIZE, 2));
+
+    // The server starts the download again with the same block size.
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE, 3));
+    CHECK(true == sink->aborted);
+    CHECK(2 == sink->started);
+    CHECK(BLOCK_SIZE == writer->package_offset());
+    CHECK(BLOCK_SIZE == sink->length);
+
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 1, true, BLOCK_SIZE, 4));
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 2, false, 8, 5));
+    CHECK(true == sink->completed);
+    CHECK(40 == sink->completed_size);
+    CHECK(0 == memcmp(sink->data, package, sizeof(package)));
+
+    uint8_t digest[M2M_FIRMWARE_DIGEST_SIZE];
+    M2MSha256 sha;
+    sha.update(package, sizeof(package));
+    sha.finish(digest);
+    CHECK(0 == memcmp(sink->digest, digest, M2M_FIRMWARE_DIGEST_SIZE));
+}
+
+void Test_M2MFirmwarePackageWriter::test_handle_block_lost_block()
+{
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE));
+    // Block 1 is lost.
+    CHECK(COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE == send_block(writer, 2, false, 8));
+    CHECK(true == writer->is_active());
+    CHECK(BLOCK_SIZE == writer->package_offset());
+
+    // Server resumes from the expected offset.
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 1, true, BLOCK_SIZE));
+    CHECK(COAP_MSG_CODE_RESPONSE_CHANGED == send_block(writer, 2, false, 8));
+    CHECK(1 == sink->started);
+    CHECK(true == sink->completed);
+    CHECK(0 == memcmp(sink->data, package, sizeof(package)));
+}
+
+void Test_M2MFirmwarePackageWriter::test_handle_block_sink_failure()
+{
+    sink->start_result = false;
+    CHECK(COAP_MSG_CODE_RESPONSE_INTERNAL_SERVER_ERROR == send_block(writer, 0, true, BLOCK_SIZE));
+    CHECK(false == writer->is_active());
+
+    sink->start_result = true;
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE));
+    sink->block_result = false;
+    CHECK(COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE == send_block(writer, 1, true, BLOCK_SIZE));
+    CHECK(true == sink->aborted);
+    CHECK(false == writer->is_active());
+    CHECK(0 == writer->package_offset());
+}
+
+void Test_M2MFirmwarePackageWriter::test_set_sink_aborts_transfer()
+{
+    CHECK(COAP_MSG_CODE_RESPONSE_CONTINUE == send_block(writer, 0, true, BLOCK_SIZE));
+    writer->set_sink(sink);
+    CHECK(true == sink->aborted);
+    CHECK(false == writer->is_active());
+    CHECK(0 == writer->package_offset());
+}
+
+void Test_M2MFirmwarePackageWriter::test_sha256()
+{
+    const uint8_t expected[M2M_FIRMWARE_DIGEST_SIZE] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+        0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+        0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+    };
+    uint8_t digest[M2M_FIRMWARE_DIGEST_SIZE];
+    M2MSha256 sha;
+    sha.update((const uint8_t*)"a", 1);
+    sha.update((const uint8_t*)"bc", 2);
+    sha.finish(digest);
+    CHECK(0 == memcmp(digest, expected, M2M_FIRMWARE_DIGEST_SIZE));
+}
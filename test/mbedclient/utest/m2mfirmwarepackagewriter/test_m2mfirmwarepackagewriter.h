@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_M2M_FIRMWARE_PACKAGE_WRITER_H
+#define TEST_M2M_FIRMWARE_PACKAGE_WRITER_H
+
+#include "include/m2mfirmwarepackagewriter.h"
+#include "m2mfirmware.h"
+
+class TestSink;
+
+class Test_M2MFirmwarePackageWriter
+{
+public:
+    Test_M2MFirmwarePackageWriter();
+
+    virtual ~Test_M2MFirmwarePackageWriter();
+
+    void test_is_block_message();
+
+    void test_parse_block_option();
+
+    void test_handle_block_in_order();
+
+    void test_handle_block_retransmission();
+
+    void test_handle_block_first_block_retransmission();
+
+    void test_handle_block_restarted_transfer();
+
+    void test_handle_block_lost_block();
+
+    void test_handle_block_sink_failure();
+
+    void test_set_sink_aborts_transfer();
+
+    void test_sha256();
+
+    M2MFirmware                 *firmware;
+    M2MFirmwarePackageWriter    *writer;
+    TestSink                    *sink;
+};
+
+#endif // TEST_M2M_FIRMWARE_PACKAGE_WRITER_H
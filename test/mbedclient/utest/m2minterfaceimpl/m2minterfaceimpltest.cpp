@@ -72,6 +72,16 @@ TEST(M2MInterfaceImpl, set_queue_sleep_handler)
     m2m_interface_impl->test_set_queue_sleep_handler();
 }
 
+TEST(M2MInterfaceImpl, send)
+{
+    m2m_interface_impl->test_send();
+}
+
+TEST(M2MInterfaceImpl, object)
+{
+    m2m_interface_impl->test_object();
+}
+
 TEST(M2MInterfaceImpl, coap_message_ready)
 {
     m2m_interface_impl->test_coap_message_ready();
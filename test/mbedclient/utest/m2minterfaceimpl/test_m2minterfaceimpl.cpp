@@ -19,6 +19,8 @@
 #include "m2mconnectionhandler_stub.h"
 #include "m2msecurity_stub.h"
 #include "m2mnsdlinterface_stub.h"
+#include "m2mtimer_stub.h"
+#include "mbed-client/m2mconstants.h"
 #include "m2mobject_stub.h"
 #include "m2mobjectinstance_stub.h"
 #include "m2mbase.h"
@@ -425,6 +427,33 @@ void Test_M2MInterfaceImpl::test_set_queue_sleep_handler()
     CHECK(impl->_callback_handler == NULL);
 }
 
+void Test_M2MInterfaceImpl::test_send()
+{
+    M2MPathList paths;
+    paths.push_back("3/0/9");
+
+    observer->error_occured = false;
+    m2mnsdlinterface_stub::bool_value = true;
+    impl->send(paths);
+    CHECK(observer->error_occured == false);
+
+    m2mnsdlinterface_stub::bool_value = false;
+    impl->send(paths);
+    CHECK(observer->error_occured == true);
+}
+
+void Test_M2MInterfaceImpl::test_object()
+{
+    CHECK(impl->object(3) == NULL);
+
+    M2MObject *object = new M2MObject("3");
+    m2mnsdlinterface_stub::object = object;
+    CHECK(impl->object(3) == object);
+
+    m2mnsdlinterface_stub::object = NULL;
+    delete object;
+}
+
 void Test_M2MInterfaceImpl::test_coap_message_ready()
 {
     m2mconnectionhandler_stub::bool_value = true;
@@ -648,6 +677,21 @@ void Test_M2MInterfaceImpl::test_data_sent()
     impl->_binding_mode = M2MInterface::UDP_SMS_QUEUE;
     impl->data_sent();
     CHECK(impl->_current_state == M2MInterfaceImpl::STATE_WAITING);
+
+    // The client stays awake for the retransmissions of pending exchanges
+    m2mnsdlinterface_stub::pending_exchanges = 1;
+    impl->data_sent();
+    CHECK(m2mtimer_stub::interval == RETRY_COUNT*RETRY_INTERVAL*1000);
+
+    m2mnsdlinterface_stub::pending_exchanges = 0;
+    impl->data_sent();
+    CHECK(m2mtimer_stub::interval == QUEUE_LISTEN_TIME*1000);
+
+    m2mtimer_stub::interval = 0;
+    impl->_binding_mode = M2MInterface::UDP;
+    impl->data_sent();
+    CHECK(m2mtimer_stub::interval == 0);
+    m2mtimer_stub::clear();
 }
 
 void Test_M2MInterfaceImpl::test_timer_expired()
@@ -662,6 +706,8 @@ void Test_M2MInterfaceImpl::test_timer_expired()
     visited = false;
     impl->timer_expired(M2MTimerObserver::QueueSleep);
     CHECK(visited == true);
+    CHECK(m2mnsdlinterface_stub::queue_sleeping == true);
+    m2mnsdlinterface_stub::clear();
 }
 
 void Test_M2MInterfaceImpl::test_callback_handler()
@@ -41,6 +41,10 @@ public:
 
     void test_set_queue_sleep_handler();
 
+    void test_send();
+
+    void test_object();
+
     void test_coap_message_ready();
 
     void test_client_registered();
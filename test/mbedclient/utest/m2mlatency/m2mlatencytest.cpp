@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mlatency.h"
+
+
+TEST_GROUP(M2MLatency)
+{
+  Test_M2MLatency* m2m_latency;
+
+  void setup()
+  {
+    m2m_latency = new Test_M2MLatency();
+  }
+  void teardown()
+  {
+    delete m2m_latency;
+  }
+};
+
+TEST(M2MLatency, Create)
+{
+    CHECK(m2m_latency != NULL);
+}
+
+TEST(M2MLatency, test_buckets)
+{
+    m2m_latency->test_buckets();
+}
+
+TEST(M2MLatency, test_percentile)
+{
+    m2m_latency->test_percentile();
+}
+
+TEST(M2MLatency, test_request)
+{
+    m2m_latency->test_request();
+}
+
+TEST(M2MLatency, test_notification)
+{
+    m2m_latency->test_notification();
+}
+
+TEST(M2MLatency, test_export_json)
+{
+    m2m_latency->test_export_json();
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mlatency.h"
+#include "m2mstatistics.h"
+#include <string.h>
+
+static uint64_t test_time = 0;
+
+static uint64_t test_clock()
+{
+    return test_time;
+}
+
+// Confirmable message with message ID 0x1234.
+static const uint8_t con[] = { 0x40, 0x45, 0x12, 0x34 };
+
+Test_M2MLatency::Test_M2MLatency()
+{
+    test_time = 1000;
+    M2MStatistics::set_clock(test_clock);
+    M2MLatency::reset();
+    M2MLatency::request_finished();
+}
+
+Test_M2MLatency::~Test_M2MLatency()
+{
+    M2MStatistics::set_clock(NULL);
+}
+
+void Test_M2MLatency::test_buckets()
+{
+    // Exact below eight, then eight buckets per power of two.
+    CHECK(M2MLatency::bucket_upper_bound(0) == 0);
+    CHECK(M2MLatency::bucket_upper_bound(7) == 7);
+    CHECK(M2MLatency::bucket_upper_bound(8) == 8);
+    CHECK(M2MLatency::bucket_upper_bound(16) == 17);
+    CHECK(M2MLatency::bucket_upper_bound(M2MLatency::BucketCount - 1) == 0xFFFFFFFF);
+
+    M2MLatency::record(M2MLatency::GetRequest, 5);
+    M2MLatency::record(M2MLatency::GetRequest, 17);
+    M2MLatency::record(M2MLatency::GetRequest, 1000);
+    M2MLatency::record(M2MLatency::GetRequest, 0x1FFFFFFFFULL);
+    CHECK(M2MLatency::count(M2MLatency::GetRequest) == 4);
+    CHECK(M2MLatency::max(M2MLatency::GetRequest) == 0xFFFFFFFF);
+    CHECK(M2MLatency::bucket(M2MLatency::GetRequest, 5) == 1);
+    CHECK(M2MLatency::bucket(M2MLatency::GetRequest, 16) == 1);
+    CHECK(M2MLatency::bucket(M2MLatency::GetRequest, M2MLatency::BucketCount - 1) == 1);
+    CHECK(M2MLatency::count(M2MLatency::PutRequest) == 0);
+
+    // Every value falls in a bucket whose bounds are within 12.5%.
+    for(uint16_t i = 9; i < M2MLatency::BucketCount - 1; i++) {
+        uint32_t lower = M2MLatency::bucket_upper_bound(i - 1) + 1;
+        uint32_t upper = M2MLatency::bucket_upper_bound(i);
+        CHECK(upper >= lower);
+        CHECK((upper - lower) <= lower / 8);
+    }
+
+    M2MLatency::record(M2MLatency::HistogramCount, 1);
+    CHECK(M2MLatency::count(M2MLatency::HistogramCount) == 0);
+}
+
+void Test_M2MLatency::test_percentile()
+{
+    CHECK(M2MLatency::percentile(M2MLatency::PutRequest, 50.0f) == 0);
+
+    for(uint32_t i = 1; i <= 1000; i++) {
+        M2MLatency::record(M2MLatency::PutRequest, i);
+    }
+    uint32_t p50 = M2MLatency::percentile(M2MLatency::PutRequest, 50.0f);
+    CHECK(p50 >= 500 && p50 <= 500 + 500 / 8);
+    uint32_t p99 = M2MLatency::percentile(M2MLatency::PutRequest, 99.0f);
+    CHECK(p99 >= 990 && p99 <= 1000);
+    // The highest percentile is capped to the largest recorded value.
+    CHECK(M2MLatency::percentile(M2MLatency::PutRequest, 100.0f) == 1000);
+    CHECK(M2MLatency::max(M2MLatency::PutRequest) == 1000);
+
+    M2MLatency::reset();
+    CHECK(M2MLatency::count(M2MLatency::PutRequest) == 0);
+    CHECK(M2MLatency::max(M2MLatency::PutRequest) == 0);
+}
+
+void Test_M2MLatency::test_request()
+{
+    M2MLatency::request_received();
+    test_time = 1300;
+    M2MLatency::request_started(1);
+    M2MLatency::message_sent(con, sizeof(con));
+    CHECK(M2MLatency::count(M2MLatency::GetRequest) == 1);
+    CHECK(M2MLatency::max(M2MLatency::GetRequest) == 300);
+
+    // Only the first message is the response.
+    M2MLatency::message_sent(con, sizeof(con));
+    CHECK(M2MLatency::count(M2MLatency::GetRequest) == 1);
+
+    // A notification sent while handling the request is not the response.
+    M2MLatency::request_received();
+    M2MLatency::request_started(3);
+    M2MLatency::notification_sending(true);
+    M2MLatency::message_sent(con, sizeof(con));
+    M2MLatency::notification_sending(false);
+    CHECK(M2MLatency::count(M2MLatency::PutRequest) == 0);
+    test_time = 1500;
+    M2MLatency::message_sent(con, sizeof(con));
+    CHECK(M2MLatency::count(M2MLatency::PutRequest) == 1);
+    CHECK(M2MLatency::max(M2MLatency::PutRequest) == 200);
+
+    M2MLatency::request_received();
+    M2MLatency::request_started(2);
+    M2MLatency::message_sent(con, sizeof(con));
+    M2MLatency::request_received();
+    M2MLatency::request_started(4);
+    M2MLatency::message_sent(con, sizeof(con));
+    CHECK(M2MLatency::count(M2MLatency::PostRequest) == 1);
+    CHECK(M2MLatency::count(M2MLatency::DeleteRequest) == 1);
+
+    // Nothing is recorded for a request without a response or without a
+    // clock.
+    M2MLatency::request_received();
+    M2MLatency::request_started(1);
+    M2MLatency::request_finished();
+    M2MLatency::message_sent(con, sizeof(con));
+    CHECK(M2MLatency::count(M2MLatency::GetRequest) == 1);
+
+    M2MStatistics::set_clock(NULL);
+    M2MLatency::request_received();
+    M2MLatency::request_started(1);
+    M2MLatency::message_sent(con, sizeof(con));
+    CHECK(M2MLatency::count(M2MLatency::GetRequest) == 1);
+}
+
+void Test_M2MLatency::test_notification()
+{
+    M2MLatency::notification_triggered(400);
+    M2MLatency::notification_sending(true);
+    M2MLatency::message_sent(con, sizeof(con));
+    M2MLatency::notification_sending(false);
+    M2MLatency::notification_triggered(0);
+    CHECK(M2MLatency::count(M2MLatency::NotificationDelay) == 1);
+    CHECK(M2MLatency::max(M2MLatency::NotificationDelay) == 600);
+
+    // A retransmission keeps the time of the first send.
+    test_time = 1500;
+    M2MLatency::notification_sending(true);
+    M2MLatency::message_sent(con, sizeof(con));
+    M2MLatency::notification_sending(false);
+    CHECK(M2MLatency::count(M2MLatency::NotificationDelay) == 1);
+
+    test_time = 1750;
+    M2MLatency::message_acknowledged(0x4321);
+    CHECK(M2MLatency::count(M2MLatency::NotificationAck) == 0);
+    M2MLatency::message_acknowledged(0x1234);
+    CHECK(M2MLatency::count(M2MLatency::NotificationAck) == 1);
+    CHECK(M2MLatency::max(M2MLatency::NotificationAck) == 750);
+    M2MLatency::message_acknowledged(0x1234);
+    CHECK(M2MLatency::count(M2MLatency::NotificationAck) == 1);
+
+    // Non-confirmable notifications get no ACK.
+    const uint8_t non[] = { 0x50, 0x45, 0x12, 0x35 };
+    M2MLatency::notification_sending(true);
+    M2MLatency::message_sent(non, sizeof(non));
+    M2MLatency::notification_sending(false);
+    M2MLatency::message_acknowledged(0x1235);
+    CHECK(M2MLatency::count(M2MLatency::NotificationAck) == 1);
+}
+
+void Test_M2MLatency::test_export_json()
+{
+    char buffer[1024];
+    M2MLatency::record(M2MLatency::GetRequest, 5);
+    M2MLatency::record(M2MLatency::GetRequest, 5);
+    M2MLatency::record(M2MLatency::NotificationAck, 1000);
+
+    uint32_t length = M2MLatency::export_json(buffer, sizeof(buffer));
+    CHECK(length == strlen(buffer));
+    CHECK(buffer[0] == '{' && buffer[length - 1] == '}');
+    CHECK(strstr(buffer, "\"get\":{\"count\":2,\"max\":5,\"p50\":5,") != NULL);
+    CHECK(strstr(buffer, "\"buckets\":[[5,2]]") != NULL);
+    CHECK(strstr(buffer, "\"put\":{\"count\":0,") != NULL);
+    CHECK(strstr(buffer, "\"notification_ack\":{\"count\":1,\"max\":1000,") != NULL);
+    CHECK(strstr(buffer, "[1023,1]") != NULL);
+
+    CHECK(M2MLatency::export_json(buffer, 20) == 0);
+    CHECK(buffer[0] == '\0');
+    CHECK(M2MLatency::export_json(NULL, 0) == 0);
+}
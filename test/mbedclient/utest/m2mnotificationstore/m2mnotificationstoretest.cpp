@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mnotificationstore.h"
+
+
+TEST_GROUP(M2MNotificationStore)
+{
+  Test_M2MNotificationStore* m2m_notification_store;
+
+  void setup()
+  {
+    m2m_notification_store = new Test_M2MNotificationStore();
+  }
+  void teardown()
+  {
+    delete m2m_notification_store;
+  }
+};
+
+TEST(M2MNotificationStore, Create)
+{
+    CHECK(m2m_notification_store != NULL);
+}
+
+TEST(M2MNotificationStore, test_store)
+{
+    m2m_notification_store->test_store();
+}
+
+TEST(M2MNotificationStore, test_store_resource_ids)
+{
+    m2m_notification_store->test_store_resource_ids();
+}
+
+TEST(M2MNotificationStore, test_store_composite)
+{
+    m2m_notification_store->test_store_composite();
+}
+
+TEST(M2MNotificationStore, test_clear)
+{
+    m2m_notification_store->test_clear();
+}
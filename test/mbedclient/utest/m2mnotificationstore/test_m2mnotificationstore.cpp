@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mnotificationstore.h"
+
+Test_M2MNotificationStore::Test_M2MNotificationStore()
+{
+}
+
+Test_M2MNotificationStore::~Test_M2MNotificationStore()
+{
+}
+
+void Test_M2MNotificationStore::test_store()
+{
+    M2MNotificationStore store;
+    m2m::IdSet ids;
+    ids.insert(1);
+
+    store.store("3/0/1", 1, ids, false, NULL);
+    store.store("3", 2, ids, false, NULL);
+    CHECK(store.count() == 2);
+
+    // A later notification replaces the pending one of the same path.
+    ids.clear();
+    ids.insert(4);
+    store.store("3", 5, ids, true, NULL);
+    ids.clear();
+    store.store("3", 6, ids, false, NULL);
+    CHECK(store.count() == 2);
+
+    const M2MNotificationStore::Entry &resource = store.entry(0);
+    CHECK(resource.path == "3/0/1");
+    CHECK(resource.composite == NULL);
+    CHECK(resource.observation_number == 1);
+
+    const M2MNotificationStore::Entry &object = store.entry(1);
+    CHECK(object.path == "3");
+    CHECK(object.observation_number == 6);
+    CHECK(object.send_object == true);
+    CHECK(object.instance_ids.contains(1));
+    CHECK(object.instance_ids.contains(4));
+    CHECK(object.delta == false);
+}
+
+void Test_M2MNotificationStore::test_store_resource_ids()
+{
+    M2MNotificationStore store;
+    m2m::IdSet instance_ids;
+    m2m::IdSet resource_ids;
+    resource_ids.insert(1);
+
+    store.store("3/0", 1, instance_ids, false, &resource_ids);
+    resource_ids.clear();
+    resource_ids.insert(13);
+    store.store("3/0", 2, instance_ids, false, &resource_ids);
+
+    const M2MNotificationStore::Entry &entry = store.entry(0);
+    CHECK(entry.delta == true);
+    CHECK(entry.resource_ids.contains(1));
+    CHECK(entry.resource_ids.contains(13));
+    CHECK(!entry.resource_ids.contains(2));
+
+    // Once all resources are to be sent the changed ones don't matter.
+    store.store("3/0", 3, instance_ids, false, NULL);
+    CHECK(entry.delta == false);
+    CHECK(entry.resource_ids.empty());
+
+    store.store("3/0", 4, instance_ids, false, &resource_ids);
+    CHECK(entry.delta == false);
+    CHECK(entry.resource_ids.empty());
+    CHECK(store.count() == 1);
+}
+
+void Test_M2MNotificationStore::test_store_composite()
+{
+    M2MNotificationStore store;
+    m2m::IdSet ids;
+    int first = 0;
+    int second = 0;
+    M2MCompositeObservation *observation = (M2MCompositeObservation*)&first;
+    M2MCompositeObservation *other = (M2MCompositeObservation*)&second;
+
+    store.store(NULL);
+    CHECK(store.count() == 0);
+
+    store.store(observation);
+    store.store("3/0/1", 1, ids, false, NULL);
+    store.store(other);
+    store.store(observation);
+    CHECK(store.count() == 3);
+    CHECK(store.entry(0).composite == observation);
+    CHECK(store.entry(0).path.empty());
+    CHECK(store.entry(2).composite == other);
+
+    store.remove(observation);
+    CHECK(store.count() == 2);
+    CHECK(store.entry(0).path == "3/0/1");
+    CHECK(store.entry(1).composite == other);
+
+    store.remove(observation);
+    CHECK(store.count() == 2);
+}
+
+void Test_M2MNotificationStore::test_clear()
+{
+    M2MNotificationStore store;
+    m2m::IdSet ids;
+    uint32_t empty = store.memory_footprint();
+
+    ids.insert(100);
+    store.store("3", 1, ids, false, NULL);
+    store.store("5/0/1", 1, ids, false, &ids);
+    CHECK(store.memory_footprint() > empty);
+
+    store.clear();
+    CHECK(store.count() == 0);
+    store.store("3/0/1", 2, ids, false, NULL);
+    CHECK(store.count() == 1);
+    CHECK(store.entry(0).observation_number == 2);
+}
@@ -53,6 +53,21 @@ TEST(M2MNsdlInterface, send_unregister_message)
     m2m_nsdl_interface->test_send_unregister_message();
 }
 
+TEST(M2MNsdlInterface, send_data)
+{
+    m2m_nsdl_interface->test_send_data();
+}
+
+TEST(M2MNsdlInterface, samples_to_be_sent)
+{
+    m2m_nsdl_interface->test_samples_to_be_sent();
+}
+
+TEST(M2MNsdlInterface, queue_mode)
+{
+    m2m_nsdl_interface->test_queue_mode();
+}
+
 TEST(M2MNsdlInterface, send_update_registration)
 {
     m2m_nsdl_interface->test_send_update_registration();
@@ -179,6 +194,16 @@ TEST(M2MNsdlInterface, test_send_delayed_response)
     m2m_nsdl_interface->test_send_delayed_response();
 }
 
+TEST(M2MNsdlInterface, test_handle_composite_request)
+{
+    m2m_nsdl_interface->test_handle_composite_request();
+}
+
+TEST(M2MNsdlInterface, test_composite_observation)
+{
+    m2m_nsdl_interface->test_composite_observation();
+}
+
 TEST(M2MNsdlInterface, resource_callback_put)
 {
     m2m_nsdl_interface->test_resource_callback_put();
@@ -23,7 +23,12 @@
 #include "m2mresourceinstance_stub.h"
 #include "m2mresource.h"
 #include "m2mbase_stub.h"
+#include "m2msenmlcborserializer_stub.h"
+#include "m2msenmlcbordeserializer_stub.h"
+#include "m2mreporthandler_stub.h"
+#include "mbed-client/m2mconstants.h"
 #include "m2mserver.h"
+#include "m2msamplebuffer.h"
 #include "m2msecurity.h"
 
 class TestObserver : public M2MNsdlObserver {
@@ -259,6 +264,230 @@ void Test_M2MNsdlInterface::test_send_unregister_message()
 
 }
 
+void Test_M2MNsdlInterface::test_send_data()
+{
+    M2MPathList paths;
+    CHECK(nsdl->send_data(paths) == M2MInterface::NotRegistered);
+
+    nsdl->_server = new M2MServer();
+    nsdl->_nsdl_handle = (nsdl_s*)malloc(sizeof(nsdl_s));
+    memset(nsdl->_nsdl_handle,0,sizeof(nsdl_s));
+    sn_nsdl_oma_server_info_t * nsp_address = (sn_nsdl_oma_server_info_t *)malloc(sizeof(sn_nsdl_oma_server_info_t));
+    memset(nsp_address,0,sizeof(sn_nsdl_oma_server_info_t));
+    sn_nsdl_addr_s* address = (sn_nsdl_addr_s*)malloc(sizeof(sn_nsdl_addr_s));
+    memset(address,0,sizeof(sn_nsdl_addr_s));
+    nsdl->_nsdl_handle->nsp_address_ptr = nsp_address;
+    nsdl->_nsdl_handle->nsp_address_ptr->omalw_address_ptr = address;
+
+    CHECK(nsdl->send_data(paths) == M2MInterface::InvalidParameters);
+
+    m2mbase_stub::string_value = new String("name");
+    M2MObject *object = new M2MObject("name");
+    M2MObjectInstance *object_instance = new M2MObjectInstance("name",*object);
+    M2MResource *resource = new M2MResource(*object_instance,
+                                            "resource_name",
+                                            "resource_type",
+                                            M2MResourceInstance::INTEGER,
+                                            false);
+    m2mobject_stub::inst = object_instance;
+    m2mobjectinstance_stub::resource = resource;
+    m2mobjectinstance_stub::resource_list.push_back(resource);
+    nsdl->_object_list.push_back(object);
+
+    paths.push_back("unknown/0");
+    CHECK(nsdl->send_data(paths) == M2MInterface::InvalidParameters);
+
+    paths.clear();
+    paths.push_back("/name/0/name");
+    paths.push_back("name/0");
+    m2msenmlcborserializer_stub::bool_value = false;
+    CHECK(nsdl->send_data(paths) == M2MInterface::InvalidParameters);
+
+    m2msenmlcborserializer_stub::bool_value = true;
+    CHECK(nsdl->send_data(paths) == M2MInterface::MemoryFail);
+
+    m2msenmlcborserializer_stub::size_value = 4;
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    common_stub::int_value = -1;
+    CHECK(nsdl->send_data(paths) == M2MInterface::NetworkError);
+
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    common_stub::int_value = 0;
+    CHECK(nsdl->send_data(paths) == M2MInterface::ErrorNone);
+
+    delete m2mbase_stub::string_value;
+    m2mbase_stub::string_value = NULL;
+    m2msenmlcborserializer_stub::clear();
+    m2mobject_stub::clear();
+    m2mobjectinstance_stub::clear();
+
+    nsdl->_object_list.clear();
+    delete resource;
+    delete object_instance;
+    delete object;
+
+    free(address);
+    free(nsp_address);
+    free(nsdl->_nsdl_handle);
+    nsdl->_nsdl_handle = NULL;
+}
+
+void Test_M2MNsdlInterface::test_samples_to_be_sent()
+{
+    m2mbase_stub::string_value = new String("name");
+    M2MObject *object = new M2MObject("name");
+    M2MObjectInstance *object_instance = new M2MObjectInstance("name",*object);
+    M2MResource *resource = new M2MResource(*object_instance,
+                                            "resource_name",
+                                            "resource_type",
+                                            M2MResourceInstance::INTEGER,
+                                            false);
+    M2MSampleBuffer samples(4, 0, 0, 0, M2MResourceInstance::DropOldest, true);
+    samples.add(1, (const uint8_t*)"1", 1);
+
+    CHECK(nsdl->samples_to_be_sent(resource, 1, samples) == false);
+
+    nsdl->_server = new M2MServer();
+    nsdl->_nsdl_handle = (nsdl_s*)malloc(sizeof(nsdl_s));
+    memset(nsdl->_nsdl_handle,0,sizeof(nsdl_s));
+    sn_nsdl_oma_server_info_t * nsp_address = (sn_nsdl_oma_server_info_t *)malloc(sizeof(sn_nsdl_oma_server_info_t));
+    memset(nsp_address,0,sizeof(sn_nsdl_oma_server_info_t));
+    sn_nsdl_addr_s* address = (sn_nsdl_addr_s*)malloc(sizeof(sn_nsdl_addr_s));
+    memset(address,0,sizeof(sn_nsdl_addr_s));
+    nsdl->_nsdl_handle->nsp_address_ptr = nsp_address;
+    nsdl->_nsdl_handle->nsp_address_ptr->omalw_address_ptr = address;
+
+    // Send operation
+    CHECK(nsdl->samples_to_be_sent(resource, 1, samples) == false);
+
+    m2msenmlcborserializer_stub::size_value = 4;
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    common_stub::int_value = -1;
+    CHECK(nsdl->samples_to_be_sent(resource, 1, samples) == false);
+
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    common_stub::int_value = 0;
+    CHECK(nsdl->samples_to_be_sent(resource, 1, samples) == true);
+
+    // A notification needs an observer with a token.
+    M2MSampleBuffer notified(4, 0, 0, 0, M2MResourceInstance::DropOldest, false);
+    notified.add(1, (const uint8_t*)"1", 1);
+    m2mbase_stub::observation_level_value = M2MBase::None;
+    CHECK(nsdl->samples_to_be_sent(resource, 1, notified) == false);
+
+    m2mbase_stub::observation_level_value = M2MBase::R_Attribute;
+    CHECK(nsdl->samples_to_be_sent(resource, 1, notified) == false);
+
+    delete m2mbase_stub::string_value;
+    m2mbase_stub::string_value = NULL;
+    m2mbase_stub::observation_level_value = M2MBase::None;
+    m2msenmlcborserializer_stub::clear();
+
+    delete resource;
+    delete object_instance;
+    delete object;
+
+    free(address);
+    free(nsp_address);
+    free(nsdl->_nsdl_handle);
+    nsdl->_nsdl_handle = NULL;
+}
+
+void Test_M2MNsdlInterface::test_queue_mode()
+{
+    // Confirmable messages are pending until their ACK
+    uint8_t con[] = {0x40, 0x02, 0x12, 0x34};
+    uint8_t con_2[] = {0x40, 0x02, 0x12, 0x35};
+    uint8_t non[] = {0x50, 0x02, 0x12, 0x36};
+    nsdl->send_to_server_callback(NULL, SN_NSDL_PROTOCOL_COAP, con, sizeof(con), NULL);
+    nsdl->send_to_server_callback(NULL, SN_NSDL_PROTOCOL_COAP, con, sizeof(con), NULL);
+    CHECK(nsdl->pending_exchanges() == 1);
+    nsdl->send_to_server_callback(NULL, SN_NSDL_PROTOCOL_COAP, con_2, sizeof(con_2), NULL);
+    nsdl->send_to_server_callback(NULL, SN_NSDL_PROTOCOL_COAP, non, sizeof(non), NULL);
+    CHECK(nsdl->pending_exchanges() == 2);
+
+    sn_coap_hdr_s *coap_header = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(coap_header, 0, sizeof(sn_coap_hdr_s));
+    coap_header->msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
+    coap_header->msg_id = 0x1234;
+    nsdl->received_from_server_callback(NULL, coap_header, NULL);
+    CHECK(nsdl->pending_exchanges() == 1);
+
+    nsdl->queue_mode_sleep();
+    CHECK(nsdl->pending_exchanges() == 0);
+    CHECK(nsdl->_queue_sleeping == true);
+
+    // Notifications are held, one per observation
+    m2mbase_stub::string_value = new String("name");
+    M2MObject *object = new M2MObject("name");
+    m2m::IdSet ids;
+    ids.insert(0);
+    nsdl->observation_to_be_sent(object, 1, ids);
+    nsdl->observation_to_be_sent(object, 2, ids, true);
+    CHECK(nsdl->_notification_store.count() == 1);
+    CHECK(nsdl->_notification_store.entry(0).observation_number == 2);
+
+    uint8_t token[] = {0x01, 0x02};
+    M2MPathList paths;
+    M2MCompositeObservation *observation = new M2MCompositeObservation(*nsdl, token,
+                                                                       sizeof(token),
+                                                                       paths);
+    nsdl->_composite_observations.push_back(observation);
+    nsdl->composite_observation_to_be_sent(*observation);
+    CHECK(nsdl->_notification_store.count() == 2);
+
+    m2msenmlcborserializer_stub::size_value = 4;
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    m2msenmlcborserializer_stub::bool_value = true;
+    M2MSampleBuffer samples(4, 0, 0, 0, M2MResourceInstance::DropOldest, true);
+    samples.add(1, (const uint8_t*)"1", 1);
+    nsdl->_server = new M2MServer();
+    nsdl->_nsdl_handle = (nsdl_s*)malloc(sizeof(nsdl_s));
+    memset(nsdl->_nsdl_handle,0,sizeof(nsdl_s));
+    CHECK(nsdl->samples_to_be_sent(object, 1, samples) == false);
+    free(m2msenmlcborserializer_stub::uint8_value);
+    m2msenmlcborserializer_stub::uint8_value = NULL;
+
+    // The acknowledged registration update flushes the store
+    nsdl->_update_id = 10;
+    coap_header->msg_id = 10;
+    coap_header->msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
+    nsdl->received_from_server_callback(NULL, coap_header, NULL);
+    CHECK(nsdl->_queue_sleeping == false);
+    CHECK(nsdl->_notification_store.count() == 0);
+
+    // A new registration drops the held notifications unsent
+    nsdl->queue_mode_sleep();
+    nsdl->composite_observation_to_be_sent(*observation);
+    CHECK(nsdl->_notification_store.count() == 1);
+    uint16_t observation_number = observation->observation_number();
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    nsdl->_register_id = 11;
+    coap_header->msg_id = 11;
+    coap_header->msg_code = COAP_MSG_CODE_RESPONSE_CREATED;
+    nsdl->received_from_server_callback(NULL, coap_header, NULL);
+    CHECK(nsdl->_queue_sleeping == false);
+    CHECK(nsdl->_notification_store.count() == 0);
+    CHECK(observation->observation_number() == observation_number);
+    free(m2msenmlcborserializer_stub::uint8_value);
+    m2msenmlcborserializer_stub::uint8_value = NULL;
+
+    // Cancelling a composite observation removes its notification
+    nsdl->queue_mode_sleep();
+    nsdl->composite_observation_to_be_sent(*observation);
+    CHECK(nsdl->_notification_store.count() == 1);
+    nsdl->cancel_composite_observation(token, sizeof(token));
+    CHECK(nsdl->_notification_store.count() == 0);
+
+    free(coap_header);
+    free(nsdl->_nsdl_handle);
+    nsdl->_nsdl_handle = NULL;
+    delete object;
+    delete m2mbase_stub::string_value;
+    m2mbase_stub::string_value = NULL;
+    m2msenmlcborserializer_stub::clear();
+}
+
 void Test_M2MNsdlInterface::test_memory_alloc()
 {
     CHECK(nsdl->memory_alloc(0) == 0);
@@ -1263,7 +1492,7 @@ void Test_M2MNsdlInterface::test_timer_expired()
 
 void Test_M2MNsdlInterface::test_observation_to_be_sent()
 {
-    Vector<uint16_t> instance_list_ids;
+    m2m::IdSet instance_list_ids;
     M2MObject *object = new M2MObject("name");
     M2MObjectInstance* instance = new M2MObjectInstance("name",*object);
     M2MResource *res = new M2MResource(*instance,
@@ -1286,7 +1515,7 @@ void Test_M2MNsdlInterface::test_observation_to_be_sent()
     m2mresource_stub::list.push_back(res_instance);
     m2mresource_stub::list.push_back(res_instance_1);
     m2mresource_stub::int_value = 2;
-    instance_list_ids.push_back(0);
+    instance_list_ids.insert(0);
 
     uint8_t value[] = {"value"};
     m2mresourceinstance_stub::value = (uint8_t *)malloc(sizeof(value));
@@ -1331,7 +1560,7 @@ void Test_M2MNsdlInterface::test_observation_to_be_sent()
     m2mobject_stub::inst = object_instance;
     m2mobjectinstance_stub::resource_list.push_back(res);
     nsdl->_object_list.push_back(object);
-    instance_list_ids.push_back(1);
+    instance_list_ids.insert(1);
     //CHECK if nothing crashes
     nsdl->observation_to_be_sent(object, 1, instance_list_ids);
     nsdl->observation_to_be_sent(object, 500, instance_list_ids, true);
@@ -1364,6 +1593,7 @@ void Test_M2MNsdlInterface::test_observation_to_be_sent()
     res_instance_1 = NULL;
 
 
+    m2mobject_stub::inst = NULL;
     delete object_instance;
     object_instance = NULL;
 
@@ -1493,6 +1723,10 @@ void Test_M2MNsdlInterface::test_find_resource()
     m2mobjectinstance_stub::resource_list.push_back(resource);
     m2mresource_stub::list.push_back(resource_instance);
 
+    m2mobject_stub::inst = object_instance;
+    m2mobjectinstance_stub::resource = resource;
+    m2mresource_stub::instance = resource_instance;
+
     m2mobject_stub::base_type = M2MBase::Object;
 
     nsdl->_object_list.push_back(object);
@@ -1510,10 +1744,18 @@ void Test_M2MNsdlInterface::test_find_resource()
     CHECK(nsdl->find_resource("name/0/name/0") != NULL);
 
     CHECK(nsdl->find_resource("name1") == NULL);
-    CHECK(nsdl->find_resource("name/1") == NULL);
-    CHECK(nsdl->find_resource("name/0/name1") == NULL);
+    CHECK(nsdl->find_resource("name/a") == NULL);
+    CHECK(nsdl->find_resource("name/0/name/0/0") == NULL);
+
+    m2mresource_stub::instance = NULL;
     CHECK(nsdl->find_resource("name/0/name/1") == NULL);
 
+    m2mobjectinstance_stub::resource = NULL;
+    CHECK(nsdl->find_resource("name/0/name1") == NULL);
+
+    m2mobject_stub::inst = NULL;
+    CHECK(nsdl->find_resource("name/1") == NULL);
+
     delete m2mbase_stub::string_value;
     m2mbase_stub::string_value = NULL;
 
@@ -1553,6 +1795,11 @@ void Test_M2MNsdlInterface::test_add_object_to_list()
     nsdl->add_object_to_list(obj);
     CHECK(nsdl->_object_list.size() == 1);
 
+    m2mbase_stub::name_id_value = 3;
+    CHECK(nsdl->object(3) == obj);
+    CHECK(nsdl->object(4) == NULL);
+    m2mbase_stub::name_id_value = -1;
+
     nsdl->_object_list.clear();
     delete obj;
 }
@@ -1608,3 +1855,230 @@ void Test_M2MNsdlInterface::test_send_delayed_response()
     m2mresource_stub::delayed_token = NULL;
     m2mresource_stub::delayed_token_len = 0;
 }
+
+void Test_M2MNsdlInterface::test_handle_composite_request()
+{
+    m2mbase_stub::string_value = new String("name");
+    M2MObject *object = new M2MObject("name");
+    M2MObjectInstance *object_instance = new M2MObjectInstance("name",*object);
+    M2MResource *resource = new M2MResource(*object_instance,
+                                            "resource_name",
+                                            "resource_type",
+                                            M2MResourceInstance::INTEGER,
+                                            false);
+    m2mobject_stub::inst = object_instance;
+    m2mobjectinstance_stub::resource = resource;
+    m2mobjectinstance_stub::resource_list.push_back(resource);
+    nsdl->_object_list.push_back(object);
+
+    sn_coap_hdr_s *coap_header = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(coap_header, 0, sizeof(sn_coap_hdr_s));
+    coap_header->msg_code = (sn_coap_msg_code_e)COAP_REQUEST_FETCH;
+    coap_header->msg_id = 2;
+
+    common_stub::coap_header = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(common_stub::coap_header, 0, sizeof(sn_coap_hdr_s));
+
+    // FETCH of a single resource
+    uint8_t path[] = {"name/0"};
+    coap_header->uri_path_ptr = path;
+    coap_header->uri_path_len = sizeof(path) - 1;
+    common_stub::int_value = 0;
+    CHECK(nsdl->received_from_server_callback(NULL, coap_header, NULL) == 0);
+    coap_header->uri_path_ptr = NULL;
+    coap_header->uri_path_len = 0;
+
+    // Unsupported content format
+    uint8_t content_type[] = {COAP_CONTENT_OMA_TLV_TYPE};
+    coap_header->content_type_ptr = content_type;
+    coap_header->content_type_len = 1;
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+    content_type[0] = COAP_CONTENT_OMA_SENML_CBOR_TYPE;
+
+    // Invalid payload
+    m2msenmlcbordeserializer_stub::bool_value = false;
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+
+    // Unknown path
+    m2msenmlcbordeserializer_stub::bool_value = true;
+    m2msenmlcbordeserializer_stub::paths.push_back("unknown/0");
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+
+    // Read
+    m2msenmlcbordeserializer_stub::paths.clear();
+    m2msenmlcbordeserializer_stub::paths.push_back("name/0/name");
+    m2msenmlcborserializer_stub::bool_value = true;
+    m2msenmlcborserializer_stub::size_value = 4;
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+    CHECK(common_stub::coap_header->content_type_ptr == NULL);
+    CHECK(nsdl->_composite_observations.empty());
+
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    common_stub::int_value = -1;
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 1);
+    common_stub::int_value = 0;
+
+    // Serializer out of memory
+    m2msenmlcborserializer_stub::uint8_value = NULL;
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+
+    free(common_stub::coap_header);
+    common_stub::coap_header = NULL;
+    free(coap_header);
+
+    m2msenmlcbordeserializer_stub::clear();
+    m2msenmlcborserializer_stub::clear();
+    delete m2mbase_stub::string_value;
+    m2mbase_stub::string_value = NULL;
+    m2mobject_stub::clear();
+    m2mobjectinstance_stub::clear();
+
+    nsdl->_object_list.clear();
+    delete resource;
+    delete object_instance;
+    delete object;
+}
+
+void Test_M2MNsdlInterface::test_composite_observation()
+{
+    m2mbase_stub::string_value = new String("name");
+    M2MObject *object = new M2MObject("name");
+    M2MObjectInstance *object_instance = new M2MObjectInstance("name",*object);
+    M2MResource *resource = new M2MResource(*object_instance,
+                                            "resource_name",
+                                            "resource_type",
+                                            M2MResourceInstance::INTEGER,
+                                            false);
+    m2mobject_stub::inst = object_instance;
+    m2mobjectinstance_stub::resource = resource;
+    m2mobjectinstance_stub::resource_list.push_back(resource);
+    m2mresourceinstance_stub::base_type = M2MBase::Resource;
+    nsdl->_object_list.push_back(object);
+
+    nsdl->_nsdl_handle = (nsdl_s*)malloc(sizeof(nsdl_s));
+    memset(nsdl->_nsdl_handle,0,sizeof(nsdl_s));
+    sn_nsdl_oma_server_info_t * nsp_address = (sn_nsdl_oma_server_info_t *)malloc(sizeof(sn_nsdl_oma_server_info_t));
+    memset(nsp_address,0,sizeof(sn_nsdl_oma_server_info_t));
+    sn_nsdl_addr_s* address = (sn_nsdl_addr_s*)malloc(sizeof(sn_nsdl_addr_s));
+    memset(address,0,sizeof(sn_nsdl_addr_s));
+    nsdl->_nsdl_handle->nsp_address_ptr = nsp_address;
+    nsdl->_nsdl_handle->nsp_address_ptr->omalw_address_ptr = address;
+
+    sn_coap_hdr_s *coap_header = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(coap_header, 0, sizeof(sn_coap_hdr_s));
+    coap_header->msg_code = (sn_coap_msg_code_e)COAP_REQUEST_FETCH;
+    uint8_t token[] = {0x01, 0x02};
+    coap_header->token_ptr = token;
+    coap_header->token_len = sizeof(token);
+    coap_header->options_list_ptr = (sn_coap_options_list_s *)malloc(sizeof(sn_coap_options_list_s));
+    memset(coap_header->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+    coap_header->options_list_ptr->observe = 1;
+    uint8_t observe = START_OBSERVATION;
+    coap_header->options_list_ptr->observe_ptr = &observe;
+    coap_header->options_list_ptr->observe_len = 1;
+
+    common_stub::coap_header = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(common_stub::coap_header, 0, sizeof(sn_coap_hdr_s));
+    common_stub::int_value = 0;
+
+    m2msenmlcbordeserializer_stub::bool_value = true;
+    m2msenmlcbordeserializer_stub::paths.push_back("name/0/name");
+    m2msenmlcborserializer_stub::bool_value = true;
+    m2msenmlcborserializer_stub::size_value = 4;
+
+    // Invalid attributes
+    uint8_t query[] = {"pmin=a"};
+    coap_header->options_list_ptr->uri_query_ptr = query;
+    coap_header->options_list_ptr->uri_query_len = sizeof(query) - 1;
+    m2mreporthandler_stub::bool_return = false;
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+    CHECK(nsdl->_composite_observations.empty());
+    coap_header->options_list_ptr->uri_query_ptr = NULL;
+    coap_header->options_list_ptr->uri_query_len = 0;
+
+    // Start
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+    CHECK(nsdl->_composite_observations.size() == 1);
+    CHECK(common_stub::coap_header->options_list_ptr != NULL);
+    CHECK(common_stub::coap_header->options_list_ptr->observe_ptr == NULL);
+    free(common_stub::coap_header->options_list_ptr);
+    common_stub::coap_header->options_list_ptr = NULL;
+
+    M2MCompositeObservation *observation = nsdl->_composite_observations[0];
+    CHECK(observation->is_member("name/0/name"));
+    CHECK(observation->has_token(token, sizeof(token)));
+
+    // A resource created later under the observed path is a member too
+    sn_nsdl_resource_info_s *nsdl_resource =
+            (sn_nsdl_resource_info_s*)malloc(sizeof(sn_nsdl_resource_info_s));
+    memset(nsdl_resource, 0, sizeof(sn_nsdl_resource_info_s));
+    nsdl_resource->mode = SN_GRS_DYNAMIC;
+    common_stub::resource = nsdl_resource;
+    m2mbase_stub::base_type = M2MBase::Resource;
+    m2mbase_stub::observe = NULL;
+    CHECK(nsdl->create_nsdl_resource(resource, "name/0/other", false));
+    CHECK(m2mbase_stub::observe == NULL);
+    CHECK(nsdl->create_nsdl_resource(resource, "name/0/name/1", false));
+    CHECK(m2mbase_stub::observe == nsdl);
+    common_stub::resource = NULL;
+    free(nsdl_resource);
+
+    // Observing again with the same token replaces the observation
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+    CHECK(nsdl->_composite_observations.size() == 1);
+    free(common_stub::coap_header->options_list_ptr);
+    common_stub::coap_header->options_list_ptr = NULL;
+    observation = nsdl->_composite_observations[0];
+
+    // Notification
+    nsdl->composite_value_changed(resource);
+    nsdl->composite_value_changed(object);
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    nsdl->composite_observation_to_be_sent(*observation);
+    CHECK(observation->observation_number() == 1);
+    m2msenmlcborserializer_stub::uint8_value = NULL;
+    nsdl->composite_observation_to_be_sent(*observation);
+    CHECK(observation->observation_number() == 1);
+
+    // Cancel
+    observe = STOP_OBSERVATION;
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+    CHECK(nsdl->_composite_observations.empty());
+
+    // The destructor deletes the remaining observations
+    observe = START_OBSERVATION;
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(4);
+    CHECK(nsdl->handle_composite_request(coap_header, NULL) == 0);
+    CHECK(nsdl->_composite_observations.size() == 1);
+    free(common_stub::coap_header->options_list_ptr);
+    common_stub::coap_header->options_list_ptr = NULL;
+
+    free(common_stub::coap_header);
+    common_stub::coap_header = NULL;
+    free(coap_header->options_list_ptr);
+    free(coap_header);
+
+    m2msenmlcbordeserializer_stub::clear();
+    m2msenmlcborserializer_stub::clear();
+    m2mreporthandler_stub::clear();
+    delete m2mbase_stub::string_value;
+    m2mbase_stub::string_value = NULL;
+    m2mobject_stub::clear();
+    m2mobjectinstance_stub::clear();
+    m2mresourceinstance_stub::clear();
+
+    nsdl->_object_list.clear();
+    delete resource;
+    delete object_instance;
+    delete object;
+
+    free(address);
+    free(nsp_address);
+    free(nsdl->_nsdl_handle);
+    nsdl->_nsdl_handle = NULL;
+}
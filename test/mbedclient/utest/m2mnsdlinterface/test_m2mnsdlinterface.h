@@ -44,6 +44,12 @@ public:
 
     void test_send_unregister_message();
 
+    void test_send_data();
+
+    void test_samples_to_be_sent();
+
+    void test_queue_mode();
+
     void test_memory_alloc();
 
     void test_memory_free();
@@ -86,6 +92,10 @@ public:
 
     void test_send_delayed_response();
 
+    void test_handle_composite_request();
+
+    void test_composite_observation();
+
     M2MNsdlInterface* nsdl;
 
     TestObserver *observer;
@@ -27,7 +27,7 @@ class TestReportObserver :  public M2MReportObserver{
 public :
     TestReportObserver() {}
     ~TestReportObserver() {}
-    void observation_to_be_sent(m2m::Vector<uint16_t>,bool){ }
+    void observation_to_be_sent(const m2m::IdSet &, bool, const m2m::IdSet *){ }
 };
 
 class Handler : public M2MObservationHandler {
@@ -36,7 +36,7 @@ public:
 
     Handler(){}
     ~Handler(){}
-    void observation_to_be_sent(M2MBase *, uint16_t, m2m::Vector<uint16_t>,bool){
+    void observation_to_be_sent(M2MBase *, uint16_t, const m2m::IdSet &, bool, const m2m::IdSet *){
         visited = true;
     }
     void send_delayed_response(M2MBase *){}
@@ -204,6 +204,7 @@ void Test_M2MObject::test_handle_get_request()
     memcpy(coap_header->token_ptr, value, sizeof(value));
 
     coap_header->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+    memset(coap_header->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
     coap_header->options_list_ptr->observe = 0;
 
 
@@ -618,8 +619,11 @@ void Test_M2MObject::test_handle_post_request()
     ins->set_instance_id(0);
     object->_instance_list.push_back(ins);
 
+    // Instance 0 is taken, the next free ID is over the limit.
+    m2mbase_stub::int_value = 0;
     coap_response = object->handle_post_request(NULL,coap_header,handler,execute_value_updated);
     CHECK( coap_response != NULL);
+    CHECK( coap_response->msg_code == COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED);
 
     object->remove_object_instance(0);
     delete test;
@@ -866,7 +870,7 @@ void Test_M2MObject::test_notification_update()
     m2mbase_stub::report = new M2MReportHandler(obs);
     m2mbase_stub::bool_value = true;
 
-    object->notification_update(0);
+    object->notification_update(0, 5);
 
     delete m2mbase_stub::report;
     m2mbase_stub::report = NULL;
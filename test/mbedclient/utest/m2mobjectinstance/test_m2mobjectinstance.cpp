@@ -21,7 +21,10 @@
 #include "m2mbase_stub.h"
 #include "m2mtlvdeserializer_stub.h"
 #include "m2mtlvserializer_stub.h"
+#include "m2msenmlcborserializer_stub.h"
+#include "m2msenmlcbordeserializer_stub.h"
 #include "m2mreporthandler_stub.h"
+#include "mbed-client/m2mconstants.h"
 
 // Length is 65
 String max_length = "65656565656565656565656565656565656565656565656565656565656565656";
@@ -32,7 +35,7 @@ public:
 
     Handler(){}
     ~Handler(){}
-    void observation_to_be_sent(M2MBase *, uint16_t, m2m::Vector<uint16_t>,bool){
+    void observation_to_be_sent(M2MBase *, uint16_t, const m2m::IdSet &, bool, const m2m::IdSet *){
         visited = true;
     }
      void send_delayed_response(M2MBase *){}
@@ -48,7 +51,7 @@ class TestReportObserver :  public M2MReportObserver{
 public :
     TestReportObserver() {}
     ~TestReportObserver() {}
-    void observation_to_be_sent(m2m::Vector<uint16_t>,bool){ }
+    void observation_to_be_sent(const m2m::IdSet &, bool, const m2m::IdSet *){ }
 };
 
 class Callback : public M2MObjectCallback {
@@ -57,7 +60,7 @@ public:
 
     Callback(){}
     ~Callback(){}
-    void notification_update(uint16_t obj_instance_id) {
+    void notification_update(uint16_t, int32_t) {
         visited = true;
     }
 
@@ -307,6 +310,27 @@ void Test_M2MObjectInstance::test_resource()
     result = object->resource("name");
     CHECK(result != NULL);
 
+    result = object->resource(String("name"));
+    CHECK(result != NULL);
+
+    result = object->resource("other");
+    CHECK(result == NULL);
+
+    m2mbase_stub::name_id_value = 5;
+    result = object->resource_by_id(5);
+    CHECK(result != NULL);
+
+    result = object->resource_by_id(6);
+    CHECK(result == NULL);
+
+    // Resource ID 0, e.g. /3/0/0
+    m2mbase_stub::name_id_value = 0;
+    result = object->resource_by_id(0);
+    CHECK(result != NULL);
+
+    result = object->resource((const char*)NULL);
+    CHECK(result == NULL);
+
     delete name;
     name = NULL;
 }
@@ -403,6 +427,7 @@ void Test_M2MObjectInstance::test_handle_get_request()
     memcpy(coap_header->token_ptr, value, sizeof(value));
 
     coap_header->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+    memset(coap_header->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
     coap_header->options_list_ptr->observe = 0;
 
     coap_header->content_type_ptr = (uint8_t*)malloc(1);
@@ -468,6 +493,37 @@ void Test_M2MObjectInstance::test_handle_get_request()
         common_stub::coap_header->options_list_ptr = NULL;
     }
 
+    // SenML-CBOR asked for with the Accept option, which wins over Content-Format
+    uint8_t accept = COAP_CONTENT_OMA_SENML_CBOR_TYPE;
+    coap_header->options_list_ptr->accept_ptr = &accept;
+    coap_header->options_list_ptr->accept_len = 1;
+    m2msenmlcborserializer_stub::uint8_value = (uint8_t*)malloc(1);
+    m2msenmlcborserializer_stub::size_value = 1;
+
+    sn_coap_hdr_s *coap_response = object->handle_get_request(NULL,coap_header,handler);
+    CHECK(coap_response != NULL);
+    CHECK(coap_response->msg_code == COAP_MSG_CODE_RESPONSE_CONTENT);
+    CHECK(*coap_response->content_type_ptr == COAP_CONTENT_OMA_SENML_CBOR_TYPE);
+    CHECK(coap_response->payload_ptr == m2msenmlcborserializer_stub::uint8_value);
+
+    coap_header->options_list_ptr->accept_ptr = NULL;
+    coap_header->options_list_ptr->accept_len = 0;
+    free(m2msenmlcborserializer_stub::uint8_value);
+    m2msenmlcborserializer_stub::clear();
+
+    if(common_stub::coap_header->content_type_ptr) {
+        free(common_stub::coap_header->content_type_ptr);
+        common_stub::coap_header->content_type_ptr = NULL;
+    }
+    if(common_stub::coap_header->options_list_ptr->max_age_ptr) {
+        free(common_stub::coap_header->options_list_ptr->max_age_ptr);
+        common_stub::coap_header->options_list_ptr->max_age_ptr = NULL;
+    }
+    if(common_stub::coap_header->options_list_ptr) {
+        free(common_stub::coap_header->options_list_ptr);
+        common_stub::coap_header->options_list_ptr = NULL;
+    }
+
     coap_header->options_list_ptr->observe = 1;
 
     uint8_t obs = 0;
@@ -770,6 +826,31 @@ void Test_M2MObjectInstance::test_handle_put_request()
         }
     }
 
+    // SenML-CBOR
+    *coap_header->content_type_ptr = COAP_CONTENT_OMA_SENML_CBOR_TYPE;
+    m2msenmlcbordeserializer_stub::error = M2MSenMLCBORDeserializer::None;
+
+    coap_response = object->handle_put_request(NULL,coap_header,handler,execute_value_updated);
+    CHECK( coap_response != NULL);
+    CHECK(coap_response->msg_code == COAP_MSG_CODE_RESPONSE_CHANGED);
+    free(coap_response->content_type_ptr);
+    coap_response->content_type_ptr = NULL;
+
+    m2msenmlcbordeserializer_stub::error = M2MSenMLCBORDeserializer::NotFound;
+
+    coap_response = object->handle_put_request(NULL,coap_header,handler,execute_value_updated);
+    CHECK(coap_response->msg_code == COAP_MSG_CODE_RESPONSE_NOT_FOUND);
+    free(coap_response->content_type_ptr);
+    coap_response->content_type_ptr = NULL;
+
+    m2msenmlcbordeserializer_stub::error = M2MSenMLCBORDeserializer::NotValid;
+
+    coap_response = object->handle_put_request(NULL,coap_header,handler,execute_value_updated);
+    CHECK(coap_response->msg_code == COAP_MSG_CODE_RESPONSE_BAD_REQUEST);
+    free(coap_response->content_type_ptr);
+    coap_response->content_type_ptr = NULL;
+    m2msenmlcbordeserializer_stub::clear();
+
     *coap_header->content_type_ptr = 100;
 
     coap_response = object->handle_put_request(NULL,coap_header,handler,execute_value_updated);
@@ -1183,7 +1264,7 @@ void Test_M2MObjectInstance::test_notification_update()
 {
     M2MBase::Observation obs_level = M2MBase::O_Attribute;
 
-    object->notification_update(obs_level);
+    object->notification_update(obs_level, 5);
     CHECK(callback->visited == true);
 
     obs_level = M2MBase::OI_Attribute;
@@ -1192,7 +1273,7 @@ void Test_M2MObjectInstance::test_notification_update()
     m2mbase_stub::report = new M2MReportHandler(obs);
     m2mbase_stub::bool_value = true;
 
-    object->notification_update(obs_level);
+    object->notification_update(obs_level, 5);
 
     delete m2mbase_stub::report;
     m2mbase_stub::report = NULL;
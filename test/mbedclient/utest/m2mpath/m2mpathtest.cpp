@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mpath.h"
+
+
+TEST_GROUP(M2MPath)
+{
+  Test_M2MPath* m2m_path;
+
+  void setup()
+  {
+    m2m_path = new Test_M2MPath();
+  }
+  void teardown()
+  {
+    delete m2m_path;
+  }
+};
+
+TEST(M2MPath, Create)
+{
+    CHECK(m2m_path != NULL);
+}
+
+TEST(M2MPath, test_parse)
+{
+    m2m_path->test_parse();
+}
+
+TEST(M2MPath, test_parse_invalid)
+{
+    m2m_path->test_parse_invalid();
+}
+
+TEST(M2MPath, test_equals)
+{
+    m2m_path->test_equals();
+}
+
+TEST(M2MPath, test_to_string)
+{
+    m2m_path->test_to_string();
+}
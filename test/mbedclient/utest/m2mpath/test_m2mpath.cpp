@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mpath.h"
+
+Test_M2MPath::Test_M2MPath()
+{
+    path = new M2MPath();
+}
+
+Test_M2MPath::~Test_M2MPath()
+{
+    delete path;
+}
+
+void Test_M2MPath::test_parse()
+{
+    CHECK(path->depth() == 0);
+    CHECK(path->id(0) == -1);
+
+    // Not null terminated, as in a CoAP option.
+    uint8_t value[] = {'3','3','0','3','/','0','/','5','7','0','0','/','1','X'};
+    CHECK(path->parse(value, sizeof(value) - 1));
+    CHECK(path->depth() == 4);
+    CHECK(path->id(0) == 3303);
+    CHECK(path->id(1) == 0);
+    CHECK(path->id(2) == 5700);
+    CHECK(path->id(3) == 1);
+    CHECK(path->id(4) == -1);
+
+    CHECK(path->parse(String("Test/65535/name")));
+    CHECK(path->depth() == 3);
+    CHECK(path->id(0) == -1);
+    CHECK(path->id(1) == 65535);
+    CHECK(path->id(2) == -1);
+    CHECK(path->id(3) == -1);
+
+    CHECK(path->parse(String("3/65536")));
+    CHECK(path->depth() == 2);
+    CHECK(path->id(1) == -1);
+
+    // The path ends at a NUL.
+    uint8_t value2[] = {"1/0"};
+    CHECK(path->parse(value2, sizeof(value2)));
+    CHECK(path->depth() == 2);
+    CHECK(path->id(1) == 0);
+}
+
+void Test_M2MPath::test_parse_invalid()
+{
+    CHECK(!path->parse(NULL, 0));
+    CHECK(path->depth() == 0);
+    CHECK(!path->parse(String("")));
+    CHECK(!path->parse(String("/3")));
+    CHECK(!path->parse(String("3/")));
+    CHECK(!path->parse(String("3//0")));
+    CHECK(!path->parse(String("3/0/1/2/3")));
+    CHECK(path->depth() == 0);
+    CHECK(path->id(0) == -1);
+}
+
+void Test_M2MPath::test_equals()
+{
+    String object("Test");
+    CHECK(!path->equals(0, object));
+
+    // The parsed string must outlive the path.
+    String value("Test/0/res");
+    CHECK(path->parse(value));
+    CHECK(path->equals(0, object));
+    CHECK(path->equals(2, String("res")));
+    CHECK(!path->equals(2, String("re")));
+    CHECK(!path->equals(2, String("resource")));
+    CHECK(!path->equals(1, object));
+    CHECK(!path->equals(3, object));
+}
+
+void Test_M2MPath::test_to_string()
+{
+    CHECK(path->to_string(1).empty());
+
+    uint8_t value[] = {'3','/','0','/','1'};
+    CHECK(path->parse(value, sizeof(value)));
+    STRCMP_EQUAL("3", path->to_string(1).c_str());
+    STRCMP_EQUAL("3/0", path->to_string(2).c_str());
+    STRCMP_EQUAL("3/0/1", path->to_string(3).c_str());
+    CHECK(path->to_string(0).empty());
+    CHECK(path->to_string(4).empty());
+}
@@ -77,3 +77,7 @@ TEST(M2MReportHandler, test_attribute_flags)
     m2m_reporthandler->test_attribute_flags();
 }
 
+TEST(M2MReportHandler, test_sample_added)
+{
+    m2m_reporthandler->test_sample_added();
+}
@@ -19,17 +19,30 @@
 #include "m2mtimer.h"
 #include "m2mtimerobserver.h"
 #include "m2mbase.h"
+#include "m2msamplebuffer.h"
 
 class Observer : public M2MReportObserver{
 
 public:
 
-    Observer(){}
+    Observer() : changed_count(0), changed_resource_count(-1),
+                 samples_sent(false), samples_count(-1) {}
     virtual ~Observer(){}
-    void observation_to_be_sent(m2m::Vector<uint16_t>,bool){
+    void observation_to_be_sent(const m2m::IdSet &changed_instance_ids, bool,
+                                const m2m::IdSet *changed_resource_ids){
         visited = true;
+        changed_count = changed_instance_ids.size();
+        changed_resource_count = changed_resource_ids ? changed_resource_ids->size() : -1;
+    }
+    bool samples_to_be_sent(M2MSampleBuffer &samples){
+        samples_count = samples.count();
+        return samples_sent;
     }
     bool visited;
+    int changed_count;
+    int changed_resource_count;
+    bool samples_sent;
+    int samples_count;
 };
 
 class TimerObserver : public M2MTimerObserver
@@ -362,14 +375,25 @@ void Test_M2MReportHandler::test_trigger_object_notification()
     CHECK(_handler->_pmin_exceeded == false);
     CHECK(_observer->visited == true);
 
-    _handler->_changed_instance_ids.push_back(0);
-    _handler->_changed_instance_ids.push_back(1);
-    _handler->_changed_instance_ids.push_back(2);
+    _handler->_changed_instance_ids.insert(0);
+    _handler->_changed_instance_ids.insert(1);
+    _handler->_changed_instance_ids.insert(2);
 
-    _handler->set_notification_trigger();
+    _handler->_notify = true;
+    _handler->_pmin_exceeded = true;
+    _handler->set_notification_trigger(2);
     CHECK(_handler->_pmin_exceeded == false);
     CHECK(_observer->visited == true);
+    CHECK(_observer->changed_count == 3);
+    CHECK(_handler->_changed_instance_ids.empty());
+    CHECK(_observer->changed_resource_count == -1);
 
+    _handler->_notify = true;
+    _handler->_pmin_exceeded = true;
+    _handler->set_notification_trigger(1, 5);
+    CHECK(_observer->changed_resource_count == 1);
+    CHECK(_handler->_changed_resource_ids.empty());
+    CHECK(_handler->_all_resources_changed == false);
 }
 
 void Test_M2MReportHandler::test_set_string_notification_trigger()
@@ -420,3 +444,36 @@ void Test_M2MReportHandler::test_attribute_flags()
             M2MReportHandler::St | M2MReportHandler::Gt | M2MReportHandler::Lt | M2MReportHandler::Cancel;
     CHECK(_handler->attribute_flags() == (1 << 6) - 1);
 }
+
+void Test_M2MReportHandler::test_sample_added()
+{
+    M2MSampleBuffer buffer(3, 0, 1000, 0, M2MResourceInstance::DropOldest, false);
+    _observer->samples_sent = true;
+
+    buffer.add(1, (const uint8_t*)"1", 1);
+    _handler->sample_added(buffer);
+    CHECK(_handler->_sample_timer != NULL);
+    buffer.add(2, (const uint8_t*)"2", 1);
+    _handler->sample_added(buffer);
+    CHECK(_observer->samples_count == -1);
+
+    // Count threshold reached.
+    buffer.add(3, (const uint8_t*)"3", 1);
+    _handler->sample_added(buffer);
+    CHECK(_observer->samples_count == 3);
+    CHECK(buffer.count() == 0);
+
+    // Samples which could not be sent are kept.
+    _observer->samples_count = -1;
+    _observer->samples_sent = false;
+    buffer.add(4, (const uint8_t*)"4", 1);
+    _handler->sample_added(buffer);
+    _handler->timer_expired(M2MTimerObserver::SampleFlush);
+    CHECK(_observer->samples_count == 1);
+    CHECK(buffer.count() == 1);
+
+    _observer->samples_count = -1;
+    _handler->remove_sample_buffer(&buffer);
+    _handler->timer_expired(M2MTimerObserver::SampleFlush);
+    CHECK(_observer->samples_count == -1);
+}
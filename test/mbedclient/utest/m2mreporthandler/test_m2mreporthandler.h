@@ -43,6 +43,8 @@ public:
 
     void test_attribute_flags();
 
+    void test_sample_added();
+
     M2MReportHandler *_handler;
     Observer         * _observer;
 };
@@ -28,7 +28,7 @@ class TestReportObserver :  public M2MReportObserver{
 public :
     TestReportObserver() {}
     ~TestReportObserver() {}
-    void observation_to_be_sent(m2m::Vector<uint16_t>,bool){ }
+    void observation_to_be_sent(const m2m::IdSet &, bool, const m2m::IdSet *){ }
 };
 
 
@@ -40,7 +40,7 @@ public:
 
     Callback(){}
     ~Callback(){}
-    void notification_update(M2MBase::Observation) {
+    void notification_update(M2MBase::Observation, int32_t) {
         visited = true;
     }
 
@@ -54,7 +54,7 @@ public:
 
     Handler(){}
     ~Handler(){}
-    void observation_to_be_sent(M2MBase *, uint16_t,m2m::Vector<uint16_t>,bool){
+    void observation_to_be_sent(M2MBase *, uint16_t, const m2m::IdSet &, bool, const m2m::IdSet *){
         visited = true;
     }
     void send_delayed_response(M2MBase *){}
@@ -255,6 +255,7 @@ void Test_M2MResource::test_handle_get_request()
     memcpy(coap_header->token_ptr, value, sizeof(value));
 
     coap_header->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+    memset(coap_header->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
     coap_header->options_list_ptr->observe = 0;
 
     coap_header->content_type_ptr = (uint8_t*)malloc(1);
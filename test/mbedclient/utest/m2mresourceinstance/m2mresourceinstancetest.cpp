@@ -81,6 +81,11 @@ TEST(M2MResourceInstance, test_set_value)
     m2m_resourceinstance->test_set_value();
 }
 
+TEST(M2MResourceInstance, test_report_composite)
+{
+    m2m_resourceinstance->test_report_composite();
+}
+
 TEST(M2MResourceInstance, test_clear_value)
 {
     m2m_resourceinstance->test_clear_value();
@@ -106,6 +111,26 @@ TEST(M2MResourceInstance, test_handle_get_request)
     m2m_resourceinstance->test_handle_get_request();
 }
 
+TEST(M2MResourceInstance, test_set_value_reference)
+{
+    m2m_resourceinstance->test_set_value_reference();
+}
+
+TEST(M2MResourceInstance, test_handle_get_request_block)
+{
+    m2m_resourceinstance->test_handle_get_request_block();
+}
+
+TEST(M2MResourceInstance, test_set_value_provider)
+{
+    m2m_resourceinstance->test_set_value_provider();
+}
+
+TEST(M2MResourceInstance, test_mark_changed)
+{
+    m2m_resourceinstance->test_mark_changed();
+}
+
 TEST(M2MResourceInstance, test_handle_put_request)
 {
     m2m_resourceinstance->test_handle_put_request();
@@ -125,3 +150,13 @@ TEST(M2MResourceInstance, test_get_object_name)
 {
     m2m_resourceinstance->test_get_object_name();
 }
+
+TEST(M2MResourceInstance, test_memory_footprint)
+{
+    m2m_resourceinstance->test_memory_footprint();
+}
+
+TEST(M2MResourceInstance, test_set_sample_buffer)
+{
+    m2m_resourceinstance->test_set_sample_buffer();
+}
@@ -18,6 +18,7 @@
 #include "CppUTest/MemoryLeakDetectorMallocMacros.h"
 #include "m2mbase_stub.h"
 #include "m2mobservationhandler.h"
+#include "m2mconstants.h"
 #include "m2mreporthandler.h"
 #include "m2mreporthandler_stub.h"
 #include "common_stub.h"
@@ -28,6 +29,25 @@ static void callback_function(void *args)
     cb_visited = true;
 }
 
+static uint32_t provider_calls = 0;
+static void provide_value(M2MResourceInstance *resource)
+{
+    provider_calls++;
+    uint8_t value[] = {"42"};
+    resource->set_value(value, (u_int32_t)sizeof(value));
+}
+
+class ValueProvider {
+public:
+    void provide_value(M2MResourceInstance *resource) {
+        visited = true;
+        uint8_t value[] = {"7"};
+        resource->set_value(value, 1);
+    }
+
+    bool visited;
+};
+
 class MyTest{
 public:
     void execute_function(void */*argument*/) {
@@ -41,7 +61,7 @@ class TestReportObserver :  public M2MReportObserver{
 public :
     TestReportObserver() {}
     ~TestReportObserver() {}
-    void observation_to_be_sent(m2m::Vector<uint16_t>,bool){ }
+    void observation_to_be_sent(const m2m::IdSet &, bool, const m2m::IdSet *){ }
 };
 
 class ResourceCallback : public M2MResourceCallback {
@@ -64,16 +84,18 @@ public:
 
     Handler(){}
     ~Handler(){}
-    void observation_to_be_sent(M2MBase *, uint16_t, m2m::Vector<uint16_t>, bool){
+    void observation_to_be_sent(M2MBase *, uint16_t, const m2m::IdSet &, bool, const m2m::IdSet *){
         visited = true;
     }
     void send_delayed_response(M2MBase *){}
     void resource_to_be_deleted(const String &){visited=true;}
     void remove_object(M2MBase *){visited = true;}
     void value_updated(M2MBase *,const String&){visited = true;}
+    void composite_value_changed(M2MBase *base){composite = base;}
 
-    void clear() {visited = false;}
+    void clear() {visited = false; composite = NULL;}
     bool visited;
+    M2MBase *composite;
 };
 
 class Callback : public M2MObjectInstanceCallback {
@@ -82,7 +104,7 @@ public:
 
     Callback(){}
     ~Callback(){}
-    void notification_update(M2MBase::Observation) {
+    void notification_update(M2MBase::Observation, int32_t) {
         visited = true;
     }
 
@@ -308,6 +330,40 @@ void Test_M2MResourceInstance::test_set_value()
     delete resource_cb;
 }
 
+void Test_M2MResourceInstance::test_report_composite()
+{
+    Handler handler;
+    handler.clear();
+    m2mbase_stub::observe = &handler;
+    m2mbase_stub::mode_value = M2MBase::Dynamic;
+
+    // Not part of a composite observation
+    m2mbase_stub::observation_level_value = M2MBase::None;
+    u_int8_t value[] = {"1"};
+    CHECK(resource_instance->set_value(value,(u_int32_t)sizeof(value)) == true);
+    CHECK(handler.composite == NULL);
+
+    m2mbase_stub::observation_level_value = M2MBase::C_Attribute;
+    u_int8_t value2[] = {"2"};
+    resource_instance->_resource_type = M2MResourceInstance::INTEGER;
+    CHECK(resource_instance->set_value(value2,(u_int32_t)sizeof(value2)) == true);
+    CHECK(handler.composite == resource_instance);
+
+    // String values are reported too
+    handler.clear();
+    u_int8_t value3[] = {"3"};
+    resource_instance->_resource_type = M2MResourceInstance::STRING;
+    CHECK(resource_instance->set_value(value3,(u_int32_t)sizeof(value3)) == true);
+    CHECK(handler.composite == resource_instance);
+
+    handler.clear();
+    resource_instance->clear_value();
+    CHECK(handler.composite == resource_instance);
+
+    m2mbase_stub::observe = NULL;
+    m2mbase_stub::observation_level_value = M2MBase::None;
+}
+
 void Test_M2MResourceInstance::test_clear_value()
 {
     u_int8_t value[] = {"value"};
@@ -387,6 +443,7 @@ void Test_M2MResourceInstance::test_handle_get_request()
     memcpy(coap_header->token_ptr, value, sizeof(value));
 
     coap_header->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+    memset(coap_header->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
     coap_header->options_list_ptr->observe = 0;
 
     coap_header->content_type_ptr = (uint8_t*)malloc(1);
@@ -622,6 +679,123 @@ void Test_M2MResourceInstance::test_handle_get_request()
     common_stub::clear();
 }
 
+void Test_M2MResourceInstance::test_set_value_reference()
+{
+    uint8_t region[] = {'r','e','g','i','o','n'};
+
+    CHECK(resource_instance->set_value_reference(NULL, 6) == false);
+    CHECK(resource_instance->set_value_reference(region, 0) == false);
+    CHECK(resource_instance->is_value_reference() == false);
+
+    CHECK(resource_instance->set_value_reference(region, sizeof(region)) == true);
+    CHECK(resource_instance->is_value_reference() == true);
+    CHECK(resource_instance->value() == region);
+    CHECK(resource_instance->value_length() == sizeof(region));
+
+    // Setting a normal value releases the reference without freeing the region.
+    uint8_t value[] = {"value"};
+    CHECK(resource_instance->set_value(value, (u_int32_t)sizeof(value)) == true);
+    CHECK(resource_instance->is_value_reference() == false);
+    CHECK(resource_instance->value() != value);
+    CHECK(resource_instance->value_length() == sizeof(value));
+
+    CHECK(resource_instance->set_value_reference(region, sizeof(region)) == true);
+    resource_instance->clear_value();
+    CHECK(resource_instance->is_value_reference() == false);
+    CHECK(resource_instance->value() == NULL);
+    CHECK(region[0] == 'r');
+
+    // A changed numeric reference is not parsed, it is not NUL terminated.
+    TestReportObserver obs;
+    m2mbase_stub::report = new M2MReportHandler(obs);
+    m2mbase_stub::bool_value = true;
+    m2mbase_stub::mode_value = M2MBase::Dynamic;
+    m2mbase_stub::observation_level_value = M2MBase::R_Attribute;
+    resource_instance->_resource_type = M2MResourceInstance::INTEGER;
+    CHECK(resource_instance->set_value_reference(region, sizeof(region)) == true);
+    m2mreporthandler_stub::clear();
+    resource_instance->mark_changed();
+    CHECK(m2mreporthandler_stub::notification_triggered == true);
+    CHECK(m2mreporthandler_stub::set_value_called == false);
+
+    delete m2mbase_stub::report;
+    m2mbase_stub::report = NULL;
+    m2mreporthandler_stub::clear();
+    m2mbase_stub::clear();
+}
+
+void Test_M2MResourceInstance::test_handle_get_request_block()
+{
+    uint8_t region[2500];
+    for(uint32_t i = 0; i < sizeof(region); i++) {
+        region[i] = i & 0xFF;
+    }
+    uint8_t value[] = {"name"};
+    sn_coap_hdr_s *coap_header = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(coap_header, 0, sizeof(sn_coap_hdr_s));
+    coap_header->uri_path_ptr = value;
+    coap_header->uri_path_len = sizeof(value);
+    coap_header->msg_code = COAP_MSG_CODE_REQUEST_GET;
+    coap_header->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+    memset(coap_header->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+
+    String *name = new String("name");
+    m2mbase_stub::string_value = name;
+    m2mbase_stub::operation = M2MBase::GET_ALLOWED;
+    common_stub::coap_header = (sn_coap_hdr_ *)malloc(sizeof(sn_coap_hdr_));
+
+    resource_instance->_resource_type = M2MResourceInstance::OPAQUE;
+    resource_instance->set_value_reference(region, sizeof(region));
+
+    // No Block2 option, the first block is returned.
+    memset(common_stub::coap_header,0,sizeof(sn_coap_hdr_));
+    CHECK(resource_instance->handle_get_request(NULL,coap_header,handler) != NULL);
+    CHECK(common_stub::coap_header->msg_code == COAP_MSG_CODE_RESPONSE_CONTENT);
+    CHECK(common_stub::coap_header->payload_len == MAX_VALUE_BLOCK_SIZE);
+    CHECK(memcmp(common_stub::coap_header->payload_ptr, region, MAX_VALUE_BLOCK_SIZE) == 0);
+    CHECK(common_stub::coap_header->options_list_ptr->block2_len == 1);
+    CHECK(*common_stub::coap_header->options_list_ptr->block2_ptr == 0x0E);
+    free(common_stub::coap_header->payload_ptr);
+    free(common_stub::coap_header->content_type_ptr);
+    free(common_stub::coap_header->options_list_ptr->max_age_ptr);
+    free(common_stub::coap_header->options_list_ptr->block2_ptr);
+    free(common_stub::coap_header->options_list_ptr);
+
+    // Last block, 512 bytes each.
+    uint8_t block = 0x45;
+    coap_header->options_list_ptr->block2_ptr = &block;
+    coap_header->options_list_ptr->block2_len = 1;
+    memset(common_stub::coap_header,0,sizeof(sn_coap_hdr_));
+    CHECK(resource_instance->handle_get_request(NULL,coap_header,handler) != NULL);
+    CHECK(common_stub::coap_header->msg_code == COAP_MSG_CODE_RESPONSE_CONTENT);
+    CHECK(common_stub::coap_header->payload_len == 452);
+    CHECK(memcmp(common_stub::coap_header->payload_ptr, region + 2048, 452) == 0);
+    CHECK(*common_stub::coap_header->options_list_ptr->block2_ptr == 0x45);
+    free(common_stub::coap_header->payload_ptr);
+    free(common_stub::coap_header->content_type_ptr);
+    free(common_stub::coap_header->options_list_ptr->max_age_ptr);
+    free(common_stub::coap_header->options_list_ptr->block2_ptr);
+    free(common_stub::coap_header->options_list_ptr);
+
+    // Out of range.
+    block = 0x55;
+    memset(common_stub::coap_header,0,sizeof(sn_coap_hdr_));
+    CHECK(resource_instance->handle_get_request(NULL,coap_header,handler) != NULL);
+    CHECK(common_stub::coap_header->msg_code == COAP_MSG_CODE_RESPONSE_BAD_OPTION);
+    CHECK(common_stub::coap_header->payload_ptr == NULL);
+    free(common_stub::coap_header->content_type_ptr);
+    free(common_stub::coap_header->options_list_ptr->max_age_ptr);
+    free(common_stub::coap_header->options_list_ptr);
+
+    free(common_stub::coap_header);
+    common_stub::coap_header = NULL;
+    free(coap_header->options_list_ptr);
+    free(coap_header);
+    delete name;
+    m2mbase_stub::clear();
+    common_stub::clear();
+}
+
 void Test_M2MResourceInstance::test_handle_put_request()
 {
     uint8_t value[] = {"name"};
@@ -769,3 +943,120 @@ void Test_M2MResourceInstance::test_get_object_instance_id()
     resource_instance->_object_instance_id = 100;
     CHECK(resource_instance->object_instance_id() == 100);
 }
+
+void Test_M2MResourceInstance::test_set_value_provider()
+{
+    m2mbase_stub::mode_value = M2MBase::Static;
+    m2mbase_stub::observe = (M2MObservationHandler*)handler;
+    handler->clear();
+
+    provider_calls = 0;
+    resource_instance->set_value_provider(provide_value);
+    CHECK(provider_calls == 0);
+    CHECK(resource_instance->value() == NULL);
+
+    uint8_t *buffer = NULL;
+    uint32_t length = 0;
+    resource_instance->get_value(buffer, length);
+    CHECK(provider_calls == 1);
+    CHECK(length == 3);
+    STRCMP_EQUAL("42", (const char*)buffer);
+    // Values set by the provider are not reported.
+    CHECK(handler->visited == false);
+
+    ValueProvider provider;
+    provider.visited = false;
+    resource_instance->set_value_provider(value_provider_callback(&provider,
+                                              &ValueProvider::provide_value));
+    resource_instance->get_value(buffer, length);
+    CHECK(provider.visited == true);
+    CHECK(provider_calls == 1);
+    CHECK(length == 1);
+    CHECK(buffer[0] == '7');
+
+    free(buffer);
+    m2mbase_stub::clear();
+}
+
+void Test_M2MResourceInstance::test_mark_changed()
+{
+    resource_instance->_resource_type = M2MResourceInstance::INTEGER;
+    m2mbase_stub::mode_value = M2MBase::Static;
+    m2mbase_stub::observe = (M2MObservationHandler*)handler;
+
+    handler->clear();
+    resource_instance->mark_changed();
+    CHECK(handler->visited == true);
+
+    provider_calls = 0;
+    resource_instance->set_value_provider(provide_value);
+    handler->clear();
+    resource_instance->mark_changed();
+    CHECK(provider_calls == 1);
+    CHECK(handler->visited == true);
+    STRCMP_EQUAL("42", (const char*)resource_instance->value());
+
+    m2mbase_stub::clear();
+}
+
+void Test_M2MResourceInstance::test_memory_footprint()
+{
+    m2mbase_stub::uint32_value = 20;
+    uint32_t bytes = resource_instance->memory_footprint();
+    CHECK(bytes >= sizeof(M2MResourceInstance) + 20);
+
+    // Owned values are stored with a terminating NUL.
+    uint8_t value[] = {"value"};
+    resource_instance->set_value(value, 5);
+    CHECK(resource_instance->memory_footprint() == bytes + 6);
+
+    // Referenced values belong to the application.
+    resource_instance->set_value_reference(value, 5);
+    CHECK(resource_instance->memory_footprint() == bytes);
+
+    resource_instance->set_execute_function(callback_function);
+    CHECK(resource_instance->memory_footprint() > bytes);
+    m2mbase_stub::clear();
+}
+
+void Test_M2MResourceInstance::test_set_sample_buffer()
+{
+    m2mbase_stub::base_type = M2MBase::ResourceInstance;
+    CHECK(resource_instance->set_sample_buffer(4) == false);
+
+    m2mbase_stub::base_type = M2MBase::Resource;
+    CHECK(resource_instance->set_sample_buffer(0) == false);
+    CHECK(resource_instance->sample_count() == 0);
+
+    uint32_t footprint = resource_instance->memory_footprint();
+    CHECK(resource_instance->set_sample_buffer(4, 2, 1000, 0, M2MResourceInstance::DropNewest) == true);
+    CHECK(resource_instance->memory_footprint() > footprint);
+
+    TestReportObserver obs;
+    m2mbase_stub::report = new M2MReportHandler(obs);
+
+    // Unchanged values are samples too.
+    u_int8_t value[] = {"12"};
+    CHECK(resource_instance->set_value(value, (u_int32_t)sizeof(value)) == true);
+    CHECK(resource_instance->set_value(value, (u_int32_t)sizeof(value)) == true);
+    CHECK(resource_instance->sample_count() == 2);
+
+    // Values from the provider are not.
+    resource_instance->_providing_value = true;
+    CHECK(resource_instance->set_value(value, (u_int32_t)sizeof(value)) == true);
+    resource_instance->_providing_value = false;
+    CHECK(resource_instance->sample_count() == 2);
+
+    CHECK(resource_instance->sends_samples() == false);
+
+    // The Send operation doesn't need an observer.
+    CHECK(resource_instance->set_sample_buffer(4, 2, 0, 0, M2MResourceInstance::DropOldest, true) == true);
+    CHECK(resource_instance->sends_samples() == true);
+
+    resource_instance->remove_sample_buffer();
+    CHECK(resource_instance->sample_count() == 0);
+    CHECK(resource_instance->sends_samples() == false);
+
+    delete m2mbase_stub::report;
+    m2mbase_stub::report = NULL;
+}
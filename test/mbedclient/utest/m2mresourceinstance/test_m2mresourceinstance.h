@@ -47,6 +47,8 @@ public:
 
     void test_set_value();
 
+    void test_report_composite();
+
     void test_clear_value();
 
     void test_get_value();
@@ -57,6 +59,14 @@ public:
 
     void test_handle_get_request();
 
+    void test_set_value_reference();
+
+    void test_handle_get_request_block();
+
+    void test_set_value_provider();
+
+    void test_mark_changed();
+
     void test_handle_put_request();
 
     void test_set_resource_observer();
@@ -69,6 +79,10 @@ public:
 
     Callback *callback;
 
+    void test_memory_footprint();
+
+    void test_set_sample_buffer();
+
     Handler* handler;
 };
 
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2msamplebuffer.h"
+
+
+TEST_GROUP(M2MSampleBuffer)
+{
+  Test_M2MSampleBuffer* m2m_sample_buffer;
+
+  void setup()
+  {
+    m2m_sample_buffer = new Test_M2MSampleBuffer();
+  }
+  void teardown()
+  {
+    delete m2m_sample_buffer;
+  }
+};
+
+TEST(M2MSampleBuffer, Create)
+{
+    CHECK(m2m_sample_buffer != NULL);
+}
+
+TEST(M2MSampleBuffer, test_add)
+{
+    m2m_sample_buffer->test_add();
+}
+
+TEST(M2MSampleBuffer, test_drop_oldest)
+{
+    m2m_sample_buffer->test_drop_oldest();
+}
+
+TEST(M2MSampleBuffer, test_drop_newest)
+{
+    m2m_sample_buffer->test_drop_newest();
+}
+
+TEST(M2MSampleBuffer, test_flush_due)
+{
+    m2m_sample_buffer->test_flush_due();
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2msamplebuffer.h"
+#include <string.h>
+
+static bool check_sample(const M2MSampleBuffer &buffer, uint16_t index,
+                         uint64_t time, const char *value)
+{
+    uint64_t sample_time = 0;
+    const uint8_t *sample_value = NULL;
+    uint32_t length = 0;
+    return buffer.sample(index, sample_time, sample_value, length) &&
+           sample_time == time &&
+           length == strlen(value) &&
+           memcmp(sample_value, value, length) == 0;
+}
+
+Test_M2MSampleBuffer::Test_M2MSampleBuffer()
+{
+}
+
+Test_M2MSampleBuffer::~Test_M2MSampleBuffer()
+{
+}
+
+void Test_M2MSampleBuffer::test_add()
+{
+    M2MSampleBuffer buffer(4, 0, 0, 0, M2MResourceInstance::DropOldest, false);
+    CHECK(buffer.is_valid());
+    CHECK(buffer.count() == 0);
+    CHECK(buffer.bytes() == 0);
+
+    CHECK(buffer.add(10, (const uint8_t*)"21.5", 4));
+    CHECK(buffer.add(20, (const uint8_t*)"22", 2));
+    CHECK(buffer.count() == 2);
+    CHECK(buffer.bytes() == 6);
+    CHECK(check_sample(buffer, 0, 10, "21.5"));
+    CHECK(check_sample(buffer, 1, 20, "22"));
+
+    uint64_t time = 0;
+    const uint8_t *value = NULL;
+    uint32_t length = 0;
+    CHECK(!buffer.sample(2, time, value, length));
+
+    uint32_t footprint = buffer.memory_footprint();
+    buffer.clear();
+    CHECK(buffer.count() == 0);
+    CHECK(buffer.bytes() == 0);
+    CHECK(buffer.memory_footprint() == footprint - 8);
+
+    M2MSampleBuffer empty(0, 0, 0, 0, M2MResourceInstance::DropOldest, false);
+    CHECK(!empty.is_valid());
+    CHECK(!empty.add(10, (const uint8_t*)"1", 1));
+}
+
+void Test_M2MSampleBuffer::test_drop_oldest()
+{
+    M2MSampleBuffer buffer(3, 0, 0, 0, M2MResourceInstance::DropOldest, false);
+    const char *values[] = {"1", "2", "3", "4", "5"};
+    for(int i = 0; i < 5; i++) {
+        CHECK(buffer.add(i, (const uint8_t*)values[i], 1));
+    }
+    // The ring has wrapped, the two oldest are gone.
+    CHECK(buffer.count() == 3);
+    CHECK(buffer.bytes() == 3);
+    CHECK(check_sample(buffer, 0, 2, "3"));
+    CHECK(check_sample(buffer, 1, 3, "4"));
+    CHECK(check_sample(buffer, 2, 4, "5"));
+}
+
+void Test_M2MSampleBuffer::test_drop_newest()
+{
+    M2MSampleBuffer buffer(2, 0, 0, 0, M2MResourceInstance::DropNewest, true);
+    CHECK(buffer.send());
+    CHECK(buffer.add(1, (const uint8_t*)"1", 1));
+    CHECK(buffer.add(2, (const uint8_t*)"2", 1));
+    CHECK(!buffer.add(3, (const uint8_t*)"3", 1));
+    CHECK(buffer.count() == 2);
+    CHECK(check_sample(buffer, 0, 1, "1"));
+    CHECK(check_sample(buffer, 1, 2, "2"));
+}
+
+void Test_M2MSampleBuffer::test_flush_due()
+{
+    // Count threshold, by default the capacity.
+    M2MSampleBuffer full(2, 0, 0, 0, M2MResourceInstance::DropOldest, false);
+    CHECK(!full.flush_due());
+    full.add(1, (const uint8_t*)"1", 1);
+    CHECK(!full.flush_due());
+    full.add(2, (const uint8_t*)"2", 1);
+    CHECK(full.flush_due());
+
+    M2MSampleBuffer count(10, 3, 0, 0, M2MResourceInstance::DropOldest, false);
+    count.add(1, (const uint8_t*)"1", 1);
+    count.add(2, (const uint8_t*)"2", 1);
+    CHECK(!count.flush_due());
+    count.add(3, (const uint8_t*)"3", 1);
+    CHECK(count.flush_due());
+
+    // Byte threshold.
+    M2MSampleBuffer bytes(10, 0, 5000, 6, M2MResourceInstance::DropOldest, false);
+    CHECK(bytes.flush_age() == 5000);
+    bytes.add(1, (const uint8_t*)"1234", 4);
+    CHECK(!bytes.flush_due());
+    bytes.add(2, (const uint8_t*)"56", 2);
+    CHECK(bytes.flush_due());
+    bytes.clear();
+    CHECK(!bytes.flush_due());
+}
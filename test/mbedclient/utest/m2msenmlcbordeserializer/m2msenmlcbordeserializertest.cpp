@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2msenmlcbordeserializer.h"
+
+
+TEST_GROUP(M2MSenMLCBORDeserializer)
+{
+  Test_M2MSenMLCBORDeserializer* m2m_deserializer;
+
+  void setup()
+  {
+    m2m_deserializer = new Test_M2MSenMLCBORDeserializer();
+  }
+  void teardown()
+  {
+    delete m2m_deserializer;
+  }
+};
+
+TEST(M2MSenMLCBORDeserializer, Create)
+{
+    CHECK(m2m_deserializer != NULL);
+}
+
+TEST(M2MSenMLCBORDeserializer, test_deserialize_paths)
+{
+    m2m_deserializer->test_deserialize_paths();
+}
+
+TEST(M2MSenMLCBORDeserializer, test_skip_values)
+{
+    m2m_deserializer->test_skip_values();
+}
+
+TEST(M2MSenMLCBORDeserializer, test_invalid_pack)
+{
+    m2m_deserializer->test_invalid_pack();
+}
+
+TEST(M2MSenMLCBORDeserializer, test_read_values)
+{
+    m2m_deserializer->test_read_values();
+}
+
+TEST(M2MSenMLCBORDeserializer, test_deserialize_resources)
+{
+    m2m_deserializer->test_deserialize_resources();
+}
+
+TEST(M2MSenMLCBORDeserializer, test_deserialize_resource_instances)
+{
+    m2m_deserializer->test_deserialize_resource_instances();
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2msenmlcbordeserializer.h"
+#include "m2mobject_stub.h"
+#include "m2mobjectinstance_stub.h"
+#include "m2mresource_stub.h"
+#include "m2mresourceinstance_stub.h"
+#include "m2mbase_stub.h"
+
+Test_M2MSenMLCBORDeserializer::Test_M2MSenMLCBORDeserializer()
+{
+    deserializer = new M2MSenMLCBORDeserializer();
+}
+
+Test_M2MSenMLCBORDeserializer::~Test_M2MSenMLCBORDeserializer()
+{
+    delete deserializer;
+    m2mbase_stub::clear();
+    m2mresourceinstance_stub::clear();
+    m2mobjectinstance_stub::clear();
+    m2mobject_stub::clear();
+    m2mresource_stub::clear();
+}
+
+void Test_M2MSenMLCBORDeserializer::test_deserialize_paths()
+{
+    // [{-2: "/3/0/", 0: "9"}, {0: "10"}, {-2: "/1/0", 0: ""}, {0: "/5"}]
+    uint8_t pack[] = {0x84,
+                      0xA2, 0x21, 0x65, '/', '3', '/', '0', '/', 0x00, 0x61, '9',
+                      0xA1, 0x00, 0x62, '1', '0',
+                      0xA2, 0x21, 0x64, '/', '1', '/', '0', 0x00, 0x60,
+                      0xA1, 0x00, 0x62, '/', '5'};
+    M2MPathList paths;
+    CHECK(deserializer->deserialize_paths(pack, sizeof(pack), paths));
+    CHECK(paths.size() == 4);
+    CHECK(paths[0] == "3/0/9");
+    CHECK(paths[1] == "3/0/10");
+    CHECK(paths[2] == "1/0");
+    CHECK(paths[3] == "1/0/5");
+}
+
+void Test_M2MSenMLCBORDeserializer::test_skip_values()
+{
+    // [{0: "/3/0/9", 2: 1000, "x": [1.5, {1: h'AB'}], 4: true, 6: -1}]
+    uint8_t pack[] = {0x81, 0xA5,
+                      0x00, 0x66, '/', '3', '/', '0', '/', '9',
+                      0x02, 0x19, 0x03, 0xE8,
+                      0x61, 'x', 0x82, 0xFA, 0x3F, 0xC0, 0x00, 0x00,
+                      0xA1, 0x01, 0x41, 0xAB,
+                      0x04, 0xF5,
+                      0x06, 0x20};
+    M2MPathList paths;
+    CHECK(deserializer->deserialize_paths(pack, sizeof(pack), paths));
+    CHECK(paths.size() == 1);
+    CHECK(paths[0] == "3/0/9");
+}
+
+void Test_M2MSenMLCBORDeserializer::test_invalid_pack()
+{
+    M2MPathList paths;
+    uint8_t empty[] = {0x80};
+    CHECK(!deserializer->deserialize_paths(empty, sizeof(empty), paths));
+    CHECK(!deserializer->deserialize_paths(NULL, 0, paths));
+
+    // Not an array of maps
+    uint8_t no_map[] = {0x81, 0x61, '3'};
+    CHECK(!deserializer->deserialize_paths(no_map, sizeof(no_map), paths));
+
+    // Record without a name
+    uint8_t no_name[] = {0x81, 0xA1, 0x02, 0x01};
+    CHECK(!deserializer->deserialize_paths(no_name, sizeof(no_name), paths));
+
+    // Name is not text
+    uint8_t bad_name[] = {0x81, 0xA1, 0x00, 0x03};
+    CHECK(!deserializer->deserialize_paths(bad_name, sizeof(bad_name), paths));
+
+    // Truncated name
+    uint8_t truncated[] = {0x81, 0xA1, 0x00, 0x66, '/', '3'};
+    CHECK(!deserializer->deserialize_paths(truncated, sizeof(truncated), paths));
+
+    // Indefinite length array
+    uint8_t indefinite[] = {0x9F, 0xA1, 0x00, 0x61, '3', 0xFF};
+    CHECK(!deserializer->deserialize_paths(indefinite, sizeof(indefinite), paths));
+
+    // Map claiming more items than there are bytes
+    uint8_t huge_map[] = {0x81, 0xA1, 0x01, 0xBA, 0xFF, 0xFF, 0xFF, 0xFF};
+    CHECK(!deserializer->deserialize_paths(huge_map, sizeof(huge_map), paths));
+
+    // Trailing bytes
+    uint8_t trailing[] = {0x81, 0xA1, 0x00, 0x61, '3', 0x00};
+    CHECK(!deserializer->deserialize_paths(trailing, sizeof(trailing), paths));
+}
+
+void Test_M2MSenMLCBORDeserializer::test_read_values()
+{
+    // [{-2: "/3/0/1", 2: -21}, {2: 21.5}, {2: 0.1}, {2: 1.5}, {2: 1000},
+    //  {4: false}, {3: "on"}, {8: h'0102'}, {"vlo": "3:0"}, {3: ""}]
+    uint8_t pack[] = {0x8A,
+                      0xA2, 0x21, 0x66, '/', '3', '/', '0', '/', '1', 0x02, 0x34,
+                      0xA1, 0x02, 0xFA, 0x41, 0xAC, 0x00, 0x00,
+                      0xA1, 0x02, 0xFB, 0x3F, 0xB9, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A,
+                      0xA1, 0x02, 0xF9, 0x3E, 0x00,
+                      0xA1, 0x02, 0x19, 0x03, 0xE8,
+                      0xA1, 0x04, 0xF4,
+                      0xA1, 0x03, 0x62, 'o', 'n',
+                      0xA1, 0x08, 0x42, 0x01, 0x02,
+                      0xA1, 0x63, 'v', 'l', 'o', 0x63, '3', ':', '0',
+                      0xA1, 0x03, 0x60};
+    const char *values[] = {"-21", "21.5", "0.1", "1.5", "1000", "0", "on", "\x01\x02", "3:0", ""};
+
+    CHECK(deserializer->begin(pack, sizeof(pack)));
+    CHECK(deserializer->_count == 10);
+    for(uint8_t i = 0; i < 10; i++) {
+        String name;
+        CHECK(deserializer->read_record(name, true));
+        CHECK(name == "3/0/1");
+        CHECK(deserializer->_value != NULL);
+        CHECK(deserializer->_value_length == strlen(values[i]));
+        CHECK(memcmp(deserializer->_value, values[i], strlen(values[i])) == 0);
+    }
+    CHECK(deserializer->_position == sizeof(pack));
+
+    String name;
+    // Record without a value
+    uint8_t no_value[] = {0x81, 0xA1, 0x00, 0x61, '3'};
+    CHECK(deserializer->begin(no_value, sizeof(no_value)));
+    CHECK(!deserializer->read_record(name, true));
+
+    // Numeric value sent as text
+    uint8_t text_number[] = {0x81, 0xA2, 0x00, 0x61, '3', 0x02, 0x61, '1'};
+    CHECK(deserializer->begin(text_number, sizeof(text_number)));
+    CHECK(!deserializer->read_record(name, true));
+
+    // Half precision NaN
+    uint8_t nan[] = {0x81, 0xA2, 0x00, 0x61, '3', 0x02, 0xF9, 0x7E, 0x00};
+    CHECK(deserializer->begin(nan, sizeof(nan)));
+    CHECK(!deserializer->read_record(name, true));
+
+    // Boolean which is not true or false
+    uint8_t bad_boolean[] = {0x81, 0xA2, 0x00, 0x61, '3', 0x04, 0x01};
+    CHECK(deserializer->begin(bad_boolean, sizeof(bad_boolean)));
+    CHECK(!deserializer->read_record(name, true));
+}
+
+void Test_M2MSenMLCBORDeserializer::test_deserialize_resources()
+{
+    m2mbase_stub::string_value = new String("3");
+    m2mbase_stub::int_value = 0;
+    m2mbase_stub::name_id_value = 1;
+    m2mbase_stub::operation = M2MBase::GET_PUT_ALLOWED;
+
+    M2MObject *object = new M2MObject("3");
+    M2MObjectInstance *instance = new M2MObjectInstance("3", *object);
+    M2MResource *resource = new M2MResource(*instance,
+                                            "1",
+                                            "1",
+                                            M2MResourceInstance::INTEGER,
+                                            M2MResource::Dynamic,
+                                            false);
+    m2mobjectinstance_stub::resource_list.push_back(resource);
+
+    // [{-2: "/3/0/", 0: "1", 2: 5}]
+    uint8_t pack[] = {0x81, 0xA3, 0x21, 0x65, '/', '3', '/', '0', '/',
+                      0x00, 0x61, '1', 0x02, 0x05};
+    CHECK(M2MSenMLCBORDeserializer::None ==
+          deserializer->deserialize_resources(pack, sizeof(pack), *instance, M2MSenMLCBORDeserializer::Put));
+
+    m2mbase_stub::operation = M2MBase::GET_ALLOWED;
+    CHECK(M2MSenMLCBORDeserializer::NotAllowed ==
+          deserializer->deserialize_resources(pack, sizeof(pack), *instance, M2MSenMLCBORDeserializer::Put));
+    m2mbase_stub::operation = M2MBase::GET_PUT_ALLOWED;
+
+    // Record of another object
+    uint8_t other_object[] = {0x81, 0xA2, 0x00, 0x66, '/', '4', '/', '0', '/', '1', 0x02, 0x05};
+    CHECK(M2MSenMLCBORDeserializer::NotValid ==
+          deserializer->deserialize_resources(other_object, sizeof(other_object), *instance, M2MSenMLCBORDeserializer::Put));
+
+    // Missing resource, created only by Post
+    uint8_t missing[] = {0x81, 0xA2, 0x00, 0x66, '/', '3', '/', '0', '/', '2', 0x02, 0x05};
+    CHECK(M2MSenMLCBORDeserializer::NotFound ==
+          deserializer->deserialize_resources(missing, sizeof(missing), *instance, M2MSenMLCBORDeserializer::Put));
+    m2mobjectinstance_stub::create_resource = resource;
+    CHECK(M2MSenMLCBORDeserializer::None ==
+          deserializer->deserialize_resources(missing, sizeof(missing), *instance, M2MSenMLCBORDeserializer::Post));
+
+    // Resource instance of a resource without instances
+    uint8_t instance_path[] = {0x81, 0xA2, 0x00, 0x68, '/', '3', '/', '0', '/', '1', '/', '0', 0x02, 0x05};
+    CHECK(M2MSenMLCBORDeserializer::NotValid ==
+          deserializer->deserialize_resources(instance_path, sizeof(instance_path), *instance, M2MSenMLCBORDeserializer::Put));
+
+    m2mresource_stub::bool_value = true;
+    CHECK(M2MSenMLCBORDeserializer::NotValid ==
+          deserializer->deserialize_resources(pack, sizeof(pack), *instance, M2MSenMLCBORDeserializer::Put));
+    CHECK(M2MSenMLCBORDeserializer::NotFound ==
+          deserializer->deserialize_resources(instance_path, sizeof(instance_path), *instance, M2MSenMLCBORDeserializer::Put));
+
+    M2MResourceInstance *res_instance = new M2MResourceInstance("1",
+                                                                "1",
+                                                                M2MResourceInstance::INTEGER,
+                                                                *instance);
+    m2mobjectinstance_stub::create_resource_instance = res_instance;
+    CHECK(M2MSenMLCBORDeserializer::None ==
+          deserializer->deserialize_resources(instance_path, sizeof(instance_path), *instance, M2MSenMLCBORDeserializer::Post));
+
+    m2mresource_stub::instance = res_instance;
+    CHECK(M2MSenMLCBORDeserializer::None ==
+          deserializer->deserialize_resources(instance_path, sizeof(instance_path), *instance, M2MSenMLCBORDeserializer::Put));
+
+    delete res_instance;
+    delete resource;
+    delete instance;
+    delete object;
+    delete m2mbase_stub::string_value;
+}
+
+void Test_M2MSenMLCBORDeserializer::test_deserialize_resource_instances()
+{
+    m2mbase_stub::string_value = new String("3");
+    m2mresourceinstance_stub::string_value = new String("3");
+    m2mresourceinstance_stub::int_value = 0;
+    m2mbase_stub::operation = M2MBase::GET_PUT_ALLOWED;
+
+    M2MObject *object = new M2MObject("3");
+    M2MObjectInstance *instance = new M2MObjectInstance("3", *object);
+    M2MResource *resource = new M2MResource(*instance,
+                                            "3",
+                                            "3",
+                                            M2MResourceInstance::INTEGER,
+                                            M2MResource::Dynamic,
+                                            true);
+    M2MResourceInstance *res_instance = new M2MResourceInstance("3",
+                                                                "3",
+                                                                M2MResourceInstance::INTEGER,
+                                                                *instance);
+
+    // [{0: "/3/0/3/1", 3: "a"}]
+    uint8_t pack[] = {0x81, 0xA2, 0x00, 0x68, '/', '3', '/', '0', '/', '3', '/', '1',
+                      0x03, 0x61, 'a'};
+    CHECK(M2MSenMLCBORDeserializer::NotFound ==
+          deserializer->deserialize_resource_instances(pack, sizeof(pack), *resource, M2MSenMLCBORDeserializer::Put));
+    CHECK(M2MSenMLCBORDeserializer::NotAllowed ==
+          deserializer->deserialize_resource_instances(pack, sizeof(pack), *resource, M2MSenMLCBORDeserializer::Post));
+
+    m2mresource_stub::instance = res_instance;
+    CHECK(M2MSenMLCBORDeserializer::None ==
+          deserializer->deserialize_resource_instances(pack, sizeof(pack), *resource, M2MSenMLCBORDeserializer::Put));
+
+    m2mbase_stub::operation = M2MBase::GET_ALLOWED;
+    CHECK(M2MSenMLCBORDeserializer::NotAllowed ==
+          deserializer->deserialize_resource_instances(pack, sizeof(pack), *resource, M2MSenMLCBORDeserializer::Put));
+
+    // The resource itself instead of one of its instances
+    uint8_t resource_path[] = {0x81, 0xA2, 0x00, 0x66, '/', '3', '/', '0', '/', '3', 0x03, 0x61, 'a'};
+    CHECK(M2MSenMLCBORDeserializer::NotValid ==
+          deserializer->deserialize_resource_instances(resource_path, sizeof(resource_path), *resource, M2MSenMLCBORDeserializer::Put));
+
+    delete res_instance;
+    delete resource;
+    delete instance;
+    delete object;
+    delete m2mbase_stub::string_value;
+    delete m2mresourceinstance_stub::string_value;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_M2M_SENML_CBOR_DESERIALIZER_H
+#define TEST_M2M_SENML_CBOR_DESERIALIZER_H
+
+#include "m2msenmlcbordeserializer.h"
+
+class Test_M2MSenMLCBORDeserializer
+{
+public:
+    Test_M2MSenMLCBORDeserializer();
+
+    virtual ~Test_M2MSenMLCBORDeserializer();
+
+    void test_deserialize_paths();
+
+    void test_skip_values();
+
+    void test_invalid_pack();
+
+    void test_read_values();
+
+    void test_deserialize_resources();
+
+    void test_deserialize_resource_instances();
+
+    M2MSenMLCBORDeserializer *deserializer;
+};
+
+#endif // TEST_M2M_SENML_CBOR_DESERIALIZER_H
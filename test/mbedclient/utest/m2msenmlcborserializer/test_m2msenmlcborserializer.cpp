@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2msenmlcborserializer.h"
+#include "m2mobject_stub.h"
+#include "m2mobjectinstance_stub.h"
+#include "m2mresource_stub.h"
+#include "m2mresourceinstance_stub.h"
+#include "m2mbase_stub.h"
+#include "m2msamplebuffer.h"
+
+// Offset of the value label in a pack with one record named "/1/0/" + "1".
+#define VALUE_OFFSET 12
+
+static void set_value(M2MResourceInstance::ResourceType type, const char *value)
+{
+    m2mresourceinstance_stub::resource_type = type;
+    m2mresourceinstance_stub::value = (uint8_t*)value;
+    m2mresourceinstance_stub::int_value = strlen(value);
+}
+
+static bool check_value(M2MSenMLCBORSerializer *serializer, M2MResource *resource,
+                        const uint8_t *expected, uint32_t expected_size)
+{
+    uint32_t size = 0;
+    serializer->append(*m2mbase_stub::string_value, 0, resource);
+    uint8_t *data = serializer->serialize(size);
+    bool match = data != NULL &&
+                 size == VALUE_OFFSET + expected_size &&
+                 memcmp(data + VALUE_OFFSET, expected, expected_size) == 0;
+    free(data);
+    return match;
+}
+
+Test_M2MSenMLCBORSerializer::Test_M2MSenMLCBORSerializer()
+{
+    serializer = new M2MSenMLCBORSerializer();
+    name = new String("1");
+    m2mbase_stub::string_value = name;
+    object = new M2MObject(*name);
+    instance = new M2MObjectInstance(*name, *object);
+    resource = new M2MResource(*instance,
+                               *name,
+                               *name,
+                               M2MResourceInstance::INTEGER,
+                               M2MResource::Dynamic,
+                               false);
+    set_value(M2MResourceInstance::INTEGER, "42");
+}
+
+Test_M2MSenMLCBORSerializer::~Test_M2MSenMLCBORSerializer()
+{
+    delete serializer;
+    delete resource;
+    delete instance;
+    delete object;
+    delete name;
+
+    m2mbase_stub::clear();
+    m2mresourceinstance_stub::clear();
+    m2mresource_stub::clear();
+    m2mobjectinstance_stub::clear();
+    m2mobject_stub::clear();
+}
+
+void Test_M2MSenMLCBORSerializer::test_serialize_resource()
+{
+    uint32_t size = 0;
+    CHECK(serializer->serialize(size) == NULL);
+    CHECK(size == 0);
+
+    CHECK(serializer->append(*name, 0, (M2MResource*)NULL) == false);
+
+    CHECK(serializer->append(*name, 0, resource) == true);
+    CHECK(serializer->record_count() == 1);
+
+    // [{-2: "/1/0/", 0: "1", 2: 42}]
+    const uint8_t expected[] = {0x81, 0xA3,
+                                0x21, 0x65, '/', '1', '/', '0', '/',
+                                0x00, 0x61, '1',
+                                0x02, 0x18, 0x2A};
+    uint8_t *data = serializer->serialize(size);
+    CHECK(data != NULL);
+    CHECK(size == sizeof(expected));
+    CHECK(memcmp(data, expected, sizeof(expected)) == 0);
+    free(data);
+
+    // The serializer is empty again.
+    CHECK(serializer->record_count() == 0);
+    CHECK(serializer->serialize(size) == NULL);
+}
+
+void Test_M2MSenMLCBORSerializer::test_base_name()
+{
+    uint32_t size = 0;
+    serializer->append(*name, 0, resource);
+    serializer->append(*name, 0, resource);
+    serializer->append(*name, 1, resource);
+
+    // The base name is only repeated when the object instance changes.
+    const uint8_t expected[] = {0x83,
+                                0xA3, 0x21, 0x65, '/', '1', '/', '0', '/',
+                                0x00, 0x61, '1', 0x02, 0x18, 0x2A,
+                                0xA2, 0x00, 0x61, '1', 0x02, 0x18, 0x2A,
+                                0xA3, 0x21, 0x65, '/', '1', '/', '1', '/',
+                                0x00, 0x61, '1', 0x02, 0x18, 0x2A};
+    uint8_t *data = serializer->serialize(size);
+    CHECK(size == sizeof(expected));
+    CHECK(memcmp(data, expected, sizeof(expected)) == 0);
+    free(data);
+
+    // Enough records for a two byte array header.
+    for(int i = 0; i < 300; i++) {
+        serializer->append(*name, 0, resource);
+    }
+    data = serializer->serialize(size);
+    CHECK(data[0] == 0x99);
+    CHECK(data[1] == 0x01);
+    CHECK(data[2] == 0x2C);
+    CHECK(data[3] == 0xA3);
+    free(data);
+}
+
+void Test_M2MSenMLCBORSerializer::test_value_types()
+{
+    const uint8_t negative[] = {0x02, 0x24};
+    set_value(M2MResourceInstance::INTEGER, "-5");
+    CHECK(check_value(serializer, resource, negative, sizeof(negative)));
+
+    const uint8_t integer[] = {0x02, 0x1A, 0x00, 0x01, 0x11, 0x70};
+    set_value(M2MResourceInstance::INTEGER, "70000");
+    CHECK(check_value(serializer, resource, integer, sizeof(integer)));
+
+    const uint8_t time[] = {0x02, 0x07};
+    set_value(M2MResourceInstance::TIME, "7");
+    CHECK(check_value(serializer, resource, time, sizeof(time)));
+
+    // Not a number, sent as a string.
+    const uint8_t not_integer[] = {0x03, 0x62, '4', 'x'};
+    set_value(M2MResourceInstance::INTEGER, "4x");
+    CHECK(check_value(serializer, resource, not_integer, sizeof(not_integer)));
+
+    const uint8_t single[] = {0x02, 0xFA, 0x3F, 0xC0, 0x00, 0x00};
+    set_value(M2MResourceInstance::FLOAT, "1.5");
+    CHECK(check_value(serializer, resource, single, sizeof(single)));
+
+    const uint8_t real[] = {0x02, 0xFB, 0x3F, 0xB9, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A};
+    set_value(M2MResourceInstance::FLOAT, "0.1");
+    CHECK(check_value(serializer, resource, real, sizeof(real)));
+
+    const uint8_t true_value[] = {0x04, 0xF5};
+    set_value(M2MResourceInstance::BOOLEAN, "1");
+    CHECK(check_value(serializer, resource, true_value, sizeof(true_value)));
+
+    const uint8_t false_value[] = {0x04, 0xF4};
+    set_value(M2MResourceInstance::BOOLEAN, "0");
+    CHECK(check_value(serializer, resource, false_value, sizeof(false_value)));
+
+    const uint8_t string[] = {0x03, 0x62, 'a', 'b'};
+    set_value(M2MResourceInstance::STRING, "ab");
+    CHECK(check_value(serializer, resource, string, sizeof(string)));
+
+    const uint8_t opaque[] = {0x08, 0x42, 0x01, 0x02};
+    set_value(M2MResourceInstance::OPAQUE, "\x01\x02");
+    CHECK(check_value(serializer, resource, opaque, sizeof(opaque)));
+
+    const uint8_t link[] = {0x63, 'v', 'l', 'o', 0x63, '3', ':', '0'};
+    set_value(M2MResourceInstance::OBJLINK, "3:0");
+    CHECK(check_value(serializer, resource, link, sizeof(link)));
+}
+
+void Test_M2MSenMLCBORSerializer::test_serialize_multiple_resource()
+{
+    M2MResourceInstance* res_instance = new M2MResourceInstance(*name,
+                                                                *name,
+                                                                M2MResourceInstance::INTEGER,
+                                                                *instance);
+    m2mresource_stub::bool_value = true;
+    m2mresource_stub::list.push_back(res_instance);
+    m2mresource_stub::list.push_back(res_instance);
+
+    CHECK(serializer->append(*name, 0, resource) == true);
+    CHECK(serializer->record_count() == 2);
+
+    const uint8_t expected[] = {0x82,
+                                0xA3, 0x21, 0x65, '/', '1', '/', '0', '/',
+                                0x00, 0x63, '1', '/', '0', 0x02, 0x18, 0x2A,
+                                0xA2, 0x00, 0x63, '1', '/', '0', 0x02, 0x18, 0x2A};
+    uint32_t size = 0;
+    uint8_t *data = serializer->serialize(size);
+    CHECK(size == sizeof(expected));
+    CHECK(memcmp(data, expected, sizeof(expected)) == 0);
+    free(data);
+
+    CHECK(serializer->append(*name, 0, res_instance) == true);
+    CHECK(serializer->record_count() == 1);
+    data = serializer->serialize(size);
+    CHECK(data != NULL);
+    free(data);
+
+    delete res_instance;
+}
+
+void Test_M2MSenMLCBORSerializer::test_serialize_object()
+{
+    CHECK(serializer->append((M2MObject*)NULL) == false);
+
+    // No instances, nothing to send.
+    CHECK(serializer->append(object) == true);
+    uint32_t size = 0;
+    CHECK(serializer->serialize(size) == NULL);
+
+    m2mbase_stub::int_value = 3;
+    m2mobject_stub::instance_list.push_back(instance);
+    m2mobjectinstance_stub::resource_list.push_back(resource);
+    m2mobjectinstance_stub::resource_list.push_back(resource);
+
+    CHECK(serializer->append(object) == true);
+    CHECK(serializer->record_count() == 2);
+
+    uint8_t *data = serializer->serialize(size);
+    CHECK(data != NULL);
+    CHECK(data[0] == 0x82);
+    CHECK(memcmp(data + 3, "\x65/1/3/", 6) == 0);
+    free(data);
+}
+
+void Test_M2MSenMLCBORSerializer::test_serialize_samples()
+{
+    uint32_t size = 0;
+    m2mresourceinstance_stub::base_type = M2MBase::Resource;
+    M2MSampleBuffer samples(4, 0, 0, 0, M2MResourceInstance::DropOldest, false);
+    samples.add(1000000, (const uint8_t*)"21", 2);
+    samples.add(3000000, (const uint8_t*)"22", 2);
+
+    CHECK(serializer->append(*name, 0, resource, samples, 3500000) == true);
+    CHECK(serializer->record_count() == 2);
+
+    // [{-2: "/1/0/", 0: "1", 6: -2.5, 2: 21}, {0: "1", 6: -0.5, 2: 22}]
+    const uint8_t expected[] = {0x82,
+                                0xA4, 0x21, 0x65, '/', '1', '/', '0', '/',
+                                0x00, 0x61, '1', 0x06, 0xFA, 0xC0, 0x20, 0x00, 0x00,
+                                0x02, 0x15,
+                                0xA3, 0x00, 0x61, '1', 0x06, 0xFA, 0xBF, 0x00, 0x00, 0x00,
+                                0x02, 0x16};
+    uint8_t *data = serializer->serialize(size);
+    CHECK(data != NULL);
+    CHECK(size == sizeof(expected));
+    CHECK(memcmp(data, expected, sizeof(expected)) == 0);
+    free(data);
+
+    // Without a clock the times are left out.
+    CHECK(serializer->append(*name, 0, resource, samples, 0) == true);
+    const uint8_t untimed[] = {0x82,
+                               0xA3, 0x21, 0x65, '/', '1', '/', '0', '/',
+                               0x00, 0x61, '1', 0x02, 0x15,
+                               0xA2, 0x00, 0x61, '1', 0x02, 0x16};
+    data = serializer->serialize(size);
+    CHECK(data != NULL);
+    CHECK(size == sizeof(untimed));
+    CHECK(memcmp(data, untimed, sizeof(untimed)) == 0);
+    free(data);
+}
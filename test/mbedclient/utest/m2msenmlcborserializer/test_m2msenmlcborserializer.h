@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_M2M_SENML_CBOR_SERIALIZER_H
+#define TEST_M2M_SENML_CBOR_SERIALIZER_H
+
+#include "m2msenmlcborserializer.h"
+
+class Test_M2MSenMLCBORSerializer
+{
+public:
+    Test_M2MSenMLCBORSerializer();
+
+    virtual ~Test_M2MSenMLCBORSerializer();
+
+    void test_serialize_resource();
+
+    void test_base_name();
+
+    void test_value_types();
+
+    void test_serialize_multiple_resource();
+
+    void test_serialize_object();
+
+    void test_serialize_samples();
+
+    M2MSenMLCBORSerializer *serializer;
+    String *name;
+    M2MObject *object;
+    M2MObjectInstance *instance;
+    M2MResource *resource;
+};
+
+#endif // TEST_M2M_SENML_CBOR_SERIALIZER_H
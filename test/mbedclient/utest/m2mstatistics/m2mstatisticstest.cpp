@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mstatistics.h"
+
+
+TEST_GROUP(M2MStatistics)
+{
+  Test_M2MStatistics* m2m_statistics;
+
+  void setup()
+  {
+    m2m_statistics = new Test_M2MStatistics();
+  }
+  void teardown()
+  {
+    delete m2m_statistics;
+  }
+};
+
+TEST(M2MStatistics, Create)
+{
+    CHECK(m2m_statistics != NULL);
+}
+
+TEST(M2MStatistics, test_increment)
+{
+    m2m_statistics->test_increment();
+}
+
+TEST(M2MStatistics, test_message_sent)
+{
+    m2m_statistics->test_message_sent();
+}
+
+TEST(M2MStatistics, test_message_received)
+{
+    m2m_statistics->test_message_received();
+}
+
+TEST(M2MStatistics, test_registration_update_latency)
+{
+    m2m_statistics->test_registration_update_latency();
+}
+
+TEST(M2MStatistics, test_reset)
+{
+    m2m_statistics->test_reset();
+}
+
+TEST(M2MStatistics, test_create_object)
+{
+    m2m_statistics->test_create_object();
+}
+
+TEST(M2MStatistics, test_memory_report)
+{
+    m2m_statistics->test_memory_report();
+}
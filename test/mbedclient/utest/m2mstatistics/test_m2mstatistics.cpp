@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_m2mstatistics.h"
+#include "m2mobject.h"
+#include "m2mobject_stub.h"
+#include "m2mobjectinstance_stub.h"
+#include "m2mbase_stub.h"
+#include "m2minterfacefactory.h"
+
+class Callback : public M2MObjectCallback {
+public:
+    Callback(){}
+    ~Callback(){}
+    void notification_update(uint16_t, int32_t) {}
+};
+
+static uint64_t test_time = 0;
+
+static uint64_t test_clock()
+{
+    return test_time;
+}
+
+Test_M2MStatistics::Test_M2MStatistics()
+{
+    M2MStatistics::set_clock(NULL);
+    M2MStatistics::set(M2MStatistics::HeapBytes, 0);
+    M2MStatistics::reset();
+}
+
+Test_M2MStatistics::~Test_M2MStatistics()
+{
+    M2MStatistics::set_clock(NULL);
+}
+
+void Test_M2MStatistics::test_increment()
+{
+    M2MStatistics::increment(M2MStatistics::NotificationsSent);
+    M2MStatistics::increment(M2MStatistics::NotificationsSent, 2);
+    CHECK(M2MStatistics::value(M2MStatistics::NotificationsSent) == 3);
+
+    M2MStatistics::set(M2MStatistics::HeapBytes, 100);
+    CHECK(M2MStatistics::value(M2MStatistics::HeapBytes) == 100);
+
+    M2MStatistics::increment(M2MStatistics::StatisticCount);
+    CHECK(M2MStatistics::value(M2MStatistics::StatisticCount) == 0);
+}
+
+void Test_M2MStatistics::test_message_sent()
+{
+    // Confirmable, message ID 0x1234.
+    uint8_t con[] = { 0x40, 0x01, 0x12, 0x34, 0xFF, 0x31 };
+    // Acknowledgement, message ID 0x1234.
+    uint8_t ack[] = { 0x60, 0x45, 0x12, 0x34 };
+
+    M2MStatistics::message_sent(con, sizeof(con));
+    CHECK(M2MStatistics::value(M2MStatistics::MessagesSent) == 1);
+    CHECK(M2MStatistics::value(M2MStatistics::BytesSent) == sizeof(con));
+    CHECK(M2MStatistics::value(M2MStatistics::MaxMessageSize) == sizeof(con));
+    CHECK(M2MStatistics::value(M2MStatistics::Retransmissions) == 0);
+
+    M2MStatistics::message_sent(con, sizeof(con));
+    CHECK(M2MStatistics::value(M2MStatistics::Retransmissions) == 1);
+
+    // Only confirmable messages are retransmitted.
+    M2MStatistics::message_sent(ack, sizeof(ack));
+    M2MStatistics::message_sent(ack, sizeof(ack));
+    CHECK(M2MStatistics::value(M2MStatistics::Retransmissions) == 1);
+    CHECK(M2MStatistics::value(M2MStatistics::MessagesSent) == 4);
+
+    // Old message IDs are forgotten.
+    for(uint8_t i = 0; i < 8; i++) {
+        con[3] = i;
+        M2MStatistics::message_sent(con, sizeof(con));
+    }
+    con[3] = 0x34;
+    M2MStatistics::message_sent(con, sizeof(con));
+    CHECK(M2MStatistics::value(M2MStatistics::Retransmissions) == 1);
+
+    M2MStatistics::message_sent(NULL, 0);
+    CHECK(M2MStatistics::value(M2MStatistics::MessagesSent) == 14);
+}
+
+void Test_M2MStatistics::test_message_received()
+{
+    M2MStatistics::message_received(10);
+    M2MStatistics::message_received(30);
+    CHECK(M2MStatistics::value(M2MStatistics::MessagesReceived) == 2);
+    CHECK(M2MStatistics::value(M2MStatistics::BytesReceived) == 40);
+    CHECK(M2MStatistics::value(M2MStatistics::MaxMessageSize) == 30);
+
+    uint8_t con[] = { 0x40, 0x01, 0x00, 0x01, 0xFF };
+    M2MStatistics::message_sent(con, sizeof(con));
+    CHECK(M2MStatistics::average_message_size() == 15);
+}
+
+void Test_M2MStatistics::test_registration_update_latency()
+{
+    // Without a clock only the updates are counted.
+    M2MStatistics::registration_update_sent();
+    M2MStatistics::registration_update_completed();
+    CHECK(M2MStatistics::value(M2MStatistics::RegistrationUpdates) == 1);
+    CHECK(M2MStatistics::value(M2MStatistics::RegistrationUpdateLatency) == 0);
+    CHECK(M2MStatistics::now() == 0);
+
+    M2MStatistics::set_clock(test_clock);
+    test_time = 1000000;
+    M2MStatistics::registration_update_sent();
+    test_time = 1250000;
+    M2MStatistics::registration_update_completed();
+    CHECK(M2MStatistics::value(M2MStatistics::RegistrationUpdates) == 2);
+    CHECK(M2MStatistics::value(M2MStatistics::RegistrationUpdateLatency) == 250);
+    CHECK(M2MStatistics::value(M2MStatistics::MaxRegistrationUpdateLatency) == 250);
+
+    test_time = 2000000;
+    M2MStatistics::registration_update_sent();
+    test_time = 2100000;
+    M2MStatistics::registration_update_completed();
+    CHECK(M2MStatistics::value(M2MStatistics::RegistrationUpdateLatency) == 100);
+    CHECK(M2MStatistics::value(M2MStatistics::MaxRegistrationUpdateLatency) == 250);
+
+    // A response without a pending update is not measured.
+    test_time = 5000000;
+    M2MStatistics::registration_update_completed();
+    CHECK(M2MStatistics::value(M2MStatistics::RegistrationUpdateLatency) == 100);
+}
+
+void Test_M2MStatistics::test_reset()
+{
+    M2MStatistics::increment(M2MStatistics::NotificationsDropped);
+    M2MStatistics::message_received(10);
+    M2MStatistics::set(M2MStatistics::HeapBytes, 512);
+
+    M2MStatistics::reset();
+    CHECK(M2MStatistics::value(M2MStatistics::NotificationsDropped) == 0);
+    CHECK(M2MStatistics::value(M2MStatistics::MessagesReceived) == 0);
+    CHECK(M2MStatistics::average_message_size() == 0);
+    CHECK(M2MStatistics::value(M2MStatistics::HeapBytes) == 512);
+}
+
+void Test_M2MStatistics::test_create_object()
+{
+    Callback callback;
+    m2mobject_stub::inst = NULL;
+    CHECK(M2MStatistics::create_object() == NULL);
+
+    m2mobject_stub::inst = new M2MObjectInstance("7", callback);
+    m2mobjectinstance_stub::create_resource = NULL;
+    CHECK(M2MStatistics::create_object() == NULL);
+
+    m2mobjectinstance_stub::create_resource = new M2MResource(*m2mobject_stub::inst,
+                                                              "2", "type",
+                                                              M2MResourceInstance::INTEGER,
+                                                              M2MBase::Dynamic);
+    M2MObject *object = M2MStatistics::create_object();
+    CHECK(object != NULL);
+    delete object;
+
+    delete m2mobjectinstance_stub::create_resource;
+    m2mobjectinstance_stub::create_resource = NULL;
+    delete m2mobject_stub::inst;
+    m2mobject_stub::inst = NULL;
+}
+
+void Test_M2MStatistics::test_memory_report()
+{
+    M2MStatistics::ObjectMemory report[2];
+    m2m::Vector<M2MObject*> objects;
+    CHECK(M2MStatistics::memory_report(objects, report, 2) == 0);
+
+    objects.push_back(M2MInterfaceFactory::create_object("3"));
+    objects.push_back(M2MInterfaceFactory::create_object("3"));
+    m2mbase_stub::name_id_value = 3;
+    m2mobject_stub::int_value = 2;
+    CHECK(M2MStatistics::memory_report(objects, report, 2) == 1);
+    CHECK(report[0].object_id == 3);
+    CHECK(report[0].objects == 2);
+    CHECK(report[0].instances == 4);
+    CHECK(report[0].bytes == 4);
+
+    // IDs that don't fit are left out.
+    CHECK(M2MStatistics::memory_report(objects, report, 0) == 0);
+    CHECK(M2MStatistics::memory_report(objects, NULL, 2) == 0);
+
+    m2mbase_stub::clear();
+    m2mobject_stub::clear();
+    m2m::Vector<M2MObject*>::const_iterator it = objects.begin();
+    for(; it != objects.end(); it++) {
+        delete *it;
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_M2M_STATISTICS_H
+#define TEST_M2M_STATISTICS_H
+
+#include "m2mstatistics.h"
+
+class Test_M2MStatistics
+{
+public:
+    Test_M2MStatistics();
+
+    virtual ~Test_M2MStatistics();
+
+    void test_increment();
+
+    void test_message_sent();
+
+    void test_message_received();
+
+    void test_registration_update_latency();
+
+    void test_reset();
+
+    void test_create_object();
+
+    void test_memory_report();
+};
+
+#endif // TEST_M2M_STATISTICS_H
@@ -156,7 +156,17 @@ TEST(M2MString, test_itoa_c)
     m2m_string->test_itoa_c();
 }
 
+TEST(M2MString, test_dtoa_c)
+{
+    m2m_string->test_dtoa_c();
+}
+
 TEST(M2MString, test_convert_integer_to_array)
 {
     m2m_string->test_convert_integer_to_array();
 }
+
+TEST(M2MString, test_id_from_string)
+{
+    m2m_string->test_id_from_string();
+}
@@ -295,6 +295,23 @@ void Test_M2MString::test_itoa_c()
     }
 }
 
+void Test_M2MString::test_dtoa_c()
+{
+    char buffer[32];
+
+    CHECK(m2m::dtoa_c(21.5, true, buffer, sizeof(buffer)) == 4);
+    CHECK(strcmp("21.5", buffer) == 0);
+    CHECK(m2m::dtoa_c(0.1f, true, buffer, sizeof(buffer)) == 3);
+    CHECK(strcmp("0.1", buffer) == 0);
+    CHECK(m2m::dtoa_c(0.1, false, buffer, sizeof(buffer)) == 3);
+    CHECK(strcmp("0.1", buffer) == 0);
+    CHECK(m2m::dtoa_c(-3, false, buffer, sizeof(buffer)) == 2);
+    CHECK(strcmp("-3", buffer) == 0);
+
+    // Does not fit
+    CHECK(m2m::dtoa_c(0.1, false, buffer, 3) == 0);
+}
+
 void Test_M2MString::test_convert_integer_to_array()
 {
     uint8_t *max_age_ptr = NULL;
@@ -377,5 +394,14 @@ void Test_M2MString::test_convert_integer_to_array()
 
 }
 
-
-
+void Test_M2MString::test_id_from_string()
+{
+    CHECK(m2m::id_from_string("0") == 0);
+    CHECK(m2m::id_from_string("3303") == 3303);
+    CHECK(m2m::id_from_string("65535") == 65535);
+    CHECK(m2m::id_from_string("65536") == -1);
+    CHECK(m2m::id_from_string("") == -1);
+    CHECK(m2m::id_from_string("12a") == -1);
+    CHECK(m2m::id_from_string("name") == -1);
+    CHECK(m2m::id_from_string(NULL) == -1);
+}
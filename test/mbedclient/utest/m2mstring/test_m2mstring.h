@@ -50,7 +50,10 @@ public:
     void test_operator_lt();
     void test_reverse();
     void test_itoa_c();
+
+    void test_dtoa_c();
     void test_convert_integer_to_array();
+    void test_id_from_string();
 
     String* str;
 };
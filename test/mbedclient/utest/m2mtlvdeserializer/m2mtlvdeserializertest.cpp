@@ -71,6 +71,16 @@ TEST(M2MTLVSerializer, serialize_resource_instance)
     m2m_serializer->test_serialize_resource_instance();
 }
 
+TEST(M2MTLVSerializer, serialize_filtered_resources)
+{
+    m2m_serializer->test_serialize_filtered_resources();
+}
+
+TEST(M2MTLVSerializer, serialize_numeric_values)
+{
+    m2m_serializer->test_serialize_numeric_values();
+}
+
 TEST(M2MTLVDeserializer, Create)
 {
     CHECK(m2m_deserializer != NULL);
@@ -121,3 +131,7 @@ TEST(M2MTLVDeserializer, test_instance_id)
     m2m_deserializer->test_instance_id();
 }
 
+TEST(M2MTLVDeserializer, test_set_numeric_value)
+{
+    m2m_deserializer->test_set_numeric_value();
+}
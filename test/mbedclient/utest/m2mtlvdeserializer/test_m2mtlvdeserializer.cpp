@@ -332,6 +332,19 @@ void Test_M2MTLVDeserializer::test_deserialize_resources()
 
     CHECK( M2MTLVDeserializer::NotFound == deserializer->deserialize_resources(data_resource,sizeof(data_resource),*instance,M2MTLVDeserializer::Put));
 
+    // A binary integer can't be 3 bytes long
+    m2mobjectinstance_stub::resource = resource;
+    m2mresourceinstance_stub::resource_type = M2MResourceInstance::INTEGER;
+    m2mresourceinstance_stub::set_value = "";
+    CHECK( M2MTLVDeserializer::NotValid == deserializer->deserialize_resources(data_resource,sizeof(data_resource),*instance,M2MTLVDeserializer::Put));
+    CHECK(m2mresourceinstance_stub::set_value == "");
+
+    uint8_t integer_resource[] = {0xC2,0x0,0x01,0x2C};
+    CHECK( M2MTLVDeserializer::None == deserializer->deserialize_resources(integer_resource,sizeof(integer_resource),*instance,M2MTLVDeserializer::Put));
+    CHECK(m2mresourceinstance_stub::set_value == "300");
+    m2mobjectinstance_stub::resource = NULL;
+    m2mresourceinstance_stub::resource_type = M2MResourceInstance::STRING;
+
     m2mbase_stub::operation = M2MBase::NOT_ALLOWED;
 
     deserializer->deserialize_resources(data_resource,sizeof(data_resource),*instance,M2MTLVDeserializer::Post);
@@ -640,3 +653,71 @@ void Test_M2MTLVDeserializer::test_instance_id()
     CHECK(deserializer->instance_id(data_resource) == 1);
     CHECK(deserializer->instance_id(data_object) == 2);
 }
+
+void Test_M2MTLVDeserializer::test_set_numeric_value()
+{
+    String *name = new String("1");
+    M2MObject *object = new M2MObject(*name);
+    M2MObjectInstance* instance = new M2MObjectInstance(*name,*object);
+    M2MResourceInstance* res_instance = new M2MResourceInstance(*name,
+                                                                *name,
+                                                                M2MResourceInstance::INTEGER,
+                                                                *instance);
+
+    m2mresourceinstance_stub::resource_type = M2MResourceInstance::INTEGER;
+    uint8_t negative[] = {0xFE, 0xD4};
+    CHECK(deserializer->set_value(*res_instance, negative, sizeof(negative)) == true);
+    CHECK(m2mresourceinstance_stub::set_value == "-300");
+
+    uint8_t large[] = {0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+    CHECK(deserializer->set_value(*res_instance, large, sizeof(large)) == true);
+    CHECK(m2mresourceinstance_stub::set_value == "4294967296");
+
+    // Text numbers are read as binary, whatever their length
+    uint8_t text2[] = {'1', '2'};
+    CHECK(deserializer->set_value(*res_instance, text2, sizeof(text2)) == true);
+    CHECK(m2mresourceinstance_stub::set_value == "12594");
+
+    uint8_t text4[] = {'1', '2', '3', '4'};
+    CHECK(deserializer->set_value(*res_instance, text4, sizeof(text4)) == true);
+    CHECK(m2mresourceinstance_stub::set_value == "825373492");
+
+    uint8_t text8[] = {'1', '2', '3', '4', '5', '6', '7', '8'};
+    CHECK(deserializer->set_value(*res_instance, text8, sizeof(text8)) == true);
+    CHECK(m2mresourceinstance_stub::set_value == "3544952156018063160");
+
+    // Lengths which are no integer size are rejected
+    m2mresourceinstance_stub::set_value = "";
+    uint8_t text3[] = {'1', '2', '3'};
+    CHECK(deserializer->set_value(*res_instance, text3, sizeof(text3)) == false);
+    CHECK(m2mresourceinstance_stub::set_value == "");
+
+    m2mresourceinstance_stub::resource_type = M2MResourceInstance::FLOAT;
+    uint8_t single[] = {0x41, 0xAC, 0x00, 0x00};
+    CHECK(deserializer->set_value(*res_instance, single, sizeof(single)) == true);
+    CHECK(m2mresourceinstance_stub::set_value == "21.5");
+
+    uint8_t real[] = {0x3F, 0xB9, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A};
+    CHECK(deserializer->set_value(*res_instance, real, sizeof(real)) == true);
+    CHECK(m2mresourceinstance_stub::set_value == "0.1");
+
+    // Text floats are read as IEEE 754, other lengths are rejected
+    uint8_t float4[] = {'1', '.', '2', '5'};
+    CHECK(deserializer->set_value(*res_instance, float4, sizeof(float4)) == true);
+    CHECK(!(m2mresourceinstance_stub::set_value == "1.25"));
+
+    m2mresourceinstance_stub::set_value = "";
+    uint8_t float2[] = {'1', '2'};
+    CHECK(deserializer->set_value(*res_instance, float2, sizeof(float2)) == false);
+    CHECK(m2mresourceinstance_stub::set_value == "");
+
+    m2mresourceinstance_stub::resource_type = M2MResourceInstance::STRING;
+    uint8_t string[] = {0x41, 0x42, 0x43};
+    CHECK(deserializer->set_value(*res_instance, string, sizeof(string)) == true);
+    CHECK(m2mresourceinstance_stub::set_value == "ABC");
+
+    delete res_instance;
+    delete instance;
+    delete object;
+    delete name;
+}
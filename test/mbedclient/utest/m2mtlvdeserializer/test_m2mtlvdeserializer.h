@@ -43,6 +43,8 @@ public:
 
     void test_instance_id();
 
+    void test_set_numeric_value();
+
     M2MTLVDeserializer *deserializer;
 };
 
@@ -303,3 +303,130 @@ void Test_M2MTLVSerializer::test_serialize_resource_instance()
     m2mobjectinstance_stub::clear();
     m2mobject_stub::clear();
 }
+
+void Test_M2MTLVSerializer::test_serialize_filtered_resources()
+{
+    String *name = new String("1");
+    M2MObject *object = new M2MObject(*name);
+    M2MObjectInstance* instance = new M2MObjectInstance(*name,*object);
+
+    uint32_t size = 0;
+    uint8_t *data = 0;
+    m2mbase_stub::name_id_value = 5;
+    M2MResource* resource = new M2MResource(*instance,
+                                                   *name,
+                                                   *name,
+                                                   M2MResourceInstance::INTEGER,
+                                                   M2MResource::Dynamic,
+                                                   false);
+
+    m2mobject_stub::instance_list.push_back(instance);
+    m2mobjectinstance_stub::resource_list.push_back(resource);
+    m2mbase_stub::operation = M2MBase::GET_ALLOWED;
+
+    m2m::IdSet ids;
+    ids.insert(7);
+    data = serializer->serialize(m2mobjectinstance_stub::resource_list, ids, size);
+    CHECK(data == NULL);
+    CHECK(size == 0);
+
+    ids.insert(5);
+    data = serializer->serialize(m2mobjectinstance_stub::resource_list, ids, size);
+    CHECK(data != NULL);
+    CHECK(size != 0);
+    free(data);
+
+    size = 0;
+    data = serializer->serialize(m2mobject_stub::instance_list, ids, size);
+    CHECK(data != NULL);
+    free(data);
+
+    delete name;
+    delete resource;
+    delete instance;
+    delete object;
+
+    m2mobjectinstance_stub::clear();
+    m2mobject_stub::clear();
+}
+
+void Test_M2MTLVSerializer::test_serialize_numeric_values()
+{
+    String *name = new String("1");
+    M2MObject *object = new M2MObject(*name);
+    M2MObjectInstance* instance = new M2MObjectInstance(*name,*object);
+
+    uint32_t size = 0;
+    uint8_t *data = 0;
+    m2mbase_stub::name_id_value = 1;
+    m2mresource_stub::bool_value = false;
+    M2MResource* resource = new M2MResource(*instance,
+                                            *name,
+                                            *name,
+                                            M2MResourceInstance::INTEGER,
+                                            M2MResource::Dynamic,
+                                            false);
+
+    // Integers take the shortest of 1, 2, 4 or 8 bytes
+    uint8_t integer[] = {"-300"};
+    m2mresourceinstance_stub::resource_type = M2MResourceInstance::INTEGER;
+    m2mresourceinstance_stub::value = integer;
+    m2mresourceinstance_stub::int_value = 4;
+    data = serializer->serialize(resource, size);
+    uint8_t integer_tlv[] = {0xC2, 0x01, 0xFE, 0xD4};
+    CHECK(size == sizeof(integer_tlv));
+    CHECK(memcmp(data, integer_tlv, size) == 0);
+    free(data);
+
+    uint8_t large[] = {"4294967296"};
+    m2mresourceinstance_stub::value = large;
+    m2mresourceinstance_stub::int_value = 10;
+    size = 0;
+    data = serializer->serialize(resource, size);
+    uint8_t large_tlv[] = {0xC8, 0x01, 0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+    CHECK(size == sizeof(large_tlv));
+    CHECK(memcmp(data, large_tlv, size) == 0);
+    free(data);
+
+    // Text which isn't a number goes as it is
+    uint8_t text[] = {"abc"};
+    m2mresourceinstance_stub::value = text;
+    m2mresourceinstance_stub::int_value = 3;
+    size = 0;
+    data = serializer->serialize(resource, size);
+    uint8_t text_tlv[] = {0xC3, 0x01, 'a', 'b', 'c'};
+    CHECK(size == sizeof(text_tlv));
+    CHECK(memcmp(data, text_tlv, size) == 0);
+    free(data);
+
+    // Floats are single precision when that holds the value exactly
+    uint8_t single[] = {"21.5"};
+    m2mresourceinstance_stub::resource_type = M2MResourceInstance::FLOAT;
+    m2mresourceinstance_stub::value = single;
+    m2mresourceinstance_stub::int_value = 4;
+    size = 0;
+    data = serializer->serialize(resource, size);
+    uint8_t single_tlv[] = {0xC4, 0x01, 0x41, 0xAC, 0x00, 0x00};
+    CHECK(size == sizeof(single_tlv));
+    CHECK(memcmp(data, single_tlv, size) == 0);
+    free(data);
+
+    uint8_t real[] = {"0.1"};
+    m2mresourceinstance_stub::value = real;
+    m2mresourceinstance_stub::int_value = 3;
+    size = 0;
+    data = serializer->serialize(resource, size);
+    uint8_t real_tlv[] = {0xC8, 0x01, 0x08, 0x3F, 0xB9, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A};
+    CHECK(size == sizeof(real_tlv));
+    CHECK(memcmp(data, real_tlv, size) == 0);
+    free(data);
+
+    delete name;
+    delete resource;
+    delete instance;
+    delete object;
+
+    m2mresourceinstance_stub::clear();
+    m2mresource_stub::clear();
+    m2mbase_stub::clear();
+}
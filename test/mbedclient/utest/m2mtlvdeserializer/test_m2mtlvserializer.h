@@ -33,6 +33,10 @@ public:
 
     void test_serialize_resource_instance();
 
+    void test_serialize_filtered_resources();
+
+    void test_serialize_numeric_values();
+
     M2MTLVSerializer *serializer;
 };
 
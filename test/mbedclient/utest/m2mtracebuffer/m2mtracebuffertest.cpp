@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mtracebuffer.h"
+
+
+TEST_GROUP(M2MTraceBuffer)
+{
+  Test_M2MTraceBuffer* m2m_trace_buffer;
+
+  void setup()
+  {
+    m2m_trace_buffer = new Test_M2MTraceBuffer();
+  }
+  void teardown()
+  {
+    delete m2m_trace_buffer;
+  }
+};
+
+TEST(M2MTraceBuffer, Create)
+{
+    CHECK(m2m_trace_buffer != NULL);
+}
+
+TEST(M2MTraceBuffer, test_record)
+{
+    m2m_trace_buffer->test_record();
+}
+
+TEST(M2MTraceBuffer, test_wrap)
+{
+    m2m_trace_buffer->test_wrap();
+}
+
+TEST(M2MTraceBuffer, test_active)
+{
+    m2m_trace_buffer->test_active();
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mtracebuffer.h"
+
+static const char *format = "value %d name %s size %lu scale %.2f flag %x";
+
+Test_M2MTraceBuffer::Test_M2MTraceBuffer()
+{
+    buffer = new M2MTraceBuffer(4);
+}
+
+Test_M2MTraceBuffer::~Test_M2MTraceBuffer()
+{
+    delete buffer;
+}
+
+void Test_M2MTraceBuffer::test_record()
+{
+    M2MTraceBuffer::Record record;
+    CHECK(buffer->count() == 0);
+    CHECK(!buffer->read(0, record));
+
+    M2MTraceBuffer::set_active(buffer);
+    M2MTraceBuffer::trace(4, format, -5, "name", 70000UL, 2.5, 0x10);
+    CHECK(buffer->count() == 1);
+    CHECK(buffer->read(0, record));
+    CHECK(record.event == (uintptr_t)format);
+    CHECK(record.level == 4);
+    CHECK(record.argument_count == M2MTraceBuffer::MaxArguments);
+    CHECK(record.arguments[0] == -5);
+    // Strings are not kept.
+    CHECK(record.arguments[1] == 0);
+    CHECK(record.arguments[2] == 70000);
+
+    M2MTraceBuffer::trace(1, "plain %% text");
+    CHECK(buffer->read(1, record));
+    CHECK(record.argument_count == 0);
+    CHECK(record.level == 1);
+
+    M2MTraceBuffer::trace(2, "float %f int %d", 3.75, 9);
+    CHECK(buffer->read(2, record));
+    CHECK(record.argument_count == 2);
+    CHECK(record.arguments[0] == 3);
+    CHECK(record.arguments[1] == 9);
+    CHECK(record.sequence == 2);
+
+    M2MTraceBuffer::set_active(NULL);
+}
+
+void Test_M2MTraceBuffer::test_wrap()
+{
+    M2MTraceBuffer::set_active(buffer);
+    for(int i = 0; i < 6; i++) {
+        M2MTraceBuffer::trace(4, "i %d", i);
+    }
+    M2MTraceBuffer::set_active(NULL);
+
+    CHECK(buffer->count() == 4);
+    CHECK(buffer->total() == 6);
+    M2MTraceBuffer::Record record;
+    CHECK(buffer->read(0, record));
+    CHECK(record.arguments[0] == 2);
+    CHECK(buffer->read(3, record));
+    CHECK(record.arguments[0] == 5);
+    CHECK(!buffer->read(4, record));
+
+    buffer->clear();
+    CHECK(buffer->count() == 0);
+    CHECK(buffer->total() == 0);
+
+    M2MTraceBuffer empty(0);
+    empty.set_active(&empty);
+    M2MTraceBuffer::trace(4, "i %d", 1);
+    CHECK(empty.count() == 0);
+}
+
+void Test_M2MTraceBuffer::test_active()
+{
+    CHECK(M2MTraceBuffer::active() == NULL);
+    M2MTraceBuffer::trace(4, "dropped %d", 1);
+
+    M2MTraceBuffer *other = new M2MTraceBuffer(2);
+    M2MTraceBuffer::set_active(other);
+    CHECK(M2MTraceBuffer::active() == other);
+    M2MTraceBuffer::trace(4, "kept %d", 1);
+    CHECK(other->count() == 1);
+    CHECK(buffer->count() == 0);
+
+    // Deleting the active buffer stops recording.
+    delete other;
+    CHECK(M2MTraceBuffer::active() == NULL);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+//CppUTest includes should be after your and system includes
+#include "CppUTest/TestHarness.h"
+#include "test_m2mvirtualclock.h"
+
+
+TEST_GROUP(M2MVirtualClock)
+{
+  Test_M2MVirtualClock* m2m_virtualclock;
+
+  void setup()
+  {
+    m2m_virtualclock = new Test_M2MVirtualClock();
+  }
+  void teardown()
+  {
+    delete m2m_virtualclock;
+  }
+};
+
+TEST(M2MVirtualClock, Create)
+{
+    CHECK(m2m_virtualclock != NULL);
+}
+
+TEST(M2MVirtualClock, test_single_shot)
+{
+    m2m_virtualclock->test_single_shot();
+}
+
+TEST(M2MVirtualClock, test_periodic)
+{
+    m2m_virtualclock->test_periodic();
+}
+
+TEST(M2MVirtualClock, test_stop_timer)
+{
+    m2m_virtualclock->test_stop_timer();
+}
+
+TEST(M2MVirtualClock, test_expiry_order)
+{
+    m2m_virtualclock->test_expiry_order();
+}
+
+TEST(M2MVirtualClock, test_delete_running_timer)
+{
+    m2m_virtualclock->test_delete_running_timer();
+}
+
+TEST(M2MVirtualClock, test_advance_to_next)
+{
+    m2m_virtualclock->test_advance_to_next();
+}
+
+TEST(M2MVirtualClock, test_dtls_timer)
+{
+    m2m_virtualclock->test_dtls_timer();
+}
+
+TEST(M2MVirtualClock, test_report_handler_pmin_pmax)
+{
+    m2m_virtualclock->test_report_handler_pmin_pmax();
+}
+
+TEST(M2MVirtualClock, test_report_handler_sample_age)
+{
+    m2m_virtualclock->test_report_handler_sample_age();
+}
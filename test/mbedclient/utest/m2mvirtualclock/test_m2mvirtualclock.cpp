@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "test_m2mvirtualclock.h"
+#include "m2mtimer.h"
+#include "m2mtimerobserver.h"
+#include "m2mreporthandler.h"
+#include "m2mreportobserver.h"
+#include "m2msamplebuffer.h"
+
+class TimerObserver : public M2MTimerObserver
+{
+public:
+    TimerObserver() : count(0), last_type(M2MTimerObserver::Notdefined), time(0) {}
+    virtual ~TimerObserver(){}
+
+    virtual void timer_expired(M2MTimerObserver::Type type){
+        count++;
+        last_type = type;
+        time = M2MVirtualClock::now();
+    }
+
+    int                     count;
+    M2MTimerObserver::Type  last_type;
+    uint64_t                time;
+};
+
+// Records the expiry order of several timers.
+class OrderObserver : public M2MTimerObserver
+{
+public:
+    OrderObserver() : count(0) {}
+    virtual ~OrderObserver(){}
+
+    virtual void timer_expired(M2MTimerObserver::Type type){
+        if(count < 4) {
+            order[count] = type;
+        }
+        count++;
+    }
+
+    int                     count;
+    M2MTimerObserver::Type  order[4];
+};
+
+class ReportObserver : public M2MReportObserver
+{
+public:
+    ReportObserver() : count(0), samples_count(0), samples_sent(true) {}
+    virtual ~ReportObserver(){}
+
+    void observation_to_be_sent(const m2m::IdSet &, bool, const m2m::IdSet *){
+        count++;
+    }
+
+    bool samples_to_be_sent(M2MSampleBuffer &samples){
+        samples_count = samples.count();
+        return samples_sent;
+    }
+
+    int count;
+    int samples_count;
+    bool samples_sent;
+};
+
+Test_M2MVirtualClock::Test_M2MVirtualClock()
+{
+    M2MVirtualClock::reset();
+}
+
+Test_M2MVirtualClock::~Test_M2MVirtualClock()
+{
+    M2MVirtualClock::reset();
+}
+
+void Test_M2MVirtualClock::test_single_shot()
+{
+    TimerObserver observer;
+    M2MTimer timer(observer);
+    timer.start_timer(100, M2MTimerObserver::PMinTimer);
+    CHECK(M2MVirtualClock::running_timers() == 1);
+
+    M2MVirtualClock::advance(99);
+    CHECK(observer.count == 0);
+
+    M2MVirtualClock::advance(1);
+    CHECK(observer.count == 1);
+    CHECK(observer.last_type == M2MTimerObserver::PMinTimer);
+    CHECK(observer.time == 100);
+    CHECK(M2MVirtualClock::running_timers() == 0);
+
+    M2MVirtualClock::advance(1000);
+    CHECK(observer.count == 1);
+    CHECK(M2MVirtualClock::now() == 1100);
+}
+
+void Test_M2MVirtualClock::test_periodic()
+{
+    TimerObserver observer;
+    M2MTimer timer(observer);
+    timer.start_timer(50, M2MTimerObserver::NsdlExecution, false);
+
+    M2MVirtualClock::advance(210);
+    CHECK(observer.count == 4);
+    CHECK(observer.time == 200);
+    CHECK(M2MVirtualClock::running_timers() == 1);
+    CHECK(M2MVirtualClock::timer_expiries() == 4);
+
+    timer.stop_timer();
+    M2MVirtualClock::advance(1000);
+    CHECK(observer.count == 4);
+}
+
+void Test_M2MVirtualClock::test_stop_timer()
+{
+    TimerObserver observer;
+    M2MTimer timer(observer);
+    timer.start_timer(100, M2MTimerObserver::PMaxTimer);
+    timer.stop_timer();
+    CHECK(M2MVirtualClock::running_timers() == 0);
+    CHECK(M2MVirtualClock::timer_stops() == 1);
+
+    M2MVirtualClock::advance(200);
+    CHECK(observer.count == 0);
+
+    // Restarting moves the deadline.
+    timer.start_timer(100, M2MTimerObserver::PMaxTimer);
+    M2MVirtualClock::advance(50);
+    timer.start_timer(100, M2MTimerObserver::PMaxTimer);
+    M2MVirtualClock::advance(99);
+    CHECK(observer.count == 0);
+    M2MVirtualClock::advance(1);
+    CHECK(observer.count == 1);
+    CHECK(observer.time == 350);
+    CHECK(M2MVirtualClock::timer_starts() == 3);
+}
+
+void Test_M2MVirtualClock::test_expiry_order()
+{
+    OrderObserver observer;
+    M2MTimer first(observer);
+    M2MTimer second(observer);
+    M2MTimer third(observer);
+    third.start_timer(20, M2MTimerObserver::PMaxTimer);
+    first.start_timer(10, M2MTimerObserver::PMinTimer);
+    second.start_timer(10, M2MTimerObserver::NsdlExecution);
+
+    M2MVirtualClock::advance(100);
+    CHECK(observer.count == 3);
+    CHECK(observer.order[0] == M2MTimerObserver::PMinTimer);
+    CHECK(observer.order[1] == M2MTimerObserver::NsdlExecution);
+    CHECK(observer.order[2] == M2MTimerObserver::PMaxTimer);
+}
+
+void Test_M2MVirtualClock::test_delete_running_timer()
+{
+    TimerObserver observer;
+    M2MTimer *timer = new M2MTimer(observer);
+    timer->start_timer(100, M2MTimerObserver::PMinTimer);
+    delete timer;
+    CHECK(M2MVirtualClock::running_timers() == 0);
+
+    // The slot of the deleted timer is reused by the next one.
+    M2MTimer other(observer);
+    other.start_timer(200, M2MTimerObserver::PMaxTimer);
+    M2MVirtualClock::advance(150);
+    CHECK(observer.count == 0);
+    M2MVirtualClock::advance(50);
+    CHECK(observer.count == 1);
+    CHECK(observer.last_type == M2MTimerObserver::PMaxTimer);
+}
+
+void Test_M2MVirtualClock::test_advance_to_next()
+{
+    CHECK(false == M2MVirtualClock::advance_to_next());
+
+    TimerObserver observer;
+    M2MTimer timer(observer);
+    timer.start_timer(3600000, M2MTimerObserver::Registration);
+    CHECK(true == M2MVirtualClock::advance_to_next());
+    CHECK(observer.count == 1);
+    CHECK(M2MVirtualClock::now() == 3600000);
+    CHECK(false == M2MVirtualClock::advance_to_next());
+}
+
+void Test_M2MVirtualClock::test_dtls_timer()
+{
+    TimerObserver observer;
+    M2MTimer timer(observer);
+    timer.start_dtls_timer(250, 1000);
+    CHECK(false == timer.is_intermediate_interval_passed());
+    CHECK(false == timer.is_total_interval_passed());
+
+    M2MVirtualClock::advance(250);
+    CHECK(true == timer.is_intermediate_interval_passed());
+    CHECK(false == timer.is_total_interval_passed());
+
+    M2MVirtualClock::advance(750);
+    CHECK(true == timer.is_total_interval_passed());
+    CHECK(observer.count == 1);
+    CHECK(observer.last_type == M2MTimerObserver::Dtls);
+}
+
+void Test_M2MVirtualClock::test_report_handler_pmin_pmax()
+{
+    ReportObserver observer;
+    M2MReportHandler handler(observer);
+    char query[] = "pmin=10&pmax=60";
+    char *query_ptr = query;
+    CHECK(true == handler.parse_notification_attribute(query_ptr,
+                                                       M2MBase::Resource,
+                                                       M2MResourceInstance::INTEGER));
+    handler.set_under_observation(true);
+
+    // The change is held back until pmin has passed.
+    handler.set_value(1.0f);
+    M2MVirtualClock::advance(9999);
+    CHECK(observer.count == 0);
+    M2MVirtualClock::advance(1);
+    CHECK(observer.count == 1);
+
+    // Without changes the value is reported again once pmax passes.
+    M2MVirtualClock::advance(59999);
+    CHECK(observer.count == 1);
+    M2MVirtualClock::advance(1);
+    CHECK(observer.count == 2);
+
+    // After pmin a change is reported immediately.
+    M2MVirtualClock::advance(10000);
+    handler.set_value(2.0f);
+    CHECK(observer.count == 3);
+
+    handler.set_under_observation(false);
+    CHECK(M2MVirtualClock::running_timers() == 0);
+}
+
+void Test_M2MVirtualClock::test_report_handler_sample_age()
+{
+    ReportObserver observer;
+    M2MReportHandler handler(observer);
+    M2MSampleBuffer buffer(100, 0, 1000, 0, M2MResourceInstance::DropOldest, false);
+
+    // The age is counted from the first sample.
+    buffer.add(1, (const uint8_t*)"1", 1);
+    handler.sample_added(buffer);
+    M2MVirtualClock::advance(500);
+    buffer.add(2, (const uint8_t*)"2", 1);
+    handler.sample_added(buffer);
+    M2MVirtualClock::advance(499);
+    CHECK(observer.samples_count == 0);
+    M2MVirtualClock::advance(1);
+    CHECK(observer.samples_count == 2);
+    CHECK(buffer.count() == 0);
+    CHECK(M2MVirtualClock::running_timers() == 0);
+
+    // A failed flush is retried after another period.
+    observer.samples_sent = false;
+    buffer.add(3, (const uint8_t*)"3", 1);
+    handler.sample_added(buffer);
+    M2MVirtualClock::advance(1000);
+    CHECK(observer.samples_count == 1);
+    CHECK(M2MVirtualClock::running_timers() == 1);
+
+    observer.samples_sent = true;
+    buffer.add(4, (const uint8_t*)"4", 1);
+    handler.sample_added(buffer);
+    M2MVirtualClock::advance(1000);
+    CHECK(observer.samples_count == 2);
+    CHECK(buffer.count() == 0);
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_M2M_VIRTUAL_CLOCK_H
+#define TEST_M2M_VIRTUAL_CLOCK_H
+
+#include "m2mvirtualclock.h"
+
+class Test_M2MVirtualClock
+{
+public:
+    Test_M2MVirtualClock();
+
+    virtual ~Test_M2MVirtualClock();
+
+    void test_single_shot();
+
+    void test_periodic();
+
+    void test_stop_timer();
+
+    void test_expiry_order();
+
+    void test_delete_running_timer();
+
+    void test_advance_to_next();
+
+    void test_dtls_timer();
+
+    void test_report_handler_pmin_pmax();
+
+    void test_report_handler_sample_age();
+};
+
+#endif // TEST_M2M_VIRTUAL_CLOCK_H
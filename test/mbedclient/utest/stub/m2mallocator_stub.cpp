@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include "m2mallocator.h"
+
+void M2MAllocator::set_allocator(M2MAllocator *)
+{
+}
+
+M2MAllocator* M2MAllocator::allocator()
+{
+    return NULL;
+}
+
+void* M2MAllocator::memory_alloc(uint16_t size)
+{
+    if(size)
+        return malloc(size);
+    else
+        return 0;
+}
+
+void M2MAllocator::memory_free(void *ptr)
+{
+    if(ptr)
+        free(ptr);
+}
+
+const M2MAllocator::Accounting& M2MAllocator::accounting()
+{
+    static M2MAllocator::Accounting accounting;
+    return accounting;
+}
+
+void M2MAllocator::reset_accounting()
+{
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include "m2marenaallocator.h"
+
+M2MArenaAllocator::M2MArenaAllocator(uint16_t)
+: _region(NULL),
+  _size(0),
+  _used(0)
+{
+}
+
+M2MArenaAllocator::~M2MArenaAllocator()
+{
+}
+
+void* M2MArenaAllocator::allocate(uint16_t size)
+{
+    if(size)
+        return malloc(size);
+    else
+        return 0;
+}
+
+void M2MArenaAllocator::deallocate(void *ptr)
+{
+    free(ptr);
+}
+
+void M2MArenaAllocator::reset()
+{
+}
+
+uint16_t M2MArenaAllocator::used() const
+{
+    return 0;
+}
+
+bool M2MArenaAllocator::contains(const void *) const
+{
+    return false;
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "m2mbase_stub.h"
+#include "nsdllinker.h"
 
 uint8_t m2mbase_stub::uint8_value;
 uint16_t m2mbase_stub::uint16_value;
@@ -160,6 +161,12 @@ void M2MBase::set_under_observation(bool /*observed*/,
 {
 }
 
+void M2MBase::set_composite_observation(bool observed,
+                                        M2MObservationHandler *handler)
+{
+    m2mbase_stub::observe = observed ? handler : NULL;
+}
+
 void M2MBase::set_observation_token(const uint8_t */*token*/,
                                     const uint8_t /*length*/)
 {
@@ -207,15 +214,25 @@ void M2MBase::remove_object_from_coap()
 {
 }
 
+bool M2MBase::sends_samples() const
+{
+    return false;
+}
+
 bool M2MBase::handle_observation_attribute(char *&query)
 {
     return m2mbase_stub::bool_value;
 }
 
-void M2MBase::observation_to_be_sent(m2m::Vector<uint16_t>, bool)
+void M2MBase::observation_to_be_sent(const m2m::IdSet &, bool, const m2m::IdSet *)
 {
 }
 
+bool M2MBase::samples_to_be_sent(M2MSampleBuffer &)
+{
+    return m2mbase_stub::bool_value;
+}
+
 void* M2MBase::memory_alloc(uint16_t)
 {
     return m2mbase_stub::void_value;
@@ -225,6 +242,38 @@ void M2MBase::memory_free(void *)
 {
 }
 
+void* M2MBase::response_alloc(M2MObservationHandler *, uint16_t size)
+{
+    return size ? malloc(size) : NULL;
+}
+
+void M2MBase::response_free(M2MObservationHandler *, void *ptr)
+{
+    free(ptr);
+}
+
+uint8_t* M2MBase::response_integer(M2MObservationHandler *,
+                                   int64_t value,
+                                   uint8_t &size)
+{
+    return String::convert_integer_to_array(value, size);
+}
+
+bool M2MBase::requested_content_type(const sn_coap_hdr_s *coap_header,
+                                     uint16_t &content_type)
+{
+    if(coap_header->options_list_ptr && coap_header->options_list_ptr->accept_ptr) {
+        content_type = String::convert_array_to_integer(coap_header->options_list_ptr->accept_ptr,
+                                                        coap_header->options_list_ptr->accept_len);
+    } else if(coap_header->content_type_ptr) {
+        content_type = String::convert_array_to_integer(coap_header->content_type_ptr,
+                                                        coap_header->content_type_len);
+    } else {
+        return false;
+    }
+    return true;
+}
+
 M2MReportHandler* M2MBase::report_handler()
 {
     return m2mbase_stub::report;
@@ -270,6 +319,15 @@ bool M2MBase::register_uri()
     return m2mbase_stub::bool_value;
 }
 
+void M2MBase::set_delta_notification(bool)
+{
+}
+
+bool M2MBase::delta_notification() const
+{
+    return m2mbase_stub::bool_value;
+}
+
 void M2MBase::set_uri_path(const String &uri_path)
 {
 }
@@ -278,3 +336,13 @@ const String& M2MBase::uri_path() const
 {
     return *m2mbase_stub::string_value;
 }
+
+uint32_t M2MBase::memory_footprint() const
+{
+    return m2mbase_stub::uint32_value;
+}
+
+uint32_t M2MBase::base_memory_footprint() const
+{
+    return m2mbase_stub::uint32_value;
+}
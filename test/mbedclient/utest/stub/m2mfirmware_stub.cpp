@@ -111,3 +111,12 @@ uint16_t M2MFirmware::total_resource_count() const
 {
     return (uint16_t)m2mfirmware_stub::int_value;
 }
+
+void M2MFirmware::set_package_sink(M2MFirmwareSink *)
+{
+}
+
+uint32_t M2MFirmware::package_offset() const
+{
+    return m2mfirmware_stub::int_value;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "m2mfirmwarepackagewriter_stub.h"
+
+bool m2mfirmwarepackagewriter_stub::bool_value;
+uint32_t m2mfirmwarepackagewriter_stub::int_value;
+sn_coap_msg_code_e m2mfirmwarepackagewriter_stub::msg_code;
+
+void m2mfirmwarepackagewriter_stub::clear()
+{
+    bool_value = false;
+    int_value = 0;
+    msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
+}
+
+M2MFirmwarePackageWriter::M2MFirmwarePackageWriter(M2MFirmware &firmware)
+: _firmware(firmware),
+  _sink(NULL),
+  _offset(0),
+  _active(false)
+{
+}
+
+M2MFirmwarePackageWriter::~M2MFirmwarePackageWriter()
+{
+}
+
+void M2MFirmwarePackageWriter::set_sink(M2MFirmwareSink *sink)
+{
+    _sink = sink;
+}
+
+bool M2MFirmwarePackageWriter::is_block_message(const sn_coap_hdr_s *) const
+{
+    return m2mfirmwarepackagewriter_stub::bool_value;
+}
+
+sn_coap_msg_code_e M2MFirmwarePackageWriter::handle_block(const sn_coap_hdr_s *,
+                                                          sn_coap_hdr_s *)
+{
+    return m2mfirmwarepackagewriter_stub::msg_code;
+}
+
+uint32_t M2MFirmwarePackageWriter::package_offset() const
+{
+    return m2mfirmwarepackagewriter_stub::int_value;
+}
+
+bool M2MFirmwarePackageWriter::is_active() const
+{
+    return m2mfirmwarepackagewriter_stub::bool_value;
+}
+
+void M2MFirmwarePackageWriter::abort()
+{
+}
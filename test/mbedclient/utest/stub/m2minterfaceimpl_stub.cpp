@@ -67,6 +67,15 @@ void M2MInterfaceImpl::unregister_object(M2MSecurity*)
 {
 }
 
+void M2MInterfaceImpl::send(const M2MPathList &)
+{
+}
+
+M2MObject* M2MInterfaceImpl::object(uint16_t) const
+{
+    return NULL;
+}
+
 void M2MInterfaceImpl::set_queue_sleep_handler(callback_handler)
 {
 
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stddef.h>
+#include "mbed-client/m2mlatency.h"
+
+void M2MLatency::record(M2MLatency::Histogram, uint64_t)
+{
+}
+
+uint32_t M2MLatency::count(M2MLatency::Histogram)
+{
+    return 0;
+}
+
+uint32_t M2MLatency::max(M2MLatency::Histogram)
+{
+    return 0;
+}
+
+uint32_t M2MLatency::percentile(M2MLatency::Histogram, float)
+{
+    return 0;
+}
+
+uint32_t M2MLatency::bucket(M2MLatency::Histogram, uint16_t)
+{
+    return 0;
+}
+
+uint32_t M2MLatency::bucket_upper_bound(uint16_t)
+{
+    return 0;
+}
+
+uint32_t M2MLatency::export_json(char *, uint32_t)
+{
+    return 0;
+}
+
+void M2MLatency::reset()
+{
+}
+
+void M2MLatency::request_received()
+{
+}
+
+void M2MLatency::request_started(uint8_t)
+{
+}
+
+void M2MLatency::request_finished()
+{
+}
+
+void M2MLatency::notification_triggered(uint64_t)
+{
+}
+
+void M2MLatency::notification_sending(bool)
+{
+}
+
+void M2MLatency::message_sent(const uint8_t *, uint16_t)
+{
+}
+
+void M2MLatency::message_acknowledged(uint16_t)
+{
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "m2mnotificationstore.h"
+
+M2MNotificationStore::Entry::Entry()
+: composite(NULL),
+  observation_number(0),
+  send_object(false),
+  delta(false)
+{
+}
+
+M2MNotificationStore::M2MNotificationStore()
+{
+}
+
+M2MNotificationStore::~M2MNotificationStore()
+{
+}
+
+void M2MNotificationStore::store(const String &,
+                                 uint16_t,
+                                 const m2m::IdSet &,
+                                 bool,
+                                 const m2m::IdSet *)
+{
+}
+
+void M2MNotificationStore::store(M2MCompositeObservation *)
+{
+}
+
+void M2MNotificationStore::remove(M2MCompositeObservation *)
+{
+}
+
+uint16_t M2MNotificationStore::count() const
+{
+    return 0;
+}
+
+const M2MNotificationStore::Entry& M2MNotificationStore::entry(uint16_t index) const
+{
+    return *_entries[index];
+}
+
+void M2MNotificationStore::clear()
+{
+}
+
+uint32_t M2MNotificationStore::memory_footprint() const
+{
+    return 0;
+}
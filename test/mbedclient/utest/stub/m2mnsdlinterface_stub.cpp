@@ -17,15 +17,22 @@
 
 bool m2mnsdlinterface_stub::bool_value;
 uint32_t m2mnsdlinterface_stub::int_value;
+uint8_t m2mnsdlinterface_stub::pending_exchanges;
+bool m2mnsdlinterface_stub::queue_sleeping;
+M2MObject *m2mnsdlinterface_stub::object;
 
 void m2mnsdlinterface_stub::clear()
 {
     bool_value = false;
     int_value = 0;
+    pending_exchanges = 0;
+    queue_sleeping = false;
+    object = NULL;
 }
 
 M2MNsdlInterface::M2MNsdlInterface(M2MNsdlObserver &observer)
-: _observer(observer)
+: _observer(observer),
+  _request_arena(0)
 {
 }
 
@@ -83,6 +90,16 @@ bool M2MNsdlInterface::send_unregister_message()
     return m2mnsdlinterface_stub::bool_value;
 }
 
+M2MInterface::Error M2MNsdlInterface::send_data(const M2MPathList &)
+{
+    return m2mnsdlinterface_stub::bool_value ? M2MInterface::ErrorNone : M2MInterface::NotRegistered;
+}
+
+M2MObject* M2MNsdlInterface::object(uint16_t) const
+{
+    return m2mnsdlinterface_stub::object;
+}
+
 void *M2MNsdlInterface::memory_alloc(uint16_t size)
 {
     return malloc(size);
@@ -134,11 +151,21 @@ void M2MNsdlInterface::stop_timers()
 
 }
 
+void M2MNsdlInterface::queue_mode_sleep()
+{
+    m2mnsdlinterface_stub::queue_sleeping = true;
+}
+
+uint8_t M2MNsdlInterface::pending_exchanges() const
+{
+    return m2mnsdlinterface_stub::pending_exchanges;
+}
+
 void M2MNsdlInterface::timer_expired(M2MTimerObserver::Type)
 {
 }
 
-void M2MNsdlInterface::observation_to_be_sent(M2MBase *, uint16_t, Vector<uint16_t>, bool)
+void M2MNsdlInterface::observation_to_be_sent(M2MBase *, uint16_t, const m2m::IdSet &, bool, const m2m::IdSet *)
 {
 }
 
@@ -157,3 +184,21 @@ void M2MNsdlInterface::value_updated(M2MBase *, const String&)
 void M2MNsdlInterface::remove_object(M2MBase *)
 {
 }
+
+M2MAllocator* M2MNsdlInterface::request_allocator()
+{
+    return NULL;
+}
+
+void M2MNsdlInterface::composite_value_changed(M2MBase *)
+{
+}
+
+bool M2MNsdlInterface::samples_to_be_sent(M2MBase *, uint16_t, M2MSampleBuffer &)
+{
+    return m2mnsdlinterface_stub::bool_value;
+}
+
+void M2MNsdlInterface::composite_observation_to_be_sent(M2MCompositeObservation &)
+{
+}
@@ -23,6 +23,9 @@ namespace m2mnsdlinterface_stub
 {
     extern bool bool_value;
     extern uint32_t int_value;
+    extern uint8_t pending_exchanges;
+    extern bool queue_sleeping;
+    extern M2MObject *object;
     void clear();
 }
 
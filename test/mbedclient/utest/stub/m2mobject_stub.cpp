@@ -115,6 +115,11 @@ sn_coap_hdr_s* M2MObject::handle_post_request(nsdl_s *,
     return m2mobject_stub::header;
 }
 
-void M2MObject::notification_update(uint16_t obj_instance_id)
+void M2MObject::notification_update(uint16_t, int32_t)
 {
 }
+
+uint32_t M2MObject::memory_footprint() const
+{
+    return m2mobject_stub::int_value;
+}
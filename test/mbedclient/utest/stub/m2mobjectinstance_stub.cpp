@@ -112,6 +112,22 @@ M2MResource* M2MObjectInstance::resource(const String &) const
     return m2mobjectinstance_stub::resource;
 }
 
+M2MResource* M2MObjectInstance::resource(const char *) const
+{
+    return m2mobjectinstance_stub::resource;
+}
+
+M2MResource* M2MObjectInstance::resource_by_id(uint16_t resource_id) const
+{
+    M2MResourceList::const_iterator it = m2mobjectinstance_stub::resource_list.begin();
+    for(; it != m2mobjectinstance_stub::resource_list.end(); it++) {
+        if((*it)->name_id() == resource_id) {
+            return *it;
+        }
+    }
+    return m2mobjectinstance_stub::resource;
+}
+
 const M2MResourceList& M2MObjectInstance::resources() const
 {
     return m2mobjectinstance_stub::resource_list;
@@ -164,6 +180,11 @@ sn_coap_hdr_s* M2MObjectInstance::handle_post_request(nsdl_s *,
     return m2mobjectinstance_stub::header;
 }
 
-void M2MObjectInstance::notification_update(M2MBase::Observation)
+void M2MObjectInstance::notification_update(M2MBase::Observation, int32_t)
+{
+}
+
+uint32_t M2MObjectInstance::memory_footprint() const
 {
+    return m2mobjectinstance_stub::int_value;
 }
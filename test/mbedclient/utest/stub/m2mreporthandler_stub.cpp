@@ -17,11 +17,15 @@
 
 bool m2mreporthandler_stub::bool_return;
 u_int8_t m2mreporthandler_stub::int_value;
+bool m2mreporthandler_stub::set_value_called;
+bool m2mreporthandler_stub::notification_triggered;
 
 void m2mreporthandler_stub::clear()
 {
     bool_return = false;
     int_value = 0;
+    set_value_called = false;
+    notification_triggered = false;
 }
 
 M2MReportHandler::M2MReportHandler(M2MReportObserver &observer)
@@ -39,6 +43,7 @@ void M2MReportHandler::set_under_observation(bool)
 
 void M2MReportHandler::set_value(float)
 {
+    m2mreporthandler_stub::set_value_called = true;
 }
 
 bool M2MReportHandler::parse_notification_attribute(char *&,
@@ -52,7 +57,16 @@ void M2MReportHandler::timer_expired(M2MTimerObserver::Type )
 {
 }
 
-void M2MReportHandler::set_notification_trigger(uint16_t)
+void M2MReportHandler::set_notification_trigger(uint16_t, int32_t)
+{
+    m2mreporthandler_stub::notification_triggered = true;
+}
+
+void M2MReportHandler::sample_added(M2MSampleBuffer &)
+{
+}
+
+void M2MReportHandler::remove_sample_buffer(M2MSampleBuffer *)
 {
 }
 
@@ -64,3 +78,8 @@ uint8_t M2MReportHandler::attribute_flags()
 {
     return m2mreporthandler_stub::int_value;
 }
+
+uint32_t M2MReportHandler::memory_footprint() const
+{
+    return m2mreporthandler_stub::int_value;
+}
@@ -23,6 +23,8 @@ namespace m2mreporthandler_stub
 {
     extern bool bool_return;
     extern u_int8_t int_value;
+    extern bool set_value_called;
+    extern bool notification_triggered;
     void clear();
 }
 
@@ -156,3 +156,8 @@ sn_coap_hdr_s* M2MResource::handle_post_request(nsdl_s *,
 {
     return m2mresource_stub::header;
 }
+
+uint32_t M2MResource::memory_footprint() const
+{
+    return m2mresource_stub::int_value;
+}
@@ -22,6 +22,7 @@ M2MResourceInstance::ResourceType m2mresourceinstance_stub::resource_type;
 sn_coap_hdr_s *m2mresourceinstance_stub::header;
 uint8_t* m2mresourceinstance_stub::value;
 M2MBase::BaseType m2mresourceinstance_stub::base_type;
+String m2mresourceinstance_stub::set_value;
 
 
 void m2mresourceinstance_stub::clear()
@@ -33,6 +34,7 @@ void m2mresourceinstance_stub::clear()
     value = NULL;
     base_type = M2MBase::ResourceInstance;
     string_value = NULL;
+    set_value.clear();
 }
 
 M2MResourceInstance& M2MResourceInstance::operator=(const M2MResourceInstance&)
@@ -103,9 +105,16 @@ void M2MResourceInstance::set_execute_function(execute_callback)
 {
 }
 
-bool M2MResourceInstance::set_value(const uint8_t *,
-                                    const uint32_t )
+bool M2MResourceInstance::set_value(const uint8_t *value,
+                                    const uint32_t length)
 {
+    char *text = (char*)malloc(length + 1);
+    if(text) {
+        memcpy(text, value, length);
+        text[length] = '\0';
+        m2mresourceinstance_stub::set_value = text;
+        free(text);
+    }
     return m2mresourceinstance_stub::bool_value;
 }
 
@@ -159,6 +168,10 @@ sn_coap_hdr_s* M2MResourceInstance::handle_put_request(nsdl_s *,
 void M2MResourceInstance::set_resource_observer(M2MResourceCallback *callback)
 {
 
+}
+
+void M2MResourceInstance::set_package_writer(M2MFirmwarePackageWriter *)
+{
 }
 const String& M2MResourceInstance::object_name() const
 {
@@ -173,3 +186,44 @@ uint16_t M2MResourceInstance::object_instance_id() const
 void M2MResourceInstance::set_execute_function(execute_callback_2 callback)
 {
 }
+
+void M2MResourceInstance::set_value_provider(value_provider_callback)
+{
+}
+
+void M2MResourceInstance::set_value_provider(value_provider_callback_2)
+{
+}
+
+void M2MResourceInstance::update_value()
+{
+}
+
+void M2MResourceInstance::mark_changed()
+{
+}
+
+bool M2MResourceInstance::set_sample_buffer(uint16_t, uint16_t, uint32_t, uint32_t,
+                                            SampleOverflow, bool)
+{
+    return m2mresourceinstance_stub::bool_value;
+}
+
+void M2MResourceInstance::remove_sample_buffer()
+{
+}
+
+bool M2MResourceInstance::sends_samples() const
+{
+    return m2mresourceinstance_stub::bool_value;
+}
+
+uint16_t M2MResourceInstance::sample_count() const
+{
+    return m2mresourceinstance_stub::int_value;
+}
+
+uint32_t M2MResourceInstance::memory_footprint() const
+{
+    return m2mresourceinstance_stub::int_value;
+}
@@ -28,6 +28,7 @@ namespace m2mresourceinstance_stub
     extern M2MResourceInstance::ResourceType resource_type;
     extern M2MBase::BaseType base_type;
     extern sn_coap_hdr_s *header;
+    extern String set_value;
     void clear();
 }
 
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "m2msenmlcbordeserializer_stub.h"
+
+bool m2msenmlcbordeserializer_stub::bool_value;
+M2MPathList m2msenmlcbordeserializer_stub::paths;
+M2MSenMLCBORDeserializer::Error m2msenmlcbordeserializer_stub::error;
+
+void m2msenmlcbordeserializer_stub::clear()
+{
+    bool_value = false;
+    paths.clear();
+    error = M2MSenMLCBORDeserializer::None;
+}
+
+M2MSenMLCBORDeserializer::M2MSenMLCBORDeserializer()
+: _data(NULL),
+  _size(0),
+  _position(0),
+  _base_name(NULL),
+  _base_name_length(0),
+  _value(NULL),
+  _value_length(0),
+  _count(0)
+{
+}
+
+M2MSenMLCBORDeserializer::~M2MSenMLCBORDeserializer()
+{
+}
+
+bool M2MSenMLCBORDeserializer::deserialize_paths(const uint8_t *, uint32_t, M2MPathList &paths)
+{
+    M2MPathList::const_iterator it = m2msenmlcbordeserializer_stub::paths.begin();
+    for(; it != m2msenmlcbordeserializer_stub::paths.end(); it++) {
+        paths.push_back(*it);
+    }
+    return m2msenmlcbordeserializer_stub::bool_value;
+}
+
+M2MSenMLCBORDeserializer::Error M2MSenMLCBORDeserializer::deserialize_resources(const uint8_t *,
+                                                                                uint32_t,
+                                                                                M2MObjectInstance &,
+                                                                                M2MSenMLCBORDeserializer::Operation)
+{
+    return m2msenmlcbordeserializer_stub::error;
+}
+
+M2MSenMLCBORDeserializer::Error M2MSenMLCBORDeserializer::deserialize_resource_instances(const uint8_t *,
+                                                                                         uint32_t,
+                                                                                         M2MResource &,
+                                                                                         M2MSenMLCBORDeserializer::Operation)
+{
+    return m2msenmlcbordeserializer_stub::error;
+}
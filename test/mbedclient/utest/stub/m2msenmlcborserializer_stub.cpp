@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "m2msenmlcborserializer_stub.h"
+
+bool m2msenmlcborserializer_stub::bool_value;
+uint8_t* m2msenmlcborserializer_stub::uint8_value;
+uint32_t m2msenmlcborserializer_stub::size_value;
+
+void m2msenmlcborserializer_stub::clear()
+{
+    bool_value = false;
+    uint8_value = NULL;
+    size_value = 0;
+}
+
+M2MSenMLCBORSerializer::M2MSenMLCBORSerializer()
+: _data(NULL),
+  _size(0),
+  _capacity(0),
+  _count(0),
+  _base_instance(-1),
+  _failed(false)
+{
+}
+
+M2MSenMLCBORSerializer::~M2MSenMLCBORSerializer()
+{
+}
+
+bool M2MSenMLCBORSerializer::append(M2MObject *)
+{
+    return m2msenmlcborserializer_stub::bool_value;
+}
+
+bool M2MSenMLCBORSerializer::append(const String &, M2MObjectInstance *)
+{
+    return m2msenmlcborserializer_stub::bool_value;
+}
+
+bool M2MSenMLCBORSerializer::append(const String &, uint16_t, M2MResource *)
+{
+    return m2msenmlcborserializer_stub::bool_value;
+}
+
+bool M2MSenMLCBORSerializer::append(const String &, uint16_t, M2MResourceInstance *)
+{
+    return m2msenmlcborserializer_stub::bool_value;
+}
+
+bool M2MSenMLCBORSerializer::append(const String &, uint16_t, M2MResourceInstance *,
+                                    const M2MSampleBuffer &, uint64_t)
+{
+    return m2msenmlcborserializer_stub::bool_value;
+}
+
+uint32_t M2MSenMLCBORSerializer::record_count() const
+{
+    return 0;
+}
+
+uint8_t* M2MSenMLCBORSerializer::serialize(uint32_t &size)
+{
+    size = m2msenmlcborserializer_stub::size_value;
+    return m2msenmlcborserializer_stub::uint8_value;
+}
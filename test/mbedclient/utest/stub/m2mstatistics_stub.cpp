@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stddef.h>
+#include "mbed-client/m2mstatistics.h"
+
+uint32_t M2MStatistics::value(M2MStatistics::Statistic)
+{
+    return 0;
+}
+
+uint32_t M2MStatistics::average_message_size()
+{
+    return 0;
+}
+
+void M2MStatistics::reset()
+{
+}
+
+void M2MStatistics::set_clock(clock_function)
+{
+}
+
+uint64_t M2MStatistics::now()
+{
+    return 0;
+}
+
+M2MObject* M2MStatistics::create_object()
+{
+    return NULL;
+}
+
+void M2MStatistics::increment(M2MStatistics::Statistic, uint32_t)
+{
+}
+
+void M2MStatistics::set(M2MStatistics::Statistic, uint32_t)
+{
+}
+
+void M2MStatistics::message_sent(const uint8_t *, uint16_t)
+{
+}
+
+void M2MStatistics::message_received(uint16_t)
+{
+}
+
+void M2MStatistics::registration_update_sent()
+{
+}
+
+void M2MStatistics::registration_update_completed()
+{
+}
+
+uint16_t M2MStatistics::memory_report(const m2m::Vector<M2MObject*> &,
+                                     M2MStatistics::ObjectMemory *,
+                                     uint16_t)
+{
+    return 0;
+}
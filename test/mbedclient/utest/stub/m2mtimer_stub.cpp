@@ -17,11 +17,13 @@
 
 bool m2mtimer_stub::bool_value;
 bool m2mtimer_stub::total_bool_value;
+uint64_t m2mtimer_stub::interval;
 
 void m2mtimer_stub::clear()
 {
     bool_value = false;
     total_bool_value = false;
+    interval = 0;
 }
 
 // Prevents the use of assignment operator
@@ -46,10 +48,11 @@ M2MTimer::~M2MTimer()
 {
 }
 
-void M2MTimer::start_timer(uint64_t /*interval*/,
+void M2MTimer::start_timer(uint64_t interval,
                            M2MTimerObserver::Type /*type*/,
                            bool /*single_shot*/)
 {
+    m2mtimer_stub::interval = interval;
 }
 
 void M2MTimer::start_dtls_timer(uint64_t , uint64_t , M2MTimerObserver::Type )
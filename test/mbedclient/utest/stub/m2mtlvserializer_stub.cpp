@@ -40,6 +40,16 @@ uint8_t* M2MTLVSerializer::serialize(M2MResourceList resource_list, uint32_t &si
     return m2mtlvserializer_stub::uint8_value;
 }
 
+uint8_t* M2MTLVSerializer::serialize(M2MObjectInstanceList, const m2m::IdSet &, uint32_t &)
+{
+    return m2mtlvserializer_stub::uint8_value;
+}
+
+uint8_t* M2MTLVSerializer::serialize(M2MResourceList, const m2m::IdSet &, uint32_t &)
+{
+    return m2mtlvserializer_stub::uint8_value;
+}
+
 uint8_t* M2MTLVSerializer::serialize(M2MResource *, uint32_t &)
 {
     return m2mtlvserializer_stub::uint8_value;
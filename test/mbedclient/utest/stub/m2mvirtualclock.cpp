@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed-client/m2mtimer.h"
+#include "mbed-client/m2mvector.h"
+#include "m2mvirtualclock.h"
+
+/**
+ * Pending expiry. Entries are never removed from the middle of the heap,
+ * a stopped or restarted timer only bumps the generation of its slot so
+ * that the stale entry is skipped when it is popped.
+ */
+typedef struct {
+    uint64_t    deadline;
+    uint64_t    sequence;
+    uint32_t    slot;
+    uint32_t    generation;
+} virtual_timer_entry_s;
+
+typedef struct {
+    M2MTimerPimpl   *timer;
+    uint32_t        generation;
+} virtual_timer_slot_s;
+
+static uint64_t                                 virtual_time = 0;
+static uint64_t                                 virtual_sequence = 0;
+static uint64_t                                 virtual_starts = 0;
+static uint64_t                                 virtual_stops = 0;
+static uint64_t                                 virtual_expiries = 0;
+static uint32_t                                 virtual_running = 0;
+static m2m::Vector<virtual_timer_entry_s>       virtual_heap;
+static m2m::Vector<virtual_timer_slot_s>        virtual_slots;
+static m2m::Vector<uint32_t>                    virtual_free_slots;
+
+static bool entry_before(const virtual_timer_entry_s &a,
+                         const virtual_timer_entry_s &b)
+{
+    return a.deadline < b.deadline ||
+           (a.deadline == b.deadline && a.sequence < b.sequence);
+}
+
+static void heap_sift_down(int index)
+{
+    int size = virtual_heap.size();
+    for(;;) {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if(left < size && entry_before(virtual_heap[left], virtual_heap[smallest])) {
+            smallest = left;
+        }
+        if(right < size && entry_before(virtual_heap[right], virtual_heap[smallest])) {
+            smallest = right;
+        }
+        if(smallest == index) {
+            break;
+        }
+        virtual_timer_entry_s tmp = virtual_heap[index];
+        virtual_heap[index] = virtual_heap[smallest];
+        virtual_heap[smallest] = tmp;
+        index = smallest;
+    }
+}
+
+static void heap_push(const virtual_timer_entry_s &entry)
+{
+    virtual_heap.push_back(entry);
+    int index = virtual_heap.size() - 1;
+    while(index > 0) {
+        int parent = (index - 1) / 2;
+        if(!entry_before(virtual_heap[index], virtual_heap[parent])) {
+            break;
+        }
+        virtual_timer_entry_s tmp = virtual_heap[index];
+        virtual_heap[index] = virtual_heap[parent];
+        virtual_heap[parent] = tmp;
+        index = parent;
+    }
+}
+
+static void heap_pop()
+{
+    virtual_heap[0] = virtual_heap.back();
+    virtual_heap.pop_back();
+    if(!virtual_heap.empty()) {
+        heap_sift_down(0);
+    }
+}
+
+static bool entry_valid(const virtual_timer_entry_s &entry)
+{
+    const virtual_timer_slot_s &slot = virtual_slots[entry.slot];
+    return slot.timer && slot.generation == entry.generation;
+}
+
+// Drops stale entries once they dominate the heap.
+static void heap_compact()
+{
+    if(virtual_heap.size() <= 64 ||
+       (uint32_t)virtual_heap.size() <= 2 * virtual_running) {
+        return;
+    }
+    int kept = 0;
+    for(int i = 0; i < virtual_heap.size(); i++) {
+        if(entry_valid(virtual_heap[i])) {
+            virtual_heap[kept++] = virtual_heap[i];
+        }
+    }
+    while(virtual_heap.size() > kept) {
+        virtual_heap.pop_back();
+    }
+    for(int i = kept / 2 - 1; i >= 0; i--) {
+        heap_sift_down(i);
+    }
+}
+
+class M2MTimerPimpl {
+public:
+    M2MTimerPimpl(M2MTimerObserver &observer)
+    : _observer(observer),
+      _type(M2MTimerObserver::Notdefined),
+      _interval(0),
+      _start_time(0),
+      _intermediate_interval(0),
+      _total_interval(0),
+      _single_shot(true),
+      _running(false)
+    {
+        if(!virtual_free_slots.empty()) {
+            _slot = virtual_free_slots.back();
+            virtual_free_slots.pop_back();
+        } else {
+            virtual_timer_slot_s slot;
+            slot.timer = NULL;
+            slot.generation = 0;
+            virtual_slots.push_back(slot);
+            _slot = virtual_slots.size() - 1;
+        }
+        virtual_slots[_slot].timer = this;
+    }
+
+    ~M2MTimerPimpl() {
+        stop();
+        virtual_slots[_slot].timer = NULL;
+        virtual_slots[_slot].generation++;
+        virtual_free_slots.push_back(_slot);
+    }
+
+    void start(uint64_t interval, M2MTimerObserver::Type type, bool single_shot) {
+        stop();
+        _interval = interval;
+        _type = type;
+        _single_shot = single_shot;
+        _start_time = virtual_time;
+        _intermediate_interval = 0;
+        _total_interval = interval;
+        virtual_starts++;
+        arm(virtual_time + interval);
+    }
+
+    void start_dtls(uint64_t intermediate_interval,
+                    uint64_t total_interval,
+                    M2MTimerObserver::Type type) {
+        start(total_interval, type, true);
+        _intermediate_interval = intermediate_interval;
+    }
+
+    void stop() {
+        if(_running) {
+            _running = false;
+            virtual_running--;
+            virtual_slots[_slot].generation++;
+            virtual_stops++;
+        }
+    }
+
+    bool intermediate_passed() const {
+        return virtual_time >= _start_time + _intermediate_interval;
+    }
+
+    bool total_passed() const {
+        return virtual_time >= _start_time + _total_interval;
+    }
+
+    void expire() {
+        _running = false;
+        virtual_running--;
+        virtual_slots[_slot].generation++;
+        virtual_expiries++;
+        if(!_single_shot) {
+            // Periodic timers are rearmed relative to their deadline,
+            // so they never drift.
+            _start_time = virtual_time;
+            arm(virtual_time + _interval);
+        }
+        _observer.timer_expired(_type);
+    }
+
+private:
+
+    void arm(uint64_t deadline) {
+        virtual_timer_entry_s entry;
+        entry.deadline = deadline;
+        entry.sequence = virtual_sequence++;
+        entry.slot = _slot;
+        entry.generation = virtual_slots[_slot].generation;
+        _running = true;
+        virtual_running++;
+        heap_push(entry);
+        heap_compact();
+    }
+
+private:
+
+    M2MTimerObserver            &_observer;
+    M2MTimerObserver::Type      _type;
+    uint64_t                    _interval;
+    uint64_t                    _start_time;
+    uint64_t                    _intermediate_interval;
+    uint64_t                    _total_interval;
+    bool                        _single_shot;
+    bool                        _running;
+    uint32_t                    _slot;
+};
+
+// Fires the earliest timer if it expires at or before the given time.
+static bool fire_next(uint64_t until)
+{
+    while(!virtual_heap.empty()) {
+        virtual_timer_entry_s entry = virtual_heap[0];
+        if(!entry_valid(entry)) {
+            heap_pop();
+            continue;
+        }
+        if(entry.deadline > until) {
+            return false;
+        }
+        heap_pop();
+        virtual_time = entry.deadline;
+        virtual_slots[entry.slot].timer->expire();
+        return true;
+    }
+    return false;
+}
+
+uint64_t M2MVirtualClock::now()
+{
+    return virtual_time;
+}
+
+void M2MVirtualClock::advance(uint64_t milliseconds)
+{
+    uint64_t until = virtual_time + milliseconds;
+    while(fire_next(until)) {
+    }
+    virtual_time = until;
+}
+
+bool M2MVirtualClock::advance_to_next()
+{
+    while(!virtual_heap.empty() && !entry_valid(virtual_heap[0])) {
+        heap_pop();
+    }
+    if(virtual_heap.empty()) {
+        return false;
+    }
+    uint64_t deadline = virtual_heap[0].deadline;
+    while(fire_next(deadline)) {
+    }
+    return true;
+}
+
+uint32_t M2MVirtualClock::running_timers()
+{
+    return virtual_running;
+}
+
+uint64_t M2MVirtualClock::timer_starts()
+{
+    return virtual_starts;
+}
+
+uint64_t M2MVirtualClock::timer_stops()
+{
+    return virtual_stops;
+}
+
+uint64_t M2MVirtualClock::timer_expiries()
+{
+    return virtual_expiries;
+}
+
+void M2MVirtualClock::reset()
+{
+    for(int i = 0; i < virtual_slots.size(); i++) {
+        if(virtual_slots[i].timer) {
+            virtual_slots[i].timer->stop();
+        }
+    }
+    virtual_heap.clear();
+    virtual_time = 0;
+    virtual_sequence = 0;
+    virtual_starts = 0;
+    virtual_stops = 0;
+    virtual_expiries = 0;
+}
+
+M2MTimer::M2MTimer(M2MTimerObserver& observer)
+: _observer(observer),
+  _private_impl(new M2MTimerPimpl(observer))
+{
+}
+
+M2MTimer::~M2MTimer()
+{
+    delete _private_impl;
+}
+
+void M2MTimer::start_timer(uint64_t interval,
+                           M2MTimerObserver::Type type,
+                           bool single_shot)
+{
+    _private_impl->start(interval, type, single_shot);
+}
+
+void M2MTimer::start_dtls_timer(uint64_t intermediate_interval,
+                                uint64_t total_interval,
+                                M2MTimerObserver::Type type)
+{
+    _private_impl->start_dtls(intermediate_interval, total_interval, type);
+}
+
+void M2MTimer::stop_timer()
+{
+    _private_impl->stop();
+}
+
+bool M2MTimer::is_intermediate_interval_passed()
+{
+    return _private_impl->intermediate_passed();
+}
+
+bool M2MTimer::is_total_interval_passed()
+{
+    return _private_impl->total_passed();
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_VIRTUAL_CLOCK_H
+#define M2M_VIRTUAL_CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * @brief M2MVirtualClock.
+ * Deterministic clock driving the virtual M2MTimer backend in
+ * m2mvirtualclock.cpp. Link that file instead of the platform timer
+ * implementation and timers expire only when the test advances the
+ * clock. Expired timers are fired in deadline order, timers with the same
+ * deadline in the order they were started.
+ */
+class M2MVirtualClock {
+
+public:
+
+    /**
+     * @brief Returns the virtual time in milliseconds.
+     */
+    static uint64_t now();
+
+    /**
+     * @brief Advances the virtual time, firing every timer that
+     * expires on the way.
+     * @param milliseconds Amount of time to advance.
+     */
+    static void advance(uint64_t milliseconds);
+
+    /**
+     * @brief Advances the virtual time to the next deadline and fires
+     * the timers expiring at it.
+     * @return False if no timer is running, else true.
+     */
+    static bool advance_to_next();
+
+    /**
+     * @brief Returns the number of running timers.
+     */
+    static uint32_t running_timers();
+
+    /**
+     * @brief Returns the number of timer starts since the last reset.
+     */
+    static uint64_t timer_starts();
+
+    /**
+     * @brief Returns the number of timer stops since the last reset.
+     */
+    static uint64_t timer_stops();
+
+    /**
+     * @brief Returns the number of timer expiries since the last reset.
+     */
+    static uint64_t timer_expiries();
+
+    /**
+     * @brief Sets the time back to zero and clears the counters.
+     * Running timers are stopped.
+     */
+    static void reset();
+};
+
+#endif // M2M_VIRTUAL_CLOCK_H
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include "benchmark.h"
+#include "mbed-client/m2mstring.h"
+#include "mbed-client/m2mvector.h"
+
+static const char *SHORT_TEXT = "3/0/1";
+static const char *LONG_TEXT = "mbed-client-benchmark-endpoint-name-0123456789";
+
+static void string_construct_short(void *, uint32_t iterations)
+{
+    for(uint32_t i = 0; i < iterations; i++) {
+        m2m::String str(SHORT_TEXT);
+        Benchmark::consume(str.c_str());
+    }
+}
+
+static void string_construct_long(void *, uint32_t iterations)
+{
+    for(uint32_t i = 0; i < iterations; i++) {
+        m2m::String str(LONG_TEXT);
+        Benchmark::consume(str.c_str());
+    }
+}
+
+static void string_copy(void *, uint32_t iterations)
+{
+    m2m::String source(LONG_TEXT);
+    for(uint32_t i = 0; i < iterations; i++) {
+        m2m::String str(source);
+        Benchmark::consume(str.c_str());
+    }
+}
+
+static void string_concat_path(void *, uint32_t iterations)
+{
+    // Mirrors how object, instance and resource names are joined into paths.
+    for(uint32_t i = 0; i < iterations; i++) {
+        m2m::String path("3");
+        path += m2m::String("/");
+        path += m2m::String("0");
+        path += m2m::String("/");
+        path += m2m::String("1");
+        Benchmark::consume(path.c_str());
+    }
+}
+
+static void string_compare_equal(void *, uint32_t iterations)
+{
+    m2m::String a(LONG_TEXT);
+    m2m::String b(LONG_TEXT);
+    for(uint32_t i = 0; i < iterations; i++) {
+        bool equal = (a == b);
+        Benchmark::consume(&equal);
+    }
+}
+
+static void string_compare_different(void *, uint32_t iterations)
+{
+    m2m::String a("3/0/1");
+    m2m::String b("3/0/2");
+    for(uint32_t i = 0; i < iterations; i++) {
+        bool equal = (a == b);
+        Benchmark::consume(&equal);
+    }
+}
+
+void bench_string()
+{
+    Benchmark::run("string_construct_short", string_construct_short);
+    Benchmark::run("string_construct_long", string_construct_long);
+    Benchmark::run("string_copy", string_copy);
+    Benchmark::run("string_concat_path", string_concat_path);
+    Benchmark::run("string_compare_equal", string_compare_equal);
+    Benchmark::run("string_compare_different", string_compare_different);
+}
+
+static void vector_push_back(void *, uint32_t iterations)
+{
+    m2m::Vector<uint16_t> vector;
+    for(uint32_t i = 0; i < iterations; i++) {
+        vector.push_back((uint16_t)i);
+    }
+    Benchmark::consume(&vector[0]);
+}
+
+static void vector_push_erase_front(void *, uint32_t iterations)
+{
+    // Keeps a list of 32 entries and always removes the oldest one,
+    // as done for changed instance ids.
+    m2m::Vector<uint16_t> vector;
+    for(uint16_t i = 0; i < 32; i++) {
+        vector.push_back(i);
+    }
+    for(uint32_t i = 0; i < iterations; i++) {
+        vector.push_back((uint16_t)i);
+        vector.erase(0);
+    }
+    Benchmark::consume(&vector[0]);
+}
+
+static void vector_copy(void *, uint32_t iterations)
+{
+    m2m::Vector<uint16_t> vector;
+    for(uint16_t i = 0; i < 32; i++) {
+        vector.push_back(i);
+    }
+    for(uint32_t i = 0; i < iterations; i++) {
+        m2m::Vector<uint16_t> copy(vector);
+        Benchmark::consume(&copy[0]);
+    }
+}
+
+void bench_vector()
+{
+    Benchmark::run("vector_push_back", vector_push_back);
+    Benchmark::run("vector_push_erase_front", vector_push_erase_front);
+    Benchmark::run("vector_copy", vector_copy);
+}
+
+static void convert_integer_to_array(void *, uint32_t iterations)
+{
+    for(uint32_t i = 0; i < iterations; i++) {
+        uint8_t size = 0;
+        uint8_t *array = m2m::String::convert_integer_to_array(i, size);
+        Benchmark::consume(array);
+        free(array);
+    }
+}
+
+static void convert_integer_to_array_from_array(void *, uint32_t iterations)
+{
+    uint8_t value[] = { 0x00, 0x01, 0x02, 0x03 };
+    for(uint32_t i = 0; i < iterations; i++) {
+        uint8_t size = 0;
+        uint8_t *array = m2m::String::convert_integer_to_array(0, size,
+                                                               value,
+                                                               sizeof(value));
+        Benchmark::consume(array);
+        free(array);
+    }
+}
+
+static void convert_array_to_integer(void *, uint32_t iterations)
+{
+    uint8_t value[] = { 0x12, 0x34, 0x56, 0x78 };
+    for(uint32_t i = 0; i < iterations; i++) {
+        int64_t result = m2m::String::convert_array_to_integer(value,
+                                                                sizeof(value));
+        Benchmark::consume(&result);
+    }
+}
+
+static void itoa_c(void *, uint32_t iterations)
+{
+    char buffer[24];
+    for(uint32_t i = 0; i < iterations; i++) {
+        m2m::itoa_c((int64_t)i * 7919, buffer);
+        Benchmark::consume(buffer);
+    }
+}
+
+void bench_integer_conversion()
+{
+    Benchmark::run("convert_integer_to_array", convert_integer_to_array);
+    Benchmark::run("convert_integer_to_array_from_array", convert_integer_to_array_from_array);
+    Benchmark::run("convert_array_to_integer", convert_array_to_integer);
+    Benchmark::run("itoa_c", itoa_c);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark.h"
+#include "mbed-client/m2mobject.h"
+#include "include/m2mnsdlinterface.h"
+#include "include/m2mnsdlobserver.h"
+
+/**
+ * Observer ignoring all callbacks, the benchmarks never talk to a server.
+ */
+class BenchNsdlObserver : public M2MNsdlObserver {
+public:
+    void coap_message_ready(uint8_t *, uint16_t, sn_nsdl_addr_s *) {}
+    void client_registered(M2MServer *) {}
+    void registration_updated(const M2MServer &) {}
+    void registration_error(uint8_t) {}
+    void client_unregistered() {}
+    void bootstrap_done(M2MSecurity *) {}
+    void bootstrap_error() {}
+    void coap_data_processed() {}
+    void value_updated(M2MBase *) {}
+};
+
+/**
+ * Gives the benchmarks access to the resource lookup of M2MNsdlInterface
+ * without registering the resources to the NSDL library.
+ */
+class Bench_M2MNsdlInterface {
+public:
+    static bool add_object(M2MNsdlInterface &nsdl, M2MObject *object) {
+        return nsdl.add_object_to_list(object);
+    }
+    static M2MBase* find_resource(M2MNsdlInterface &nsdl, const String &path) {
+        return nsdl.find_resource(path);
+    }
+};
+
+struct FindResourceContext {
+    M2MNsdlInterface    *nsdl;
+    String              path;
+};
+
+static void find_resource(void *context, uint32_t iterations)
+{
+    FindResourceContext *ctx = (FindResourceContext*)context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        M2MBase *base = Bench_M2MNsdlInterface::find_resource(*ctx->nsdl,
+                                                              ctx->path);
+        Benchmark::consume(base);
+    }
+}
+
+/**
+ * Measures the lookup of the last resource of the tree, which is the
+ * worst case for the linear search. The tree has `objects` objects, each
+ * with `instances` instances of `resources` resources.
+ */
+static void bench_find_resource_tree(const char *name,
+                                     uint16_t objects,
+                                     uint16_t instances,
+                                     uint16_t resources)
+{
+    BenchNsdlObserver observer;
+    M2MNsdlInterface *nsdl = new M2MNsdlInterface(observer);
+    M2MObjectList list;
+    for(uint16_t i = 0; i < objects; i++) {
+        M2MObject *object = bench_create_object(10000 + i, instances, resources);
+        if(object) {
+            list.push_back(object);
+            Bench_M2MNsdlInterface::add_object(*nsdl, object);
+        }
+    }
+
+    char buffer[12];
+    FindResourceContext ctx;
+    ctx.nsdl = nsdl;
+    m2m::itoa_c(10000 + objects - 1, buffer);
+    ctx.path += buffer;
+    ctx.path += "/";
+    m2m::itoa_c(instances - 1, buffer);
+    ctx.path += buffer;
+    ctx.path += "/";
+    m2m::itoa_c(resources - 1, buffer);
+    ctx.path += buffer;
+
+    if(Bench_M2MNsdlInterface::find_resource(*nsdl, ctx.path)) {
+        Benchmark::run(name, find_resource, &ctx);
+    }
+
+    delete nsdl;
+    M2MObjectList::const_iterator it = list.begin();
+    for(; it != list.end(); it++) {
+        delete *it;
+    }
+}
+
+void bench_find_resource()
+{
+    bench_find_resource_tree("find_resource_10", 1, 1, 10);
+    bench_find_resource_tree("find_resource_1k", 10, 10, 10);
+    bench_find_resource_tree("find_resource_100k", 100, 10, 100);
+}
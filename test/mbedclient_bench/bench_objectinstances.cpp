@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark.h"
+#include "mbed-client/m2minterfacefactory.h"
+#include "mbed-client/m2mobject.h"
+#include "include/m2mindex.h"
+
+#define BENCH_INSTANCE_COUNT 10000
+
+static void object_create_instances_ascending(void *, uint32_t iterations)
+{
+    for(uint32_t i = 0; i < iterations; i++) {
+        M2MObject *object = M2MInterfaceFactory::create_object("10000");
+        for(uint16_t id = 0; id < BENCH_INSTANCE_COUNT; id++) {
+            Benchmark::consume(object->create_object_instance(id));
+        }
+        delete object;
+    }
+}
+
+/**
+ * Every instance goes to the front of the sorted list, which is the worst
+ * case for inserting into it.
+ */
+static void object_create_instances_descending(void *, uint32_t iterations)
+{
+    for(uint32_t i = 0; i < iterations; i++) {
+        M2MObject *object = M2MInterfaceFactory::create_object("10000");
+        for(uint16_t id = BENCH_INSTANCE_COUNT; id > 0; id--) {
+            Benchmark::consume(object->create_object_instance(id - 1));
+        }
+        delete object;
+    }
+}
+
+static void object_instance_lookup(void *context, uint32_t iterations)
+{
+    M2MObject *object = (M2MObject*)context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        Benchmark::consume(object->object_instance(i % BENCH_INSTANCE_COUNT));
+    }
+}
+
+static void object_first_free_id(void *context, uint32_t iterations)
+{
+    M2MObject *object = (M2MObject*)context;
+    int32_t sum = 0;
+    for(uint32_t i = 0; i < iterations; i++) {
+        sum += M2MIndex::first_free_id(object->instances());
+    }
+    Benchmark::consume(&sum);
+}
+
+void bench_object_instances()
+{
+    Benchmark::run("object_create_instances_10k_ascending",
+                   object_create_instances_ascending);
+    Benchmark::run("object_create_instances_10k_descending",
+                   object_create_instances_descending);
+
+    M2MObject *object = M2MInterfaceFactory::create_object("10000");
+    for(uint16_t id = 0; id < BENCH_INSTANCE_COUNT; id++) {
+        object->create_object_instance(id);
+    }
+    Benchmark::run("object_instance_lookup_10k", object_instance_lookup, object);
+    Benchmark::run("object_first_free_id_10k", object_first_free_id, object);
+    delete object;
+}
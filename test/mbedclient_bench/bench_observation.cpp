@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "benchmark.h"
+#include "m2mvirtualclock.h"
+#include "mbed-client/m2mreportobserver.h"
+#include "include/m2mreporthandler.h"
+
+#define OBSERVATION_DEFAULT_RESOURCES   100000
+#define OBSERVATION_DEFAULT_HOURS       1
+#define OBSERVATION_TICK_MS             1000
+// One resource in this many changes its value every tick.
+#define OBSERVATION_CHANGE_RATIO        10
+
+/**
+ * Observer counting the notifications of all resources.
+ */
+class CountingObserver : public M2MReportObserver {
+public:
+    CountingObserver() : _notifications(0), _pmax_notifications(0) {}
+    void observation_to_be_sent(const m2m::IdSet &, bool send_object, const m2m::IdSet *) {
+        _notifications++;
+        if(send_object) {
+            _pmax_notifications++;
+        }
+    }
+    uint64_t _notifications;
+    uint64_t _pmax_notifications;
+};
+
+// Attribute sets assigned round robin to the observed resources.
+static const char *ATTRIBUTES[] = {
+    "pmin=10&pmax=60",
+    "pmin=5&pmax=300&st=2",
+    "pmin=1&gt=60&lt=20",
+    "pmax=30"
+};
+
+static uint64_t cpu_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Deterministic pseudo random generator, the run must be reproducible.
+static uint32_t next_random(uint32_t &state)
+{
+    state = state * 1664525UL + 1013904223UL;
+    return state >> 8;
+}
+
+/**
+ * Runs observed resources through simulated time on the virtual clock.
+ * Usage: mbed-client-test-observation [resources] [simulated hours]
+ * Every simulated second a tenth of the resources changes its value.
+ * Prints one JSON line with the notification counts, the CPU time per
+ * notification and the timer management overhead.
+ */
+int main(int argc, char **argv)
+{
+    uint32_t resources = argc > 1 ? strtoul(argv[1], NULL, 10) : OBSERVATION_DEFAULT_RESOURCES;
+    uint32_t hours = argc > 2 ? strtoul(argv[2], NULL, 10) : OBSERVATION_DEFAULT_HOURS;
+    if(!resources) {
+        resources = OBSERVATION_DEFAULT_RESOURCES;
+    }
+
+    CountingObserver observer;
+    M2MReportHandler **handlers = (M2MReportHandler**)malloc(resources * sizeof(M2MReportHandler*));
+    float *values = (float*)malloc(resources * sizeof(float));
+    if(!handlers || !values) {
+        return 1;
+    }
+    const uint32_t attribute_sets = sizeof(ATTRIBUTES) / sizeof(ATTRIBUTES[0]);
+    for(uint32_t i = 0; i < resources; i++) {
+        handlers[i] = new M2MReportHandler(observer);
+        char query[32];
+        snprintf(query, sizeof(query), "%s", ATTRIBUTES[i % attribute_sets]);
+        char *query_ptr = query;
+        handlers[i]->parse_notification_attribute(query_ptr, M2MBase::Resource,
+                                                  M2MResourceInstance::FLOAT);
+        handlers[i]->set_under_observation(true);
+        values[i] = 40.0f;
+    }
+
+    uint32_t state = 1;
+    uint32_t ticks = hours * 3600 * (1000 / OBSERVATION_TICK_MS);
+    uint32_t changes_per_tick = resources / OBSERVATION_CHANGE_RATIO;
+    uint64_t timer_cpu = 0;
+    uint64_t value_cpu = 0;
+    uint64_t starts = M2MVirtualClock::timer_starts();
+    uint64_t stops = M2MVirtualClock::timer_stops();
+    uint64_t expiries = M2MVirtualClock::timer_expiries();
+    uint64_t allocations = Benchmark::allocations();
+    for(uint32_t tick = 0; tick < ticks; tick++) {
+        uint64_t start = cpu_ns();
+        for(uint32_t i = 0; i < changes_per_tick; i++) {
+            uint32_t index = next_random(state) % resources;
+            // Random walk between 0 and 80 around the gt/lt thresholds.
+            values[index] += (float)((int32_t)(next_random(state) % 7) - 3);
+            if(values[index] < 0.0f) {
+                values[index] = 0.0f;
+            } else if(values[index] > 80.0f) {
+                values[index] = 80.0f;
+            }
+            handlers[index]->set_value(values[index]);
+        }
+        uint64_t changed = cpu_ns();
+        M2MVirtualClock::advance(OBSERVATION_TICK_MS);
+        timer_cpu += cpu_ns() - changed;
+        value_cpu += changed - start;
+    }
+    allocations = Benchmark::allocations() - allocations;
+
+    uint64_t notifications = observer._notifications;
+    uint64_t total_cpu = timer_cpu + value_cpu;
+    printf("{\"benchmark\":\"observation\",\"resources\":%u,\"simulated_seconds\":%llu,"
+           "\"value_changes\":%llu,\"notifications\":%llu,\"pmax_notifications\":%llu,"
+           "\"cpu_ms\":%.1f,\"ns_per_notification\":%.1f,\"timer_cpu_ms\":%.1f,"
+           "\"timer_starts\":%llu,\"timer_stops\":%llu,\"timer_expiries\":%llu,"
+           "\"allocs_per_notification\":%.2f}\n",
+           resources,
+           (unsigned long long)(M2MVirtualClock::now() / 1000),
+           (unsigned long long)changes_per_tick * ticks,
+           (unsigned long long)notifications,
+           (unsigned long long)observer._pmax_notifications,
+           total_cpu / 1000000.0,
+           notifications ? (double)total_cpu / notifications : 0.0,
+           timer_cpu / 1000000.0,
+           (unsigned long long)(M2MVirtualClock::timer_starts() - starts),
+           (unsigned long long)(M2MVirtualClock::timer_stops() - stops),
+           (unsigned long long)(M2MVirtualClock::timer_expiries() - expiries),
+           notifications ? (double)allocations / notifications : 0.0);
+
+    for(uint32_t i = 0; i < resources; i++) {
+        delete handlers[i];
+    }
+    free(handlers);
+    free(values);
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark.h"
+#include "mbed-client/m2mreportobserver.h"
+#include "include/m2mreporthandler.h"
+
+/**
+ * Observer counting the reports, nothing is sent anywhere.
+ */
+class BenchReportObserver : public M2MReportObserver {
+public:
+    BenchReportObserver() : _reports(0) {}
+    void observation_to_be_sent(const m2m::IdSet &, bool, const m2m::IdSet *) {
+        _reports++;
+    }
+    uint32_t _reports;
+};
+
+static void report_handler_set_value_unchanged(void *context, uint32_t iterations)
+{
+    M2MReportHandler *handler = (M2MReportHandler*)context;
+    handler->set_value(1.0f);
+    for(uint32_t i = 0; i < iterations; i++) {
+        handler->set_value(1.0f);
+    }
+}
+
+static void report_handler_set_value_changed(void *context, uint32_t iterations)
+{
+    M2MReportHandler *handler = (M2MReportHandler*)context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        handler->set_value((float)(i & 0xFFFF) + 2.0f);
+    }
+}
+
+void bench_report_handler()
+{
+    BenchReportObserver observer;
+    M2MReportHandler *handler = new M2MReportHandler(observer);
+    handler->set_under_observation(true);
+
+    Benchmark::run("report_handler_set_value_unchanged",
+                   report_handler_set_value_unchanged, handler);
+    Benchmark::run("report_handler_set_value_changed",
+                   report_handler_set_value_changed, handler);
+
+    handler->set_under_observation(false);
+    delete handler;
+}
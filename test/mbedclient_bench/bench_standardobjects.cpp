@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark.h"
+#include "benchmark.h"
+#include "mbed-client/m2minterfacefactory.h"
+#include "mbed-client/m2mdevice.h"
+#include "mbed-client/m2mfirmware.h"
+#include "mbed-client/m2msecurity.h"
+#include "mbed-client/m2mserver.h"
+
+static void standard_objects_create(void *, uint32_t iterations)
+{
+    for(uint32_t i = 0; i < iterations; i++) {
+        Benchmark::consume(M2MInterfaceFactory::create_device());
+        Benchmark::consume(M2MInterfaceFactory::create_firmware());
+        M2MServer *server = M2MInterfaceFactory::create_server();
+        M2MSecurity *security = M2MInterfaceFactory::create_security(M2MSecurity::M2MServer);
+        delete security;
+        delete server;
+        M2MFirmware::delete_instance();
+        M2MDevice::delete_instance();
+    }
+}
+
+static void device_set_resource_value(void *context, uint32_t iterations)
+{
+    M2MDevice *device = (M2MDevice*)context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        device->set_resource_value(M2MDevice::BatteryLevel, (int64_t)(i % 100));
+    }
+}
+
+static void device_resource_value_int(void *context, uint32_t iterations)
+{
+    M2MDevice *device = (M2MDevice*)context;
+    int64_t sum = 0;
+    for(uint32_t i = 0; i < iterations; i++) {
+        sum += device->resource_value_int(M2MDevice::BatteryLevel);
+    }
+    Benchmark::consume(&sum);
+}
+
+void bench_standard_objects()
+{
+    Benchmark::run("standard_objects_create", standard_objects_create);
+
+    M2MDevice *device = M2MInterfaceFactory::create_device();
+    device->create_resource(M2MDevice::Manufacturer, "ARM");
+    device->create_resource(M2MDevice::ModelNumber, "bench");
+    device->create_resource(M2MDevice::MemoryFree, 1024);
+    device->create_resource(M2MDevice::BatteryLevel, 50);
+    Benchmark::run("device_set_resource_value", device_set_resource_value, device);
+    Benchmark::run("device_resource_value_int", device_resource_value_int, device);
+    M2MDevice::delete_instance();
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include "benchmark.h"
+#include "mbed-client/m2mobject.h"
+#include "include/m2mtlvserializer.h"
+#include "include/m2mtlvdeserializer.h"
+#include "include/m2msenmlcborserializer.h"
+
+struct TLVContext {
+    M2MObject           *object;
+    uint8_t             *data;
+    uint32_t            size;
+};
+
+static void serialize_object(void *context, uint32_t iterations)
+{
+    TLVContext *ctx = (TLVContext*)context;
+    M2MTLVSerializer serializer;
+    for(uint32_t i = 0; i < iterations; i++) {
+        uint32_t size = 0;
+        uint8_t *data = serializer.serialize(ctx->object->instances(), size);
+        Benchmark::consume(data);
+        free(data);
+    }
+}
+
+static void serialize_object_senml_cbor(void *context, uint32_t iterations)
+{
+    TLVContext *ctx = (TLVContext*)context;
+    M2MSenMLCBORSerializer serializer;
+    for(uint32_t i = 0; i < iterations; i++) {
+        uint32_t size = 0;
+        serializer.append(ctx->object);
+        uint8_t *data = serializer.serialize(size);
+        Benchmark::consume(data);
+        free(data);
+    }
+}
+
+static void deserialize_object(void *context, uint32_t iterations)
+{
+    TLVContext *ctx = (TLVContext*)context;
+    M2MTLVDeserializer deserializer;
+    for(uint32_t i = 0; i < iterations; i++) {
+        M2MTLVDeserializer::Error error =
+            deserializer.deserialise_object_instances(ctx->data, ctx->size,
+                                                      *ctx->object,
+                                                      M2MTLVDeserializer::Put);
+        Benchmark::consume(&error);
+    }
+}
+
+static void bench_tlv_object(const char *serialize_name,
+                             const char *deserialize_name,
+                             uint16_t instances,
+                             uint16_t resources)
+{
+    TLVContext ctx;
+    ctx.object = bench_create_object(1000, instances, resources);
+    if(!ctx.object) {
+        return;
+    }
+    M2MTLVSerializer serializer;
+    ctx.size = 0;
+    ctx.data = serializer.serialize(ctx.object->instances(), ctx.size);
+
+    Benchmark::run(serialize_name, serialize_object, &ctx);
+    if(ctx.data) {
+        Benchmark::run(deserialize_name, deserialize_object, &ctx);
+    }
+    free(ctx.data);
+    delete ctx.object;
+}
+
+static void bench_senml_cbor_object(const char *serialize_name,
+                                    uint16_t instances,
+                                    uint16_t resources)
+{
+    TLVContext ctx;
+    ctx.object = bench_create_object(1000, instances, resources);
+    if(!ctx.object) {
+        return;
+    }
+    Benchmark::run(serialize_name, serialize_object_senml_cbor, &ctx);
+    delete ctx.object;
+}
+
+void bench_tlv()
+{
+    bench_tlv_object("tlv_serialize_small", "tlv_deserialize_small", 1, 4);
+    bench_tlv_object("tlv_serialize_medium", "tlv_deserialize_medium", 4, 16);
+    bench_tlv_object("tlv_serialize_large", "tlv_deserialize_large", 16, 64);
+    bench_senml_cbor_object("senml_cbor_serialize_medium", 4, 16);
+}
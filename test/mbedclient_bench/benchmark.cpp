@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "benchmark.h"
+
+// Minimum duration of a calibrated run.
+#define BENCHMARK_MIN_TIME_NS   200000000ULL
+#define BENCHMARK_MAX_ITERATIONS 0x40000000UL
+
+static uint64_t allocation_count = 0;
+static const char *benchmark_filter = NULL;
+static const void * volatile benchmark_sink = NULL;
+
+extern "C" {
+
+// glibc entry points used to forward the interposed allocation functions.
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size)
+{
+    allocation_count++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    allocation_count++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    allocation_count++;
+    return __libc_realloc(ptr, size);
+}
+
+}
+
+static uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void Benchmark::set_filter(const char *filter)
+{
+    benchmark_filter = filter;
+}
+
+void Benchmark::run(const char *name,
+                    benchmark_function function,
+                    void *context)
+{
+    if(benchmark_filter && !strstr(name, benchmark_filter)) {
+        return;
+    }
+    // Warm up caches and lazily created state.
+    function(context, 1);
+
+    uint32_t iterations = 1;
+    uint64_t elapsed = 0;
+    uint64_t allocs = 0;
+    for(;;) {
+        uint64_t allocs_start = allocation_count;
+        uint64_t start = now_ns();
+        function(context, iterations);
+        elapsed = now_ns() - start;
+        allocs = allocation_count - allocs_start;
+        if(elapsed >= BENCHMARK_MIN_TIME_NS ||
+           iterations >= BENCHMARK_MAX_ITERATIONS) {
+            break;
+        }
+        // Aim directly for the minimum time, growing at most 100 times per step.
+        uint64_t next = elapsed ? (BENCHMARK_MIN_TIME_NS * 12 / 10) * iterations / elapsed
+                                : (uint64_t)iterations * 100;
+        if(next > (uint64_t)iterations * 100) {
+            next = (uint64_t)iterations * 100;
+        }
+        if(next <= iterations) {
+            next = (uint64_t)iterations + 1;
+        }
+        if(next > BENCHMARK_MAX_ITERATIONS) {
+            next = BENCHMARK_MAX_ITERATIONS;
+        }
+        iterations = (uint32_t)next;
+    }
+    printf("{\"benchmark\":\"%s\",\"iterations\":%u,\"ns_per_op\":%.2f,\"allocs_per_op\":%.2f}\n",
+           name, iterations,
+           (double)elapsed / iterations,
+           (double)allocs / iterations);
+    fflush(stdout);
+}
+
+void Benchmark::consume(const void *value)
+{
+    benchmark_sink = value;
+}
+
+uint64_t Benchmark::allocations()
+{
+    return allocation_count;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_BENCHMARK_H
+#define M2M_BENCHMARK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "mbed-client/m2mresourceinstance.h"
+
+class M2MObject;
+
+/**
+ * @brief Function measured by the benchmark runner. It must perform the
+ * measured operation exactly `iterations` times.
+ */
+typedef void (*benchmark_function)(void *context, uint32_t iterations);
+
+/**
+ * @brief Minimal microbenchmark runner.
+ * Every benchmark is calibrated until a single run lasts long enough to be
+ * measured reliably and the result is printed as one JSON object per line:
+ * {"benchmark":"<name>","iterations":N,"ns_per_op":X,"allocs_per_op":Y}
+ * Allocations are counted by interposing malloc, calloc and realloc.
+ */
+class Benchmark {
+
+public:
+
+    /**
+     * @brief Restricts the benchmarks being run to the ones whose name
+     * contains the given string. NULL runs all benchmarks.
+     */
+    static void set_filter(const char *filter);
+
+    /**
+     * @brief Calibrates and runs the benchmark and reports the result.
+     * @param name Name of the benchmark as reported.
+     * @param function Function performing the measured operation.
+     * @param context Context passed to the function.
+     */
+    static void run(const char *name,
+                    benchmark_function function,
+                    void *context = NULL);
+
+    /**
+     * @brief Consumes a value so that the compiler cannot
+     * optimize away the computation producing it.
+     */
+    static void consume(const void *value);
+
+    /**
+     * @brief Returns the number of heap allocations made so far.
+     */
+    static uint64_t allocations();
+};
+
+/**
+ * @brief Creates an object with the given number of instances, each holding
+ * `resources` readable and writable resources. Resource types alternate
+ * between INTEGER and STRING and every resource has a value set.
+ * The caller owns the returned object.
+ */
+M2MObject* bench_create_object(uint16_t object_id,
+                               uint16_t instances,
+                               uint16_t resources);
+
+// Benchmark suites, one per component.
+void bench_tlv();
+void bench_string();
+void bench_vector();
+void bench_integer_conversion();
+void bench_find_resource();
+void bench_object_instances();
+void bench_report_handler();
+void bench_standard_objects();
+
+#endif // M2M_BENCHMARK_H
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include "benchmark.h"
+#include "mbed-client/m2minterfacefactory.h"
+#include "mbed-client/m2mobject.h"
+#include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mresource.h"
+
+M2MObject* bench_create_object(uint16_t object_id,
+                               uint16_t instances,
+                               uint16_t resources)
+{
+    char buffer[12];
+    m2m::itoa_c(object_id, buffer);
+    M2MObject *object = M2MInterfaceFactory::create_object(buffer);
+    if(!object) {
+        return NULL;
+    }
+    for(uint16_t i = 0; i < instances; i++) {
+        M2MObjectInstance *instance = object->create_object_instance(i);
+        if(!instance) {
+            continue;
+        }
+        for(uint16_t r = 0; r < resources; r++) {
+            m2m::itoa_c(r, buffer);
+            bool integer = (r % 2) == 0;
+            M2MResource *res = instance->create_dynamic_resource(buffer, "bench",
+                                  integer ? M2MResourceInstance::INTEGER :
+                                            M2MResourceInstance::STRING,
+                                  false);
+            if(res) {
+                res->set_operation(M2MBase::GET_PUT_ALLOWED);
+                const char *value = integer ? "1234567" : "mbed-client-value";
+                res->set_value((const uint8_t*)value, strlen(value));
+            }
+        }
+    }
+    return object;
+}
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "benchmark.h"
+#include "loopbackserver.h"
+#include "mbed-client/m2minterfacefactory.h"
+#include "mbed-client/m2minterfaceobserver.h"
+#include "mbed-client/m2minterface.h"
+#include "mbed-client/m2msecurity.h"
+#include "mbed-client/m2mobject.h"
+#include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mresource.h"
+#include "mbed-client/m2mstatistics.h"
+#include "mbed-client/m2mlatency.h"
+
+#define LOADGEN_SERVER_PORT         5783
+#define LOADGEN_DEFAULT_OPERATIONS  1000
+#define LOADGEN_TIMEOUT_MS          2000
+#define LOADGEN_REGISTER_TIMEOUT_MS 10000
+#define LOADGEN_LIFETIME            3600
+
+static const char *OBSERVED_PATH = "1000/0/0";
+static const char *WRITABLE_PATH = "1000/0/1";
+static const char *EXECUTABLE_PATH = "1000/0/2";
+
+static uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t now_us()
+{
+    return now_ns() / 1000ULL;
+}
+
+/**
+ * Client under load, one object with an observable, a writable and an
+ * executable resource.
+ */
+class LoadClient : public M2MInterfaceObserver {
+public:
+    LoadClient()
+    : _interface(NULL),
+      _security(NULL),
+      _object(NULL),
+      _observed(NULL),
+      _registered(false),
+      _error(false),
+      _executions(0)
+    {
+    }
+
+    virtual ~LoadClient() {
+        delete _interface;
+        delete _security;
+        delete _object;
+    }
+
+    bool create(uint16_t server_port) {
+        _interface = M2MInterfaceFactory::create_interface(*this,
+                                                           "loadgen",
+                                                           "bench",
+                                                           LOADGEN_LIFETIME,
+                                                           server_port + 1,
+                                                           "",
+                                                           M2MInterface::UDP,
+                                                           M2MInterface::LwIP_IPv4,
+                                                           "");
+        _security = M2MInterfaceFactory::create_security(M2MSecurity::M2MServer);
+        if(!_interface || !_security) {
+            return false;
+        }
+        char uri[32];
+        snprintf(uri, sizeof(uri), "coap://127.0.0.1:%d", server_port);
+        if(!_security->set_resource_value(M2MSecurity::M2MServerUri, uri) ||
+           !_security->set_resource_value(M2MSecurity::SecurityMode, M2MSecurity::NoSecurity)) {
+            return false;
+        }
+
+        _object = M2MInterfaceFactory::create_object("1000");
+        M2MObjectInstance *inst = _object ? _object->create_object_instance() : NULL;
+        if(!inst) {
+            return false;
+        }
+        _observed = inst->create_dynamic_resource("0", "Counter",
+                                                  M2MResourceInstance::INTEGER,
+                                                  true);
+        M2MResource *writable = inst->create_dynamic_resource("1", "Text",
+                                                              M2MResourceInstance::STRING,
+                                                              false);
+        M2MResource *executable = inst->create_dynamic_resource("2", "Action",
+                                                                M2MResourceInstance::OPAQUE,
+                                                                false);
+        if(!_observed || !writable || !executable) {
+            return false;
+        }
+        _observed->set_operation(M2MBase::GET_PUT_ALLOWED);
+        _observed->set_value((const uint8_t*)"0", 1);
+        writable->set_operation(M2MBase::GET_PUT_ALLOWED);
+        executable->set_operation(M2MBase::POST_ALLOWED);
+        executable->set_execute_function(execute_callback(this, &LoadClient::execute));
+        return true;
+    }
+
+    void register_client() {
+        M2MObjectList object_list;
+        object_list.push_back(_object);
+        _interface->register_object(_security, object_list);
+    }
+
+    void unregister_client() {
+        _interface->unregister_object(NULL);
+    }
+
+    void set_value(uint32_t value) {
+        char buffer[12];
+        int size = snprintf(buffer, sizeof(buffer), "%u", value);
+        _observed->set_value((const uint8_t*)buffer, size);
+    }
+
+    bool failed() const {
+        return _error;
+    }
+
+    void execute(void *) {
+        _executions++;
+    }
+
+    void bootstrap_done(M2MSecurity *) {}
+
+    void object_registered(M2MSecurity *, const M2MServer &) {
+        _registered = true;
+    }
+
+    void object_unregistered(M2MSecurity *) {
+        _registered = false;
+    }
+
+    void registration_updated(M2MSecurity *, const M2MServer &) {}
+
+    void error(M2MInterface::Error error) {
+        fprintf(stderr, "client error %d\n", (int)error);
+        _error = true;
+    }
+
+    void value_updated(M2MBase *, M2MBase::BaseType) {}
+
+private:
+
+    M2MInterface            *_interface;
+    M2MSecurity             *_security;
+    M2MObject               *_object;
+    M2MResource             *_observed;
+    volatile bool           _registered;
+    volatile bool           _error;
+    volatile uint32_t       _executions;
+};
+
+static int compare_latency(const void *a, const void *b)
+{
+    uint64_t left = *(const uint64_t*)a;
+    uint64_t right = *(const uint64_t*)b;
+    return (left > right) - (left < right);
+}
+
+static double percentile_us(const uint64_t *sorted, uint32_t count, double p)
+{
+    if(!count) {
+        return 0;
+    }
+    uint32_t index = (uint32_t)(p * count);
+    if(index >= count) {
+        index = count - 1;
+    }
+    return sorted[index] / 1000.0;
+}
+
+/**
+ * Prints the results of a workload as one JSON object per line.
+ */
+static void report(const char *workload,
+                   uint64_t *latencies,
+                   uint32_t count,
+                   uint32_t errors,
+                   uint64_t elapsed_ns,
+                   uint64_t allocations)
+{
+    qsort(latencies, count, sizeof(uint64_t), compare_latency);
+    uint32_t operations = count + errors;
+    printf("{\"workload\":\"%s\",\"operations\":%u,\"errors\":%u,"
+           "\"ops_per_second\":%.1f,\"p50_us\":%.1f,\"p99_us\":%.1f,"
+           "\"p999_us\":%.1f,\"allocs_per_op\":%.2f}\n",
+           workload, operations, errors,
+           elapsed_ns ? count * 1000000000.0 / elapsed_ns : 0.0,
+           percentile_us(latencies, count, 0.50),
+           percentile_us(latencies, count, 0.99),
+           percentile_us(latencies, count, 0.999),
+           operations ? (double)allocations / operations : 0.0);
+    fflush(stdout);
+}
+
+static void run_requests(LoopbackServer &server,
+                         const char *workload,
+                         uint8_t code,
+                         const char *path,
+                         const char *payload,
+                         uint8_t expected,
+                         uint64_t *latencies,
+                         uint32_t operations)
+{
+    uint32_t count = 0;
+    uint32_t errors = 0;
+    uint16_t payload_len = payload ? strlen(payload) : 0;
+    uint64_t allocations = Benchmark::allocations();
+    uint64_t start = now_ns();
+    for(uint32_t i = 0; i < operations; i++) {
+        uint64_t sent = now_ns();
+        uint8_t response = server.request(code, path, (const uint8_t*)payload,
+                                          payload_len, false,
+                                          LOADGEN_TIMEOUT_MS);
+        if(response == expected) {
+            latencies[count++] = now_ns() - sent;
+        } else {
+            errors++;
+        }
+    }
+    uint64_t elapsed = now_ns() - start;
+    report(workload, latencies, count, errors, elapsed,
+           Benchmark::allocations() - allocations);
+}
+
+static void run_notifications(LoopbackServer &server,
+                              LoadClient &client,
+                              uint64_t *latencies,
+                              uint32_t operations)
+{
+    if(server.request(COAP_CODE_GET, OBSERVED_PATH, NULL, 0, true,
+                      LOADGEN_TIMEOUT_MS) != COAP_CODE_CONTENT) {
+        fprintf(stderr, "observation failed\n");
+        return;
+    }
+    uint32_t count = 0;
+    uint32_t errors = 0;
+    uint64_t allocations = Benchmark::allocations();
+    uint64_t start = now_ns();
+    for(uint32_t i = 0; i < operations; i++) {
+        uint64_t changed = now_ns();
+        client.set_value(i + 1);
+        if(server.wait_for_notification(LOADGEN_TIMEOUT_MS)) {
+            latencies[count++] = now_ns() - changed;
+        } else {
+            errors++;
+        }
+    }
+    uint64_t elapsed = now_ns() - start;
+    report("notify", latencies, count, errors, elapsed,
+           Benchmark::allocations() - allocations);
+}
+
+/**
+ * Load generator running the mbed Client against a loopback LwM2M server.
+ * Usage: mbed-client-test-loadgen [operations] [server port]
+ * Each workload issues the given number of operations one at a time and
+ * reports latency percentiles, throughput and allocations per operation.
+ */
+int main(int argc, char **argv)
+{
+    uint32_t operations = argc > 1 ? strtoul(argv[1], NULL, 10) : LOADGEN_DEFAULT_OPERATIONS;
+    uint16_t port = argc > 2 ? strtoul(argv[2], NULL, 10) : LOADGEN_SERVER_PORT;
+    if(!operations) {
+        operations = LOADGEN_DEFAULT_OPERATIONS;
+    }
+
+    M2MStatistics::set_clock(now_us);
+
+    LoopbackServer server;
+    if(!server.start(port)) {
+        fprintf(stderr, "cannot bind loopback server to port %d\n", port);
+        return 1;
+    }
+    LoadClient *client = new LoadClient();
+    if(!client->create(port)) {
+        fprintf(stderr, "cannot create client\n");
+        delete client;
+        return 1;
+    }
+    client->register_client();
+    if(!server.wait_for_registration(LOADGEN_REGISTER_TIMEOUT_MS) || client->failed()) {
+        fprintf(stderr, "registration failed\n");
+        delete client;
+        return 1;
+    }
+
+    uint64_t *latencies = (uint64_t*)malloc(operations * sizeof(uint64_t));
+    if(!latencies) {
+        delete client;
+        return 1;
+    }
+    run_requests(server, "get", COAP_CODE_GET, OBSERVED_PATH, NULL,
+                 COAP_CODE_CONTENT, latencies, operations);
+    run_requests(server, "put", COAP_CODE_PUT, WRITABLE_PATH, "loadgen",
+                 COAP_CODE_CHANGED, latencies, operations);
+    run_requests(server, "post", COAP_CODE_POST, EXECUTABLE_PATH, NULL,
+                 COAP_CODE_CHANGED, latencies, operations);
+    run_notifications(server, *client, latencies, operations);
+    free(latencies);
+
+    printf("{\"statistics\":{\"messages_sent\":%u,\"messages_received\":%u,"
+           "\"retransmissions\":%u,\"notifications_sent\":%u,"
+           "\"notifications_dropped\":%u,\"bytes_sent\":%u,\"bytes_received\":%u,"
+           "\"heap_bytes\":%u}}\n",
+           M2MStatistics::value(M2MStatistics::MessagesSent),
+           M2MStatistics::value(M2MStatistics::MessagesReceived),
+           M2MStatistics::value(M2MStatistics::Retransmissions),
+           M2MStatistics::value(M2MStatistics::NotificationsSent),
+           M2MStatistics::value(M2MStatistics::NotificationsDropped),
+           M2MStatistics::value(M2MStatistics::BytesSent),
+           M2MStatistics::value(M2MStatistics::BytesReceived),
+           M2MStatistics::value(M2MStatistics::HeapBytes));
+
+    // Latencies as seen inside the client, to compare with the round trip
+    // times measured above.
+    static char histograms[16384];
+    if(M2MLatency::export_json(histograms, sizeof(histograms))) {
+        printf("{\"latency_us\":%s}\n", histograms);
+    }
+
+    client->unregister_client();
+    server.wait_for_deregistration(LOADGEN_TIMEOUT_MS);
+    delete client;
+    return 0;
+}
@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "loopbackserver.h"
+
+#define COAP_VERSION                1
+#define COAP_TYPE_CON               0
+#define COAP_TYPE_NON               1
+#define COAP_TYPE_ACK               2
+#define COAP_TYPE_RST               3
+#define COAP_CODE_NOT_FOUND         0x84
+
+#define COAP_OPTION_OBSERVE         6
+#define COAP_OPTION_LOCATION_PATH   8
+#define COAP_OPTION_URI_PATH        11
+#define COAP_OPTION_CONTENT_FORMAT  12
+#define COAP_OPTION_URI_QUERY       15
+#define COAP_PAYLOAD_MARKER         0xFF
+
+static const char *REGISTRATION_PATH = "rd";
+static const char *REGISTRATION_PREFIX = "rd/";
+static const char *LOCATION = "loadgen";
+
+static uint64_t now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+static uint16_t encode_header(uint8_t *buffer,
+                              uint8_t type,
+                              uint8_t code,
+                              uint16_t msg_id,
+                              const uint8_t *token,
+                              uint8_t token_len)
+{
+    buffer[0] = (COAP_VERSION << 6) | (type << 4) | token_len;
+    buffer[1] = code;
+    buffer[2] = msg_id >> 8;
+    buffer[3] = msg_id & 0xFF;
+    memcpy(buffer + 4, token, token_len);
+    return 4 + token_len;
+}
+
+static uint16_t encode_option(uint8_t *buffer,
+                              uint16_t offset,
+                              uint16_t &last_number,
+                              uint16_t number,
+                              const uint8_t *value,
+                              uint16_t value_len)
+{
+    uint16_t delta = number - last_number;
+    last_number = number;
+    uint8_t *header = buffer + offset++;
+    *header = 0;
+    if(delta < 13) {
+        *header |= delta << 4;
+    } else {
+        *header |= 13 << 4;
+        buffer[offset++] = delta - 13;
+    }
+    if(value_len < 13) {
+        *header |= value_len;
+    } else {
+        *header |= 13;
+        buffer[offset++] = value_len - 13;
+    }
+    memcpy(buffer + offset, value, value_len);
+    return offset + value_len;
+}
+
+static bool decode_extended(const uint8_t *&ptr,
+                            const uint8_t *end,
+                            uint16_t &value)
+{
+    if(value == 13) {
+        if(ptr >= end) {
+            return false;
+        }
+        value = 13 + *ptr++;
+    } else if(value == 14) {
+        if(ptr + 1 >= end) {
+            return false;
+        }
+        value = 269 + ((ptr[0] << 8) | ptr[1]);
+        ptr += 2;
+    } else if(value == 15) {
+        return false;
+    }
+    return true;
+}
+
+static bool decode_message(const uint8_t *buffer,
+                           uint16_t length,
+                           loopback_message_s &message)
+{
+    memset(&message, 0, sizeof(message));
+    if(length < 4 || (buffer[0] >> 6) != COAP_VERSION) {
+        return false;
+    }
+    message.type = (buffer[0] >> 4) & 0x03;
+    message.token_len = buffer[0] & 0x0F;
+    message.code = buffer[1];
+    message.msg_id = (buffer[2] << 8) | buffer[3];
+    if(message.token_len > 8 || 4 + message.token_len > length) {
+        return false;
+    }
+    memcpy(message.token, buffer + 4, message.token_len);
+
+    const uint8_t *ptr = buffer + 4 + message.token_len;
+    const uint8_t *end = buffer + length;
+    uint16_t number = 0;
+    uint16_t path_len = 0;
+    while(ptr < end && *ptr != COAP_PAYLOAD_MARKER) {
+        uint16_t delta = *ptr >> 4;
+        uint16_t option_len = *ptr & 0x0F;
+        ptr++;
+        if(!decode_extended(ptr, end, delta) ||
+           !decode_extended(ptr, end, option_len) ||
+           ptr + option_len > end) {
+            return false;
+        }
+        number += delta;
+        if(number == COAP_OPTION_URI_PATH) {
+            if(path_len + option_len + 2 > LOOPBACK_MAX_PATH_LENGTH) {
+                return false;
+            }
+            if(path_len) {
+                message.path[path_len++] = '/';
+            }
+            memcpy(message.path + path_len, ptr, option_len);
+            path_len += option_len;
+        } else if(number == COAP_OPTION_OBSERVE) {
+            message.has_observe = true;
+            for(uint16_t i = 0; i < option_len; i++) {
+                message.observe = (message.observe << 8) | ptr[i];
+            }
+        } else if(number == COAP_OPTION_URI_QUERY) {
+            message.has_query = true;
+        }
+        ptr += option_len;
+    }
+    if(ptr < end) {
+        // Skip the payload marker.
+        ptr++;
+        message.payload = ptr;
+        message.payload_len = end - ptr;
+    }
+    return true;
+}
+
+LoopbackServer::LoopbackServer()
+: _socket(-1),
+  _registered(false),
+  _msg_id(0),
+  _token(0),
+  _observing(false),
+  _notifications(0),
+  _registration_updates(0)
+{
+    memset(&_client_address, 0, sizeof(_client_address));
+    memset(_observe_token, 0, sizeof(_observe_token));
+}
+
+LoopbackServer::~LoopbackServer()
+{
+    stop();
+}
+
+bool LoopbackServer::start(uint16_t port)
+{
+    _socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if(_socket < 0) {
+        return false;
+    }
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(bind(_socket, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void LoopbackServer::stop()
+{
+    if(_socket >= 0) {
+        close(_socket);
+        _socket = -1;
+    }
+}
+
+bool LoopbackServer::wait_for_registration(uint32_t timeout_ms)
+{
+    return wait_for_registration_state(true, timeout_ms);
+}
+
+bool LoopbackServer::wait_for_deregistration(uint32_t timeout_ms)
+{
+    return !wait_for_registration_state(false, timeout_ms);
+}
+
+bool LoopbackServer::wait_for_registration_state(bool registered,
+                                                 uint32_t timeout_ms)
+{
+    uint64_t deadline = now_ms() + timeout_ms;
+    loopback_message_s message;
+    while(_registered != registered) {
+        uint64_t now = now_ms();
+        if(now >= deadline) {
+            break;
+        }
+        if(receive(message, deadline - now)) {
+            handle_client_message(message);
+        }
+    }
+    return _registered;
+}
+
+uint8_t LoopbackServer::request(uint8_t code,
+                                const char *path,
+                                const uint8_t *payload,
+                                uint16_t payload_len,
+                                bool observe,
+                                uint32_t timeout_ms)
+{
+    if(!_registered) {
+        return COAP_CODE_EMPTY;
+    }
+    uint16_t msg_id = ++_msg_id;
+    uint32_t token_value = ++_token;
+    uint8_t token[LOOPBACK_TOKEN_LENGTH];
+    for(uint8_t i = 0; i < LOOPBACK_TOKEN_LENGTH; i++) {
+        token[i] = token_value >> (8 * (LOOPBACK_TOKEN_LENGTH - 1 - i));
+    }
+
+    uint16_t offset = encode_header(_send_buffer, COAP_TYPE_CON, code, msg_id,
+                                    token, LOOPBACK_TOKEN_LENGTH);
+    uint16_t number = 0;
+    if(observe) {
+        offset = encode_option(_send_buffer, offset, number,
+                               COAP_OPTION_OBSERVE, NULL, 0);
+    }
+    const char *segment = path;
+    while(*segment) {
+        const char *separator = strchr(segment, '/');
+        uint16_t segment_len = separator ? separator - segment : strlen(segment);
+        offset = encode_option(_send_buffer, offset, number, COAP_OPTION_URI_PATH,
+                               (const uint8_t*)segment, segment_len);
+        segment += segment_len;
+        if(*segment == '/') {
+            segment++;
+        }
+    }
+    if(payload && payload_len) {
+        // text/plain is encoded as an empty Content-Format option.
+        offset = encode_option(_send_buffer, offset, number,
+                               COAP_OPTION_CONTENT_FORMAT, NULL, 0);
+        if(offset + 1 + payload_len > LOOPBACK_MAX_MESSAGE_SIZE) {
+            return COAP_CODE_EMPTY;
+        }
+        _send_buffer[offset++] = COAP_PAYLOAD_MARKER;
+        memcpy(_send_buffer + offset, payload, payload_len);
+        offset += payload_len;
+    }
+    if(!send(offset)) {
+        return COAP_CODE_EMPTY;
+    }
+    if(observe) {
+        memcpy(_observe_token, token, LOOPBACK_TOKEN_LENGTH);
+        _observing = true;
+    }
+
+    uint64_t deadline = now_ms() + timeout_ms;
+    loopback_message_s message;
+    for(;;) {
+        uint64_t now = now_ms();
+        if(now >= deadline) {
+            break;
+        }
+        if(!receive(message, deadline - now)) {
+            continue;
+        }
+        bool own_token = message.token_len == LOOPBACK_TOKEN_LENGTH &&
+                         memcmp(message.token, token, LOOPBACK_TOKEN_LENGTH) == 0;
+        if(message.type == COAP_TYPE_ACK && message.msg_id == msg_id) {
+            if(message.code != COAP_CODE_EMPTY) {
+                return message.code;
+            }
+            // Empty ACK, the response follows separately.
+        } else if(own_token && message.code >= COAP_CODE_CREATED) {
+            if(message.type == COAP_TYPE_CON) {
+                send_ack(message, COAP_CODE_EMPTY, false);
+            }
+            return message.code;
+        } else {
+            handle_client_message(message);
+        }
+    }
+    return COAP_CODE_EMPTY;
+}
+
+bool LoopbackServer::wait_for_notification(uint32_t timeout_ms)
+{
+    uint64_t deadline = now_ms() + timeout_ms;
+    loopback_message_s message;
+    for(;;) {
+        uint64_t now = now_ms();
+        if(now >= deadline) {
+            break;
+        }
+        if(receive(message, deadline - now) &&
+           handle_client_message(message)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t LoopbackServer::notifications() const
+{
+    return _notifications;
+}
+
+uint32_t LoopbackServer::registration_updates() const
+{
+    return _registration_updates;
+}
+
+bool LoopbackServer::receive(loopback_message_s &message, uint32_t timeout_ms)
+{
+    struct pollfd fd;
+    fd.fd = _socket;
+    fd.events = POLLIN;
+    fd.revents = 0;
+    if(poll(&fd, 1, timeout_ms) <= 0) {
+        return false;
+    }
+    struct sockaddr_in address;
+    socklen_t address_len = sizeof(address);
+    ssize_t length = recvfrom(_socket, _receive_buffer, sizeof(_receive_buffer), 0,
+                              (struct sockaddr*)&address, &address_len);
+    if(length <= 0 || !decode_message(_receive_buffer, length, message)) {
+        return false;
+    }
+    if(!_registered) {
+        // Requests and responses go to wherever the client registers from.
+        _client_address = address;
+    }
+    return true;
+}
+
+bool LoopbackServer::handle_client_message(const loopback_message_s &message)
+{
+    bool notification = false;
+    if(message.code >= COAP_CODE_GET && message.code <= COAP_CODE_DELETE) {
+        if(message.code == COAP_CODE_POST &&
+           strcmp(message.path, REGISTRATION_PATH) == 0) {
+            _registered = true;
+            send_ack(message, COAP_CODE_CREATED, true);
+        } else if(message.code == COAP_CODE_POST &&
+                  strncmp(message.path, REGISTRATION_PREFIX, 3) == 0) {
+            _registration_updates++;
+            send_ack(message, COAP_CODE_CHANGED, false);
+        } else if(message.code == COAP_CODE_DELETE &&
+                  strncmp(message.path, REGISTRATION_PREFIX, 3) == 0) {
+            _registered = false;
+            _observing = false;
+            send_ack(message, COAP_CODE_DELETED, false);
+        } else {
+            send_ack(message, COAP_CODE_NOT_FOUND, false);
+        }
+    } else if(message.code >= COAP_CODE_CREATED &&
+              _observing &&
+              message.token_len == LOOPBACK_TOKEN_LENGTH &&
+              memcmp(message.token, _observe_token, LOOPBACK_TOKEN_LENGTH) == 0) {
+        if(message.type == COAP_TYPE_CON) {
+            send_ack(message, COAP_CODE_EMPTY, false);
+        }
+        _notifications++;
+        notification = true;
+    }
+    return notification;
+}
+
+void LoopbackServer::send_ack(const loopback_message_s &message,
+                              uint8_t code,
+                              bool location)
+{
+    if(message.type != COAP_TYPE_CON) {
+        return;
+    }
+    uint16_t offset;
+    if(code == COAP_CODE_EMPTY) {
+        offset = encode_header(_send_buffer, COAP_TYPE_ACK, code,
+                               message.msg_id, NULL, 0);
+    } else {
+        offset = encode_header(_send_buffer, COAP_TYPE_ACK, code,
+                               message.msg_id, message.token,
+                               message.token_len);
+    }
+    if(location) {
+        uint16_t number = 0;
+        offset = encode_option(_send_buffer, offset, number,
+                               COAP_OPTION_LOCATION_PATH,
+                               (const uint8_t*)REGISTRATION_PATH,
+                               strlen(REGISTRATION_PATH));
+        offset = encode_option(_send_buffer, offset, number,
+                               COAP_OPTION_LOCATION_PATH,
+                               (const uint8_t*)LOCATION,
+                               strlen(LOCATION));
+    }
+    send(offset);
+}
+
+bool LoopbackServer::send(uint16_t length)
+{
+    ssize_t sent = sendto(_socket, _send_buffer, length, 0,
+                          (struct sockaddr*)&_client_address,
+                          sizeof(_client_address));
+    return sent == length;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOOPBACK_SERVER_H
+#define LOOPBACK_SERVER_H
+
+#include <stdint.h>
+#include <netinet/in.h>
+
+#define LOOPBACK_MAX_MESSAGE_SIZE   1280
+#define LOOPBACK_MAX_PATH_LENGTH    64
+#define LOOPBACK_TOKEN_LENGTH       4
+
+// CoAP codes used by the loopback server.
+#define COAP_CODE_EMPTY             0x00
+#define COAP_CODE_GET               0x01
+#define COAP_CODE_POST              0x02
+#define COAP_CODE_PUT               0x03
+#define COAP_CODE_DELETE            0x04
+#define COAP_CODE_CREATED           0x41
+#define COAP_CODE_DELETED           0x42
+#define COAP_CODE_CHANGED           0x44
+#define COAP_CODE_CONTENT           0x45
+
+/**
+ * @brief Parsed CoAP message. Payload and path point into the receive
+ * buffer of the server and are valid until the next receive.
+ */
+typedef struct {
+    uint8_t         type;
+    uint8_t         code;
+    uint16_t        msg_id;
+    uint8_t         token[8];
+    uint8_t         token_len;
+    bool            has_observe;
+    uint32_t        observe;
+    char            path[LOOPBACK_MAX_PATH_LENGTH];
+    bool            has_query;
+    const uint8_t   *payload;
+    uint16_t        payload_len;
+} loopback_message_s;
+
+/**
+ * @brief Minimal LwM2M server on the localhost UDP interface.
+ * It accepts client registration, registration updates and
+ * deregistration and issues requests to the registered client. Only the
+ * subset of CoAP the mbed Client uses is understood. The server is driven
+ * synchronously from the calling thread and does not allocate memory
+ * once started, so it does not disturb allocation measurements of the
+ * client running in the same process.
+ */
+class LoopbackServer {
+
+public:
+
+    LoopbackServer();
+
+    ~LoopbackServer();
+
+    /**
+     * @brief Binds the server to 127.0.0.1 and the given port.
+     * @return True if the socket could be bound, else false.
+     */
+    bool start(uint16_t port);
+
+    /**
+     * @brief Closes the server socket.
+     */
+    void stop();
+
+    /**
+     * @brief Serves the client until it has registered.
+     * @param timeout_ms Time to wait, in milliseconds.
+     * @return True if the client registered, else false.
+     */
+    bool wait_for_registration(uint32_t timeout_ms);
+
+    /**
+     * @brief Serves the client until it has deregistered.
+     * @param timeout_ms Time to wait, in milliseconds.
+     * @return True if the client deregistered, else false.
+     */
+    bool wait_for_deregistration(uint32_t timeout_ms);
+
+    /**
+     * @brief Sends a confirmable request to the registered client and
+     * serves incoming messages until the matching response arrives.
+     * @param code Request method code.
+     * @param path Resource path without a leading slash, e.g. "3/0/0".
+     * @param payload Request payload, can be NULL.
+     * @param payload_len Length of the payload.
+     * @param observe True to register an observation on the path.
+     * @param timeout_ms Time to wait for the response, in milliseconds.
+     * @return Code of the response, COAP_CODE_EMPTY on timeout.
+     */
+    uint8_t request(uint8_t code,
+                    const char *path,
+                    const uint8_t *payload,
+                    uint16_t payload_len,
+                    bool observe,
+                    uint32_t timeout_ms);
+
+    /**
+     * @brief Serves incoming messages until a notification for the
+     * observation started with request() arrives.
+     * @param timeout_ms Time to wait, in milliseconds.
+     * @return True if a notification was received, else false.
+     */
+    bool wait_for_notification(uint32_t timeout_ms);
+
+    /**
+     * @brief Returns the number of notifications received.
+     */
+    uint32_t notifications() const;
+
+    /**
+     * @brief Returns the number of registration updates served.
+     */
+    uint32_t registration_updates() const;
+
+private:
+
+    bool wait_for_registration_state(bool registered, uint32_t timeout_ms);
+
+    bool receive(loopback_message_s &message, uint32_t timeout_ms);
+
+    // Answers the requests the client sends to the server. Returns true
+    // if the message was a notification for the current observation.
+    bool handle_client_message(const loopback_message_s &message);
+
+    void send_ack(const loopback_message_s &message,
+                  uint8_t code,
+                  bool location);
+
+    bool send(uint16_t length);
+
+private:
+
+    // Prevents the use of assignment operator by accident.
+    LoopbackServer& operator=( const LoopbackServer& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    LoopbackServer( const LoopbackServer& /*other*/ );
+
+private:
+
+    int                     _socket;
+    struct sockaddr_in      _client_address;
+    bool                    _registered;
+    uint16_t                _msg_id;
+    uint32_t                _token;
+    uint8_t                 _observe_token[LOOPBACK_TOKEN_LENGTH];
+    bool                    _observing;
+    uint32_t                _notifications;
+    uint32_t                _registration_updates;
+    uint8_t                 _receive_buffer[LOOPBACK_MAX_MESSAGE_SIZE];
+    uint8_t                 _send_buffer[LOOPBACK_MAX_MESSAGE_SIZE];
+};
+
+#endif // LOOPBACK_SERVER_H
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2015 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark.h"
+
+/**
+ * Runs the mbed Client microbenchmarks. An optional argument restricts
+ * the run to benchmarks whose name contains it, e.g. "tlv".
+ */
+int main(int argc, char **argv)
+{
+    Benchmark::set_filter(argc > 1 ? argv[1] : NULL);
+
+    bench_tlv();
+    bench_string();
+    bench_vector();
+    bench_integer_conversion();
+    bench_find_resource();
+    bench_object_instances();
+    bench_report_handler();
+    bench_standard_objects();
+    return 0;
+}